@@ -0,0 +1,260 @@
+#include <pcl/ElapsedTime.h>
+#include <pcl/Settings.h>
+
+#include <map>
+#include <thread>
+
+#include "TRTInferenceAutotune.h"
+#include "TRTInferenceOnnx.h"
+#include "TRTInferencePipeline.h"
+#include "TRTInferencePreview.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+// A new value must beat the current one by this much to be taken
+static const double s_minImprovement = 0.02;
+static const int s_maxPasses = 3;
+
+String TRTTuning::toString() const
+{
+    auto value = [](int32 v) { return (v > 0) ? String().Format("%d", v) : String("default"); };
+    return "batch " + value(batchSize) + ", placement threads " + value(placementThreads) +
+           ", in-flight tiles " + value(inFlightTiles) + ", CPU threads " + value(cpuThreads);
+}
+
+IsoString TRTTuning::serialize() const
+{
+    return IsoString().Format("batch=%d placement=%d inflight=%d cpu=%d", batchSize, placementThreads, inFlightTiles, cpuThreads);
+}
+
+TRTTuning TRTTuning::deserialize(const IsoString& text)
+{
+    TRTTuning tuning;
+    IsoStringList items;
+    text.Break(items, ' ', true);
+    for (const IsoString& item : items)
+    {
+        size_type eq = item.Find('=');
+        if (eq == IsoString::notFound)
+            continue;
+        IsoString key = item.Left(eq);
+        int value;
+        if (!item.Substring(eq + 1).TryToInt(value))
+            continue;
+        value = Max(0, value);
+        if (key == "batch")
+            tuning.batchSize = value;
+        else if (key == "placement")
+            tuning.placementThreads = value;
+        else if (key == "inflight")
+            tuning.inFlightTiles = value;
+        else if (key == "cpu")
+            tuning.cpuThreads = value;
+    }
+    return tuning;
+}
+
+TRTTuning searchTuning(const TRTTuningSpace& space, const std::function<double(const TRTTuning&)>& measure,
+                       std::vector<TRTTuningResult>& results)
+{
+    std::map<IsoString, double> measured;
+    auto secondsPerTile = [&](const TRTTuning& tuning)
+    {
+        IsoString key = tuning.serialize();
+        auto i = measured.find(key);
+        if (i != measured.end())
+            return i->second;
+        double seconds = measure(tuning);
+        measured[key] = seconds;
+        results.push_back({ tuning, seconds });
+        return seconds;
+    };
+
+    struct Dimension
+    {
+        const std::vector<int32>& values;
+        int32 TRTTuning::*setting;
+    };
+    const Dimension dimensions[] = {
+        { space.batchSizes, &TRTTuning::batchSize },
+        { space.placementThreads, &TRTTuning::placementThreads },
+        { space.inFlightTiles, &TRTTuning::inFlightTiles },
+        { space.cpuThreads, &TRTTuning::cpuThreads },
+    };
+
+    TRTTuning current;
+    for (const Dimension& d : dimensions)
+        if (!d.values.empty())
+            current.*d.setting = d.values.front();
+    double currentSeconds = secondsPerTile(current);
+
+    for (int pass = 0; pass < s_maxPasses; pass++)
+    {
+        bool changed = false;
+        for (const Dimension& d : dimensions)
+        {
+            TRTTuning best = current;
+            double bestSeconds = currentSeconds;
+            for (int32 value : d.values)
+            {
+                if (value == current.*d.setting)
+                    continue;
+                TRTTuning candidate = current;
+                candidate.*d.setting = value;
+                double seconds = secondsPerTile(candidate);
+                if (seconds < bestSeconds)
+                {
+                    best = candidate;
+                    bestSeconds = seconds;
+                }
+            }
+            if (bestSeconds < currentSeconds * (1 - s_minImprovement))
+            {
+                current = best;
+                currentSeconds = bestSeconds;
+                changed = true;
+            }
+        }
+        if (!changed)
+            break;
+    }
+    return current;
+}
+
+TRTTuningSpace tuningSpace(const TRTEngine& engine, int numPlanes)
+{
+    int numProcessors = Max(1, int(std::thread::hardware_concurrency()));
+    TRTTuningSpace space;
+
+    // Batches of a single-channel engine must divide the planes of a tile, as the engine buffers are
+    // sized for whole batches
+    if ((engine.getNumberOfChannels() == 1) && (numPlanes > 1))
+        for (int32 b = 1; b < Min(numPlanes, engine.getMaxBatchSize()); b++)
+            if (numPlanes % b == 0)
+                space.batchSizes.push_back(b);
+
+    for (int32 n : { 1, 2, 4, 8 })
+        if (n <= numProcessors)
+            space.placementThreads.push_back(n);
+    for (int32 n : { 2, 4, 8, 16 })
+        space.inFlightTiles.push_back(n);
+
+    if (dynamic_cast<const TRTOnnxEngine*>(&engine) != nullptr)
+        for (int32 n : { numProcessors / 4, numProcessors / 2 })
+            if ((n > 0) && (n != space.cpuThreads.back()))
+                space.cpuThreads.push_back(n);
+    return space;
+}
+
+String tuningDeviceKey(const TRTEngine& engine)
+{
+    // The devices of all stages, each once
+    if (const TRTPipelineEngine* pipeline = dynamic_cast<const TRTPipelineEngine*>(&engine))
+    {
+        StringList keys;
+        String deviceKey;
+        for (int i = 0; i < pipeline->numStages(); i++)
+        {
+            String key = tuningDeviceKey(pipeline->stage(i));
+            if (key.IsEmpty())
+                return String();
+            if (!keys.Contains(key))
+            {
+                keys << key;
+                deviceKey += (deviceKey.IsEmpty() ? "" : "+") + key;
+            }
+        }
+        return deviceKey;
+    }
+
+    if (dynamic_cast<const TRTOnnxEngine*>(&engine) != nullptr)
+        return String().Format("cpu%d", int(std::thread::hardware_concurrency()));
+    if (dynamic_cast<const TRTLocalEngine*>(&engine) == nullptr)
+        return String();
+
+    const TRTRuntime& runtime = trtRuntime();
+    int major = 0, minor = 0, numMultiprocessors = 0;
+    size_t free = 0, total = 0;
+    if ((runtime.deviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0) != cudaSuccess) ||
+        (runtime.deviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0) != cudaSuccess) ||
+        (runtime.deviceGetAttribute(&numMultiprocessors, cudaDevAttrMultiProcessorCount, 0) != cudaSuccess) ||
+        (runtime.memGetInfo(&free, &total) != cudaSuccess))
+        return String();
+    return String().Format("sm%d%d_%dsm_%lluMiB", major, minor, numMultiprocessors, (unsigned long long)(total >> 20));
+}
+
+void applyTuning(TRTEngine& engine, const TRTTuning& tuning)
+{
+    engine.setBatchLimit(tuning.batchSize);
+    engine.setNumberOfThreads(tuning.cpuThreads);
+}
+
+double benchmarkTuning(TRTEngine& engine, const FImage& crop, int numPlanes, const TRTTuning& tuning, double tileOverlap,
+                       int maxTiles)
+{
+    applyTuning(engine, tuning);
+    engine.setNumberOfPlanes(numPlanes);
+
+    int inputTileW = engine.getInputTileW();
+    int inputTileH = engine.getInputTileH();
+    int outputTileW = engine.getOutputTileW();
+    int outputTileH = engine.getOutputTileH();
+    int factorW = outputTileW / inputTileW;
+    int factorH = outputTileH / inputTileH;
+    int stepX = Max(1, int(inputTileW * (1.0 - tileOverlap)));
+    int stepY = Max(1, int(inputTileH * (1.0 - tileOverlap)));
+
+    FImage output;
+    output.AllocateData(crop.Width() * factorW, crop.Height() * factorH, numPlanes,
+                        (numPlanes == 3) ? ColorSpace::RGB : ColorSpace::Gray);
+
+    Array<Point> tiles = previewTiles(crop.Width(), crop.Height(), inputTileW, inputTileH, tileOverlap);
+    if (tiles.IsEmpty())
+        throw Error("Autotune: empty benchmark image.");
+    int numTiles = Min(int(tiles.Length()), Max(1, maxTiles));
+
+    // The first inference after a change of settings pays for allocations and lazy initialization
+    extractTile(crop, tiles[0], inputTileW, inputTileH, numPlanes, engine.getInputBuffer());
+    engine.runInference();
+
+    ElapsedTime T;
+    {
+        TRTTilePlacer placer(output, outputTileW, outputTileH, numPlanes, tuning.placementThreads, tuning.inFlightTiles);
+        for (int i = 0; i < numTiles; i++)
+        {
+            const Point& tilePos = tiles[i];
+            extractTile(crop, tilePos, inputTileW, inputTileH, numPlanes, engine.getInputBuffer());
+            engine.runInference();
+            Rect rect = cropRegion(tilePos, inputTileW, inputTileH, stepX, stepY, crop.Width(), crop.Height());
+            placer.place(engine.getOutputBuffer(), Point(tilePos.x * factorW, tilePos.y * factorH),
+                         Rect(rect.x0 * factorW, rect.y0 * factorH, rect.x1 * factorW, rect.y1 * factorH));
+        }
+        placer.wait();
+    }
+    return T() / numTiles;
+}
+
+// Settings keys are 8-bit; device keys are ASCII
+static IsoString tuningKey(uint64 engineHash, const String& deviceKey)
+{
+    return IsoString().Format("Autotune/%016llx/", (unsigned long long)engineHash) + deviceKey.ToIsoString();
+}
+
+bool loadTuning(uint64 engineHash, const String& deviceKey, TRTTuning& tuning)
+{
+    tuning = TRTTuning();
+    String text;
+    if (deviceKey.IsEmpty() || !Settings::Read(tuningKey(engineHash, deviceKey), text) || text.IsEmpty())
+        return false;
+    tuning = TRTTuning::deserialize(text.ToIsoString());
+    return true;
+}
+
+void saveTuning(uint64 engineHash, const String& deviceKey, const TRTTuning& tuning)
+{
+    Settings::Write(tuningKey(engineHash, deviceKey), String(tuning.serialize().c_str()));
+}
+
+}	// namespace pcl
@@ -0,0 +1,86 @@
+#ifndef __TRTInferenceAutotune_h
+#define __TRTInferenceAutotune_h
+
+#include <pcl/Image.h>
+#include <pcl/String.h>
+
+#include <functional>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Execution settings that change the speed of a run but not its result. Zero leaves a setting at its
+// default.
+struct TRTTuning
+{
+    // Planes a single-channel engine infers at once
+    int32 batchSize = 0;
+    // Threads placing output tiles, and tiles queued for placement
+    int32 placementThreads = 0;
+    int32 inFlightTiles = 0;
+    // Threads of an engine running on the CPU
+    int32 cpuThreads = 0;
+
+    bool isDefault() const
+    {
+        return (batchSize == 0) && (placementThreads == 0) && (inFlightTiles == 0) && (cpuThreads == 0);
+    }
+
+    // For display
+    String toString() const;
+
+    // As "batch=3 placement=4 inflight=8 cpu=15"; unknown keys are ignored, and missing keys and
+    // invalid values read as zero
+    IsoString serialize() const;
+    static TRTTuning deserialize(const IsoString& text);
+};
+
+// Values to try for each setting, the default one first. A setting with a single value is not tuned.
+struct TRTTuningSpace
+{
+    std::vector<int32> batchSizes = { 0 };
+    std::vector<int32> placementThreads = { 0 };
+    std::vector<int32> inFlightTiles = { 0 };
+    std::vector<int32> cpuThreads = { 0 };
+};
+
+struct TRTTuningResult
+{
+    TRTTuning tuning;
+    double secondsPerTile = 0;
+};
+
+// Searches the fastest tuning by coordinate descent: starting from the defaults, each setting in turn
+// takes the value that runs fastest with the others fixed, and passes repeat until no setting changes.
+// A value replaces the current one only if it is more than 2% faster, so noise does not pick it.
+// measure returns the seconds per tile of a tuning and is called once per distinct tuning; every
+// measurement is appended to results. Returns the fastest tuning.
+TRTTuning searchTuning(const TRTTuningSpace& space, const std::function<double(const TRTTuning&)>& measure,
+                       std::vector<TRTTuningResult>& results);
+
+// Settings worth tuning for an engine processing tiles of numPlanes planes
+TRTTuningSpace tuningSpace(const TRTEngine& engine, int numPlanes);
+
+// Identifies the device an engine runs on, as GPU architecture, multiprocessors and memory, or CPU
+// threads, and the devices of the stages of a pipeline. Empty for engines run by another process,
+// which are not tuned.
+String tuningDeviceKey(const TRTEngine& engine);
+
+void applyTuning(TRTEngine& engine, const TRTTuning& tuning);
+
+// Runs center-crop tiling of an image crop with a tuning and returns the seconds per tile, after one
+// inference to warm up. At most maxTiles tiles are run.
+double benchmarkTuning(TRTEngine& engine, const FImage& crop, int numPlanes, const TRTTuning& tuning, double tileOverlap,
+                       int maxTiles);
+
+// Per-machine profiles, kept in the module settings by engine hash and device key. loadTuning returns
+// false, with a default tuning, when there is no profile.
+bool loadTuning(uint64 engineHash, const String& deviceKey, TRTTuning& tuning);
+void saveTuning(uint64 engineHash, const String& deviceKey, const TRTTuning& tuning);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceAutotune_h
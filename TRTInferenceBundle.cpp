@@ -0,0 +1,181 @@
+#include <pcl/File.h>
+
+#include <algorithm>
+
+#include "TRTInferenceBundle.h"
+#include "TRTInferenceRuntime.h"
+
+namespace pcl
+{
+
+static const char s_magic[8] = { 'T', 'R', 'T', 'B', 'U', 'N', 'D', 'L' };
+static const uint32 s_version = 1;
+static const uint64 s_alignment = 4096;
+
+struct BundleHeader
+{
+    char magic[8];
+    uint32 version;
+    uint32 numVariants;
+};
+
+static const char* precisionName(int32 precision)
+{
+    switch (precision)
+    {
+    case TRTBundlePrecision::FP32:
+        return "FP32";
+    case TRTBundlePrecision::FP16:
+        return "FP16";
+    case TRTBundlePrecision::INT8:
+        return "INT8";
+    default:
+        return "unknown precision";
+    }
+}
+
+// Lower is better
+static int precisionRank(int32 precision, int32 computeCapability)
+{
+    // Reduced precision is fast from the tensor cores of Volta on; INT8 calibration may cost accuracy
+    if (precision == TRTBundlePrecision::INT8)
+        return 2;
+    bool tensorCores = computeCapability >= 70;
+    return ((precision == TRTBundlePrecision::FP16) == tensorCores) ? 0 : 1;
+}
+
+int selectBundleVariant(const std::vector<TRTBundleVariant>& variants, const TRTBundleTarget& target, String& whyNot)
+{
+    int best = -1;
+    auto better = [&](const TRTBundleVariant& a, const TRTBundleVariant& b)
+    {
+        bool aFits = (target.imageW == 0) || ((a.tileW <= target.imageW) && (a.tileH <= target.imageH));
+        bool bFits = (target.imageW == 0) || ((b.tileW <= target.imageW) && (b.tileH <= target.imageH));
+        if (aFits != bFits)
+            return aFits;
+        int aRank = precisionRank(a.precision, target.computeCapability);
+        int bRank = precisionRank(b.precision, target.computeCapability);
+        if (aRank != bRank)
+            return aRank < bRank;
+        // Tiles larger than the image are wasted work: the smallest of those is best
+        int64 aArea = int64(a.tileW) * a.tileH;
+        int64 bArea = int64(b.tileW) * b.tileH;
+        if (aArea != bArea)
+            return aFits ? (aArea > bArea) : (aArea < bArea);
+        return a.deviceMemory < b.deviceMemory;
+    };
+
+    int numArchitecture = 0, numVersion = 0;
+    for (size_type i = 0; i < variants.size(); i++)
+    {
+        const TRTBundleVariant& v = variants[i];
+        if (v.computeCapability != target.computeCapability)
+            continue;
+        numArchitecture++;
+        if (v.tensorrtVersion / 100 != target.tensorrtVersion / 100)
+            continue;
+        numVersion++;
+        if ((target.memoryBudget > 0) && (v.deviceMemory > target.memoryBudget))
+            continue;
+        if ((best < 0) || better(v, variants[best]))
+            best = int(i);
+    }
+
+    if (best < 0)
+    {
+        if (numArchitecture == 0)
+            whyNot = String().Format("The bundle has no engine for compute capability %d.%d.",
+                                     target.computeCapability / 10, target.computeCapability % 10);
+        else if (numVersion == 0)
+            whyNot = String().Format("The bundle has no engine for TensorRT %d.%d.",
+                                     target.tensorrtVersion / 1000, target.tensorrtVersion / 100 % 10);
+        else
+            whyNot = String().Format("All engines of the bundle for this device need more than %.0f MiB of device memory.",
+                                     target.memoryBudget / 1048576.0);
+    }
+    return best;
+}
+
+TRTEngineBundle::TRTEngineBundle(const String& path)
+{
+    m_file = std::make_unique<TRTMappedFile>(path, false);
+    const BundleHeader* header = reinterpret_cast<const BundleHeader*>(m_file->data());
+    if ((m_file->size() < sizeof(BundleHeader)) || (::memcmp(header->magic, s_magic, sizeof(s_magic)) != 0))
+        throw Error("Not an engine bundle: " + path);
+    if (header->version != s_version)
+        throw Error("Unsupported engine bundle version: " + path);
+    if (m_file->size() < sizeof(BundleHeader) + header->numVariants * sizeof(TRTBundleVariant))
+        throw Error("Truncated engine bundle: " + path);
+
+    const TRTBundleVariant* manifest = reinterpret_cast<const TRTBundleVariant*>(header + 1);
+    m_variants.assign(manifest, manifest + header->numVariants);
+    for (TRTBundleVariant& v : m_variants)
+    {
+        v.name[sizeof(v.name) - 1] = '\0';
+        if ((v.offset > m_file->size()) || (v.size > m_file->size() - v.offset))
+            throw Error("Truncated engine bundle: " + path);
+    }
+}
+
+bool TRTEngineBundle::isBundle(const String& path)
+{
+    return File::ExtractExtension(path).CaseFolded() == ".trtb";
+}
+
+TRTBundleTarget TRTEngineBundle::deviceTarget(int32 imageW, int32 imageH, uint64 memoryBudget)
+{
+    const TRTRuntime& runtime = trtRuntime();
+    TRTBundleTarget target;
+    int major = 0, minor = 0;
+    if ((runtime.deviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0) != cudaSuccess) ||
+        (runtime.deviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0) != cudaSuccess))
+        throw Error("No CUDA device.");
+    target.computeCapability = major * 10 + minor;
+    target.tensorrtVersion = runtime.getInferLibVersion();
+    target.imageW = imageW;
+    target.imageH = imageH;
+
+    size_t free = 0, total = 0;
+    target.memoryBudget = memoryBudget;
+    if (runtime.memGetInfo(&free, &total) == cudaSuccess)
+        target.memoryBudget = (memoryBudget > 0) ? Min(memoryBudget, uint64(free)) : uint64(free);
+    return target;
+}
+
+void TRTEngineBundle::write(const String& path, std::vector<TRTBundleVariant> variants, const std::vector<ByteArray>& engines)
+{
+    if (variants.size() != engines.size())
+        throw Error("Engine bundle: one engine is required per variant.");
+
+    auto align = [](uint64 offset) { return (offset + s_alignment - 1) & ~(s_alignment - 1); };
+    uint64 offset = align(sizeof(BundleHeader) + variants.size() * sizeof(TRTBundleVariant));
+    for (size_type i = 0; i < variants.size(); i++)
+    {
+        variants[i].offset = offset;
+        variants[i].size = engines[i].Length();
+        offset = align(offset + variants[i].size);
+    }
+
+    File file = File::CreateFileForWriting(path);
+    BundleHeader header = {};
+    ::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.version = s_version;
+    header.numVariants = uint32(variants.size());
+    file.Write(&header, sizeof(header));
+    file.Write(variants.data(), variants.size() * sizeof(TRTBundleVariant));
+    for (size_type i = 0; i < variants.size(); i++)
+    {
+        ByteArray padding(variants[i].offset - uint64(file.Position()), uint8(0));
+        file.Write(padding.Begin(), padding.Length());
+        file.Write(engines[i].Begin(), engines[i].Length());
+    }
+    file.Close();
+}
+
+String bundleVariantDescription(const TRTBundleVariant& variant)
+{
+    return String().Format("%s, %s, %dx%d tiles, compute capability %d.%d", variant.name, precisionName(variant.precision),
+                           variant.tileW, variant.tileH, variant.computeCapability / 10, variant.computeCapability % 10);
+}
+
+}	// namespace pcl
@@ -0,0 +1,94 @@
+#ifndef __TRTInferenceBundle_h
+#define __TRTInferenceBundle_h
+
+#include <pcl/ByteArray.h>
+#include <pcl/String.h>
+
+#include <memory>
+#include <vector>
+
+#include "TRTInferenceMappedFile.h"
+
+namespace pcl
+{
+
+namespace TRTBundlePrecision
+{
+    enum value_type { FP32, FP16, INT8 };
+}
+
+// Manifest entry of an engine in a bundle, as stored in the file
+struct TRTBundleVariant
+{
+    char name[64];
+    int32 precision;
+    // GPU architecture the engine was built for, as major * 10 + minor compute capability
+    int32 computeCapability;
+    // TensorRT version the engine was built with, as NV_TENSORRT_VERSION
+    int32 tensorrtVersion;
+    int32 tileW;
+    int32 tileH;
+    int32 scaleFactor;
+    // Device memory needed to run the engine, in bytes
+    uint64 deviceMemory;
+    // Serialized engine, from the start of the file
+    uint64 offset;
+    uint64 size;
+};
+
+// Device and image an engine variant is selected for
+struct TRTBundleTarget
+{
+    int32 computeCapability = 0;
+    int32 tensorrtVersion = 0;
+    // Dimensions of the image to process, zero when not known
+    int32 imageW = 0;
+    int32 imageH = 0;
+    // Device memory the engine may use, in bytes; zero for no limit
+    uint64 memoryBudget = 0;
+};
+
+// Chooses the variant to run on a target. Engines only run on the GPU architecture and TensorRT
+// minor version they were built for, and within the memory budget. Among those, tiles not larger than
+// the image come first, then FP16 on GPUs with tensor cores (FP32 on older ones) before the other
+// precisions, then the largest tiles, which need the fewest overlapping tiles, then the least memory.
+// Returns the index of the variant, or -1 with the reason in whyNot when none can run.
+int selectBundleVariant(const std::vector<TRTBundleVariant>& variants, const TRTBundleTarget& target, String& whyNot);
+
+// Name, precision, tile size and architecture of a variant, for display
+String bundleVariantDescription(const TRTBundleVariant& variant);
+
+// Several serialized engines of one model, for different GPU architectures, precisions and tile
+// sizes, in one file mapped read-only: a header, a manifest of variants, and the engines, aligned to
+// pages. Only the engine selected for the device is deserialized.
+class TRTEngineBundle
+{
+public:
+    explicit TRTEngineBundle(const String& path);
+
+    static bool isBundle(const String& path);
+
+    const std::vector<TRTBundleVariant>& variants() const
+    {
+        return m_variants;
+    }
+
+    const uint8* variantData(int index) const
+    {
+        return m_file->data() + m_variants[index].offset;
+    }
+
+    // Target for the first CUDA device, whose currently free memory bounds memoryBudget
+    static TRTBundleTarget deviceTarget(int32 imageW, int32 imageH, uint64 memoryBudget);
+
+    // Writes a bundle; the offsets and sizes of the variants are set from the engines
+    static void write(const String& path, std::vector<TRTBundleVariant> variants, const std::vector<ByteArray>& engines);
+
+private:
+    std::unique_ptr<TRTMappedFile> m_file;
+    std::vector<TRTBundleVariant> m_variants;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceBundle_h
@@ -0,0 +1,580 @@
+#include <pcl/File.h>
+#include <NvInfer.h>
+
+#include <memory>
+
+#include "TRTInferenceBundle.h"
+#include "TRTInferenceCatalog.h"
+#include "TRTInferenceOnnx.h"
+#include "TRTInferenceRuntime.h"
+
+namespace pcl
+{
+
+static const char s_magic[8] = { 'T', 'R', 'T', 'I', 'N', 'D', 'E', 'X' };
+static const uint32 s_version = 2;
+static const char* s_indexFileName = "TRTInference.index";
+static const char* s_extensions[] = { ".trt", ".engine", ".plan", ".trtb", ".onnx" };
+
+// Keeps the last error reported while deserializing, which explains version mismatches
+class CatalogLogger : public nvinfer1::ILogger
+{
+public:
+    String m_lastError;
+
+    void log(Severity severity, const char* msg) noexcept override
+    {
+        if (severity <= Severity::kERROR)
+            m_lastError = msg;
+    }
+};
+
+// Serialization of the index, in native byte order: the index is a cache of this machine
+class IndexWriter
+{
+public:
+    ByteArray m_data;
+
+    template <typename T>
+    void write(const T& value)
+    {
+        const uint8* p = reinterpret_cast<const uint8*>(&value);
+        m_data.Append(p, p + sizeof(T));
+    }
+
+    void write(const IsoString& s)
+    {
+        write(uint32(s.Length()));
+        m_data.Append(reinterpret_cast<const uint8*>(s.Begin()), reinterpret_cast<const uint8*>(s.End()));
+    }
+
+    void write(const std::vector<int32>& v)
+    {
+        write(uint32(v.size()));
+        for (int32 x : v)
+            write(x);
+    }
+};
+
+class IndexReader
+{
+public:
+    IndexReader(const ByteArray& data)
+        : m_p(data.Begin())
+        , m_end(data.End())
+    {
+    }
+
+    template <typename T>
+    void read(T& value)
+    {
+        if (size_type(m_end - m_p) < sizeof(T))
+            throw Error("Truncated engine index.");
+        ::memcpy(&value, m_p, sizeof(T));
+        m_p += sizeof(T);
+    }
+
+    void read(IsoString& s)
+    {
+        uint32 length;
+        read(length);
+        if (size_type(m_end - m_p) < length)
+            throw Error("Truncated engine index.");
+        s = IsoString(reinterpret_cast<const char*>(m_p), reinterpret_cast<const char*>(m_p + length));
+        m_p += length;
+    }
+
+    void read(std::vector<int32>& v)
+    {
+        uint32 n;
+        read(n);
+        v.resize(n);
+        for (int32& x : v)
+            read(x);
+    }
+
+private:
+    const uint8* m_p;
+    const uint8* m_end;
+};
+
+static IsoString dataTypeName(nvinfer1::DataType type)
+{
+    switch (type)
+    {
+    case nvinfer1::DataType::kFLOAT:
+        return "float";
+    case nvinfer1::DataType::kHALF:
+        return "half";
+    case nvinfer1::DataType::kINT8:
+        return "int8";
+    case nvinfer1::DataType::kINT32:
+        return "int32";
+    case nvinfer1::DataType::kBOOL:
+        return "bool";
+    case nvinfer1::DataType::kUINT8:
+        return "uint8";
+    default:
+        return "unknown";
+    }
+}
+
+static std::vector<int32> dimsVector(const nvinfer1::Dims& dims)
+{
+    std::vector<int32> v;
+    for (int32 i = 0; i < dims.nbDims; i++)
+        v.push_back(dims.d[i]);
+    return v;
+}
+
+static String dimsText(const std::vector<int32>& dims)
+{
+    String text;
+    for (size_type i = 0; i < dims.size(); i++)
+    {
+        if (i > 0)
+            text += 'x';
+        text += (dims[i] < 0) ? String("?") : String(dims[i]);
+    }
+    return text;
+}
+
+static bool isEngineFile(const String& fileName)
+{
+    String extension = File::ExtractExtension(fileName).CaseFolded();
+    for (const char* e : s_extensions)
+        if (extension == e)
+            return true;
+    return false;
+}
+
+// Same requirements as the engines of the module have on their input and output
+static String checkTensors(const TRTEngineInfo& info)
+{
+    const TRTTensorInfo* input = nullptr;
+    const TRTTensorInfo* output = nullptr;
+    for (const TRTTensorInfo& t : info.tensors)
+        if ((t.name == "input") && t.isInput)
+            input = &t;
+        else if ((t.name == "output") && !t.isInput)
+            output = &t;
+    if (input == nullptr)
+        return "No input tensor named input.";
+    if (output == nullptr)
+        return "No output tensor named output.";
+    if ((input->dims.size() != 4) || (output->dims.size() != 4))
+        return "Input and output are not 4-dimensional.";
+    if ((input->dims[1] != 1) && (input->dims[1] != 3))
+        return "Input does not have 1 or 3 channels.";
+    if (output->dims[1] != input->dims[1])
+        return "Output does not have the same number of channels as input.";
+    if ((input->dims[2] < 0) || (input->dims[3] < 0))
+        return "Tile dimensions are dynamic.";
+    if ((output->dims[2] % input->dims[2] != 0) || (output->dims[3] % input->dims[3] != 0))
+        return "Output is not a multiple of input.";
+    if ((input->dataType != "float") || (output->dataType != "float"))
+        return "Input and output are not 32-bit float.";
+    return String();
+}
+
+String TRTEngineInfo::summary() const
+{
+    String text = format;
+    if (runtimeVersion > 0)
+        text += String().Format(" %d.%d.%d", runtimeVersion / 1000, runtimeVersion / 100 % 10, runtimeVersion % 100);
+    for (const TRTTensorInfo& t : tensors)
+        if (t.isInput)
+        {
+            text += ", " + dimsText(t.dims);
+            break;
+        }
+    if (scaleFactor > 0)
+        text += String().Format(", %dx", scaleFactor);
+    if (numProfiles > 1)
+        text += String().Format(", %d profiles", numProfiles);
+    for (size_type i = 0; i < variants.size(); i++)
+        text += ((i == 0) ? ": " : "; ") + variants[i];
+    if (!described)
+        text += " (not described: " + problem + ')';
+    else if (!problem.IsEmpty())
+        text += " (cannot be used: " + problem + ')';
+    return text;
+}
+
+TRTEngineCatalog::TRTEngineCatalog(const String& directory)
+    : m_directory(directory)
+{
+}
+
+TRTEngineCatalog::~TRTEngineCatalog()
+{
+    // The engine being described is finished, the others are left for the next refresh
+    m_cancel = true;
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+String TRTEngineCatalog::directoryOf(const String& enginePath)
+{
+    return File::ExtractDrive(enginePath) + File::ExtractDirectory(enginePath);
+}
+
+String TRTEngineCatalog::indexPath(const String& directory)
+{
+    return directory + '/' + s_indexFileName;
+}
+
+const TRTEngineInfo* TRTEngineCatalog::find(const String& enginePath) const
+{
+    if (directoryOf(enginePath) != m_directory)
+        return nullptr;
+    String fileName = File::ExtractNameAndExtension(enginePath);
+    for (const TRTEngineInfo& info : m_engines)
+        if (info.fileName == fileName)
+            return &info;
+    return nullptr;
+}
+
+TRTEngineInfo TRTEngineCatalog::describe(const String& enginePath)
+{
+    TRTEngineInfo info;
+    info.fileName = File::ExtractNameAndExtension(enginePath);
+
+    ByteArray data = File::ReadFile(enginePath);
+    info.fileSize = data.Length();
+    info.fileHash = Hash64(data.Begin(), data.Length());
+
+    if (File::ExtractExtension(enginePath).CaseFolded() == ".onnx")
+    {
+        info.format = "ONNX";
+        info.described = true;
+        try
+        {
+            // Compiling the model checks that all of its operators are supported
+            TRTOnnxEngine engine(enginePath);
+            int32 tileH = engine.isDynamic() ? -1 : engine.getInputTileH();
+            int32 tileW = engine.isDynamic() ? -1 : engine.getInputTileW();
+            TRTTensorInfo input;
+            input.name = engine.getInputName();
+            input.isInput = true;
+            input.dataType = "float";
+            input.dims = { 1, engine.getNumberOfChannels(), tileH, tileW };
+            TRTTensorInfo output;
+            output.name = engine.getOutputName();
+            output.dataType = "float";
+            output.dims = { 1, engine.getNumberOfChannels(), engine.getOutputTileH(), engine.getOutputTileW() };
+            if (engine.isDynamic())
+                output.dims[2] = output.dims[3] = -1;
+            info.tensors = { input, output };
+            info.scaleFactor = engine.getOutputTileW() / engine.getInputTileW();
+        }
+        catch (const Error& x)
+        {
+            info.problem = x.Message();
+        }
+        return info;
+    }
+
+    // The variant of a bundle is only chosen when it is loaded, for the device and the image
+    if (TRTEngineBundle::isBundle(enginePath))
+    {
+        TRTEngineBundle bundle(enginePath);
+        info.format = IsoString().Format("Engine bundle of %d variants", int(bundle.variants().size()));
+        for (const TRTBundleVariant& variant : bundle.variants())
+            info.variants.push_back(bundleVariantDescription(variant));
+        info.described = true;
+        return info;
+    }
+
+    info.format = "TensorRT";
+    const TRTRuntime* runtime;
+    try
+    {
+        runtime = &trtRuntime();
+    }
+    catch (const Error& x)
+    {
+        info.problem = x.Message();
+        return info;
+    }
+
+    info.described = true;
+    info.runtimeVersion = runtime->getInferLibVersion();
+    CatalogLogger logger;
+    auto trtRuntimeInstance = std::unique_ptr<nvinfer1::IRuntime>(static_cast<nvinfer1::IRuntime*>(runtime->createInferRuntime(&logger, NV_TENSORRT_VERSION)));
+    if (!trtRuntimeInstance)
+    {
+        info.problem = "Failed to create TensorRT runtime.";
+        return info;
+    }
+    runtime->setDevice(0);
+    auto engine = std::unique_ptr<nvinfer1::ICudaEngine>(trtRuntimeInstance->deserializeCudaEngine(data.Begin(), data.Length()));
+    if (!engine)
+    {
+        info.problem = logger.m_lastError.IsEmpty() ? String("Not a TensorRT engine.") : logger.m_lastError;
+        return info;
+    }
+
+    info.numProfiles = engine->getNbOptimizationProfiles();
+    for (int32_t i = 0; i < engine->getNbIOTensors(); i++)
+    {
+        const char* name = engine->getIOTensorName(i);
+        TRTTensorInfo t;
+        t.name = name;
+        t.isInput = engine->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT;
+        t.dataType = dataTypeName(engine->getTensorDataType(name));
+        t.dims = dimsVector(engine->getTensorShape(name));
+        if (t.isInput && (info.numProfiles > 0))
+        {
+            t.minDims = dimsVector(engine->getProfileShape(name, 0, nvinfer1::OptProfileSelector::kMIN));
+            t.optDims = dimsVector(engine->getProfileShape(name, 0, nvinfer1::OptProfileSelector::kOPT));
+            t.maxDims = dimsVector(engine->getProfileShape(name, 0, nvinfer1::OptProfileSelector::kMAX));
+        }
+        info.tensors.push_back(t);
+    }
+
+    info.problem = checkTensors(info);
+    if (info.problem.IsEmpty())
+    {
+        int32 inputW = 0, outputW = 0;
+        for (const TRTTensorInfo& t : info.tensors)
+            if (t.name == "input")
+                inputW = t.dims[3];
+            else if (t.name == "output")
+                outputW = t.dims[3];
+        info.scaleFactor = outputW / inputW;
+    }
+    return info;
+}
+
+bool TRTEngineCatalog::refresh()
+{
+    if (!m_loaded)
+    {
+        load();
+        m_loaded = true;
+    }
+
+    std::vector<TRTEngineInfo> engines;
+    bool changed = scan(engines);
+    m_engines = std::move(engines);
+    if (changed)
+        save(m_directory, m_engines);
+    return changed;
+}
+
+void TRTEngineCatalog::startRefresh()
+{
+    if (m_thread.joinable())
+        return;
+    if (!m_loaded)
+    {
+        load();
+        m_loaded = true;
+    }
+
+    m_done = false;
+    m_refreshed.clear();
+    m_refreshError.Clear();
+    m_thread = std::thread(&TRTEngineCatalog::runRefresh, this);
+}
+
+void TRTEngineCatalog::runRefresh()
+{
+    try
+    {
+        std::vector<TRTEngineInfo> engines;
+        if (scan(engines))
+            save(m_directory, engines);
+        m_refreshed = std::move(engines);
+    }
+    catch (const Error& x)
+    {
+        m_refreshError = x.Message();
+    }
+    catch (...)
+    {
+        m_refreshError = "Unable to refresh the engine catalog.";
+    }
+    m_done = true;
+}
+
+bool TRTEngineCatalog::finishRefresh()
+{
+    if (!m_thread.joinable() || !m_done)
+        return false;
+    m_thread.join();
+    if (!m_refreshError.IsEmpty())
+        throw Error(m_refreshError);
+    m_engines = std::move(m_refreshed);
+    return true;
+}
+
+// Lists the engines of the directory into engines, describing those that are new or changed since
+// m_engines was recorded. Returns true if the index has to be rewritten.
+bool TRTEngineCatalog::scan(std::vector<TRTEngineInfo>& engines) const
+{
+    // Engines described by another TensorRT version are described again once a runtime is loaded
+    String description;
+    int32 currentVersion = 0;
+    if (trtRuntimeState(description) == TRTRuntimeState::Loaded)
+        currentVersion = trtRuntime().getInferLibVersion();
+
+    bool changed = false;
+    FindFileInfo file;
+    for (File::Find f(m_directory + "/*"); f.NextItem(file);)
+    {
+        if (file.IsDirectory() || !isEngineFile(file.name))
+            continue;
+        if (m_cancel)
+            throw Error("Engine catalog refresh cancelled.");
+
+        const TRTEngineInfo* known = nullptr;
+        for (const TRTEngineInfo& info : m_engines)
+            if (info.fileName == file.name)
+                known = &info;
+        bool stale = (known == nullptr) || (known->fileSize != uint64(file.size)) || (known->lastModified != file.lastModified.ToJD()) ||
+                     !known->described || ((known->format == "TensorRT") && (currentVersion != 0) && (known->runtimeVersion != currentVersion));
+        if (!stale)
+        {
+            engines.push_back(*known);
+            continue;
+        }
+
+        TRTEngineInfo info;
+        try
+        {
+            info = describe(m_directory + '/' + file.name);
+        }
+        catch (const Error& x)
+        {
+            info.fileName = file.name;
+            info.problem = x.Message();
+        }
+        info.fileSize = uint64(file.size);
+        info.lastModified = file.lastModified.ToJD();
+        // An engine that still cannot be described is not a change worth rewriting the index for
+        if ((known == nullptr) || info.described || known->described)
+            changed = true;
+        engines.push_back(info);
+    }
+    if (engines.size() != m_engines.size())
+        changed = true;
+    return changed;
+}
+
+void TRTEngineCatalog::load()
+{
+    m_engines.clear();
+    String path = indexPath(m_directory);
+    if (!File::Exists(path))
+        return;
+
+    // A damaged or outdated index is rebuilt
+    try
+    {
+        ByteArray data = File::ReadFile(path);
+        IndexReader r(data);
+        char magic[8];
+        uint32 version, count;
+        r.read(magic);
+        r.read(version);
+        if ((::memcmp(magic, s_magic, sizeof(s_magic)) != 0) || (version != s_version))
+            return;
+        r.read(count);
+        for (uint32 i = 0; i < count; i++)
+        {
+            TRTEngineInfo info;
+            IsoString fileName, problem;
+            uint32 numTensors;
+            uint8 described;
+            r.read(fileName);
+            r.read(info.fileSize);
+            r.read(info.lastModified);
+            r.read(info.fileHash);
+            r.read(info.format);
+            r.read(info.runtimeVersion);
+            r.read(info.numProfiles);
+            r.read(info.scaleFactor);
+            r.read(described);
+            r.read(problem);
+            r.read(numTensors);
+            for (uint32 j = 0; j < numTensors; j++)
+            {
+                TRTTensorInfo t;
+                uint8 isInput;
+                r.read(t.name);
+                r.read(isInput);
+                r.read(t.dataType);
+                r.read(t.dims);
+                r.read(t.minDims);
+                r.read(t.optDims);
+                r.read(t.maxDims);
+                t.isInput = isInput != 0;
+                info.tensors.push_back(t);
+            }
+            uint32 numVariants;
+            r.read(numVariants);
+            for (uint32 j = 0; j < numVariants; j++)
+            {
+                IsoString variant;
+                r.read(variant);
+                info.variants.push_back(String::UTF8ToUTF16(variant.c_str()));
+            }
+            info.fileName = String::UTF8ToUTF16(fileName.c_str());
+            info.problem = String::UTF8ToUTF16(problem.c_str());
+            info.described = described != 0;
+            m_engines.push_back(info);
+        }
+    }
+    catch (const Error&)
+    {
+        m_engines.clear();
+    }
+}
+
+void TRTEngineCatalog::save(const String& directory, const std::vector<TRTEngineInfo>& engines)
+{
+    IndexWriter w;
+    w.write(s_magic);
+    w.write(s_version);
+    w.write(uint32(engines.size()));
+    for (const TRTEngineInfo& info : engines)
+    {
+        w.write(info.fileName.ToUTF8());
+        w.write(info.fileSize);
+        w.write(info.lastModified);
+        w.write(info.fileHash);
+        w.write(info.format);
+        w.write(info.runtimeVersion);
+        w.write(info.numProfiles);
+        w.write(info.scaleFactor);
+        w.write(uint8(info.described));
+        w.write(info.problem.ToUTF8());
+        w.write(uint32(info.tensors.size()));
+        for (const TRTTensorInfo& t : info.tensors)
+        {
+            w.write(t.name);
+            w.write(uint8(t.isInput));
+            w.write(t.dataType);
+            w.write(t.dims);
+            w.write(t.minDims);
+            w.write(t.optDims);
+            w.write(t.maxDims);
+        }
+        w.write(uint32(info.variants.size()));
+        for (const String& variant : info.variants)
+            w.write(variant.ToUTF8());
+    }
+
+    // The index is only a cache: engine directories may well be read-only
+    try
+    {
+        File::WriteFile(indexPath(directory), w.m_data);
+    }
+    catch (const Error&)
+    {
+    }
+}
+
+}	// namespace pcl
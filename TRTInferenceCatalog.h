@@ -0,0 +1,126 @@
+#ifndef __TRTInferenceCatalog_h
+#define __TRTInferenceCatalog_h
+
+#include <pcl/String.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace pcl
+{
+
+// Input or output tensor of an engine. Dynamic dimensions are -1; for inputs, the minimum, optimum
+// and maximum dimensions of the first optimization profile tell their range.
+struct TRTTensorInfo
+{
+    IsoString name;
+    bool isInput = false;
+    IsoString dataType;
+    std::vector<int32> dims;
+    std::vector<int32> minDims;
+    std::vector<int32> optDims;
+    std::vector<int32> maxDims;
+};
+
+// Properties of an engine file, as recorded in the catalog of its directory
+struct TRTEngineInfo
+{
+    String fileName;
+    uint64 fileSize = 0;
+    double lastModified = 0;
+    uint64 fileHash = 0;
+    // "TensorRT" or "ONNX"
+    IsoString format;
+    // TensorRT library version the engine was described with, which it was built for when it could be
+    // deserialized; zero for ONNX models and engines not described yet
+    int32 runtimeVersion = 0;
+    std::vector<TRTTensorInfo> tensors;
+    int32 numProfiles = 0;
+    int32 scaleFactor = 0;
+    // False when the engine could not be looked into, for lack of an inference backend. Such entries
+    // are described again at the next refresh.
+    bool described = false;
+    // Why the module cannot run the engine, empty when it can
+    String problem;
+    // Variants of an engine bundle, as listed in its manifest
+    std::vector<String> variants;
+
+    // One-line description for display
+    String summary() const;
+};
+
+// Index of the engines in a directory: TensorRT engines (.trt, .engine, .plan), engine bundles (.trtb)
+// and ONNX models. The properties of each engine are kept in a sidecar index file in the directory,
+// so engines can be listed and validated without deserializing them. A refresh only looks into files
+// that are new or changed since the index was written, or that were described by another TensorRT
+// version. Describing engines can take seconds each, so the GUI refreshes catalogs on a worker thread
+// with startRefresh() and lists the engines recorded in the index meanwhile.
+class TRTEngineCatalog
+{
+public:
+    explicit TRTEngineCatalog(const String& directory);
+    ~TRTEngineCatalog();
+
+    const String& directory() const
+    {
+        return m_directory;
+    }
+
+    const std::vector<TRTEngineInfo>& engines() const
+    {
+        return m_engines;
+    }
+
+    // Entry of an engine file by its path, or nullptr if it is not in the directory
+    const TRTEngineInfo* find(const String& enginePath) const;
+
+    // Rescans the directory, describes new and changed engines, and writes the index if it changed.
+    // Returns true if the list of engines changed.
+    bool refresh();
+
+    // Starts a refresh on a worker thread. Until finishRefresh() takes its result, engines() lists the
+    // engines as recorded in the index, which is read on the calling thread. Does nothing while a
+    // refresh is running.
+    void startRefresh();
+
+    // True while a refresh started by startRefresh() has not been taken by finishRefresh()
+    bool refreshing() const
+    {
+        return m_thread.joinable();
+    }
+
+    // Once the refresh started by startRefresh() is done, makes engines() list its result and returns
+    // true; returns false while it is running or when none was started. Throws the error of a failed
+    // refresh.
+    bool finishRefresh();
+
+    // Directory of an engine file, as the catalogs are identified
+    static String directoryOf(const String& enginePath);
+
+    static String indexPath(const String& directory);
+
+    // Reads the properties of an engine file
+    static TRTEngineInfo describe(const String& enginePath);
+
+private:
+    String m_directory;
+    std::vector<TRTEngineInfo> m_engines;
+    bool m_loaded = false;
+
+    // Refresh running on a worker thread, which only reads m_engines
+    std::thread m_thread;
+    std::atomic<bool> m_done { false };
+    std::atomic<bool> m_cancel { false };
+    std::vector<TRTEngineInfo> m_refreshed;
+    String m_refreshError;
+
+    void load();
+    void runRefresh();
+    bool scan(std::vector<TRTEngineInfo>& engines) const;
+    static void save(const String& directory, const std::vector<TRTEngineInfo>& engines);
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceCatalog_h
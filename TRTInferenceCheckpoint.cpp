@@ -0,0 +1,210 @@
+#include <pcl/File.h>
+
+#include "TRTInferenceCheckpoint.h"
+
+namespace pcl
+{
+
+static const char s_magic[8] = { 'T', 'R', 'T', 'C', 'K', 'P', 'T', ' ' };
+static const uint32 s_version = 2;
+static const size_type s_headerSize = 128;
+
+struct CheckpointHeader
+{
+    char magic[8];
+    uint32 version;
+    int32 finishedRows;
+    TRTCheckpointLayout layout;
+};
+
+// The manifest follows the header, padded so that rows stay aligned
+static size_type manifestSize(const TRTCheckpointLayout& layout)
+{
+    return (size_type(layout.tilesPerRow) * layout.numTileRows + 15) & ~size_type(15);
+}
+
+TRTCheckpoint::TRTCheckpoint(const String& path, const TRTCheckpointLayout& layout, FImage& accumulator, FImage* weight, double interval)
+    : m_path(path)
+    , m_layout(layout)
+    , m_accumulator(accumulator)
+    , m_weight(weight)
+    , m_interval(interval)
+    , m_doneTiles(size_type(layout.tilesPerRow) * layout.numTileRows, 0)
+{
+    size_type totalSize = s_headerSize + manifestSize(layout) +
+                          size_type(layout.numChannels) * layout.height * layout.width * sizeof(float);
+
+    if (File::Exists(path))
+    {
+        bool valid = false;
+        {
+            TRTMappedFile existing(path, false);
+            if (existing.size() == totalSize)
+            {
+                const CheckpointHeader* header = reinterpret_cast<const CheckpointHeader*>(existing.data());
+                valid = (::memcmp(header->magic, s_magic, sizeof(s_magic)) == 0) &&
+                        (header->version == s_version) &&
+                        (::memcmp(&header->layout, &layout, sizeof(layout)) == 0);
+            }
+        }
+        if (valid)
+            m_file = std::make_unique<TRTMappedFile>(path, true);
+        else
+            File::Remove(path);
+    }
+
+    if (!m_file)
+    {
+        // A new file is zero-filled, so it holds no finished rows and no tiles done
+        m_file = std::make_unique<TRTMappedFile>(path, true, totalSize);
+        CheckpointHeader* header = reinterpret_cast<CheckpointHeader*>(m_file->data());
+        ::memcpy(header->magic, s_magic, sizeof(s_magic));
+        header->version = s_version;
+        header->layout = layout;
+        m_file->flush();
+    }
+
+    m_thread = std::thread(&TRTCheckpoint::run, this);
+}
+
+TRTCheckpoint::~TRTCheckpoint()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_written.wait(lock, [this] { return !m_pending; });
+        m_stop = true;
+    }
+    m_requested.notify_one();
+    m_thread.join();
+}
+
+String TRTCheckpoint::checkpointPath(const String& directory, const TRTCheckpointLayout& layout)
+{
+    String dir = directory.IsEmpty() ? File::SystemTempDirectory() : directory;
+    return dir + '/' + String().Format("TRTInference_%016llx", Hash64(&layout, sizeof(layout))) + ".trtckpt";
+}
+
+int TRTCheckpoint::firstTileRowBelow(int numRows, int numTileRows, int tileStepY, int tileH, int factor)
+{
+    int row = 0;
+    while ((row < numTileRows) && ((row * tileStepY + tileH) * factor <= numRows))
+        row++;
+    return row;
+}
+
+uint8* TRTCheckpoint::manifest() const
+{
+    return m_file->data() + s_headerSize;
+}
+
+float* TRTCheckpoint::savedRow(int channel, int row) const
+{
+    float* data = reinterpret_cast<float*>(manifest() + manifestSize(m_layout));
+    return data + (size_type(channel) * m_layout.height + row) * m_layout.width;
+}
+
+int TRTCheckpoint::resume()
+{
+    const CheckpointHeader* header = reinterpret_cast<const CheckpointHeader*>(m_file->data());
+    if (header->finishedRows <= 0)
+        return 0;
+
+    m_savedRows = m_restoredRows = header->finishedRows;
+    ::memcpy(m_doneTiles.data(), manifest(), m_doneTiles.size());
+    restoreFinishedRows();
+    m_timer.Reset();
+    return m_restoredRows;
+}
+
+void TRTCheckpoint::restoreFinishedRows()
+{
+    size_type rowSize = size_type(m_layout.width) * sizeof(float);
+    for (int y = 0; y < m_restoredRows; y++)
+    {
+        for (int c = 0; c < m_layout.numChannels; c++)
+            ::memcpy(m_accumulator.ScanLine(y, c), savedRow(c, y), rowSize);
+        if (m_weight != nullptr)
+            std::fill_n(m_weight->ScanLine(y), m_layout.width, 1.0f);
+    }
+}
+
+void TRTCheckpoint::save(int finishedRows, const std::vector<uint8>& doneTiles)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending)
+            return;
+        m_doneTiles = doneTiles;
+        m_requestedRows = finishedRows;
+        m_pending = true;
+    }
+    m_requested.notify_one();
+    m_timer.Reset();
+}
+
+void TRTCheckpoint::discard()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_written.wait(lock, [this] { return !m_pending; });
+    }
+    m_file.reset();
+    File::Remove(m_path);
+}
+
+void TRTCheckpoint::run()
+{
+    for (;;)
+    {
+        int finishedRows;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_requested.wait(lock, [this] { return m_stop || m_pending; });
+            if (m_stop)
+                return;
+            finishedRows = m_requestedRows;
+        }
+
+        write(finishedRows);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = false;
+        }
+        m_written.notify_all();
+    }
+}
+
+void TRTCheckpoint::write(int finishedRows)
+{
+    // Finished rows are appended and tiles are only ever added to the manifest, so the previous
+    // checkpoint stays valid until the header is updated
+    for (int y = m_savedRows; y < finishedRows; y++)
+    {
+        const float* w = (m_weight != nullptr) ? m_weight->ScanLine(y) : nullptr;
+        for (int c = 0; c < m_layout.numChannels; c++)
+        {
+            const float* a = m_accumulator.ScanLine(y, c);
+            float* d = savedRow(c, y);
+            for (int x = 0; x < m_layout.width; x++)
+            {
+                // As normalized by finalizeOutput
+                float f = (w != nullptr) ? a[x] * ((w[x] > 0.0f) ? 1.0f / w[x] : 0.0f) : a[x];
+                d[x] = (f < 0.0f) ? 0.0f : ((f > 1.0f) ? 1.0f : f);
+            }
+        }
+    }
+    ::memcpy(manifest(), m_doneTiles.data(), m_doneTiles.size());
+    // The rows must be on disk before the header covers them, or a system crash could leave a header
+    // claiming rows which were never written. If they cannot be written, the previous checkpoint stands.
+    if (!m_file->flush(true))
+        return;
+
+    CheckpointHeader* header = reinterpret_cast<CheckpointHeader*>(m_file->data());
+    header->finishedRows = Max(header->finishedRows, finishedRows);
+    m_file->flush(true);
+
+    m_savedRows = Max(m_savedRows, finishedRows);
+}
+
+}	// namespace pcl
@@ -0,0 +1,113 @@
+#ifndef __TRTInferenceCheckpoint_h
+#define __TRTInferenceCheckpoint_h
+
+#include <pcl/ElapsedTime.h>
+#include <pcl/Image.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TRTInferenceMappedFile.h"
+
+namespace pcl
+{
+
+// Identifies the engine, input image, parameters and accumulator a checkpoint was recorded for
+struct TRTCheckpointLayout
+{
+    uint64 engineHash;
+    uint64 imageHash;
+    uint64 parameterHash;
+    int32 width;
+    int32 height;
+    int32 numChannels;
+    int32 weighted;
+    int32 tilesPerRow;
+    int32 numTileRows;
+};
+
+// Periodic snapshot of a long run in a memory-mapped scratch file, so a run interrupted by a crash or an
+// abort can resume. A checkpoint holds the finished output rows, normalized and clamped as they will be
+// finalized, and a manifest of the tiles done. Finished rows are written once, at the resolution of the
+// accumulator; the header is only updated once the rows and the manifest are in the file. Writing
+// happens on a worker thread.
+//
+// Rows that were still being accumulated are not kept, so tiles reaching below the finished rows run
+// again after resuming, whatever the tile order. Their contributions to the finished rows are then
+// replaced by the saved rows with restoreFinishedRows().
+class TRTCheckpoint
+{
+public:
+    TRTCheckpoint(const String& path, const TRTCheckpointLayout& layout, FImage& accumulator, FImage* weight, double interval);
+    ~TRTCheckpoint();
+
+    // Scratch file of the checkpoint for a layout. An empty directory stands for the system temporary
+    // directory.
+    static String checkpointPath(const String& directory, const TRTCheckpointLayout& layout);
+
+    // First row of tiles reaching below the first numRows accumulator rows, for tiles of tileH rows
+    // every tileStepY rows whose output is factor times larger
+    static int firstTileRowBelow(int numRows, int numTileRows, int tileStepY, int tileH, int factor);
+
+    // Restores the finished rows of the checkpoint to the accumulator, with unit weights, and returns
+    // their number. Returns zero when there is nothing to resume.
+    int resume();
+
+    // Writes the restored rows to the accumulator again, over whatever was accumulated to them since
+    // resume()
+    void restoreFinishedRows();
+
+    // Tiles done at the last checkpoint, resumed or saved, flagged by index in row-major order
+    const std::vector<uint8>& doneTiles() const
+    {
+        return m_doneTiles;
+    }
+
+    // True once the interval has elapsed since the last checkpoint
+    bool due() const
+    {
+        return m_timer() >= m_interval;
+    }
+
+    // Starts saving a checkpoint. Accumulator rows above finishedRows are final and must not be written
+    // anymore by the caller; doneTiles is copied before returning. Does nothing while the previous
+    // checkpoint is still being written.
+    void save(int finishedRows, const std::vector<uint8>& doneTiles);
+
+    // Removes the checkpoint after a successful run
+    void discard();
+
+private:
+    String m_path;
+    TRTCheckpointLayout m_layout;
+    FImage& m_accumulator;
+    FImage* m_weight;
+    double m_interval;
+    ElapsedTime m_timer;
+    std::unique_ptr<TRTMappedFile> m_file;
+
+    // Accumulator rows already in the file, and those restored by resume()
+    int m_savedRows = 0;
+    int m_restoredRows = 0;
+    std::vector<uint8> m_doneTiles;
+
+    int m_requestedRows = 0;
+    bool m_pending = false;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_requested;
+    std::condition_variable m_written;
+    std::thread m_thread;
+
+    uint8* manifest() const;
+    float* savedRow(int channel, int row) const;
+    void run();
+    void write(int finishedRows);
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceCheckpoint_h
@@ -0,0 +1,122 @@
+#include <pcl/Console.h>
+#include <pcl/File.h>
+
+#include "TRTInferenceClient.h"
+
+namespace pcl
+{
+
+TRTRemoteEngine::TRTRemoteEngine(const String& enginePath, const String& socketPath)
+    : TRTRemoteEngine(TRTSocket::connect(socketPath), enginePath, false)
+{
+}
+
+TRTRemoteEngine::TRTRemoteEngine(TRTSocket socket, const String& enginePath, bool inlineTiles)
+    : m_socket(std::move(socket))
+    , m_inline(inlineTiles)
+{
+    TRTReply reply = request(TRTRequestType::Open, 0, enginePath.IsEmpty() ? String() : File::FullPath(enginePath));
+    m_inputTileW = reply.inputTileW;
+    m_inputTileH = reply.inputTileH;
+    m_outputTileW = reply.outputTileW;
+    m_outputTileH = reply.outputTileH;
+    m_numChannels = reply.numChannels;
+    m_engineHash = reply.engineHash;
+
+    if (!m_inline)
+        m_tileBufferPath = File::UniqueFileName(File::SystemTempDirectory(), 12, "TRTInference_", ".tiles");
+    setNumberOfPlanes(m_numChannels);
+}
+
+std::unique_ptr<TRTRemoteEngine> TRTRemoteEngine::worker(const String& address)
+{
+    return std::unique_ptr<TRTRemoteEngine>(new TRTRemoteEngine(TRTSocket::connectTcp(address), String(), true));
+}
+
+TRTRemoteEngine::~TRTRemoteEngine()
+{
+    try
+    {
+        request(TRTRequestType::Close);
+    }
+    catch (...)
+    {
+    }
+    m_tileBuffer.reset();
+    if (!m_tileBufferPath.IsEmpty() && File::Exists(m_tileBufferPath))
+        File::Remove(m_tileBufferPath);
+}
+
+TRTReply TRTRemoteEngine::request(uint32 type, int32 numPlanes, const String& path)
+{
+    TRTRequest req = {};
+    req.magic = TRTProtocolMagic;
+    req.type = type;
+    req.numPlanes = numPlanes;
+    IsoString utf8 = path.ToUTF8();
+    if (utf8.Length() >= sizeof(req.path))
+        throw Error("Path too long: " + path);
+    ::memcpy(req.path, utf8.c_str(), utf8.Length());
+    m_socket.send(&req, sizeof(req));
+    if (type == TRTRequestType::InferTile)
+        m_socket.sendTile(getInputBuffer(), inputSize());
+
+    if (type == TRTRequestType::Close)
+        return TRTReply();
+
+    TRTReply reply;
+    m_socket.receive(&reply, sizeof(reply));
+    if (reply.magic != TRTProtocolMagic)
+        throw Error("Invalid reply from the inference server.");
+    if (reply.status != 0)
+    {
+        reply.message[sizeof(reply.message) - 1] = '\0';
+        throw Error("Inference server: " + String::UTF8ToUTF16(reply.message));
+    }
+    if (type == TRTRequestType::InferTile)
+        m_socket.receiveTile(tiles() + inputSize(), outputSize());
+    return reply;
+}
+
+void TRTRemoteEngine::setNumberOfPlanes(int32_t numPlanes)
+{
+    if (numPlanes == m_numPlanes)
+        return;
+
+    // The server maps the buffer sized here and validates the number of planes for the engine
+    size_type size = size_type(numPlanes) * (size_type(m_inputTileW) * m_inputTileH + size_type(m_outputTileW) * m_outputTileH);
+    if (m_inline)
+        m_tiles.resize(size);
+    else
+    {
+        m_tileBuffer.reset();
+        m_tileBuffer = std::make_unique<TRTMappedFile>(m_tileBufferPath, true, size * sizeof(float));
+    }
+    request(TRTRequestType::SetPlanes, numPlanes, m_tileBufferPath);
+    m_numPlanes = numPlanes;
+}
+
+void TRTRemoteEngine::runInference()
+{
+    request(m_inline ? TRTRequestType::InferTile : TRTRequestType::Infer);
+}
+
+std::unique_ptr<TRTEngine> openEngine(const String& enginePath, bool useServer, int32 imageW, int32 imageH, uint64 memoryBudget)
+{
+    if (useServer)
+    {
+        try
+        {
+            return std::make_unique<TRTRemoteEngine>(enginePath);
+        }
+        catch (const Error& x)
+        {
+            Console console;
+            console.WarningLn("<end><cbr>** Warning: Inference server unavailable: " + x.Message());
+            console.WriteLn("Loading the engine in this process.");
+        }
+    }
+    return openLocalEngine(enginePath, imageW, imageH, memoryBudget);
+}
+
+}	// namespace pcl
@@ -0,0 +1,76 @@
+#ifndef __TRTInferenceClient_h
+#define __TRTInferenceClient_h
+
+#include <memory>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+#include "TRTInferenceMappedFile.h"
+#include "TRTInferenceProtocol.h"
+
+namespace pcl
+{
+
+// Engine run by the inference server. The server keeps the engine loaded between executions and
+// shares it, and the GPU, with the other PixInsight instances of the workstation. The same server runs
+// on the worker nodes of a tile farm, where tiles travel through the connection instead of a shared file.
+class TRTRemoteEngine : public TRTEngine
+{
+public:
+    explicit TRTRemoteEngine(const String& enginePath, const String& socketPath = serverSocketPath());
+    ~TRTRemoteEngine() override;
+
+    // Engine run by the worker node at address, given as "host:port": the engine the worker was started
+    // with, since workers accept no paths
+    static std::unique_ptr<TRTRemoteEngine> worker(const String& address);
+
+    void setNumberOfPlanes(int32_t numPlanes) override;
+
+    float* getInputBuffer() override
+    {
+        return tiles();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return tiles() + inputSize();
+    }
+
+    void runInference() override;
+
+private:
+    TRTSocket m_socket;
+    // Tiles are exchanged through the mapped tile buffer file, or held here for a worker node
+    bool m_inline;
+    String m_tileBufferPath;
+    std::unique_ptr<TRTMappedFile> m_tileBuffer;
+    mutable std::vector<float> m_tiles;
+
+    TRTRemoteEngine(TRTSocket socket, const String& enginePath, bool inlineTiles);
+
+    TRTReply request(uint32 type, int32 numPlanes = 0, const String& path = String());
+
+    float* tiles() const
+    {
+        return m_inline ? m_tiles.data() : reinterpret_cast<float*>(m_tileBuffer->data());
+    }
+
+    size_type inputSize() const
+    {
+        return size_type(m_numPlanes) * m_inputTileW * m_inputTileH;
+    }
+
+    size_type outputSize() const
+    {
+        return size_type(m_numPlanes) * m_outputTileW * m_outputTileH;
+    }
+};
+
+// Opens an engine through the inference server if requested and available, and in this process
+// otherwise. The image dimensions and memory budget select the variant of an engine bundle, as in
+// openLocalEngine(); the server selects variants for its own device.
+std::unique_ptr<TRTEngine> openEngine(const String& enginePath, bool useServer, int32 imageW = 0, int32 imageH = 0, uint64 memoryBudget = 0);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceClient_h
@@ -0,0 +1,436 @@
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TRT_CPU_SSE2
+#endif
+
+#include "TRTInferenceCpuKernels.h"
+
+namespace pcl
+{
+
+TRTCpuThreadPool::TRTCpuThreadPool()
+{
+    start(0);
+}
+
+TRTCpuThreadPool::~TRTCpuThreadPool()
+{
+    stop();
+}
+
+void TRTCpuThreadPool::setNumberOfThreads(int numThreads)
+{
+    std::lock_guard<std::mutex> call(m_callMutex);
+    stop();
+    start(numThreads);
+}
+
+void TRTCpuThreadPool::start(int numThreads)
+{
+    // The calling thread is one of them
+    int numWorkers = ((numThreads > 0) ? numThreads : int(std::thread::hardware_concurrency())) - 1;
+    m_stop = false;
+    for (int i = 0; i < numWorkers; i++)
+        m_threads.emplace_back(&TRTCpuThreadPool::run, this);
+}
+
+void TRTCpuThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobQueued.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+}
+
+void TRTCpuThreadPool::parallelFor(int count, const std::function<void(int, int)>& body)
+{
+    if (count <= 0)
+        return;
+    if (m_threads.empty() || (count == 1))
+    {
+        body(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(m_callMutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // More chunks than threads evens out chunks of unequal cost
+    m_body = &body;
+    m_count = count;
+    m_numChunks = Min(count, 4 * int(m_threads.size() + 1));
+    m_nextChunk = 0;
+    m_doneChunks = 0;
+    m_jobQueued.notify_all();
+
+    while (runChunk(lock))
+    {
+    }
+    m_jobDone.wait(lock, [this] { return m_doneChunks == m_numChunks; });
+    m_body = nullptr;
+}
+
+void TRTCpuThreadPool::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_jobQueued.wait(lock, [this] { return m_stop || ((m_body != nullptr) && (m_nextChunk < m_numChunks)); });
+        if (m_stop)
+            return;
+        while (runChunk(lock))
+        {
+        }
+    }
+}
+
+bool TRTCpuThreadPool::runChunk(std::unique_lock<std::mutex>& lock)
+{
+    if ((m_body == nullptr) || (m_nextChunk == m_numChunks))
+        return false;
+    int chunk = m_nextChunk++;
+    int begin = int(int64(m_count) * chunk / m_numChunks);
+    int end = int(int64(m_count) * (chunk + 1) / m_numChunks);
+    const std::function<void(int, int)>& body = *m_body;
+
+    lock.unlock();
+    body(begin, end);
+    lock.lock();
+
+    if (++m_doneChunks == m_numChunks)
+        m_jobDone.notify_all();
+    return true;
+}
+
+static void activateRow(float* __restrict row, size_type n, const TRTCpuActivationParams& params, int channel)
+{
+    switch (params.type)
+    {
+    case TRTCpuActivation::Relu:
+        for (size_type i = 0; i < n; i++)
+            row[i] = (row[i] < 0.0f) ? 0.0f : row[i];
+        break;
+    case TRTCpuActivation::LeakyRelu:
+        {
+            float alpha = params.alpha;
+            for (size_type i = 0; i < n; i++)
+                row[i] = (row[i] < 0.0f) ? row[i] * alpha : row[i];
+        }
+        break;
+    case TRTCpuActivation::PRelu:
+        {
+            float slope = params.slopes[(params.numSlopes == 1) ? 0 : channel];
+            for (size_type i = 0; i < n; i++)
+                row[i] = (row[i] < 0.0f) ? row[i] * slope : row[i];
+        }
+        break;
+    case TRTCpuActivation::Sigmoid:
+        for (size_type i = 0; i < n; i++)
+            row[i] = 1.0f / (1.0f + std::exp(-row[i]));
+        break;
+    case TRTCpuActivation::Tanh:
+        for (size_type i = 0; i < n; i++)
+            row[i] = std::tanh(row[i]);
+        break;
+    case TRTCpuActivation::Clip:
+        {
+            float low = params.alpha;
+            float high = params.beta;
+            for (size_type i = 0; i < n; i++)
+                row[i] = (row[i] < low) ? low : ((row[i] > high) ? high : row[i]);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Accumulates one kernel tap of one input row into the rows of up to four output channels, reading
+// each input sample once for all of them. Rows of stride 1, the common case, go four samples at a time
+// with SSE2; the products are added as in the scalar loop, so both give the same result.
+static void accumulateTap(const float* __restrict input, int stride, int width, int numChannels, const float* tapWeights,
+                          float* const* outputs)
+{
+    if (numChannels == 4)
+    {
+        float w0 = tapWeights[0], w1 = tapWeights[1], w2 = tapWeights[2], w3 = tapWeights[3];
+        float* __restrict o0 = outputs[0];
+        float* __restrict o1 = outputs[1];
+        float* __restrict o2 = outputs[2];
+        float* __restrict o3 = outputs[3];
+        int x = 0;
+        if (stride == 1)
+        {
+#ifdef TRT_CPU_SSE2
+            __m128 v0 = _mm_set1_ps(w0), v1 = _mm_set1_ps(w1), v2 = _mm_set1_ps(w2), v3 = _mm_set1_ps(w3);
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128 v = _mm_loadu_ps(input + x);
+                _mm_storeu_ps(o0 + x, _mm_add_ps(_mm_loadu_ps(o0 + x), _mm_mul_ps(v0, v)));
+                _mm_storeu_ps(o1 + x, _mm_add_ps(_mm_loadu_ps(o1 + x), _mm_mul_ps(v1, v)));
+                _mm_storeu_ps(o2 + x, _mm_add_ps(_mm_loadu_ps(o2 + x), _mm_mul_ps(v2, v)));
+                _mm_storeu_ps(o3 + x, _mm_add_ps(_mm_loadu_ps(o3 + x), _mm_mul_ps(v3, v)));
+            }
+#endif
+            for (; x < width; x++)
+            {
+                float v = input[x];
+                o0[x] += w0 * v;
+                o1[x] += w1 * v;
+                o2[x] += w2 * v;
+                o3[x] += w3 * v;
+            }
+        }
+        else
+            for (; x < width; x++)
+            {
+                float v = input[x * stride];
+                o0[x] += w0 * v;
+                o1[x] += w1 * v;
+                o2[x] += w2 * v;
+                o3[x] += w3 * v;
+            }
+        return;
+    }
+
+    for (int k = 0; k < numChannels; k++)
+    {
+        float w = tapWeights[k];
+        float* __restrict o = outputs[k];
+        int x = 0;
+        if (stride == 1)
+        {
+#ifdef TRT_CPU_SSE2
+            __m128 vw = _mm_set1_ps(w);
+            for (; x + 4 <= width; x += 4)
+                _mm_storeu_ps(o + x, _mm_add_ps(_mm_loadu_ps(o + x), _mm_mul_ps(vw, _mm_loadu_ps(input + x))));
+#endif
+            for (; x < width; x++)
+                o[x] += w * input[x];
+        }
+        else
+            for (; x < width; x++)
+                o[x] += w * input[x * stride];
+    }
+}
+
+void convolve(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const float* weights, const float* bias, const TRTCpuConvParams& params,
+              TRTCpuTensor& output, std::vector<float>& scratch)
+{
+    int inputChannelsPerGroup = input.channels / params.groups;
+    int outputChannelsPerGroup = output.channels / params.groups;
+    int kernelSize = params.kernelH * params.kernelW;
+
+    TRTCpuTensor padded = input;
+    if ((params.padTop | params.padLeft | params.padBottom | params.padRight) != 0)
+    {
+        padded.height = input.height + params.padTop + params.padBottom;
+        padded.width = input.width + params.padLeft + params.padRight;
+        scratch.resize(padded.size());
+        padded.data = scratch.data();
+        pool.parallelFor(input.channels, [&](int begin, int end)
+        {
+            for (int c = begin; c < end; c++)
+            {
+                float* d = padded.plane(c);
+                ::memset(d, 0, padded.planeSize() * sizeof(float));
+                for (int y = 0; y < input.height; y++)
+                    ::memcpy(d + size_type(y + params.padTop) * padded.width + params.padLeft,
+                             input.plane(c) + size_type(y) * input.width, input.width * sizeof(float));
+            }
+        });
+    }
+
+    // Work items are blocks of up to four output channels of a group, times bands of output rows
+    const int channelBlock = 4;
+    const int bandRows = 8;
+    int blocksPerGroup = (outputChannelsPerGroup + channelBlock - 1) / channelBlock;
+    int numBands = (output.height + bandRows - 1) / bandRows;
+    pool.parallelFor(params.groups * blocksPerGroup * numBands, [&](int begin, int end)
+    {
+        std::vector<float> tapWeights(size_type(inputChannelsPerGroup) * kernelSize * channelBlock);
+        for (int item = begin; item < end; item++)
+        {
+            int block = item / numBands;
+            int band = item % numBands;
+            int group = block / blocksPerGroup;
+            int firstChannel = group * outputChannelsPerGroup + (block % blocksPerGroup) * channelBlock;
+            int numChannels = Min(channelBlock, (group + 1) * outputChannelsPerGroup - firstChannel);
+
+            // Weights of the block interleaved by tap, so each tap reads consecutive values
+            for (int ic = 0; ic < inputChannelsPerGroup; ic++)
+                for (int t = 0; t < kernelSize; t++)
+                    for (int k = 0; k < numChannels; k++)
+                        tapWeights[(size_type(ic) * kernelSize + t) * channelBlock + k] =
+                            weights[(size_type(firstChannel + k) * inputChannelsPerGroup + ic) * kernelSize + t];
+
+            for (int y = band * bandRows, y1 = Min(y + bandRows, output.height); y < y1; y++)
+            {
+                float* rows[channelBlock];
+                for (int k = 0; k < numChannels; k++)
+                {
+                    rows[k] = output.plane(firstChannel + k) + size_type(y) * output.width;
+                    float b = (bias != nullptr) ? bias[firstChannel + k] : 0.0f;
+                    for (int x = 0; x < output.width; x++)
+                        rows[k][x] = b;
+                }
+
+                for (int ic = 0; ic < inputChannelsPerGroup; ic++)
+                {
+                    const float* plane = padded.plane(group * inputChannelsPerGroup + ic);
+                    for (int ky = 0; ky < params.kernelH; ky++)
+                    {
+                        const float* row = plane + size_type(y * params.strideH + ky * params.dilationH) * padded.width;
+                        for (int kx = 0; kx < params.kernelW; kx++)
+                            accumulateTap(row + kx * params.dilationW, params.strideW, output.width, numChannels,
+                                          &tapWeights[(size_type(ic) * kernelSize + ky * params.kernelW + kx) * channelBlock], rows);
+                    }
+                }
+
+                for (int k = 0; k < numChannels; k++)
+                    activateRow(rows[k], output.width, params.activation, firstChannel + k);
+            }
+        }
+    });
+}
+
+void activate(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const TRTCpuActivationParams& params, TRTCpuTensor& output)
+{
+    pool.parallelFor(input.channels, [&](int begin, int end)
+    {
+        for (int c = begin; c < end; c++)
+        {
+            if (output.data != input.data)
+                ::memcpy(output.plane(c), input.plane(c), input.planeSize() * sizeof(float));
+            activateRow(output.plane(c), output.planeSize(), params, c);
+        }
+    });
+}
+
+template <class F>
+static void binaryApply(TRTCpuThreadPool& pool, const TRTCpuTensor& a, const float* b, size_type bSize, TRTCpuTensor& output, F f)
+{
+    size_type n = a.planeSize();
+    pool.parallelFor(a.channels, [&](int begin, int end)
+    {
+        for (int c = begin; c < end; c++)
+        {
+            const float* __restrict s = a.plane(c);
+            float* __restrict d = output.plane(c);
+            if (bSize == a.size())
+            {
+                const float* __restrict t = b + c * n;
+                for (size_type i = 0; i < n; i++)
+                    d[i] = f(s[i], t[i]);
+            }
+            else
+            {
+                float t = b[(bSize == 1) ? 0 : c];
+                for (size_type i = 0; i < n; i++)
+                    d[i] = f(s[i], t);
+            }
+        }
+    });
+}
+
+void binaryOp(TRTCpuThreadPool& pool, int op, const TRTCpuTensor& a, const float* b, size_type bSize, bool bFirst, TRTCpuTensor& output)
+{
+    switch (op)
+    {
+    case TRTCpuBinaryOp::Add:
+        binaryApply(pool, a, b, bSize, output, [](float x, float y) { return x + y; });
+        break;
+    case TRTCpuBinaryOp::Sub:
+        if (bFirst)
+            binaryApply(pool, a, b, bSize, output, [](float x, float y) { return y - x; });
+        else
+            binaryApply(pool, a, b, bSize, output, [](float x, float y) { return x - y; });
+        break;
+    case TRTCpuBinaryOp::Mul:
+        binaryApply(pool, a, b, bSize, output, [](float x, float y) { return x * y; });
+        break;
+    case TRTCpuBinaryOp::Div:
+        if (bFirst)
+            binaryApply(pool, a, b, bSize, output, [](float x, float y) { return y / x; });
+        else
+            binaryApply(pool, a, b, bSize, output, [](float x, float y) { return x / y; });
+        break;
+    }
+}
+
+void concatenate(TRTCpuThreadPool& pool, const std::vector<const TRTCpuTensor*>& inputs, TRTCpuTensor& output)
+{
+    std::vector<std::pair<const TRTCpuTensor*, int>> sources;
+    for (const TRTCpuTensor* input : inputs)
+        for (int c = 0; c < input->channels; c++)
+            sources.push_back({ input, c });
+    pool.parallelFor(output.channels, [&](int begin, int end)
+    {
+        for (int c = begin; c < end; c++)
+            ::memcpy(output.plane(c), sources[c].first->plane(sources[c].second), output.planeSize() * sizeof(float));
+    });
+}
+
+void depthToSpace(TRTCpuThreadPool& pool, const TRTCpuTensor& input, int blockSize, bool crd, TRTCpuTensor& output)
+{
+    int r = blockSize;
+    pool.parallelFor(output.channels, [&](int begin, int end)
+    {
+        for (int c = begin; c < end; c++)
+            for (int i = 0; i < r; i++)
+                for (int j = 0; j < r; j++)
+                {
+                    int source = crd ? (c * r + i) * r + j : (i * r + j) * output.channels + c;
+                    const float* s = input.plane(source);
+                    float* d = output.plane(c);
+                    for (int y = 0; y < input.height; y++)
+                    {
+                        const float* __restrict sr = s + size_type(y) * input.width;
+                        float* __restrict dr = d + size_type(y * r + i) * output.width + j;
+                        for (int x = 0; x < input.width; x++)
+                            dr[x * r] = sr[x];
+                    }
+                }
+    });
+}
+
+void resize(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const TRTCpuResizeTable& rows, const TRTCpuResizeTable& columns,
+            bool nearest, TRTCpuTensor& output)
+{
+    pool.parallelFor(output.channels, [&](int begin, int end)
+    {
+        std::vector<float> row0(output.width), row1(output.width);
+        for (int c = begin; c < end; c++)
+            for (int y = 0; y < output.height; y++)
+            {
+                const float* s0 = input.plane(c) + size_type(rows.index0[y]) * input.width;
+                float* __restrict d = output.plane(c) + size_type(y) * output.width;
+                if (nearest)
+                {
+                    for (int x = 0; x < output.width; x++)
+                        d[x] = s0[columns.index0[x]];
+                    continue;
+                }
+
+                // Columns first, then rows
+                const float* s1 = input.plane(c) + size_type(rows.index1[y]) * input.width;
+                for (int x = 0; x < output.width; x++)
+                {
+                    float f = columns.fraction[x];
+                    row0[x] = s0[columns.index0[x]] + f * (s0[columns.index1[x]] - s0[columns.index0[x]]);
+                    row1[x] = s1[columns.index0[x]] + f * (s1[columns.index1[x]] - s1[columns.index0[x]]);
+                }
+                float f = rows.fraction[y];
+                for (int x = 0; x < output.width; x++)
+                    d[x] = row0[x] + f * (row1[x] - row0[x]);
+            }
+    });
+}
+
+}	// namespace pcl
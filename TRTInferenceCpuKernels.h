@@ -0,0 +1,149 @@
+#ifndef __TRTInferenceCpuKernels_h
+#define __TRTInferenceCpuKernels_h
+
+#include <pcl/Defs.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pcl
+{
+
+// Kernels of the CPU backend. Tensors hold one image, planar: channels of height rows of width
+// floats. The inner loop of the convolution, where the time goes, is written with SSE2 intrinsics on
+// x86, with a scalar fallback elsewhere; the other kernels are bound by memory bandwidth and run over
+// contiguous rows of restrict-qualified pointers, left to the compiler. The work of each kernel is
+// spread over a pool of threads.
+
+struct TRTCpuTensor
+{
+    int channels = 0;
+    int height = 0;
+    int width = 0;
+    float* data = nullptr;
+
+    size_type planeSize() const
+    {
+        return size_type(height) * width;
+    }
+
+    size_type size() const
+    {
+        return size_type(channels) * planeSize();
+    }
+
+    float* plane(int c) const
+    {
+        return data + c * planeSize();
+    }
+};
+
+// Worker threads of a CPU engine. The calling thread takes part in the work.
+class TRTCpuThreadPool
+{
+public:
+    TRTCpuThreadPool();
+    ~TRTCpuThreadPool();
+
+    // Calls body(begin, end) on disjoint ranges covering [0, count), and waits for all of them
+    void parallelFor(int count, const std::function<void(int, int)>& body);
+
+    // Number of threads taking part in the work, the calling thread included; zero for all processors
+    void setNumberOfThreads(int numThreads);
+
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_callMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_jobQueued;
+    std::condition_variable m_jobDone;
+    const std::function<void(int, int)>* m_body = nullptr;
+    int m_count = 0;
+    int m_numChunks = 0;
+    int m_nextChunk = 0;
+    int m_doneChunks = 0;
+    bool m_stop = false;
+
+    void start(int numThreads);
+    void stop();
+    void run();
+    bool runChunk(std::unique_lock<std::mutex>& lock);
+};
+
+namespace TRTCpuActivation
+{
+    enum value_type { None, Relu, LeakyRelu, PRelu, Sigmoid, Tanh, Clip };
+}
+
+// Element-wise function applied in place, optionally fused into a convolution
+struct TRTCpuActivationParams
+{
+    int type = TRTCpuActivation::None;
+    // LeakyRelu slope, or Clip minimum
+    float alpha = 0;
+    // Clip maximum
+    float beta = 0;
+    // PRelu slopes, one per channel, or a single one
+    const float* slopes = nullptr;
+    int numSlopes = 0;
+};
+
+struct TRTCpuConvParams
+{
+    int kernelH = 1;
+    int kernelW = 1;
+    int strideH = 1;
+    int strideW = 1;
+    int dilationH = 1;
+    int dilationW = 1;
+    int padTop = 0;
+    int padLeft = 0;
+    int padBottom = 0;
+    int padRight = 0;
+    int groups = 1;
+    TRTCpuActivationParams activation;
+};
+
+// Direct grouped convolution: weights are [outputChannels][inputChannels / groups][kernelH][kernelW],
+// bias is optional. Depthwise convolutions are the case of one input channel per group. The input is
+// zero-padded once into scratch when the convolution has padding.
+void convolve(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const float* weights, const float* bias, const TRTCpuConvParams& params,
+              TRTCpuTensor& output, std::vector<float>& scratch);
+
+void activate(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const TRTCpuActivationParams& params, TRTCpuTensor& output);
+
+namespace TRTCpuBinaryOp
+{
+    enum value_type { Add, Sub, Mul, Div };
+}
+
+// Element-wise binary operation. b is a tensor of the shape of a, one value per channel, or a single
+// value, as given by bSize; bFirst swaps the operands of the non-commutative operations.
+void binaryOp(TRTCpuThreadPool& pool, int op, const TRTCpuTensor& a, const float* b, size_type bSize, bool bFirst, TRTCpuTensor& output);
+
+// Concatenation along channels
+void concatenate(TRTCpuThreadPool& pool, const std::vector<const TRTCpuTensor*>& inputs, TRTCpuTensor& output);
+
+// Pixel shuffle: moves blocks of blockSize^2 channels to blockSize x blockSize pixel blocks. In DCR
+// mode the block offset varies slowest across channels, in CRD mode fastest.
+void depthToSpace(TRTCpuThreadPool& pool, const TRTCpuTensor& input, int blockSize, bool crd, TRTCpuTensor& output);
+
+// Source coordinates of the rows or columns of a resampled tensor: output index i reads source
+// indices index0[i] and index1[i] with weights 1 - fraction[i] and fraction[i]
+struct TRTCpuResizeTable
+{
+    std::vector<int> index0;
+    std::vector<int> index1;
+    std::vector<float> fraction;
+};
+
+// Resampling by coordinate tables; nearest-neighbor resampling skips the interpolation
+void resize(TRTCpuThreadPool& pool, const TRTCpuTensor& input, const TRTCpuResizeTable& rows, const TRTCpuResizeTable& columns,
+            bool nearest, TRTCpuTensor& output);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceCpuKernels_h
@@ -0,0 +1,206 @@
+#include <pcl/Console.h>
+#include <pcl/File.h>
+
+#include "TRTInferenceBundle.h"
+#include "TRTInferenceEngine.h"
+#include "TRTInferenceOnnx.h"
+#include "TRTInferenceProfile.h"
+
+namespace pcl
+{
+
+void TRTLogger::log(Severity severity, const char* msg) noexcept
+{
+    if (severity > Severity::kWARNING)
+        return;
+    Console console;
+    if (severity == Severity::kWARNING)
+        console.WarningLn(String("[TensorRT] WARNING: ") + msg);
+    else
+        console.CriticalLn(String("[TensorRT] ERROR: ") + msg);
+}
+
+void TRTLayerProfiler::reportLayerTime(const char* layerName, float ms) noexcept
+{
+    if (m_profile != nullptr)
+        m_profile->addLayerTime(layerName, ms);
+}
+
+TRTLocalEngine::TRTLocalEngine(String enginePath, const char* inputBlobName, const char* outputBlobName)
+    : m_runtime(trtRuntime())
+{
+    File file(enginePath, FileMode::Read);
+    if (!file.IsOpen())
+        throw Error("Unable to open TensorRT engine file " + enginePath);
+    auto size = file.Size();
+    ByteArray buffer(size);
+    file.Read(buffer.Begin(), size);
+    file.Close();
+
+    load(buffer.Begin(), size, "engine file " + enginePath, inputBlobName, outputBlobName);
+}
+
+TRTLocalEngine::TRTLocalEngine(const void* data, size_type size, const String& source, const char* inputBlobName, const char* outputBlobName)
+    : m_runtime(trtRuntime())
+{
+    load(data, size, source, inputBlobName, outputBlobName);
+}
+
+void TRTLocalEngine::load(const void* data, size_type size, const String& source, const char* inputBlobName, const char* outputBlobName)
+{
+    strcpy(m_inputBlobName, inputBlobName);
+    strcpy(m_outputBlobName, outputBlobName);
+    m_engineHash = Hash64(data, size);
+
+    auto runtime = std::unique_ptr<nvinfer1::IRuntime>(static_cast<nvinfer1::IRuntime*>(m_runtime.createInferRuntime(&m_logger, NV_TENSORRT_VERSION)));
+    if (!runtime)
+        throw Error("Failed to create TensorRT runtime.");
+
+    m_runtime.setDevice(0);
+
+    m_engine = std::unique_ptr<nvinfer1::ICudaEngine>(runtime->deserializeCudaEngine(data, size));
+    if (!m_engine)
+        throw Error("Failed to deserialize TensorRT engine from " + source);
+
+    auto dims = m_engine->getTensorShape(m_inputBlobName);
+    if ((dims.nbDims == -1) || (m_engine->getTensorIOMode(m_inputBlobName) != nvinfer1::TensorIOMode::kINPUT))
+        throw Error("Input blob " + String(m_inputBlobName) + " not found.");
+    if (dims.nbDims != 4)
+        throw Error("Input blob " + String(m_inputBlobName) + " is not 4-dimension.");
+    if ((dims.d[1] != 1) && (dims.d[1] != 3))
+        throw Error("Input blob " + String(m_inputBlobName) + " does not have 1 or 3 channels.");
+    m_numChannels = dims.d[1];
+    m_inputTileH = dims.d[2];
+    m_inputTileW = dims.d[3];
+
+    // A dynamic batch dimension lets single-channel engines process all planes of a tile at once
+    m_maxBatchSize = 1;
+    if (dims.d[0] == -1)
+        m_maxBatchSize = m_engine->getProfileShape(m_inputBlobName, 0, nvinfer1::OptProfileSelector::kMAX).d[0];
+
+    dims = m_engine->getTensorShape(m_outputBlobName);
+    if ((dims.nbDims == -1) || (m_engine->getTensorIOMode(m_outputBlobName) != nvinfer1::TensorIOMode::kOUTPUT))
+        throw Error("Output blob " + String(m_outputBlobName)+" not found.");
+    if (dims.nbDims != 4)
+        throw Error("Output blob " + String(m_outputBlobName)+" is not 4-dimension.");
+    if (dims.d[1] != m_numChannels)
+        throw Error("Output blob " + String(m_outputBlobName)+" does not have the same number of channels as input blob " + m_inputBlobName);
+    m_outputTileH = dims.d[2];
+    m_outputTileW = dims.d[3];
+
+    if (((m_outputTileW % m_inputTileW) != 0) || ((m_outputTileH % m_inputTileH) != 0))
+        throw Error("Shape of output blob " + String(m_outputBlobName)+" is not multiple of input blob " + m_inputBlobName);
+
+    auto datatype = m_engine->getTensorDataType(m_inputBlobName);
+    if (datatype != nvinfer1::DataType::kFLOAT)
+        throw Error("Input blob " + String(m_inputBlobName)+" is not 32-bit float.");
+    datatype = m_engine->getTensorDataType(m_outputBlobName);
+    if (datatype != nvinfer1::DataType::kFLOAT)
+        throw Error("Output blob " + String(m_outputBlobName)+" is not 32-bit float.");
+
+    m_context = std::unique_ptr<nvinfer1::IExecutionContext>(m_engine->createExecutionContext());
+    if (!m_context)
+        throw Error("Failed to create TensorRT execution context.");
+
+    if (m_runtime.streamCreate(&m_cudaStream) != cudaSuccess)
+        throw Error("Failed to create CUDA stream.");
+
+    setNumberOfPlanes(m_numChannels);
+}
+
+TRTLocalEngine::~TRTLocalEngine()
+{
+    m_runtime.streamDestroy(m_cudaStream);
+    m_context.reset();
+    m_engine.reset();
+}
+
+void TRTLocalEngine::setNumberOfPlanes(int32_t numPlanes)
+{
+    if (numPlanes == m_numChannels)
+        m_batchSize = 1;
+    else if (m_numChannels == 1)
+        m_batchSize = batchSizeFor(numPlanes, (m_batchLimit > 0) ? Min(m_batchLimit, m_maxBatchSize) : m_maxBatchSize);
+    else
+        throw Error(String().Format("A %d-channel engine cannot process %d-plane tiles.", m_numChannels, numPlanes));
+    m_numPlanes = numPlanes;
+
+    auto dims = m_engine->getTensorShape(m_inputBlobName);
+    dims.d[0] = m_batchSize;
+    if (!m_context->setInputShape(m_inputBlobName, dims))
+        throw Error("Failed to set input shape.");
+    size_t inputSize = size_t(m_numPlanes) * m_inputTileW * m_inputTileH;
+    m_inputBuffer.resize(inputSize);
+    m_inputDeviceBuffer.resize(inputSize * sizeof(float));
+    size_t outputSize = size_t(m_numPlanes) * m_outputTileW * m_outputTileH;
+    m_outputBuffer.resize(outputSize);
+    m_outputDeviceBuffer.resize(outputSize * sizeof(float));
+}
+
+void TRTLocalEngine::runInference()
+{
+    // Copy from CPU to GPU
+    auto ret = m_runtime.memcpyAsync(m_inputDeviceBuffer.data(), m_inputBuffer.data(), m_inputDeviceBuffer.size(), cudaMemcpyHostToDevice, m_cudaStream);
+    if (ret != cudaSuccess)
+        throw Error("Failed to send image tile to GPU.");
+
+    // Run inference, in several batches if the engine cannot take all planes at once
+    int32_t planesPerRun = (m_numPlanes == m_numChannels) ? m_numPlanes : m_batchSize;
+    for (int32_t plane = 0; plane < m_numPlanes; plane += planesPerRun)
+    {
+        float* input = static_cast<float*>(m_inputDeviceBuffer.data()) + size_t(plane) * m_inputTileW * m_inputTileH;
+        float* output = static_cast<float*>(m_outputDeviceBuffer.data()) + size_t(plane) * m_outputTileW * m_outputTileH;
+        if (!m_context->setTensorAddress(m_inputBlobName, input))
+            throw Error("Failed to set input tensors.");
+        if (!m_context->setTensorAddress(m_outputBlobName, output))
+            throw Error("Failed to set output tensors.");
+        if (!m_context->enqueueV3(m_cudaStream))
+            throw Error("Failed to run inference on image tile.");
+    }
+
+    // Copy from GPU to CPU
+    ret = m_runtime.memcpyAsync(m_outputBuffer.data(), m_outputDeviceBuffer.data(), m_outputDeviceBuffer.size(), cudaMemcpyDeviceToHost, m_cudaStream);
+    if (ret != cudaSuccess)
+        throw Error("Failed to receive image tile from GPU.");
+
+    // Wait for CUDA stream
+    ret = m_runtime.streamSynchronize(m_cudaStream);
+    if (ret != cudaSuccess)
+        throw Error("Failed to synchronize CUDA stream.");
+}
+
+bool TRTLocalEngine::setLayerProfile(TRTLayerProfile* profile)
+{
+    // With a profiler, each inference waits for the layers to complete to time them
+    m_profiler.m_profile = profile;
+    m_context->setProfiler((profile != nullptr) ? &m_profiler : nullptr);
+    return true;
+}
+
+std::unique_ptr<TRTEngine> openLocalEngine(const String& enginePath, int32 imageW, int32 imageH, uint64 memoryBudget)
+{
+    if (File::ExtractExtension(enginePath).CaseFolded() == ".onnx")
+        return std::make_unique<TRTOnnxEngine>(enginePath);
+    if (TRTEngineBundle::isBundle(enginePath))
+    {
+        TRTEngineBundle bundle(enginePath);
+        String whyNot;
+        int index = selectBundleVariant(bundle.variants(), TRTEngineBundle::deviceTarget(imageW, imageH, memoryBudget), whyNot);
+        if (index < 0)
+            throw Error(whyNot + ' ' + enginePath);
+        const TRTBundleVariant& variant = bundle.variants()[index];
+        Console().WriteLn("<end><cbr>Engine bundle variant: " + bundleVariantDescription(variant));
+        return std::make_unique<TRTLocalEngine>(bundle.variantData(index), variant.size, "engine bundle " + enginePath);
+    }
+    return std::make_unique<TRTLocalEngine>(enginePath);
+}
+
+int32_t batchSizeFor(int32_t numPlanes, int32_t maxBatch)
+{
+    for (int32_t b = Min(numPlanes, maxBatch); b > 1; b--)
+        if (numPlanes % b == 0)
+            return b;
+    return 1;
+}
+
+}	// namespace pcl
@@ -0,0 +1,201 @@
+#ifndef __TRTInferenceEngine_h
+#define __TRTInferenceEngine_h
+
+#include <pcl/String.h>
+#include <NvInfer.h>
+
+#include <memory>
+#include <vector>
+
+#include "TRTInferenceRuntime.h"
+
+namespace pcl
+{
+
+class TRTLogger : public nvinfer1::ILogger
+{
+public:
+    void log(Severity severity, const char* msg) noexcept override;
+};
+
+class TRTLayerProfile;
+
+// Forwards the layer times reported by TensorRT to a layer profile
+class TRTLayerProfiler : public nvinfer1::IProfiler
+{
+public:
+    TRTLayerProfile* m_profile = nullptr;
+
+    void reportLayerTime(const char* layerName, float ms) noexcept override;
+};
+
+// An engine running inference on planar tiles of fixed dimensions, in this process or elsewhere
+class TRTEngine
+{
+protected:
+    int32_t m_inputTileW = 0;
+    int32_t m_inputTileH = 0;
+    int32_t m_outputTileW = 0;
+    int32_t m_outputTileH = 0;
+    int32_t m_numChannels = 0;
+    int32_t m_numPlanes = 0;
+    uint64 m_engineHash = 0;
+
+public:
+    virtual ~TRTEngine() = default;
+
+    int32_t getInputTileW() const
+    {
+        return m_inputTileW;
+    }
+
+    int32_t getInputTileH() const
+    {
+        return m_inputTileH;
+    }
+
+    int32_t getOutputTileW() const
+    {
+        return m_outputTileW;
+    }
+
+    int32_t getOutputTileH() const
+    {
+        return m_outputTileH;
+    }
+
+    // Hash of the serialized engine, identifying it independently of its file path
+    uint64 getEngineHash() const
+    {
+        return m_engineHash;
+    }
+
+    int32_t getNumberOfChannels() const
+    {
+        return m_numChannels;
+    }
+
+    // Number of image planes in a tile: the engine channels, or any number of planes for a
+    // single-channel engine, which processes them as a batch
+    virtual void setNumberOfPlanes(int32_t numPlanes) = 0;
+
+    int32_t getNumberOfPlanes() const
+    {
+        return m_numPlanes;
+    }
+
+    // Planar host buffer receiving the input tile
+    virtual float* getInputBuffer() = 0;
+
+    // Planar host buffer holding the output tile after runInference()
+    virtual const float* getOutputBuffer() const = 0;
+
+    virtual void runInference() = 0;
+
+    // Largest number of planes a single-channel engine infers at once
+    virtual int32_t getMaxBatchSize() const
+    {
+        return 1;
+    }
+
+    // Limits the planes inferred at once by a single-channel engine; zero for no limit. Takes effect at
+    // the next setNumberOfPlanes().
+    virtual void setBatchLimit(int32_t)
+    {
+    }
+
+    // Threads of an engine running on the CPU; zero for all processors
+    virtual void setNumberOfThreads(int)
+    {
+    }
+
+    // Context a tile needs on each side of a region to process it as in a full execution, in input
+    // pixels
+    virtual int32_t getContextMarginX() const
+    {
+        return m_inputTileW / 2;
+    }
+
+    virtual int32_t getContextMarginY() const
+    {
+        return m_inputTileH / 2;
+    }
+
+    // Records the time of each layer of the following inferences in profile, or stops recording when
+    // null. Returns false if the engine cannot report layer times.
+    virtual bool setLayerProfile(TRTLayerProfile*)
+    {
+        return false;
+    }
+};
+
+// TensorRT engine loaded in this process, running on the first CUDA device. The TensorRT and CUDA
+// runtime libraries are loaded by the first engine.
+class TRTLocalEngine : public TRTEngine
+{
+private:
+    const TRTRuntime& m_runtime;
+    char m_inputBlobName[256];
+    char m_outputBlobName[256];
+    TRTLogger m_logger;
+    TRTLayerProfiler m_profiler;
+    std::unique_ptr<nvinfer1::ICudaEngine> m_engine;
+    std::unique_ptr<nvinfer1::IExecutionContext> m_context;
+    cudaStream_t m_cudaStream;
+    int32_t m_maxBatchSize;
+    int32_t m_batchLimit = 0;
+    int32_t m_batchSize;
+    std::vector<float> m_inputBuffer;
+    std::vector<float> m_outputBuffer;
+    TRTDeviceBuffer m_inputDeviceBuffer;
+    TRTDeviceBuffer m_outputDeviceBuffer;
+
+    void load(const void* data, size_type size, const String& source, const char* inputBlobName, const char* outputBlobName);
+
+public:
+    explicit TRTLocalEngine(String enginePath, const char* inputBlobName = "input", const char* outputBlobName = "output");
+    // Engine serialized in memory, such as a variant of an engine bundle; source names it in messages
+    TRTLocalEngine(const void* data, size_type size, const String& source, const char* inputBlobName = "input",
+                   const char* outputBlobName = "output");
+    ~TRTLocalEngine() override;
+
+    void setNumberOfPlanes(int32_t numPlanes) override;
+
+    float* getInputBuffer() override
+    {
+        return m_inputBuffer.data();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return m_outputBuffer.data();
+    }
+
+    void runInference() override;
+
+    int32_t getMaxBatchSize() const override
+    {
+        return m_maxBatchSize;
+    }
+
+    void setBatchLimit(int32_t batchLimit) override
+    {
+        m_batchLimit = batchLimit;
+    }
+
+    bool setLayerProfile(TRTLayerProfile* profile) override;
+};
+
+// Loads an engine in this process: ONNX models, by their .onnx extension, on the CPU, and serialized
+// TensorRT engines otherwise. From an engine bundle (.trtb), the variant best suited to the device,
+// the image dimensions and the memory budget in bytes is loaded; zero stands for unknown dimensions
+// and for the free device memory.
+std::unique_ptr<TRTEngine> openLocalEngine(const String& enginePath, int32 imageW = 0, int32 imageH = 0, uint64 memoryBudget = 0);
+
+// Batch size of a single-channel engine for tiles of numPlanes planes: the largest divisor of
+// numPlanes not above maxBatch, so that every enqueue processes a whole batch
+int32_t batchSizeFor(int32_t numPlanes, int32_t maxBatch);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceEngine_h
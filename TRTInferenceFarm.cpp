@@ -0,0 +1,213 @@
+#include <pcl/Console.h>
+
+#include "TRTInferenceFarm.h"
+#include "TRTInferenceTileProducer.h"
+
+namespace pcl
+{
+
+TRTTileFarm::TRTTileFarm(const String& workers)
+{
+    StringList addresses;
+    workers.Break(addresses, ',', true);
+    for (const String& address : addresses)
+    {
+        if (address.IsEmpty())
+            continue;
+        try
+        {
+            std::unique_ptr<Worker> worker = std::make_unique<Worker>();
+            worker->address = address;
+            worker->engine = TRTRemoteEngine::worker(address);
+            m_workers.push_back(std::move(worker));
+        }
+        catch (const Error& x)
+        {
+            Console().WarningLn("<end><cbr>** Warning: Tile farm worker " + address + " left out: " + x.Message());
+        }
+    }
+    if (m_workers.empty())
+        throw Error("No tile farm worker is reachable.");
+
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+    {
+        TRTEngine& engine = *worker->engine;
+        TRTEngine& first = *m_workers[0]->engine;
+        if ((engine.getInputTileW() != first.getInputTileW()) || (engine.getInputTileH() != first.getInputTileH()) ||
+            (engine.getOutputTileW() != first.getOutputTileW()) || (engine.getOutputTileH() != first.getOutputTileH()) ||
+            (engine.getNumberOfChannels() != first.getNumberOfChannels()))
+            throw Error("Tile farm worker " + worker->address + " serves an engine with a different tile geometry than " + m_workers[0]->address);
+        // Each worker serves the engine it was started with, and all must compute the same tiles
+        if (engine.getEngineHash() != first.getEngineHash())
+            throw Error("Tile farm worker " + worker->address + " serves a different engine than " + m_workers[0]->address);
+    }
+}
+
+TRTTileFarm::~TRTTileFarm()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workAvailable.notify_all();
+    // A worker busy with a tile finishes it first
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+}
+
+void TRTTileFarm::start(const FImage& input, const Array<Point>& positions, int numPlanes, bool skipUniformTiles, float uniformTileTolerance,
+                        pcl_enum uniformTilePolicy, bool useTileCache)
+{
+    m_input = &input;
+    m_positions = positions;
+    // Enough tiles ahead for every worker to have one in flight and a few to be stolen
+    m_window = 4 * numWorkers();
+
+    // The tiles of the first window are partitioned into contiguous runs, one per worker
+    int initial = Min(m_window, int(m_positions.Length()));
+    for (int i = 0; i < numWorkers(); i++)
+        for (int s = initial * i / numWorkers(); s < initial * (i + 1) / numWorkers(); s++)
+            m_workers[i]->queue.push_back(s);
+    m_nextDealt = initial;
+
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+    {
+        worker->engine->setNumberOfPlanes(numPlanes);
+        worker->thread = std::thread(&TRTTileFarm::run, this, std::ref(*worker), numPlanes, skipUniformTiles, uniformTileTolerance,
+                                     uniformTilePolicy, useTileCache);
+    }
+}
+
+const float* TRTTileFarm::next()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_resultReady.wait(lock, [this] { return !m_error.IsEmpty() || (m_results.count(m_nextConsumed) > 0); });
+    if (!m_error.IsEmpty())
+        throw Error(m_error);
+
+    auto result = m_results.find(m_nextConsumed);
+    m_current.swap(result->second);
+    m_results.erase(result);
+    m_nextConsumed++;
+
+    deal();
+    lock.unlock();
+    m_workAvailable.notify_all();
+    return m_current.data();
+}
+
+void TRTTileFarm::run(Worker& worker, int numPlanes, bool skipUniformTiles, float uniformTileTolerance, pcl_enum uniformTilePolicy, bool useTileCache)
+{
+    TRTTileProducer producer(*worker.engine, numPlanes, skipUniformTiles, uniformTileTolerance, uniformTilePolicy, useTileCache);
+    for (;;)
+    {
+        int sequence;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [&] { return m_stop || !m_error.IsEmpty() || take(worker, sequence); });
+            if (m_stop || !m_error.IsEmpty())
+                return;
+        }
+
+        try
+        {
+            int skipped = producer.numSkipped();
+            int cached = producer.numCached();
+            const float* tile = producer.produce(*m_input, m_positions[sequence]);
+            std::vector<float> output(tile, tile + size_type(numPlanes) * worker.engine->getOutputTileW() * worker.engine->getOutputTileH());
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_results[sequence].swap(output);
+                m_numSkipped += producer.numSkipped() - skipped;
+                m_numCached += producer.numCached() - cached;
+                worker.numProduced++;
+            }
+            m_resultReady.notify_one();
+        }
+        catch (const TRTConnectionError& x)
+        {
+            fail(worker, sequence, x.Message());
+            return;
+        }
+        catch (const Exception& x)
+        {
+            // Reported by the worker itself, so other workers would fail the same way
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_error = "Tile farm worker " + worker.address + ": " + x.Message();
+            }
+            m_resultReady.notify_one();
+            m_workAvailable.notify_all();
+            return;
+        }
+    }
+}
+
+int TRTTileFarm::numProduced(int worker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_workers[worker]->numProduced;
+}
+
+bool TRTTileFarm::take(Worker& worker, int& sequence)
+{
+    if (!worker.queue.empty())
+    {
+        sequence = worker.queue.front();
+        worker.queue.pop_front();
+        return true;
+    }
+
+    Worker* victim = nullptr;
+    for (const std::unique_ptr<Worker>& other : m_workers)
+        if (other->alive && !other->queue.empty())
+            if ((victim == nullptr) || (other->queue.size() > victim->queue.size()))
+                victim = other.get();
+    if (victim == nullptr)
+        return false;
+    sequence = victim->queue.back();
+    victim->queue.pop_back();
+    return true;
+}
+
+void TRTTileFarm::deal()
+{
+    for (; (m_nextDealt < int(m_positions.Length())) && (m_nextDealt < m_nextConsumed + m_window); m_nextDealt++)
+        if (Worker* worker = shortestQueue())
+            worker->queue.push_back(m_nextDealt);
+}
+
+TRTTileFarm::Worker* TRTTileFarm::shortestQueue()
+{
+    Worker* shortest = nullptr;
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+        if (worker->alive)
+            if ((shortest == nullptr) || (worker->queue.size() < shortest->queue.size()))
+                shortest = worker.get();
+    return shortest;
+}
+
+void TRTTileFarm::fail(Worker& worker, int sequence, const String& message)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        worker.alive = false;
+        m_numFailedWorkers++;
+        if (shortestQueue() == nullptr)
+            m_error = "All tile farm workers failed. Last failure at " + worker.address + ": " + message;
+        else
+        {
+            // The failed tile is the most urgent of its queue, so it goes first
+            shortestQueue()->queue.push_front(sequence);
+            for (int s : worker.queue)
+                shortestQueue()->queue.push_back(s);
+        }
+        worker.queue.clear();
+    }
+    m_resultReady.notify_one();
+    m_workAvailable.notify_all();
+}
+
+}	// namespace pcl
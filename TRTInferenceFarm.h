@@ -0,0 +1,111 @@
+#ifndef __TRTInferenceFarm_h
+#define __TRTInferenceFarm_h
+
+#include <pcl/Array.h>
+#include <pcl/Image.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TRTInferenceClient.h"
+
+namespace pcl
+{
+
+// Spreads the tiles of an image over the worker nodes of a tile farm, each running the inference
+// server. Every worker has its own queue of tiles; a worker done with its queue steals from the end of
+// the longest one. Tiles are produced at most a window ahead of the consumer and handed over in plan
+// order, so the result does not depend on which worker produced which tile. The tiles of a failed
+// worker go to the others, and the farm fails only when no worker is left.
+class TRTTileFarm
+{
+public:
+    // Connects to the workers at the comma-separated "host:port" addresses. Unreachable workers are
+    // left out with a warning; throws Error if none is reachable, or if the workers serve different
+    // engines.
+    explicit TRTTileFarm(const String& workers);
+    ~TRTTileFarm();
+
+    // Engine of the first worker, for the tile geometry
+    TRTEngine& engine()
+    {
+        return *m_workers[0]->engine;
+    }
+
+    int numWorkers() const
+    {
+        return int(m_workers.size());
+    }
+
+    // Starts producing the tiles at the given input positions. Uniform tiles and the tile cache are
+    // handled on the coordinator as with a local engine.
+    void start(const FImage& input, const Array<Point>& positions, int numPlanes, bool skipUniformTiles, float uniformTileTolerance,
+               pcl_enum uniformTilePolicy, bool useTileCache);
+
+    // Output tile at the next position, valid until the next call; waits for it
+    const float* next();
+
+    int numSkipped() const
+    {
+        return m_numSkipped;
+    }
+
+    int numCached() const
+    {
+        return m_numCached;
+    }
+
+    // Workers which failed; their tiles were requeued on the others while any was left
+    int numFailedWorkers() const
+    {
+        return m_numFailedWorkers;
+    }
+
+    // Tiles produced so far by the worker with the given index
+    int numProduced(int worker);
+
+private:
+    struct Worker
+    {
+        String address;
+        std::unique_ptr<TRTRemoteEngine> engine;
+        // Sequence numbers of the tiles assigned to this worker
+        std::deque<int> queue;
+        bool alive = true;
+        int numProduced = 0;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    const FImage* m_input = nullptr;
+    Array<Point> m_positions;
+    int m_window = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_resultReady;
+    std::map<int, std::vector<float>> m_results;
+    std::vector<float> m_current;
+    int m_nextDealt = 0;
+    int m_nextConsumed = 0;
+    bool m_stop = false;
+    String m_error;
+    int m_numSkipped = 0;
+    int m_numCached = 0;
+    int m_numFailedWorkers = 0;
+
+    void run(Worker& worker, int numPlanes, bool skipUniformTiles, float uniformTileTolerance, pcl_enum uniformTilePolicy, bool useTileCache);
+    bool take(Worker& worker, int& sequence);
+    void deal();
+    Worker* shortestQueue();
+    void fail(Worker& worker, int sequence, const String& message);
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceFarm_h
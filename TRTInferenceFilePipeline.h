@@ -0,0 +1,52 @@
+#ifndef __TRTInferenceFilePipeline_h
+#define __TRTInferenceFilePipeline_h
+
+#include <pcl/Defs.h>
+
+#include <future>
+
+namespace pcl
+{
+
+// Processes count items of type T on the calling thread while a worker thread reads the next item and
+// another writes the previous result. read(i) returns item i on a worker thread, and process(i, item)
+// works on it in place. write(i, item) is then called on the calling thread, once the previous write
+// has completed, and returns the function storing the item, which runs on a worker thread. At most one
+// read and one write are in flight, so no more than three items are held at a time. An exception thrown
+// by a read or a write is rethrown on the calling thread when the item is needed or the next write is
+// due; the write in flight is completed before any exception propagates.
+template <class T, class Read, class Process, class Write>
+void runFilePipeline(size_type count, Read read, Process process, Write write)
+{
+    if (count == 0)
+        return;
+
+    std::future<T> next = std::async(std::launch::async, read, size_type(0));
+    std::future<void> writing;
+    try
+    {
+        for (size_type i = 0; i < count; i++)
+        {
+            T item = next.get();
+            if (i + 1 < count)
+                next = std::async(std::launch::async, read, i + 1);
+
+            process(i, item);
+
+            if (writing.valid())
+                writing.get();
+            writing = std::async(std::launch::async, write(i, std::move(item)));
+        }
+    }
+    catch (...)
+    {
+        if (writing.valid())
+            writing.wait();
+        throw;
+    }
+    writing.get();
+}
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceFilePipeline_h
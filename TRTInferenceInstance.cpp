@@ -1,188 +1,63 @@
 #include <pcl/AutoViewLock.h>
 #include <pcl/Console.h>
+#include <pcl/ElapsedTime.h>
 #include <pcl/File.h>
-#include <pcl/IntegerResample.h>
-#include <pcl/Resample.h>
+#include <pcl/FileFormat.h>
+#include <pcl/FileFormatInstance.h>
+#include <pcl/ImageWindow.h>
 #include <pcl/StandardStatus.h>
 #include <pcl/View.h>
 
+#include "TRTInferenceAutotune.h"
+#include "TRTInferenceClient.h"
+#include "TRTInferenceFarm.h"
+#include "TRTInferenceFilePipeline.h"
 #include "TRTInferenceInstance.h"
+#include "TRTInferenceOutOfCore.h"
 #include "TRTInferenceParameters.h"
+#include "TRTInferencePipeline.h"
+#include "TRTInferenceProcessing.h"
 #include "TRTInferenceProcess.h"
+#include "TRTInferenceTileStore.h"
+#include "TRTInferenceTiling.h"
 
 namespace pcl
 {
 
-void TRTLogger::log(Severity severity, const char* msg) noexcept
-{
-    if (severity > Severity::kWARNING)
-        return;
-    Console console;
-    if (severity == Severity::kWARNING)
-        console.WarningLn(String("[TensorRT] WARNING: ") + msg);
-    else
-        console.CriticalLn(String("[TensorRT] ERROR: ") + msg);
-}
-
-TRTEngine::TRTEngine(String enginePath, const char* inputBlobName, const char* outputBlobName)
-{
-    strcpy(m_inputBlobName, inputBlobName);
-    strcpy(m_outputBlobName, outputBlobName);
-
-    File file(enginePath, FileMode::Read);
-    if (!file.IsOpen())
-        throw Error("Unable to open TensorRT engine file " + enginePath);
-    auto size = file.Size();
-    ByteArray buffer(size);
-    file.Read(buffer.Begin(), size);
-    file.Close();
-
-    auto runtime = std::unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(m_logger));
-    if (!runtime)
-        throw Error("Failed to create TensorRT runtime.");
-
-    cudaSetDevice(0);
-
-    m_engine = std::unique_ptr<nvinfer1::ICudaEngine>(runtime->deserializeCudaEngine(buffer.Begin(), size));
-    if (!m_engine)
-        throw Error("Failed to deserialize TensorRT engine from engine file " + enginePath);
-
-    auto dims = m_engine->getTensorShape(m_inputBlobName);
-    if ((dims.d[0] == -1) || (m_engine->getTensorIOMode(m_inputBlobName) != nvinfer1::TensorIOMode::kINPUT))
-        throw Error("Input blob " + String(m_inputBlobName) + " not found.");
-    if (dims.nbDims != 4)
-        throw Error("Input blob " + String(m_inputBlobName) + " is not 4-dimension.");
-    if (dims.d[1] != 3)
-        throw Error("Input blob " + String(m_inputBlobName) + " does not have 3 channels.");
-    m_inputTileH = dims.d[2];
-    m_inputTileW = dims.d[3];
-
-    dims = m_engine->getTensorShape(m_outputBlobName);
-    if ((dims.d[0] == -1) || (m_engine->getTensorIOMode(m_outputBlobName) != nvinfer1::TensorIOMode::kOUTPUT))
-        throw Error("Output blob " + String(m_outputBlobName)+" not found.");
-    if (dims.nbDims != 4)
-        throw Error("Output blob " + String(m_outputBlobName)+" is not 4-dimension.");
-    if (dims.d[1] != 3)
-        throw Error("Output blob " + String(m_outputBlobName)+" does not have 3 channels.");
-    m_outputTileH = dims.d[2];
-    m_outputTileW = dims.d[3];
-
-    if (((m_outputTileW % m_inputTileW) != 0) || ((m_outputTileH % m_inputTileH) != 0))
-        throw Error("Shape of output blob " + String(m_outputBlobName)+" is not multiple of input blob " + m_inputBlobName);
-
-    auto datatype = m_engine->getTensorDataType(m_inputBlobName);
-    if (datatype != nvinfer1::DataType::kFLOAT)
-        throw Error("Input blob " + String(m_inputBlobName)+" is not 32-bit float.");
-    datatype = m_engine->getTensorDataType(m_outputBlobName);
-    if (datatype != nvinfer1::DataType::kFLOAT)
-        throw Error("Output blob " + String(m_outputBlobName)+" is not 32-bit float.");
-
-    m_context = std::unique_ptr<nvinfer1::IExecutionContext>(m_engine->createExecutionContext());
-    if (!m_context)
-        throw Error("Failed to create TensorRT execution context.");
-
-    if (cudaStreamCreate(&m_cudaStream) != cudaSuccess)
-        throw Error("Failed to create CUDA stream.");
-}
-
-TRTEngine::~TRTEngine()
-{
-    cudaStreamDestroy(m_cudaStream);
-    m_context.reset();
-    m_engine.reset();
-}
-
-void TRTEngine::runInferenceTile(const FImage& input, const Point tilePos, FImage& output, FImage& mask)
-{
-    auto dims = m_engine->getTensorShape(m_inputBlobName);
-    dims.d[0] = 1;
-    if (!m_context->setInputShape(m_inputBlobName, dims))
-        throw Error("Failed to set input shape.");
-    m_inputBuffer.hostBuffer.resize(dims);
-    m_inputBuffer.deviceBuffer.resize(dims);
-    dims = m_context->getTensorShape(m_outputBlobName);
-    m_outputBuffer.hostBuffer.resize(dims);
-    m_outputBuffer.deviceBuffer.resize(dims);
-
-    // Get tile
-    float* p = static_cast<float*>(m_inputBuffer.hostBuffer.data());
-    for (int c = 0; c < 3; c++)
-        for (int y = 0; y < m_inputTileH; y++)
-        {
-            int y0 = y + tilePos.y;
-            if (y0 >= input.Height())
-                y0 = input.Height() - 1;
-            for (int x = 0; x < m_inputTileW; x++)
-            {
-                int x0 = x + tilePos.x;
-                if (x0 >= input.Width())
-                    x0 = input.Width() - 1;
-                *p++ = input.Pixel(x0, y0, (input.NumberOfChannels() == 3) ? c : 0);
-            }
-        }
-
-    // Copy from CPU to GPU
-    auto ret = cudaMemcpyAsync(m_inputBuffer.deviceBuffer.data(), m_inputBuffer.hostBuffer.data(), m_inputBuffer.hostBuffer.nbBytes(), cudaMemcpyHostToDevice, m_cudaStream);
-    if (ret != cudaSuccess)
-        throw Error("Failed to send image tile to GPU.");
-
-    // Run inference
-    if (!m_context->setTensorAddress(m_inputBlobName, m_inputBuffer.deviceBuffer.data()))
-        throw Error("Failed to set input tensors.");
-    if (!m_context->setTensorAddress(m_outputBlobName, m_outputBuffer.deviceBuffer.data()))
-        throw Error("Failed to set output tensors.");
-    if (!m_context->enqueueV3(m_cudaStream))
-        throw Error("Failed to run inference on image tile.");
-
-    // Copy from GPU to CPU
-    ret = cudaMemcpyAsync(m_outputBuffer.hostBuffer.data(), m_outputBuffer.deviceBuffer.data(), m_outputBuffer.deviceBuffer.nbBytes(), cudaMemcpyDeviceToHost, m_cudaStream);
-    if (ret != cudaSuccess)
-        throw Error("Failed to receive image tile from GPU.");
-
-    // Wait for CUDA stream
-    ret = cudaStreamSynchronize(m_cudaStream);
-    if (ret != cudaSuccess)
-        throw Error("Failed to synchronize CUDA stream.");
-
-    // Copy tile to output
-    int padX = m_outputTileW / 16;
-    int padY = m_outputTileH / 16;
-    Point outputTilePos(tilePos.x * (m_outputTileW / m_inputTileW), tilePos.y * (m_outputTileH / m_inputTileH));
-    p = static_cast<float*>(m_outputBuffer.hostBuffer.data());
-    for (int c = 0; c < 3; c++)
-        for (int y = 0; y < m_outputTileH; y++)
-        {
-            int y0 = y + outputTilePos.y;
-            for (int x = 0; x < m_outputTileW; x++)
-            {
-                int x0 = x + outputTilePos.x;
-                if ((x0 >= output.Width()) || (y0 >= output.Height()))
-                {
-                    p++;
-                    continue;
-                }
-                float rx = 0.5f - Abs(x - m_outputTileW / 2) * 1.0f / (m_outputTileW - 2 * padX);
-                if (rx < 0.001f)
-                    rx = 0.001f;
-                float ry = 0.5f - Abs(y - m_outputTileH / 2) * 1.0f / (m_outputTileH - 2 * padY);
-                if (ry < 0.001f)
-                    ry = 0.001f;
-                float r = rx * ry;
-                float v = *p++;
-                if (v < 0.0f)
-                    v = 0.0f;
-                else if (v > 1.0f)
-                    v = 1.0f;
-                output.Pixel(x0, y0, c) += v * r;
-                mask.Pixel(x0, y0, c) += r;
-            }
-        }
-}
-
 TRTInferenceInstance::TRTInferenceInstance(const MetaProcess* m)
     : ProcessImplementation(m)
     , p_tileOverlap(TheTRTInferenceTileOverlapParameter->DefaultValue())
     , p_keepOutputDimension(TheTRTInferenceKeepOutputDimensionParameter->DefaultValue())
+    , p_skipUniformTiles(TheTRTInferenceSkipUniformTilesParameter->DefaultValue())
+    , p_uniformTileTolerance(TheTRTInferenceUniformTileToleranceParameter->DefaultValue())
+    , p_uniformTilePolicy(TRTInferenceUniformTilePolicy::Default)
+    , p_useTileCache(TheTRTInferenceUseTileCacheParameter->DefaultValue())
+    , p_tileCacheSize(int32(TheTRTInferenceTileCacheSizeParameter->DefaultValue()))
+    , p_tileCacheDiskSize(int32(TheTRTInferenceTileCacheDiskSizeParameter->DefaultValue()))
+    , p_useTileStore(TheTRTInferenceUseTileStoreParameter->DefaultValue())
+    , p_blendMode(TRTInferenceBlendMode::Default)
+    , p_monoChannelAverage(TheTRTInferenceMonoChannelAverageParameter->DefaultValue())
+    , p_binInput(TheTRTInferenceBinInputParameter->DefaultValue())
+    , p_useROI(TheTRTInferenceUseROIParameter->DefaultValue())
+    , p_roiX0(int32(TheTRTInferenceROIX0Parameter->DefaultValue()))
+    , p_roiY0(int32(TheTRTInferenceROIY0Parameter->DefaultValue()))
+    , p_roiX1(int32(TheTRTInferenceROIX1Parameter->DefaultValue()))
+    , p_roiY1(int32(TheTRTInferenceROIY1Parameter->DefaultValue()))
+    , p_liveDisplay(TheTRTInferenceLiveDisplayParameter->DefaultValue())
+    , p_liveDisplayInterval(TheTRTInferenceLiveDisplayIntervalParameter->DefaultValue())
+    , p_outputDirectory(TheTRTInferenceOutputDirectoryParameter->DefaultValue())
+    , p_outputPostfix(TheTRTInferenceOutputPostfixParameter->DefaultValue())
+    , p_overwriteExistingFiles(TheTRTInferenceOverwriteExistingFilesParameter->DefaultValue())
+    , p_outOfCore(TheTRTInferenceOutOfCoreParameter->DefaultValue())
+    , p_useCheckpoints(TheTRTInferenceUseCheckpointsParameter->DefaultValue())
+    , p_checkpointInterval(TheTRTInferenceCheckpointIntervalParameter->DefaultValue())
+    , p_tileOrder(TRTInferenceTileOrder::Default)
+    , p_tileBandHeight(int32(TheTRTInferenceTileBandHeightParameter->DefaultValue()))
+    , p_useInferenceServer(TheTRTInferenceUseInferenceServerParameter->DefaultValue())
+    , p_gpuMemoryBudget(int32(TheTRTInferenceGpuMemoryBudgetParameter->DefaultValue()))
+    , p_useTuningProfile(TheTRTInferenceUseTuningProfileParameter->DefaultValue())
+    , p_autoTileOverlap(TheTRTInferenceAutoTileOverlapParameter->DefaultValue())
+    , p_seamErrorThreshold(TheTRTInferenceSeamErrorThresholdParameter->DefaultValue())
 {
 }
 
@@ -200,6 +75,41 @@ void TRTInferenceInstance::Assign(const ProcessImplementation& p)
         p_trtEngine = x->p_trtEngine;
         p_tileOverlap = x->p_tileOverlap;
         p_keepOutputDimension = x->p_keepOutputDimension;
+        p_skipUniformTiles = x->p_skipUniformTiles;
+        p_uniformTileTolerance = x->p_uniformTileTolerance;
+        p_uniformTilePolicy = x->p_uniformTilePolicy;
+        p_useTileCache = x->p_useTileCache;
+        p_tileCacheSize = x->p_tileCacheSize;
+        p_tileCacheDiskSize = x->p_tileCacheDiskSize;
+        p_tileCacheDirectory = x->p_tileCacheDirectory;
+        p_useTileStore = x->p_useTileStore;
+        p_blendMode = x->p_blendMode;
+        p_monoChannelAverage = x->p_monoChannelAverage;
+        p_binInput = x->p_binInput;
+        p_useROI = x->p_useROI;
+        p_roiX0 = x->p_roiX0;
+        p_roiY0 = x->p_roiY0;
+        p_roiX1 = x->p_roiX1;
+        p_roiY1 = x->p_roiY1;
+        p_liveDisplay = x->p_liveDisplay;
+        p_liveDisplayInterval = x->p_liveDisplayInterval;
+        p_inputFiles = x->p_inputFiles;
+        p_outputDirectory = x->p_outputDirectory;
+        p_outputPostfix = x->p_outputPostfix;
+        p_overwriteExistingFiles = x->p_overwriteExistingFiles;
+        p_outOfCore = x->p_outOfCore;
+        p_useCheckpoints = x->p_useCheckpoints;
+        p_checkpointInterval = x->p_checkpointInterval;
+        p_checkpointDirectory = x->p_checkpointDirectory;
+        p_tileOrder = x->p_tileOrder;
+        p_tileBandHeight = x->p_tileBandHeight;
+        p_useInferenceServer = x->p_useInferenceServer;
+        p_tileFarmWorkers = x->p_tileFarmWorkers;
+        p_pipelineEngines = x->p_pipelineEngines;
+        p_gpuMemoryBudget = x->p_gpuMemoryBudget;
+        p_useTuningProfile = x->p_useTuningProfile;
+        p_autoTileOverlap = x->p_autoTileOverlap;
+        p_seamErrorThreshold = x->p_seamErrorThreshold;
     }
 }
 
@@ -208,6 +118,12 @@ bool TRTInferenceInstance::IsHistoryUpdater(const View& view) const
     return true;
 }
 
+bool TRTInferenceInstance::IsMaskable(const View& view, const ImageWindow& mask) const
+{
+    // The mask is applied by ExecuteOn, which skips the tiles it excludes
+    return false;
+}
+
 bool TRTInferenceInstance::CanExecuteOn(const View& view, String& whyNot) const
 {
     if (view.Image().IsComplexSample())
@@ -245,63 +161,264 @@ bool TRTInferenceInstance::ExecuteOn(View& view)
     ImageVariant image = view.Image();
     image.SetStatusCallback(&status);
 
-    TRTEngine trtEngine(p_trtEngine);
+    // Tiles are spread over the workers of the tile farm if there is one, and this process only
+    // coordinates them
+    std::unique_ptr<TRTTileFarm> farm;
+    std::unique_ptr<TRTEngine> engine;
+    if (!p_tileFarmWorkers.Trimmed().IsEmpty())
+    {
+        if (!p_pipelineEngines.Trimmed().IsEmpty())
+            throw Error("Engine pipelines cannot run on a tile farm.");
+        farm = std::make_unique<TRTTileFarm>(p_tileFarmWorkers);
+        console.WriteLn(String().Format("<end><cbr>Tile farm: %d workers", farm->numWorkers()));
+    }
+    else
+        engine = openEngineChain(p_trtEngine, p_pipelineEngines, p_useInferenceServer, image.Width(), image.Height(),
+                                 uint64(p_gpuMemoryBudget) << 20, p_tileOverlap);
+    TRTEngine& trtEngine = farm ? farm->engine() : *engine;
+    applyTuningProfile(trtEngine);
     int factorW = trtEngine.getOutputTileW() / trtEngine.getInputTileW();
     int factorH = trtEngine.getOutputTileH() / trtEngine.getInputTileH();
 
-    ImageVariant imgToTRT;
-    imgToTRT.CreateFloatImage();
-    imgToTRT.AllocateImage(image.Width(), image.Height(), image.NumberOfChannels(), image.ColorSpace());
-    imgToTRT.CopyImage(image);
-    imgToTRT.SetStatusCallback(nullptr);
-
-    ImageVariant imgFromTRT, mask;
-    imgFromTRT.CreateFloatImage();
-    imgFromTRT.AllocateImage(image.Width() * factorW, image.Height() * factorH, 3, ImageVariant::color_space::RGB);
-    imgFromTRT.Zero();
-    imgFromTRT.SetStatusCallback(nullptr);
-    mask.CopyImage(imgFromTRT);
-    mask.EnsureUniqueImage();
-    mask.SetStatusCallback(nullptr);
-
-    // Tile processing
-    int tileStepX = trtEngine.getInputTileW() * (1.0f - p_tileOverlap);
-    int tileStepY = trtEngine.getInputTileH() * (1.0f - p_tileOverlap);
-    int n = (image.Width() + tileStepX - 1) / tileStepX;
-    n *= (image.Height() + tileStepY - 1) / tileStepY;
-    image.Status().Initialize("Running inference", n);
-    for (int y = 0; y < image.Height(); y += tileStepY)
-        for (int x = 0; x < image.Width(); x += tileStepX)
-        {
-            trtEngine.runInferenceTile(static_cast<const FImage&>(*imgToTRT), Point(x, y), static_cast<FImage&>(*imgFromTRT), static_cast<FImage&>(*mask));
-            image.Status() += 1;
-        }
-    image.Status().Complete();
+    // ROI margins are in binned pixels in same-size fast mode
+    bool binned = p_binInput && !p_keepOutputDimension && (factorW > 1) && (factorW == factorH);
+
+    // Region of interest: from here on image is a copy of the ROI plus a margin of context, and only
+    // the ROI is written back to the view at the end
+    ImageVariant viewImage = image;
+    Rect roi = image.Bounds();
+    Rect context = roi;
+    if (p_useROI)
+    {
+        if (p_keepOutputDimension && ((factorW > 1) || (factorH > 1)))
+            throw Error("Region of interest execution requires the original image dimensions. Disable Keep Output Dimension.");
+        roi = Rect(p_roiX0, p_roiY0, p_roiX1, p_roiY1).Ordered().Intersection(image.Bounds());
+        if (!roi.IsRect())
+            throw Error("The region of interest does not intersect the image.");
+
+        int marginX = trtEngine.getContextMarginX() * (binned ? factorW : 1);
+        int marginY = trtEngine.getContextMarginY() * (binned ? factorH : 1);
+        context = contextRegion(roi, marginX, marginY, image.Width(), image.Height());
+
+        viewImage.SelectRectangle(context);
+        image = ImageVariant();
+        image.CreateImageAs(viewImage);
+        image.AllocateImage(context.Width(), context.Height(), viewImage.NumberOfChannels(), viewImage.ColorSpace());
+        image.CopyImage(viewImage);
+        image.SetStatusCallback(&status);
+        viewImage.ResetSelections();
+
+        console.WriteLn(String().Format("<end><cbr>Region of interest: %dx%d at (%d,%d), processing %dx%d at (%d,%d)",
+                                        roi.Width(), roi.Height(), roi.x0, roi.y0, context.Width(), context.Height(), context.x0, context.y0));
+    }
 
-    imgFromTRT.Divide(mask);
+    // Active mask of the view, in the coordinates of image
+    ImageVariant viewMask;
+    ImageWindow maskWindow = view.Window().Mask();
+    bool masked = view.Window().IsMaskEnabled() && !maskWindow.IsNull();
+    if (masked)
+    {
+        if (p_keepOutputDimension && ((factorW > 1) || (factorH > 1)))
+            throw Error("Masked execution requires the original image dimensions. Disable Keep Output Dimension or the mask.");
+        ImageVariant maskImage = maskWindow.MainView().Image();
+        maskImage.SelectRectangle(context);
+        viewMask.CreateFloatImage();
+        viewMask.AllocateImage(context.Width(), context.Height(), maskImage.NumberOfChannels(), maskImage.ColorSpace());
+        viewMask.CopyImage(maskImage);
+        viewMask.SetStatusCallback(nullptr);
+        maskImage.ResetSelections();
+        if (view.Window().IsMaskInverted())
+            viewMask.Invert();
+    }
 
-    // Keep original color space
-    if (imgFromTRT.ColorSpace() != image.ColorSpace())
-        imgFromTRT.SetColorSpace(image.ColorSpace());
+    String storePath = p_useTileStore ? TRTTileStore::storePath(view.Window().FilePath(), view.Id()) : String();
+    processImage(processingSettings(), trtEngine, image, masked ? &static_cast<const FImage&>(*viewMask) : nullptr, storePath, farm.get());
 
-    if (!p_keepOutputDimension)
+    // Write back only the ROI; the context margin was there to feed the engine
+    if (p_useROI)
+        viewImage.Apply(image, ImageOp::Mov, roi.LeftTop(), -1, roi.MovedBy(-context.x0, -context.y0));
+
+    return true;
+}
+
+bool TRTInferenceInstance::CanExecuteGlobal(String& whyNot) const
+{
+    for (const InputFile& file : p_inputFiles)
+        if (file.enabled)
+            return true;
+    whyNot = "No input files have been specified.";
+    return false;
+}
+
+// An image of a batch, with the metadata carried over to its output file
+struct BatchImage
+{
+    ImageVariant image;
+    FITSKeywordArray keywords;
+};
+
+static BatchImage readBatchImage(const String& path)
+{
+    FileFormat format(File::ExtractExtension(path), true, false);
+    FileFormatInstance file(format);
+    ImageDescriptionArray images;
+    if (!file.Open(images, path))
+        throw Error("Unable to open file: " + path);
+    if (images.IsEmpty())
+        throw Error("Empty image file: " + path);
+
+    BatchImage batchImage;
+    const ImageOptions& options = images[0].options;
+    if (options.complexSample || (options.bitsPerSample == 64))
+        throw Error("Unsupported sample format: " + path);
+    if (format.CanStoreKeywords())
+        file.ReadFITSKeywords(batchImage.keywords);
+    batchImage.image.CreateImage(options.ieeefpSampleFormat, false, options.bitsPerSample);
+    if (!file.ReadImage(batchImage.image))
+        throw Error("Unable to read file: " + path);
+    file.Close();
+
+    if ((batchImage.image.NumberOfChannels() != 1) && (batchImage.image.NumberOfChannels() != 3))
+        throw Error("Only single-channel or RGB images can be processed: " + path);
+    return batchImage;
+}
+
+static void writeBatchImage(const String& path, const BatchImage& batchImage)
+{
+    FileFormat format(File::ExtractExtension(path), false, true);
+    FileFormatInstance file(format);
+    if (!file.Create(path))
+        throw Error("Unable to create file: " + path);
+
+    ImageOptions options;
+    options.bitsPerSample = batchImage.image.BitsPerSample();
+    options.ieeefpSampleFormat = batchImage.image.IsFloatSample();
+    file.SetOptions(options);
+    if (format.CanStoreKeywords())
+        file.WriteFITSKeywords(batchImage.keywords);
+    if (!file.WriteImage(batchImage.image))
+        throw Error("Unable to write file: " + path);
+    file.Close();
+}
+
+void TRTInferenceInstance::applyTuningProfile(TRTEngine& trtEngine)
+{
+    m_tuning = TRTTuning();
+    if (!p_useTuningProfile)
+        return;
+    String deviceKey = tuningDeviceKey(trtEngine);
+    if (loadTuning(trtEngine.getEngineHash(), deviceKey, m_tuning))
     {
-        // Resample
-        if ((factorW > 1) && (factorW == factorH))
-        {
-            IntegerResample ir(-factorW);
-            ir >> imgFromTRT;
-        }
-        else if (factorW > 1)
+        applyTuning(trtEngine, m_tuning);
+        Console().WriteLn("<end><cbr>Tuned settings: " + m_tuning.toString());
+    }
+}
+
+TRTProcessingSettings TRTInferenceInstance::processingSettings() const
+{
+    TRTProcessingSettings settings;
+    settings.tileOverlap = p_tileOverlap;
+    settings.autoTileOverlap = p_autoTileOverlap;
+    settings.seamErrorThreshold = p_seamErrorThreshold;
+    settings.keepOutputDimension = p_keepOutputDimension;
+    settings.binInput = p_binInput;
+    settings.blendMode = p_blendMode;
+    settings.monoChannelAverage = p_monoChannelAverage;
+    settings.skipUniformTiles = p_skipUniformTiles;
+    settings.uniformTileTolerance = p_uniformTileTolerance;
+    settings.uniformTilePolicy = p_uniformTilePolicy;
+    settings.useTileCache = p_useTileCache;
+    settings.tileCacheSize = p_tileCacheSize;
+    settings.tileCacheDiskSize = p_tileCacheDiskSize;
+    settings.tileCacheDirectory = p_tileCacheDirectory;
+    settings.liveDisplay = p_liveDisplay;
+    settings.liveDisplayInterval = p_liveDisplayInterval;
+    settings.useCheckpoints = p_useCheckpoints;
+    settings.checkpointInterval = p_checkpointInterval;
+    settings.checkpointDirectory = p_checkpointDirectory;
+    settings.tileOrder = p_tileOrder;
+    settings.tileBandHeight = p_tileBandHeight;
+    settings.tuning = m_tuning;
+    return settings;
+}
+
+String TRTInferenceInstance::batchOutputPath(const String& inputPath) const
+{
+    String directory = p_outputDirectory.Trimmed();
+    if (directory.IsEmpty())
+        directory = File::ExtractDrive(inputPath) + File::ExtractDirectory(inputPath);
+    if (!directory.EndsWith('/'))
+        directory += '/';
+    String name = directory + File::ExtractName(inputPath) + p_outputPostfix;
+    String extension = File::ExtractExtension(inputPath);
+
+    String path = name + extension;
+    if (!p_overwriteExistingFiles)
+        for (int i = 1; File::Exists(path); i++)
+            path = name + String().Format("_%d", i) + extension;
+    return path;
+}
+
+bool TRTInferenceInstance::ExecuteGlobal()
+{
+    String why;
+    if (!CanExecuteGlobal(why))
+        throw Error(why);
+
+    Console console;
+    console.EnableAbort();
+
+    StringList inputPaths;
+    for (const InputFile& file : p_inputFiles)
+        if (file.enabled)
+            inputPaths << file.path;
+
+    // One engine for the whole batch
+    std::unique_ptr<TRTEngine> engine = openEngineChain(p_trtEngine, p_pipelineEngines, p_useInferenceServer, 0, 0,
+                                                        uint64(p_gpuMemoryBudget) << 20, p_tileOverlap);
+    TRTEngine& trtEngine = *engine;
+    applyTuningProfile(trtEngine);
+    ElapsedTime T;
+
+    if (p_outOfCore)
+    {
+        // Images are streamed band by band, so nothing is read ahead
+        for (size_type i = 0; i < inputPaths.Length(); i++)
         {
-            BicubicFilterPixelInterpolation bf(factorW / 2, factorH / 2, CubicBSplineFilter());
-            Resample r(bf, 1.0 / factorW, 1.0 / factorH);
-            r >> imgFromTRT;
+            console.WriteLn("<end><cbr><br>" + String().Format("* Processing file %u of %u: ", i + 1, inputPaths.Length()) + inputPaths[i]);
+
+            String outputPath = batchOutputPath(inputPaths[i]);
+            console.WriteLn("Writing " + outputPath);
+            if (TRTBandReader::canRead(inputPaths[i]) && TRTBandWriter::canWrite(outputPath))
+                processFileOutOfCore(processingSettings(), trtEngine, inputPaths[i], outputPath);
+            else
+            {
+                console.WarningLn("** Warning: The file format does not support incremental reads and writes. The image will be processed in memory.");
+                BatchImage batchImage = readBatchImage(inputPaths[i]);
+                processImage(processingSettings(), trtEngine, batchImage.image, nullptr, String());
+                writeBatchImage(outputPath, batchImage);
+            }
         }
     }
+    else
+    {
+        // While an image is being processed, the next file is read and the previous result is written by
+        // worker threads
+        runFilePipeline<BatchImage>(
+            inputPaths.Length(),
+            [&inputPaths](size_type i) { return readBatchImage(inputPaths[i]); },
+            [&](size_type i, BatchImage& batchImage) {
+                console.WriteLn("<end><cbr><br>" + String().Format("* Processing file %u of %u: ", i + 1, inputPaths.Length()) + inputPaths[i]);
+                processImage(processingSettings(), trtEngine, batchImage.image, nullptr, String());
+            },
+            [&](size_type i, BatchImage&& batchImage) {
+                String outputPath = batchOutputPath(inputPaths[i]);
+                console.WriteLn("Writing " + outputPath);
+                return [outputPath, batchImage = std::move(batchImage)]() { writeBatchImage(outputPath, batchImage); };
+            });
+    }
 
-    image.CopyImage(imgFromTRT);
-
+    console.WriteLn(String().Format("<end><cbr><br>%u files processed in ", inputPaths.Length()) + T.ToString());
     return true;
 }
 
@@ -311,7 +428,136 @@ void* TRTInferenceInstance::LockParameter(const MetaParameter* p, size_type tabl
         return &p_tileOverlap;
     if (p == TheTRTInferenceKeepOutputDimensionParameter)
         return &p_keepOutputDimension;
+    if (p == TheTRTInferenceSkipUniformTilesParameter)
+        return &p_skipUniformTiles;
+    if (p == TheTRTInferenceUniformTileToleranceParameter)
+        return &p_uniformTileTolerance;
+    if (p == TheTRTInferenceUniformTilePolicyParameter)
+        return &p_uniformTilePolicy;
+    if (p == TheTRTInferenceUseTileCacheParameter)
+        return &p_useTileCache;
+    if (p == TheTRTInferenceTileCacheSizeParameter)
+        return &p_tileCacheSize;
+    if (p == TheTRTInferenceTileCacheDiskSizeParameter)
+        return &p_tileCacheDiskSize;
+    if (p == TheTRTInferenceUseTileStoreParameter)
+        return &p_useTileStore;
+    if (p == TheTRTInferenceBlendModeParameter)
+        return &p_blendMode;
+    if (p == TheTRTInferenceMonoChannelAverageParameter)
+        return &p_monoChannelAverage;
+    if (p == TheTRTInferenceBinInputParameter)
+        return &p_binInput;
+    if (p == TheTRTInferenceUseROIParameter)
+        return &p_useROI;
+    if (p == TheTRTInferenceROIX0Parameter)
+        return &p_roiX0;
+    if (p == TheTRTInferenceROIY0Parameter)
+        return &p_roiY0;
+    if (p == TheTRTInferenceROIX1Parameter)
+        return &p_roiX1;
+    if (p == TheTRTInferenceROIY1Parameter)
+        return &p_roiY1;
+    if (p == TheTRTInferenceLiveDisplayParameter)
+        return &p_liveDisplay;
+    if (p == TheTRTInferenceLiveDisplayIntervalParameter)
+        return &p_liveDisplayInterval;
+    if (p == TheTRTInferenceInputFileEnabledParameter)
+        return &p_inputFiles[tableRow].enabled;
+    if (p == TheTRTInferenceInputFilePathParameter)
+        return p_inputFiles[tableRow].path.Begin();
+    if (p == TheTRTInferenceOutputDirectoryParameter)
+        return p_outputDirectory.Begin();
+    if (p == TheTRTInferenceOutputPostfixParameter)
+        return p_outputPostfix.Begin();
+    if (p == TheTRTInferenceOverwriteExistingFilesParameter)
+        return &p_overwriteExistingFiles;
+    if (p == TheTRTInferenceOutOfCoreParameter)
+        return &p_outOfCore;
+    if (p == TheTRTInferenceUseCheckpointsParameter)
+        return &p_useCheckpoints;
+    if (p == TheTRTInferenceCheckpointIntervalParameter)
+        return &p_checkpointInterval;
+    if (p == TheTRTInferenceTileOrderParameter)
+        return &p_tileOrder;
+    if (p == TheTRTInferenceTileBandHeightParameter)
+        return &p_tileBandHeight;
+    if (p == TheTRTInferenceUseInferenceServerParameter)
+        return &p_useInferenceServer;
+    if (p == TheTRTInferenceTileFarmWorkersParameter)
+        return p_tileFarmWorkers.Begin();
+    if (p == TheTRTInferencePipelineEnginesParameter)
+        return p_pipelineEngines.Begin();
+    if (p == TheTRTInferenceGpuMemoryBudgetParameter)
+        return &p_gpuMemoryBudget;
+    if (p == TheTRTInferenceUseTuningProfileParameter)
+        return &p_useTuningProfile;
+    if (p == TheTRTInferenceAutoTileOverlapParameter)
+        return &p_autoTileOverlap;
+    if (p == TheTRTInferenceSeamErrorThresholdParameter)
+        return &p_seamErrorThreshold;
     return nullptr;
 }
 
+bool TRTInferenceInstance::AllocateParameter(size_type sizeOrLength, const MetaParameter* p, size_type tableRow)
+{
+    if (p == TheTRTInferenceInputFilesParameter)
+    {
+        p_inputFiles.Clear();
+        if (sizeOrLength > 0)
+            p_inputFiles.Add(InputFile(), sizeOrLength);
+    }
+    else if (p == TheTRTInferenceInputFilePathParameter)
+    {
+        p_inputFiles[tableRow].path.Clear();
+        if (sizeOrLength > 0)
+            p_inputFiles[tableRow].path.SetLength(sizeOrLength);
+    }
+    else if (p == TheTRTInferenceOutputDirectoryParameter)
+    {
+        p_outputDirectory.Clear();
+        if (sizeOrLength > 0)
+            p_outputDirectory.SetLength(sizeOrLength);
+    }
+    else if (p == TheTRTInferenceOutputPostfixParameter)
+    {
+        p_outputPostfix.Clear();
+        if (sizeOrLength > 0)
+            p_outputPostfix.SetLength(sizeOrLength);
+    }
+    else if (p == TheTRTInferenceTileFarmWorkersParameter)
+    {
+        p_tileFarmWorkers.Clear();
+        if (sizeOrLength > 0)
+            p_tileFarmWorkers.SetLength(sizeOrLength);
+    }
+    else if (p == TheTRTInferencePipelineEnginesParameter)
+    {
+        p_pipelineEngines.Clear();
+        if (sizeOrLength > 0)
+            p_pipelineEngines.SetLength(sizeOrLength);
+    }
+    else
+        return false;
+
+    return true;
+}
+
+size_type TRTInferenceInstance::ParameterLength(const MetaParameter* p, size_type tableRow) const
+{
+    if (p == TheTRTInferenceInputFilesParameter)
+        return p_inputFiles.Length();
+    if (p == TheTRTInferenceInputFilePathParameter)
+        return p_inputFiles[tableRow].path.Length();
+    if (p == TheTRTInferenceOutputDirectoryParameter)
+        return p_outputDirectory.Length();
+    if (p == TheTRTInferenceOutputPostfixParameter)
+        return p_outputPostfix.Length();
+    if (p == TheTRTInferenceTileFarmWorkersParameter)
+        return p_tileFarmWorkers.Length();
+    if (p == TheTRTInferencePipelineEnginesParameter)
+        return p_pipelineEngines.Length();
+    return 0;
+}
+
 }	// namespace pcl
\ No newline at end of file
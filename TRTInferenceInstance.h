@@ -2,60 +2,15 @@
 #define __TRTInferenceInstance_h
 
 #include <pcl/ProcessImplementation.h>
-#include <NvInfer.h>
-#include <buffers.h>
 
-namespace pcl
-{
+#include <vector>
 
-class TRTLogger : public nvinfer1::ILogger
-{
-public:
-    void log(Severity severity, const char* msg) noexcept override;
-};
+#include "TRTInferenceAutotune.h"
+#include "TRTInferenceEngine.h"
+#include "TRTInferenceProcessing.h"
 
-class TRTEngine
+namespace pcl
 {
-private:
-    char m_inputBlobName[256];
-    char m_outputBlobName[256];
-    TRTLogger m_logger;
-    std::unique_ptr<nvinfer1::ICudaEngine> m_engine;
-    std::unique_ptr<nvinfer1::IExecutionContext> m_context;
-    cudaStream_t m_cudaStream;
-    int32_t m_inputTileW;
-    int32_t m_inputTileH;
-    int32_t m_outputTileW;
-    int32_t m_outputTileH;
-    samplesCommon::ManagedBuffer m_inputBuffer;
-    samplesCommon::ManagedBuffer m_outputBuffer;
-
-public:
-    explicit TRTEngine(String enginePath, const char* inputBlobName = "input", const char* outputBlobName = "output");
-    ~TRTEngine();
-
-    int32_t getInputTileW() const
-    {
-        return m_inputTileW;
-    }
-
-    int32_t getInputTileH() const
-    {
-        return m_inputTileH;
-    }
-
-    int32_t getOutputTileW() const
-    {
-        return m_outputTileW;
-    }
-
-    int32_t getOutputTileH() const
-    {
-        return m_outputTileH;
-    }
-
-    void runInferenceTile(const pcl::FImage& input, const pcl::Point tilePos, pcl::FImage& output, pcl::FImage& mask);
-};
 
 class TRTInferenceInstance : public ProcessImplementation
 {
@@ -65,14 +20,83 @@ public:
 
     void Assign(const ProcessImplementation&) override;
     bool IsHistoryUpdater(const View& v) const override;
+    bool IsMaskable(const View&, const ImageWindow& mask) const override;
     bool CanExecuteOn(const View&, String& whyNot) const override;
     bool ExecuteOn(View& view) override;
+    bool CanExecuteGlobal(String& whyNot) const override;
+    bool ExecuteGlobal() override;
     void* LockParameter(const MetaParameter*, size_type tableRow) override;
+    bool AllocateParameter(size_type sizeOrLength, const MetaParameter* p, size_type tableRow) override;
+    size_type ParameterLength(const MetaParameter* p, size_type tableRow) const override;
 
 private:
+    struct InputFile
+    {
+        bool enabled = true;
+        String path;
+
+        InputFile(const String& path_ = String())
+            : path(path_)
+        {
+        }
+    };
+
     String p_trtEngine;
     double p_tileOverlap;
     bool p_keepOutputDimension;
+    bool p_skipUniformTiles;
+    float p_uniformTileTolerance;
+    pcl_enum p_uniformTilePolicy;
+    bool p_useTileCache;
+    int32 p_tileCacheSize;
+    int32 p_tileCacheDiskSize;
+    String p_tileCacheDirectory;
+    bool p_useTileStore;
+    pcl_enum p_blendMode;
+    bool p_monoChannelAverage;
+    bool p_binInput;
+    bool p_useROI;
+    int32 p_roiX0;
+    int32 p_roiY0;
+    int32 p_roiX1;
+    int32 p_roiY1;
+    bool p_liveDisplay;
+    float p_liveDisplayInterval;
+    Array<InputFile> p_inputFiles;
+    String p_outputDirectory;
+    String p_outputPostfix;
+    bool p_overwriteExistingFiles;
+    bool p_outOfCore;
+    bool p_useCheckpoints;
+    float p_checkpointInterval;
+    String p_checkpointDirectory;
+    pcl_enum p_tileOrder;
+    int32 p_tileBandHeight;
+    bool p_useInferenceServer;
+    // Comma-separated host:port addresses of the tile farm workers; empty to infer locally
+    String p_tileFarmWorkers;
+    // Device memory the variant of an engine bundle may use, in MiB; zero for the free device memory
+    int32 p_gpuMemoryBudget;
+    // Apply the autotuned settings of the engine on this machine, if any
+    bool p_useTuningProfile;
+    // Select the smallest tile overlap whose seams, as probed on the image, differ by at most the threshold
+    bool p_autoTileOverlap;
+    float p_seamErrorThreshold;
+    // Semicolon-separated paths of the engines run after trtEngine on each tile, in order; empty to run
+    // trtEngine alone
+    String p_pipelineEngines;
+
+    // Settings of the current execution, from the tuning profile
+    TRTTuning m_tuning;
+
+    // Loads and applies the tuning profile of an engine when enabled
+    void applyTuningProfile(TRTEngine& trtEngine);
+
+    // Settings of processImage and processFileOutOfCore for this instance and the current execution
+    TRTProcessingSettings processingSettings() const;
+
+    // Output file of a batch input file, in the same format
+    String batchOutputPath(const String& inputPath) const;
 
     friend class TRTInferenceProcess;
     friend class TRTInferenceInterface;
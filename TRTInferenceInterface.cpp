@@ -1,9 +1,20 @@
+#include "TRTInferenceAutotune.h"
+#include "TRTInferenceClient.h"
 #include "TRTInferenceInterface.h"
 #include "TRTInferenceParameters.h"
+#include "TRTInferencePipeline.h"
+#include "TRTInferenceProfile.h"
 #include "TRTInferenceProcess.h"
+#include "TRTInferenceRuntime.h"
 
+#include <pcl/Console.h>
 #include <pcl/ErrorHandler.h>
+#include <pcl/File.h>
 #include <pcl/FileDialog.h>
+#include <pcl/ImageWindow.h>
+#include <pcl/MetaModule.h>
+#include <pcl/PreviewSelectionDialog.h>
+#include <pcl/RealTimePreview.h>
 #include <pcl/Settings.h>
 
 namespace pcl
@@ -40,7 +51,7 @@ IsoString TRTInferenceInterface::IconImageSVG() const
 
 InterfaceFeatures TRTInferenceInterface::Features() const
 {
-	return InterfaceFeature::Default;
+	return InterfaceFeature::Default | InterfaceFeature::ApplyGlobalButton | InterfaceFeature::RealTimeButton;
 }
 
 void TRTInferenceInterface::ResetInstance()
@@ -56,6 +67,8 @@ bool TRTInferenceInterface::Launch(const MetaProcess& P, const ProcessImplementa
 		GUI = new GUIData(*this);
 		SetWindowTitle(TRTInferenceProcess::MODULE_NAME);
 		Settings::Read("TRTEngine", m_instance.p_trtEngine);
+		Settings::Read("TileCacheDirectory", m_instance.p_tileCacheDirectory);
+		Settings::Read("CheckpointDirectory", m_instance.p_checkpointDirectory);
 		UpdateControls();
 
 		// Restore position only
@@ -98,18 +111,467 @@ void TRTInferenceInterface::SaveSettings() const
 	SaveGeometry();
 }
 
+void TRTInferenceInterface::RealTimePreviewUpdated(bool active)
+{
+	if (GUI != nullptr)
+		if (active)
+			RealTimePreview::SetOwner(*this);
+		else
+		{
+			RealTimePreview::SetOwner(ProcessInterface::Null());
+			// Release the GPU memory held by the preview engine
+			m_previewEngine.reset();
+		}
+}
+
+bool TRTInferenceInterface::RequiresRealTimePreviewUpdate(const UInt16Image&, const View&, const Rect&, int zoomLevel) const
+{
+	return true;
+}
+
+bool TRTInferenceInterface::GenerateRealTimePreview(UInt16Image& image, const View&, const Rect&, int zoomLevel, String& info) const
+{
+	try
+	{
+		// Tiled pipeline stages depend on the tile overlap
+		bool pipeline = !m_instance.p_pipelineEngines.Trimmed().IsEmpty();
+		if (!m_previewEngine || (m_previewEnginePath != m_instance.p_trtEngine) || (m_previewEngineShared != m_instance.p_useInferenceServer) ||
+			(m_previewPipelineEngines != m_instance.p_pipelineEngines) || (pipeline && (m_previewTileOverlap != m_instance.p_tileOverlap)))
+		{
+			m_previewEngine.reset();
+			m_previewEngine = openEngineChain(m_instance.p_trtEngine, m_instance.p_pipelineEngines, m_instance.p_useInferenceServer,
+											  0, 0, uint64(m_instance.p_gpuMemoryBudget) << 20, m_instance.p_tileOverlap);
+			m_previewEnginePath = m_instance.p_trtEngine;
+			m_previewEngineShared = m_instance.p_useInferenceServer;
+			m_previewPipelineEngines = m_instance.p_pipelineEngines;
+			m_previewTileOverlap = m_instance.p_tileOverlap;
+		}
+	}
+	catch (const Exception& x)
+	{
+		info = x.Message();
+		return false;
+	}
+
+	// The preview image only holds the visible region at the current zoom level. Large ones get a
+	// binned first pass, and the refine timer requests the full pass once it is shown.
+	bool refine = m_refinePreview;
+	m_refinePreview = false;
+
+	m_realTimeThread = new TRTPreviewThread(*m_previewEngine);
+	for (;;)
+	{
+		int coarseFactor = TRTPreviewPass::coarseFactorFor(image.Width(), image.Height(), refine);
+		m_realTimeThread->Reset(image, m_instance.p_tileOverlap, m_instance.p_blendMode == TRTInferenceBlendMode::CenterCrop, coarseFactor);
+		m_realTimeThread->Start();
+		while (m_realTimeThread->IsActive())
+		{
+			Module->ProcessEvents();
+			if (!IsRealTimePreviewActive())
+			{
+				m_realTimeThread->Cancel();
+				m_realTimeThread->Wait();
+				delete m_realTimeThread;
+				m_realTimeThread = nullptr;
+				return false;
+			}
+		}
+
+		if (!m_realTimeThread->IsCancelled())
+		{
+			String error = m_realTimeThread->m_error;
+			if (error.IsEmpty())
+				image.Assign(m_realTimeThread->m_image);
+			delete m_realTimeThread;
+			m_realTimeThread = nullptr;
+
+			if (!error.IsEmpty())
+			{
+				info = error;
+				return false;
+			}
+			if (coarseFactor > 1)
+			{
+				info = "Coarse preview, refining";
+				GUI->RefineRealTimePreview_Timer.Start();
+			}
+			return true;
+		}
+
+		// Parameters changed while running: start over, coarse again
+		refine = false;
+	}
+}
+
+void TRTInferenceInterface::UpdateRealTimePreview()
+{
+	if (IsRealTimePreviewActive())
+	{
+		// Stale work is cancelled, and a pending refinement would render old parameters
+		GUI->RefineRealTimePreview_Timer.Stop();
+		m_refinePreview = false;
+		if (m_realTimeThread != nullptr)
+			m_realTimeThread->Cancel();
+		GUI->UpdateRealTimePreview_Timer.Start();
+	}
+}
+
+void TRTInferenceInterface::__RealTimePreview_Timer(Timer& sender)
+{
+	if (m_realTimeThread != nullptr)
+		if (m_realTimeThread->IsActive())
+			return;
+
+	if (sender == GUI->RefineRealTimePreview_Timer)
+		m_refinePreview = true;
+	if (IsRealTimePreviewActive())
+		RealTimePreview::Update();
+}
+
 void TRTInferenceInterface::UpdateControls()
 {
 	GUI->TRTEngine_Edit.SetText(m_instance.p_trtEngine);
+	GUI->PipelineEngines_Edit.SetText(m_instance.p_pipelineEngines);
 	Settings::Write("TRTEngine", m_instance.p_trtEngine);
 	GUI->TileOverlap_NumericControl.SetValue(m_instance.p_tileOverlap);
+	GUI->AutoTileOverlap_CheckBox.SetChecked(m_instance.p_autoTileOverlap);
+	GUI->SeamErrorThreshold_NumericControl.SetValue(m_instance.p_seamErrorThreshold);
+	GUI->SeamErrorThreshold_NumericControl.Enable(m_instance.p_autoTileOverlap);
+	GUI->BlendMode_ComboBox.SetCurrentItem(m_instance.p_blendMode);
+	GUI->TileOrder_ComboBox.SetCurrentItem(m_instance.p_tileOrder);
+	GUI->TileBandHeight_SpinBox.SetValue(m_instance.p_tileBandHeight);
+	GUI->TileBandHeight_Label.Enable(m_instance.p_tileOrder == TRTInferenceTileOrder::BandMajor);
+	GUI->TileBandHeight_SpinBox.Enable(m_instance.p_tileOrder == TRTInferenceTileOrder::BandMajor);
+	GUI->UseInferenceServer_CheckBox.SetChecked(m_instance.p_useInferenceServer);
+	UpdateEngineCatalog();
+	String backendStatus;
+	if (File::ExtractExtension(m_instance.p_trtEngine).CaseFolded() == ".onnx")
+		backendStatus = "CPU, ONNX model";
+	else
+		trtRuntimeState(backendStatus);
+	GUI->BackendStatus_Label.SetText(backendStatus);
+	GUI->GpuMemoryBudget_SpinBox.SetValue(m_instance.p_gpuMemoryBudget);
+	GUI->UseTuningProfile_CheckBox.SetChecked(m_instance.p_useTuningProfile);
+	GUI->TileFarmWorkers_Edit.SetText(m_instance.p_tileFarmWorkers);
 	GUI->KeepOutputDimension_CheckBox.SetChecked(m_instance.p_keepOutputDimension);
+	GUI->BinInput_CheckBox.SetChecked(m_instance.p_binInput);
+	GUI->BinInput_CheckBox.Enable(!m_instance.p_keepOutputDimension);
+	GUI->MonoChannelAverage_CheckBox.SetChecked(m_instance.p_monoChannelAverage);
+	GUI->SkipUniformTiles_CheckBox.SetChecked(m_instance.p_skipUniformTiles);
+	GUI->UniformTileTolerance_NumericControl.SetValue(m_instance.p_uniformTileTolerance);
+	GUI->UniformTileTolerance_NumericControl.Enable(m_instance.p_skipUniformTiles);
+	GUI->UniformTilePolicy_ComboBox.SetCurrentItem(m_instance.p_uniformTilePolicy);
+	GUI->UniformTilePolicy_Label.Enable(m_instance.p_skipUniformTiles);
+	GUI->UniformTilePolicy_ComboBox.Enable(m_instance.p_skipUniformTiles);
+	GUI->LiveDisplay_CheckBox.SetChecked(m_instance.p_liveDisplay);
+	GUI->LiveDisplayInterval_NumericControl.SetValue(m_instance.p_liveDisplayInterval);
+	GUI->LiveDisplayInterval_NumericControl.Enable(m_instance.p_liveDisplay);
+	GUI->UseTileCache_CheckBox.SetChecked(m_instance.p_useTileCache);
+	GUI->TileCacheSize_SpinBox.SetValue(m_instance.p_tileCacheSize);
+	GUI->TileCacheDiskSize_SpinBox.SetValue(m_instance.p_tileCacheDiskSize);
+	GUI->TileCacheDirectory_Edit.SetText(m_instance.p_tileCacheDirectory);
+	Settings::Write("TileCacheDirectory", m_instance.p_tileCacheDirectory);
+	GUI->TileCacheSize_Label.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheSize_SpinBox.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheDiskSize_Label.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheDiskSize_SpinBox.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheDirectory_Label.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheDirectory_Edit.Enable(m_instance.p_useTileCache);
+	GUI->TileCacheDirectory_ToolButton.Enable(m_instance.p_useTileCache);
+	GUI->UseTileStore_CheckBox.SetChecked(m_instance.p_useTileStore);
+	GUI->UseCheckpoints_CheckBox.SetChecked(m_instance.p_useCheckpoints);
+	GUI->CheckpointInterval_NumericControl.SetValue(m_instance.p_checkpointInterval);
+	GUI->CheckpointDirectory_Edit.SetText(m_instance.p_checkpointDirectory);
+	Settings::Write("CheckpointDirectory", m_instance.p_checkpointDirectory);
+	GUI->CheckpointInterval_NumericControl.Enable(m_instance.p_useCheckpoints);
+	GUI->CheckpointDirectory_Label.Enable(m_instance.p_useCheckpoints);
+	GUI->CheckpointDirectory_Edit.Enable(m_instance.p_useCheckpoints);
+	GUI->CheckpointDirectory_ToolButton.Enable(m_instance.p_useCheckpoints);
+	GUI->UseROI_CheckBox.SetChecked(m_instance.p_useROI);
+	GUI->ROIX0_SpinBox.SetValue(m_instance.p_roiX0);
+	GUI->ROIY0_SpinBox.SetValue(m_instance.p_roiY0);
+	GUI->ROIWidth_SpinBox.SetValue(m_instance.p_roiX1 - m_instance.p_roiX0);
+	GUI->ROIHeight_SpinBox.SetValue(m_instance.p_roiY1 - m_instance.p_roiY0);
+	GUI->ROIX0_Label.Enable(m_instance.p_useROI);
+	GUI->ROIX0_SpinBox.Enable(m_instance.p_useROI);
+	GUI->ROIY0_Label.Enable(m_instance.p_useROI);
+	GUI->ROIY0_SpinBox.Enable(m_instance.p_useROI);
+	GUI->ROIWidth_Label.Enable(m_instance.p_useROI);
+	GUI->ROIWidth_SpinBox.Enable(m_instance.p_useROI);
+	GUI->ROIHeight_Label.Enable(m_instance.p_useROI);
+	GUI->ROIHeight_SpinBox.Enable(m_instance.p_useROI);
+	GUI->ROISelectPreview_Button.Enable(m_instance.p_useROI);
+	UpdateInputFilesList();
+	GUI->OutputDirectory_Edit.SetText(m_instance.p_outputDirectory);
+	GUI->OutputPostfix_Edit.SetText(m_instance.p_outputPostfix);
+	GUI->OverwriteExistingFiles_CheckBox.SetChecked(m_instance.p_overwriteExistingFiles);
+	GUI->OutOfCore_CheckBox.SetChecked(m_instance.p_outOfCore);
+	UpdateRealTimePreview();
+}
+
+void TRTInferenceInterface::UpdateInputFilesList()
+{
+	int currentIdx = GUI->InputFiles_TreeBox.ChildIndex(GUI->InputFiles_TreeBox.CurrentNode());
+
+	GUI->InputFiles_TreeBox.DisableUpdates();
+	GUI->InputFiles_TreeBox.Clear();
+	for (const TRTInferenceInstance::InputFile& file : m_instance.p_inputFiles)
+	{
+		TreeBox::Node* node = new TreeBox::Node(GUI->InputFiles_TreeBox);
+		node->SetCheckable();
+		node->Check(file.enabled);
+		node->SetText(0, File::ExtractNameAndExtension(file.path));
+		node->SetToolTip(0, file.path);
+	}
+	if (!m_instance.p_inputFiles.IsEmpty())
+		if (currentIdx >= 0 && currentIdx < GUI->InputFiles_TreeBox.NumberOfChildren())
+			GUI->InputFiles_TreeBox.SetCurrentNode(GUI->InputFiles_TreeBox[currentIdx]);
+	GUI->InputFiles_TreeBox.EnableUpdates();
+}
+
+// Floating point copy of the central part of an image, at most width x height pixels
+static ImageVariant centralCrop(ImageVariant& image, int width, int height)
+{
+	Rect crop(Min(image.Width(), width), Min(image.Height(), height));
+	crop.MoveTo((image.Width() - crop.Width()) / 2, (image.Height() - crop.Height()) / 2);
+	image.SelectRectangle(crop);
+	ImageVariant cropImage;
+	cropImage.CreateFloatImage();
+	cropImage.AllocateImage(crop.Width(), crop.Height(), image.NumberOfChannels(), image.ColorSpace());
+	cropImage.CopyImage(image);
+	image.ResetSelections();
+	return cropImage;
+}
+
+void TRTInferenceInterface::Autotune()
+{
+	try
+	{
+		ImageWindow window = ImageWindow::ActiveWindow();
+		if (window.IsNull())
+			throw Error("Autotune runs on a crop of the active image. Open an image first.");
+		ImageVariant image = window.CurrentView().Image();
+
+		Console console;
+		console.Show();
+		console.WriteLn("<end><cbr><br>Autotuning " + m_instance.p_trtEngine);
+
+		// Opened as processing opens it, pipeline and bundle variant included, so the profile is saved under
+		// the engine hash processing looks up
+		std::unique_ptr<TRTEngine> engine = openEngineChain(m_instance.p_trtEngine, m_instance.p_pipelineEngines, m_instance.p_useInferenceServer,
+		                                                    image.Width(), image.Height(), uint64(m_instance.p_gpuMemoryBudget) << 20,
+		                                                    m_instance.p_tileOverlap);
+		String deviceKey = tuningDeviceKey(*engine);
+		if (deviceKey.IsEmpty())
+			throw Error("Only engines running in this process can be tuned. Disable Shared.");
+
+		// A central crop of about 4x4 tiles has the content of a typical image and runs in seconds
+		ImageVariant cropImage = centralCrop(image, 4 * engine->getInputTileW(), 4 * engine->getInputTileH());
+		const FImage& input = static_cast<const FImage&>(*cropImage);
+
+		int numPlanes = (engine->getNumberOfChannels() == 3) ? 3 : input.NumberOfChannels();
+		TRTTuningSpace space = tuningSpace(*engine, numPlanes);
+		std::vector<TRTTuningResult> results;
+		TRTTuning best = searchTuning(space, [&](const TRTTuning& tuning)
+		{
+			double seconds = benchmarkTuning(*engine, input, numPlanes, tuning, m_instance.p_tileOverlap, 64);
+			console.WriteLn(String().Format("%10.2f ms/tile  ", seconds * 1000) + tuning.toString());
+			Module->ProcessEvents();
+			return seconds;
+		}, results);
+
+		double defaultSeconds = results.front().secondsPerTile;
+		double bestSeconds = defaultSeconds;
+		for (const TRTTuningResult& result : results)
+			if (result.tuning.serialize() == best.serialize())
+				bestSeconds = result.secondsPerTile;
+
+		saveTuning(engine->getEngineHash(), deviceKey, best);
+		console.WriteLn("Fastest: " + best.toString() + String().Format(", %.2f ms/tile, %.0f%% of the default time",
+		                                                                  bestSeconds * 1000, 100 * bestSeconds / defaultSeconds));
+		console.WriteLn("Saved for " + deviceKey);
+		GUI->TuningStatus_Label.SetText(String().Format("%.2f ms/tile (%.0f%%): ", bestSeconds * 1000, 100 * bestSeconds / defaultSeconds) +
+		                                best.toString());
+	}
+	ERROR_HANDLER
+}
+
+void TRTInferenceInterface::ProfileLayers()
+{
+	try
+	{
+		ImageWindow window = ImageWindow::ActiveWindow();
+		if (window.IsNull())
+			throw Error("The layer profile runs on tiles of the active image. Open an image first.");
+		ImageVariant image = window.CurrentView().Image();
+
+		Console console;
+		console.Show();
+		console.WriteLn("<end><cbr><br>Profiling " + m_instance.p_trtEngine);
+
+		std::unique_ptr<TRTEngine> engine = openEngineChain(m_instance.p_trtEngine, m_instance.p_pipelineEngines, m_instance.p_useInferenceServer,
+		                                                    image.Width(), image.Height(), uint64(m_instance.p_gpuMemoryBudget) << 20,
+		                                                    m_instance.p_tileOverlap);
+		ImageVariant cropImage = centralCrop(image, 2 * engine->getInputTileW(), 2 * engine->getInputTileH());
+		const FImage& input = static_cast<const FImage&>(*cropImage);
+		int numPlanes = (engine->getNumberOfChannels() == 3) ? 3 : input.NumberOfChannels();
+
+		TRTLayerProfile profile;
+		profileEngine(*engine, input, numPlanes, 8, profile);
+		console.WriteLn("<raw>" + profile.formatTable() + "</raw>");
+
+		SaveFileDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Export Layer Profile");
+		d.AddFilter(FileFilter("JSON Files", ".json"));
+		d.SetInitialPath(File::ChangeExtension(m_instance.p_trtEngine, ".profile.json"));
+		if (d.Execute())
+		{
+			File::WriteTextFile(d.FileName(), profile.toJSON());
+			console.WriteLn("Layer profile written to " + d.FileName());
+		}
+	}
+	ERROR_HANDLER
+}
+
+void TRTInferenceInterface::__InputFiles_NodeUpdated(TreeBox& sender, TreeBox::Node& node, int col)
+{
+	int index = sender.ChildIndex(&node);
+	if (index >= 0 && size_type(index) < m_instance.p_inputFiles.Length())
+		m_instance.p_inputFiles[index].enabled = node.IsChecked();
 }
 
 void TRTInferenceInterface::__EditValueUpdated(NumericEdit& sender, double value)
 {
 	if (sender == GUI->TileOverlap_NumericControl)
 		m_instance.p_tileOverlap = value;
+	else if (sender == GUI->SeamErrorThreshold_NumericControl)
+		m_instance.p_seamErrorThreshold = value;
+	else if (sender == GUI->UniformTileTolerance_NumericControl)
+		m_instance.p_uniformTileTolerance = value;
+	else if (sender == GUI->LiveDisplayInterval_NumericControl)
+		m_instance.p_liveDisplayInterval = value;
+	else if (sender == GUI->CheckpointInterval_NumericControl)
+		m_instance.p_checkpointInterval = value;
+	UpdateRealTimePreview();
+}
+
+void TRTInferenceInterface::__SpinValueUpdated(SpinBox& sender, int value)
+{
+	if (sender == GUI->TileCacheSize_SpinBox)
+		m_instance.p_tileCacheSize = value;
+	else if (sender == GUI->TileBandHeight_SpinBox)
+		m_instance.p_tileBandHeight = value;
+	else if (sender == GUI->TileCacheDiskSize_SpinBox)
+		m_instance.p_tileCacheDiskSize = value;
+	else if (sender == GUI->GpuMemoryBudget_SpinBox)
+		m_instance.p_gpuMemoryBudget = value;
+	else if (sender == GUI->ROIX0_SpinBox)
+	{
+		// Keep the size when moving the origin
+		m_instance.p_roiX1 += value - m_instance.p_roiX0;
+		m_instance.p_roiX0 = value;
+	}
+	else if (sender == GUI->ROIY0_SpinBox)
+	{
+		m_instance.p_roiY1 += value - m_instance.p_roiY0;
+		m_instance.p_roiY0 = value;
+	}
+	else if (sender == GUI->ROIWidth_SpinBox)
+		m_instance.p_roiX1 = m_instance.p_roiX0 + value;
+	else if (sender == GUI->ROIHeight_SpinBox)
+		m_instance.p_roiY1 = m_instance.p_roiY0 + value;
+	UpdateRealTimePreview();
+}
+
+void TRTInferenceInterface::UpdateEngineCatalog()
+{
+	if (m_instance.p_trtEngine == m_catalogEnginePath)
+		return;
+	m_catalogEnginePath = m_instance.p_trtEngine;
+
+	if (m_instance.p_trtEngine.IsEmpty())
+	{
+		GUI->EngineCatalog_Timer.Stop();
+		m_catalog.reset();
+		GUI->EngineCatalog_ComboBox.Clear();
+		GUI->EngineInfoText_Label.Clear();
+		return;
+	}
+
+	// Engines are described on a worker thread; the index lists them meanwhile
+	String directory = TRTEngineCatalog::directoryOf(m_instance.p_trtEngine);
+	if (!m_catalog || (m_catalog->directory() != directory))
+		m_catalog = std::make_unique<TRTEngineCatalog>(directory);
+	m_catalog->startRefresh();
+	ListEngineCatalog();
+	GUI->EngineCatalog_Timer.Start();
+}
+
+void TRTInferenceInterface::ListEngineCatalog()
+{
+	GUI->EngineCatalog_ComboBox.Clear();
+	GUI->EngineInfoText_Label.Clear();
+	if (!m_catalog)
+		return;
+
+	const TRTEngineInfo* selected = m_catalog->find(m_instance.p_trtEngine);
+	for (const TRTEngineInfo& info : m_catalog->engines())
+	{
+		GUI->EngineCatalog_ComboBox.AddItem(info.fileName);
+		if (&info == selected)
+			GUI->EngineCatalog_ComboBox.SetCurrentItem(GUI->EngineCatalog_ComboBox.NumberOfItems() - 1);
+	}
+	if (selected != nullptr)
+		GUI->EngineInfoText_Label.SetText(selected->summary());
+	else if (m_catalog->refreshing())
+		GUI->EngineInfoText_Label.SetText("Looking into the engines of the directory...");
+	else
+		GUI->EngineInfoText_Label.SetText("Not an engine file, or not found.");
+}
+
+void TRTInferenceInterface::__EngineCatalog_Timer(Timer& sender)
+{
+	if (!m_catalog || !m_catalog->refreshing())
+	{
+		GUI->EngineCatalog_Timer.Stop();
+		return;
+	}
+
+	try
+	{
+		if (!m_catalog->finishRefresh())
+			return;
+		ListEngineCatalog();
+	}
+	catch (const Error& x)
+	{
+		m_catalog.reset();
+		ListEngineCatalog();
+		GUI->EngineInfoText_Label.SetText(x.Message());
+	}
+	GUI->EngineCatalog_Timer.Stop();
+}
+
+void TRTInferenceInterface::__ItemSelected(ComboBox& sender, int itemIndex)
+{
+	if (sender == GUI->EngineCatalog_ComboBox)
+	{
+		if (m_catalog && (itemIndex >= 0) && (itemIndex < int(m_catalog->engines().size())))
+		{
+			m_instance.p_trtEngine = m_catalog->directory() + '/' + m_catalog->engines()[itemIndex].fileName;
+			UpdateControls();
+		}
+	}
+	else if (sender == GUI->UniformTilePolicy_ComboBox)
+		m_instance.p_uniformTilePolicy = itemIndex;
+	else if (sender == GUI->BlendMode_ComboBox)
+		m_instance.p_blendMode = itemIndex;
+	else if (sender == GUI->TileOrder_ComboBox)
+	{
+		m_instance.p_tileOrder = itemIndex;
+		UpdateControls();
+	}
+	UpdateRealTimePreview();
 }
 
 void TRTInferenceInterface::__Click(Button& sender, bool checked)
@@ -119,18 +581,184 @@ void TRTInferenceInterface::__Click(Button& sender, bool checked)
 		OpenFileDialog d;
 		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Select TensorRT Engine");
 		d.AddFilter(FileFilter("TensorRT Engine Files", ".trt"));
+		d.AddFilter(FileFilter("Engine Bundles", ".trtb"));
+		d.AddFilter(FileFilter("ONNX Models", ".onnx"));
 		d.AddFilter(FileFilter("Any Files", "*"));
 		d.DisableMultipleSelections();
 		if (d.Execute())
 		{
 			m_instance.p_trtEngine = d.FileName();
+			// Browsing rescans the directory even when the same engine is selected again
+			m_catalogEnginePath.Clear();
 			UpdateControls();
 		}
 	}
+	else if (sender == GUI->PipelineEngines_ToolButton)
+	{
+		OpenFileDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Append Pipeline Engine");
+		d.AddFilter(FileFilter("TensorRT Engine Files", ".trt"));
+		d.AddFilter(FileFilter("Engine Bundles", ".trtb"));
+		d.AddFilter(FileFilter("ONNX Models", ".onnx"));
+		d.AddFilter(FileFilter("Any Files", "*"));
+		d.DisableMultipleSelections();
+		if (d.Execute())
+		{
+			String engines = m_instance.p_pipelineEngines.Trimmed();
+			if (!engines.IsEmpty())
+				engines << "; ";
+			m_instance.p_pipelineEngines = engines + d.FileName();
+			UpdateControls();
+		}
+	}
+	else if (sender == GUI->UseInferenceServer_CheckBox)
+	{
+		m_instance.p_useInferenceServer = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->UseTuningProfile_CheckBox)
+	{
+		m_instance.p_useTuningProfile = checked;
+	}
+	else if (sender == GUI->Autotune_PushButton)
+	{
+		Autotune();
+	}
+	else if (sender == GUI->ProfileLayers_PushButton)
+	{
+		ProfileLayers();
+	}
+	else if (sender == GUI->AutoTileOverlap_CheckBox)
+	{
+		m_instance.p_autoTileOverlap = checked;
+		UpdateControls();
+	}
 	else if (sender == GUI->KeepOutputDimension_CheckBox)
 	{
 		m_instance.p_keepOutputDimension = checked;
+		UpdateControls();
 	}
+	else if (sender == GUI->BinInput_CheckBox)
+	{
+		m_instance.p_binInput = checked;
+	}
+	else if (sender == GUI->MonoChannelAverage_CheckBox)
+	{
+		m_instance.p_monoChannelAverage = checked;
+	}
+	else if (sender == GUI->SkipUniformTiles_CheckBox)
+	{
+		m_instance.p_skipUniformTiles = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->LiveDisplay_CheckBox)
+	{
+		m_instance.p_liveDisplay = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->UseTileCache_CheckBox)
+	{
+		m_instance.p_useTileCache = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->UseTileStore_CheckBox)
+	{
+		m_instance.p_useTileStore = checked;
+	}
+	else if (sender == GUI->UseCheckpoints_CheckBox)
+	{
+		m_instance.p_useCheckpoints = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->CheckpointDirectory_ToolButton)
+	{
+		GetDirectoryDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Select Checkpoint Directory");
+		if (d.Execute())
+		{
+			m_instance.p_checkpointDirectory = d.Directory();
+			UpdateControls();
+		}
+	}
+	else if (sender == GUI->UseROI_CheckBox)
+	{
+		m_instance.p_useROI = checked;
+		UpdateControls();
+	}
+	else if (sender == GUI->ROISelectPreview_Button)
+	{
+		PreviewSelectionDialog d;
+		if (d.Execute())
+			if (!d.Id().IsEmpty())
+			{
+				View view = View::ViewById(d.Id());
+				if (!view.IsNull())
+				{
+					Rect rect = view.Window().PreviewRect(view.Id());
+					m_instance.p_roiX0 = rect.x0;
+					m_instance.p_roiY0 = rect.y0;
+					m_instance.p_roiX1 = rect.x1;
+					m_instance.p_roiY1 = rect.y1;
+					UpdateControls();
+				}
+			}
+	}
+	else if (sender == GUI->AddFiles_PushButton)
+	{
+		OpenFileDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Select Input Files");
+		d.LoadImageFilters();
+		d.EnableMultipleSelections();
+		if (d.Execute())
+		{
+			for (const String& fileName : d.FileNames())
+				m_instance.p_inputFiles.Add(TRTInferenceInstance::InputFile(fileName));
+			UpdateInputFilesList();
+		}
+	}
+	else if (sender == GUI->RemoveFiles_PushButton)
+	{
+		Array<TRTInferenceInstance::InputFile> files;
+		for (int i = 0, n = GUI->InputFiles_TreeBox.NumberOfChildren(); i < n; i++)
+			if (!GUI->InputFiles_TreeBox[i]->IsSelected())
+				files.Add(m_instance.p_inputFiles[i]);
+		m_instance.p_inputFiles = files;
+		UpdateInputFilesList();
+	}
+	else if (sender == GUI->ClearFiles_PushButton)
+	{
+		m_instance.p_inputFiles.Clear();
+		UpdateInputFilesList();
+	}
+	else if (sender == GUI->OverwriteExistingFiles_CheckBox)
+	{
+		m_instance.p_overwriteExistingFiles = checked;
+	}
+	else if (sender == GUI->OutOfCore_CheckBox)
+	{
+		m_instance.p_outOfCore = checked;
+	}
+	else if (sender == GUI->OutputDirectory_ToolButton)
+	{
+		GetDirectoryDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Select Output Directory");
+		if (d.Execute())
+		{
+			m_instance.p_outputDirectory = d.Directory();
+			UpdateControls();
+		}
+	}
+	else if (sender == GUI->TileCacheDirectory_ToolButton)
+	{
+		GetDirectoryDialog d;
+		d.SetCaption(String(TRTInferenceProcess::MODULE_NAME) + ": Select Tile Cache Directory");
+		if (d.Execute())
+		{
+			m_instance.p_tileCacheDirectory = d.Directory();
+			UpdateControls();
+		}
+	}
+	UpdateRealTimePreview();
 }
 
 void TRTInferenceInterface::__EditCompleted(Edit& sender)
@@ -140,6 +768,18 @@ void TRTInferenceInterface::__EditCompleted(Edit& sender)
 		String filePath = sender.Text().Trimmed();
 		if (sender == GUI->TRTEngine_Edit)
 			m_instance.p_trtEngine = filePath;
+		else if (sender == GUI->PipelineEngines_Edit)
+			m_instance.p_pipelineEngines = filePath;
+		else if (sender == GUI->TileCacheDirectory_Edit)
+			m_instance.p_tileCacheDirectory = filePath;
+		else if (sender == GUI->CheckpointDirectory_Edit)
+			m_instance.p_checkpointDirectory = filePath;
+		else if (sender == GUI->OutputDirectory_Edit)
+			m_instance.p_outputDirectory = filePath;
+		else if (sender == GUI->OutputPostfix_Edit)
+			m_instance.p_outputPostfix = filePath;
+		else if (sender == GUI->TileFarmWorkers_Edit)
+			m_instance.p_tileFarmWorkers = filePath;
 		UpdateControls();
 	}
 	ERROR_CLEANUP(
@@ -170,13 +810,153 @@ TRTInferenceInterface::GUIData::GUIData(TRTInferenceInterface& w)
 	TRTEngine_ToolButton.SetToolTip("<p>Select TensorRT Engine</p>");
 	TRTEngine_ToolButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
 
+	UseInferenceServer_CheckBox.SetText("Shared");
+	UseInferenceServer_CheckBox.SetToolTip("<p>Run the engine in the inference server, which keeps engines loaded between "
+										   "executions and shares the GPU fairly among the PixInsight instances of this workstation.</p>"
+										   "<p>Start TRTInferenceServer first. If no server is running, the engine is loaded in this "
+										   "process as usual.</p>");
+	UseInferenceServer_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
 	TRTEngine_Sizer.SetSpacing(4);
 	TRTEngine_Sizer.Add(TRTEngine_Label);
 	TRTEngine_Sizer.Add(TRTEngine_Edit, 100);
 	TRTEngine_Sizer.Add(TRTEngine_ToolButton);
+	TRTEngine_Sizer.AddSpacing(8);
+	TRTEngine_Sizer.Add(UseInferenceServer_CheckBox);
 	TRTEngine_Sizer.AddStretch();
 
-	TRTEngine_Control.SetSizer(TRTEngine_Sizer);
+	const char* pipelineEnginesToolTip = "<p>Engines to run after the TensorRT engine, separated by semicolons. Each tile "
+										 "goes through all of them in turn and only the output of the last one is written "
+										 "to the image, so a denoise-then-upscale chain needs no intermediate image.</p>"
+										 "<p>An engine whose tile differs from the output of the previous one runs over it "
+										 "in tiles of its own, with the tile overlap below. Automatic tile overlap is "
+										 "recommended, since chained engines see farther than each of them alone.</p>"
+										 "<p>Leave empty to run the TensorRT engine alone.</p>";
+
+	PipelineEngines_Label.SetText("Then Run:");
+	PipelineEngines_Label.SetFixedWidth(labelWidth1);
+	PipelineEngines_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	PipelineEngines_Label.SetToolTip(pipelineEnginesToolTip);
+
+	PipelineEngines_Edit.SetToolTip(pipelineEnginesToolTip);
+	PipelineEngines_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	PipelineEngines_ToolButton.SetIcon(w.ScaledResource(":/browser/select-file.png"));
+	PipelineEngines_ToolButton.SetScaledFixedSize(20, 20);
+	PipelineEngines_ToolButton.SetToolTip("<p>Append an engine to the pipeline</p>");
+	PipelineEngines_ToolButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	PipelineEngines_Sizer.SetSpacing(4);
+	PipelineEngines_Sizer.Add(PipelineEngines_Label);
+	PipelineEngines_Sizer.Add(PipelineEngines_Edit, 100);
+	PipelineEngines_Sizer.Add(PipelineEngines_ToolButton);
+
+	const char* engineCatalogToolTip = "<p>Engines and ONNX models found next to the selected engine, with their "
+		"properties. These are recorded in a TRTInference.index file in the directory, so engines are only looked into "
+		"once, when they are new or have changed. For engine bundles, the variants of the bundle are listed.</p>";
+
+	EngineCatalog_Label.SetText("Engines:");
+	EngineCatalog_Label.SetFixedWidth(labelWidth1);
+	EngineCatalog_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	EngineCatalog_Label.SetToolTip(engineCatalogToolTip);
+
+	EngineCatalog_ComboBox.SetToolTip(engineCatalogToolTip);
+	EngineCatalog_ComboBox.OnItemSelected((ComboBox::item_event_handler)&TRTInferenceInterface::__ItemSelected, w);
+
+	EngineCatalog_Sizer.SetSpacing(4);
+	EngineCatalog_Sizer.Add(EngineCatalog_Label);
+	EngineCatalog_Sizer.Add(EngineCatalog_ComboBox, 100);
+
+	EngineInfo_Label.SetText("Properties:");
+	EngineInfo_Label.SetFixedWidth(labelWidth1);
+	EngineInfo_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	EngineInfo_Label.SetToolTip(engineCatalogToolTip);
+
+	EngineInfoText_Label.SetTextAlignment(TextAlign::Left | TextAlign::VertCenter);
+	EngineInfoText_Label.EnableWordWrapping();
+	EngineInfoText_Label.SetToolTip(engineCatalogToolTip);
+
+	EngineInfo_Sizer.SetSpacing(4);
+	EngineInfo_Sizer.Add(EngineInfo_Label);
+	EngineInfo_Sizer.Add(EngineInfoText_Label, 100);
+
+	const char* backendToolTip = "<p>Inference runtime of this workstation. The TensorRT and CUDA runtime libraries are "
+		"loaded at the first inference. When they cannot be found, engines can still run through the inference server "
+		"or a tile farm.</p>";
+
+	Backend_Label.SetText("Backend:");
+	Backend_Label.SetFixedWidth(labelWidth1);
+	Backend_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	Backend_Label.SetToolTip(backendToolTip);
+
+	BackendStatus_Label.SetTextAlignment(TextAlign::Left | TextAlign::VertCenter);
+	BackendStatus_Label.SetToolTip(backendToolTip);
+
+	const char* gpuMemoryBudgetToolTip = "<p>Device memory the engine may use, in MiB. From an engine bundle (.trtb), "
+		"the best variant for the GPU and the image that fits in this budget is loaded. Free uses the memory currently free "
+		"on the GPU.</p>";
+
+	GpuMemoryBudget_Label.SetText("GPU Memory (MiB):");
+	GpuMemoryBudget_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	GpuMemoryBudget_Label.SetToolTip(gpuMemoryBudgetToolTip);
+
+	GpuMemoryBudget_SpinBox.SetRange(int(TheTRTInferenceGpuMemoryBudgetParameter->MinimumValue()), int(TheTRTInferenceGpuMemoryBudgetParameter->MaximumValue()));
+	GpuMemoryBudget_SpinBox.SetMinimumValueText("Free");
+	GpuMemoryBudget_SpinBox.SetToolTip(gpuMemoryBudgetToolTip);
+	GpuMemoryBudget_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	Backend_Sizer.SetSpacing(4);
+	Backend_Sizer.Add(Backend_Label);
+	Backend_Sizer.Add(BackendStatus_Label, 100);
+	Backend_Sizer.AddSpacing(8);
+	Backend_Sizer.Add(GpuMemoryBudget_Label);
+	Backend_Sizer.Add(GpuMemoryBudget_SpinBox);
+
+	const char* tuningToolTip = "<p>Tile batch size, output placement threads, tiles in flight and, for ONNX models, CPU "
+		"threads that run the engine fastest on this machine. Autotune benchmarks them on a crop of the active image, "
+		"at the current tile overlap, and keeps the fastest ones in a profile of the engine and device. Tuned settings "
+		"change the speed of a run, never its result.</p>";
+
+	Tuning_Label.SetText("Tuning:");
+	Tuning_Label.SetFixedWidth(labelWidth1);
+	Tuning_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	Tuning_Label.SetToolTip(tuningToolTip);
+
+	UseTuningProfile_CheckBox.SetText("Use tuned settings");
+	UseTuningProfile_CheckBox.SetToolTip(tuningToolTip);
+	UseTuningProfile_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	TuningStatus_Label.SetTextAlignment(TextAlign::Left | TextAlign::VertCenter);
+	TuningStatus_Label.SetToolTip(tuningToolTip);
+
+	Autotune_PushButton.SetText("Autotune");
+	Autotune_PushButton.SetToolTip(tuningToolTip);
+	Autotune_PushButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	ProfileLayers_PushButton.SetText("Profile Layers");
+	ProfileLayers_PushButton.SetToolTip("<p>Times each layer of a TensorRT engine over a few tiles of the active image, prints the "
+										"layers by decreasing cost to the console, and offers to export the table as JSON, in the format "
+										"of trtexec --exportProfile.</p><p>Engines built with --profilingVerbosity=detailed report the "
+										"names of their layers.</p>");
+	ProfileLayers_PushButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	Tuning_Sizer.SetSpacing(4);
+	Tuning_Sizer.Add(Tuning_Label);
+	Tuning_Sizer.Add(UseTuningProfile_CheckBox);
+	Tuning_Sizer.AddSpacing(8);
+	Tuning_Sizer.Add(TuningStatus_Label, 100);
+	Tuning_Sizer.Add(Autotune_PushButton);
+	Tuning_Sizer.Add(ProfileLayers_PushButton);
+
+	Engine_Sizer.SetSpacing(4);
+	Engine_Sizer.Add(TRTEngine_Sizer);
+	Engine_Sizer.Add(PipelineEngines_Sizer);
+	Engine_Sizer.Add(EngineCatalog_Sizer);
+	Engine_Sizer.Add(EngineInfo_Sizer);
+	Engine_Sizer.Add(Backend_Sizer);
+	Engine_Sizer.Add(Tuning_Sizer);
+
+	TRTEngine_Control.SetSizer(Engine_Sizer);
 
 	TileOverlap_NumericControl.label.SetText("Tile Overlap:");
 	TileOverlap_NumericControl.label.SetFixedWidth(labelWidth1);
@@ -190,22 +970,469 @@ TRTInferenceInterface::GUIData::GUIData(TRTInferenceInterface& w)
 		                                  "<p>The image is processed in tiles, with overlap and feathering among the adjacent tiles to reduce artifacts at tile edges.</p>");
 	TileOverlap_NumericControl.OnValueUpdated((NumericEdit::value_event_handler)&TRTInferenceInterface::__EditValueUpdated, w);
 
+	AutoTileOverlap_CheckBox.SetText("Automatic Tile Overlap");
+	AutoTileOverlap_CheckBox.SetToolTip("<p>Before processing, probe a few pairs of adjacent tiles of the image at increasing overlaps, "
+										"and use the smallest overlap at which the two tiles of each pair agree where their seam falls.</p>"
+										"<p>Engines that see little context around each pixel then run with fewer tiles. The selected overlap "
+										"and the change in the number of tiles are shown in the console. Tile Overlap still applies to "
+										"out-of-core processing and the real-time preview.</p>");
+	AutoTileOverlap_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	SeamErrorThreshold_NumericControl.label.SetText("Seam Error:");
+	SeamErrorThreshold_NumericControl.label.SetFixedWidth(labelWidth1);
+	SeamErrorThreshold_NumericControl.slider.SetRange(1, 1000);
+	SeamErrorThreshold_NumericControl.slider.SetScaledMinWidth(300);
+	SeamErrorThreshold_NumericControl.SetReal();
+	SeamErrorThreshold_NumericControl.SetRange(TheTRTInferenceSeamErrorThresholdParameter->MinimumValue(), TheTRTInferenceSeamErrorThresholdParameter->MaximumValue());
+	SeamErrorThreshold_NumericControl.SetPrecision(TheTRTInferenceSeamErrorThresholdParameter->Precision());
+	SeamErrorThreshold_NumericControl.edit.SetFixedWidth(editWidth1);
+	SeamErrorThreshold_NumericControl.SetToolTip("<p>Largest mean difference between two adjacent tiles along their seam, in the [0,1] "
+												 "sample range, accepted by the automatic tile overlap.</p>");
+	SeamErrorThreshold_NumericControl.OnValueUpdated((NumericEdit::value_event_handler)&TRTInferenceInterface::__EditValueUpdated, w);
+
+	const char* blendModeToolTip = "<p>How overlapping output tiles are stitched together.</p>"
+		"<p><b>Weighted</b> blends the overlapping parts of adjacent tiles with a feathered window.</p>"
+		"<p><b>Center Crop</b> keeps only the central part of each tile, so every output pixel is written exactly once. "
+		"This is faster and needs less memory, and works as well as blending for engines with a large receptive field.</p>";
+
+	BlendMode_Label.SetText("Blend Mode:");
+	BlendMode_Label.SetFixedWidth(labelWidth1);
+	BlendMode_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	BlendMode_Label.SetToolTip(blendModeToolTip);
+
+	BlendMode_ComboBox.AddItem("Weighted");
+	BlendMode_ComboBox.AddItem("Center Crop");
+	BlendMode_ComboBox.SetToolTip(blendModeToolTip);
+	BlendMode_ComboBox.OnItemSelected((ComboBox::item_event_handler)&TRTInferenceInterface::__ItemSelected, w);
+
+	BlendMode_Sizer.SetSpacing(4);
+	BlendMode_Sizer.Add(BlendMode_Label);
+	BlendMode_Sizer.Add(BlendMode_ComboBox);
+	BlendMode_Sizer.AddStretch();
+
+	const char* tileOrderToolTip = "<p>Order in which tiles are processed.</p>"
+		"<p><b>Raster</b> goes row by row, left to right.</p>"
+		"<p><b>Serpentine</b> reverses every other row, so consecutive tiles are always adjacent.</p>"
+		"<p><b>Z-Order</b> follows a space-filling curve, keeping recently used parts of the image close in both directions.</p>"
+		"<p><b>Band-Major</b> goes column by column within bands of several rows of tiles, so the output rows "
+		"in use are limited to one band.</p>"
+		"<p>With the weighted blend mode, the order of the additions changes, so results may differ in the last bits.</p>"
+		"<p>Out-of-core batch processing always uses raster order.</p>";
+
+	TileOrder_Label.SetText("Tile Order:");
+	TileOrder_Label.SetFixedWidth(labelWidth1);
+	TileOrder_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileOrder_Label.SetToolTip(tileOrderToolTip);
+
+	TileOrder_ComboBox.AddItem("Raster");
+	TileOrder_ComboBox.AddItem("Serpentine");
+	TileOrder_ComboBox.AddItem("Z-Order");
+	TileOrder_ComboBox.AddItem("Band-Major");
+	TileOrder_ComboBox.SetToolTip(tileOrderToolTip);
+	TileOrder_ComboBox.OnItemSelected((ComboBox::item_event_handler)&TRTInferenceInterface::__ItemSelected, w);
+
+	TileBandHeight_Label.SetText("Band Height:");
+	TileBandHeight_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileBandHeight_SpinBox.SetRange(int(TheTRTInferenceTileBandHeightParameter->MinimumValue()), int(TheTRTInferenceTileBandHeightParameter->MaximumValue()));
+	TileBandHeight_SpinBox.SetToolTip("<p>Rows of tiles in a band of the band-major order.</p>");
+	TileBandHeight_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	TileOrder_Sizer.SetSpacing(4);
+	TileOrder_Sizer.Add(TileOrder_Label);
+	TileOrder_Sizer.Add(TileOrder_ComboBox);
+	TileOrder_Sizer.AddSpacing(8);
+	TileOrder_Sizer.Add(TileBandHeight_Label);
+	TileOrder_Sizer.Add(TileBandHeight_SpinBox);
+	TileOrder_Sizer.AddStretch();
+
+	const char* tileFarmWorkersToolTip = "<p>Comma-separated host:port addresses of the worker nodes of a tile farm, "
+		"for example <i>gpu1:7070, gpu2:7070</i>. Each node runs TRTInferenceServer with the --port, --bind and "
+		"--engine options, and serves the engine it was started with instead of the engine selected here.</p>"
+		"<p>When set, the tiles of the image are spread over the workers, and this instance only extracts and "
+		"blends them. Workers that fail are left out and their tiles are processed by the others.</p>"
+		"<p>Leave empty to run the engine on this workstation.</p>";
+
+	TileFarmWorkers_Label.SetText("Tile Farm:");
+	TileFarmWorkers_Label.SetFixedWidth(labelWidth1);
+	TileFarmWorkers_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileFarmWorkers_Label.SetToolTip(tileFarmWorkersToolTip);
+
+	TileFarmWorkers_Edit.SetToolTip(tileFarmWorkersToolTip);
+	TileFarmWorkers_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	TileFarmWorkers_Sizer.SetSpacing(4);
+	TileFarmWorkers_Sizer.Add(TileFarmWorkers_Label);
+	TileFarmWorkers_Sizer.Add(TileFarmWorkers_Edit, 100);
+
 	KeepOutputDimension_CheckBox.SetText("Keep Output Dimension");
 	KeepOutputDimension_CheckBox.SetToolTip("<p>This is for the AI models with scale-up ratio on the output tensors.</p>"
 											"<p>When enabled, the scale-up will be reflected in the result.</p>"
 										    "<p>When disabled, resampling will be applied to the output so the result will have the original dimension.</p>");
 	KeepOutputDimension_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
 
+	BinInput_CheckBox.SetText("Same-Size Fast Mode");
+	BinInput_CheckBox.SetToolTip("<p>For AI models with scale-up ratio, when Keep Output Dimension is disabled.</p>"
+								 "<p>The input is binned by the scale-up ratio before processing, so the engine output already has the "
+								 "original dimension. This needs about 1/ratio<sup>2</sup> of the tiles, but detail finer than the binned "
+								 "resolution cannot be recovered and the result is softer.</p>");
+	BinInput_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	MonoChannelAverage_CheckBox.SetText("Average Mono Output");
+	MonoChannelAverage_CheckBox.SetToolTip("<p>For grayscale images processed by a 3-channel engine, accumulate only the average of the "
+										   "output channels instead of all three channels.</p>"
+										   "<p>This reduces the memory and time spent on blending to a third. When disabled, the RGB output is "
+										   "converted to grayscale by its CIE L* component.</p>");
+	MonoChannelAverage_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	SkipUniformTiles_CheckBox.SetText("Skip Uniform Tiles");
+	SkipUniformTiles_CheckBox.SetToolTip("<p>Detect tiles whose input is constant, such as the black borders of mosaics and registered stacks, "
+										 "and do not send them through the engine.</p>");
+	SkipUniformTiles_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	UniformTileTolerance_NumericControl.label.SetText("Uniform Tolerance:");
+	UniformTileTolerance_NumericControl.label.SetFixedWidth(labelWidth1);
+	UniformTileTolerance_NumericControl.slider.SetRange(0, 100);
+	UniformTileTolerance_NumericControl.slider.SetScaledMinWidth(300);
+	UniformTileTolerance_NumericControl.SetReal();
+	UniformTileTolerance_NumericControl.SetRange(TheTRTInferenceUniformTileToleranceParameter->MinimumValue(), TheTRTInferenceUniformTileToleranceParameter->MaximumValue());
+	UniformTileTolerance_NumericControl.SetPrecision(TheTRTInferenceUniformTileToleranceParameter->Precision());
+	UniformTileTolerance_NumericControl.edit.SetFixedWidth(editWidth1);
+	UniformTileTolerance_NumericControl.SetToolTip("<p>Maximum difference between the smallest and largest sample of each channel for a tile to be considered uniform.</p>");
+	UniformTileTolerance_NumericControl.OnValueUpdated((NumericEdit::value_event_handler)&TRTInferenceInterface::__EditValueUpdated, w);
+
+	const char* uniformTilePolicyToolTip = "<p>Output used for uniform tiles.</p>"
+		"<p><b>Passthrough</b> copies the input tile to the output.</p>"
+		"<p><b>Zero</b> fills the output tile with zeros.</p>"
+		"<p><b>Cached Response</b> runs the engine once for each distinct uniform level and reuses its output for all tiles of the same level.</p>";
+
+	UniformTilePolicy_Label.SetText("Uniform Tiles:");
+	UniformTilePolicy_Label.SetFixedWidth(labelWidth1);
+	UniformTilePolicy_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	UniformTilePolicy_Label.SetToolTip(uniformTilePolicyToolTip);
+
+	UniformTilePolicy_ComboBox.AddItem("Passthrough");
+	UniformTilePolicy_ComboBox.AddItem("Zero");
+	UniformTilePolicy_ComboBox.AddItem("Cached Response");
+	UniformTilePolicy_ComboBox.SetToolTip(uniformTilePolicyToolTip);
+	UniformTilePolicy_ComboBox.OnItemSelected((ComboBox::item_event_handler)&TRTInferenceInterface::__ItemSelected, w);
+
+	UniformTilePolicy_Sizer.SetSpacing(4);
+	UniformTilePolicy_Sizer.Add(UniformTilePolicy_Label);
+	UniformTilePolicy_Sizer.Add(UniformTilePolicy_ComboBox);
+	UniformTilePolicy_Sizer.AddStretch();
+
+	LiveDisplay_CheckBox.SetText("Live Display");
+	LiveDisplay_CheckBox.SetToolTip("<p>Show the finished part of the output in a temporary image window while the tiles are being "
+									"processed, so a wrong engine or setting can be spotted early in a long run.</p>"
+									"<p>The window is reduced to at most 4096 pixels and closed when the run completes.</p>");
+	LiveDisplay_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	LiveDisplayInterval_NumericControl.label.SetText("Display Interval:");
+	LiveDisplayInterval_NumericControl.label.SetFixedWidth(labelWidth1);
+	LiveDisplayInterval_NumericControl.slider.SetRange(1, 300);
+	LiveDisplayInterval_NumericControl.slider.SetScaledMinWidth(300);
+	LiveDisplayInterval_NumericControl.SetReal();
+	LiveDisplayInterval_NumericControl.SetRange(TheTRTInferenceLiveDisplayIntervalParameter->MinimumValue(), TheTRTInferenceLiveDisplayIntervalParameter->MaximumValue());
+	LiveDisplayInterval_NumericControl.SetPrecision(TheTRTInferenceLiveDisplayIntervalParameter->Precision());
+	LiveDisplayInterval_NumericControl.edit.SetFixedWidth(editWidth1);
+	LiveDisplayInterval_NumericControl.SetToolTip("<p>Minimum time in seconds between two updates of the live display.</p>");
+	LiveDisplayInterval_NumericControl.OnValueUpdated((NumericEdit::value_event_handler)&TRTInferenceInterface::__EditValueUpdated, w);
+
 	Inference_Sizer.SetSpacing(4);
 	Inference_Sizer.Add(TileOverlap_NumericControl);
+	Inference_Sizer.Add(AutoTileOverlap_CheckBox);
+	Inference_Sizer.Add(SeamErrorThreshold_NumericControl);
+	Inference_Sizer.Add(BlendMode_Sizer);
+	Inference_Sizer.Add(TileOrder_Sizer);
+	Inference_Sizer.Add(TileFarmWorkers_Sizer);
 	Inference_Sizer.Add(KeepOutputDimension_CheckBox);
+	Inference_Sizer.Add(BinInput_CheckBox);
+	Inference_Sizer.Add(MonoChannelAverage_CheckBox);
+	Inference_Sizer.Add(SkipUniformTiles_CheckBox);
+	Inference_Sizer.Add(UniformTileTolerance_NumericControl);
+	Inference_Sizer.Add(UniformTilePolicy_Sizer);
+	Inference_Sizer.Add(LiveDisplay_CheckBox);
+	Inference_Sizer.Add(LiveDisplayInterval_NumericControl);
 
 	Inference_Control.SetSizer(Inference_Sizer);
 
+	UseTileCache_CheckBox.SetText("Use Tile Cache");
+	UseTileCache_CheckBox.SetToolTip("<p>Keep the engine output of every tile, keyed by the engine, the tile geometry and the input tile data.</p>"
+									 "<p>Running the same engine again on the same image, for example after changing only the output options, "
+									 "serves the unchanged tiles from the cache instead of running inference.</p>");
+	UseTileCache_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	TileCacheSize_Label.SetText("Memory (MiB):");
+	TileCacheSize_Label.SetFixedWidth(labelWidth1);
+	TileCacheSize_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileCacheSize_SpinBox.SetRange(int(TheTRTInferenceTileCacheSizeParameter->MinimumValue()), int(TheTRTInferenceTileCacheSizeParameter->MaximumValue()));
+	TileCacheSize_SpinBox.SetToolTip("<p>Maximum memory used by cached tiles.</p>");
+	TileCacheSize_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	TileCacheDiskSize_Label.SetText("Disk (MiB):");
+	TileCacheDiskSize_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileCacheDiskSize_SpinBox.SetRange(int(TheTRTInferenceTileCacheDiskSizeParameter->MinimumValue()), int(TheTRTInferenceTileCacheDiskSizeParameter->MaximumValue()));
+	TileCacheDiskSize_SpinBox.SetToolTip("<p>Maximum disk space used by tiles spilled to the tile cache directory.</p>");
+	TileCacheDiskSize_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	TileCacheSize_Sizer.SetSpacing(4);
+	TileCacheSize_Sizer.Add(TileCacheSize_Label);
+	TileCacheSize_Sizer.Add(TileCacheSize_SpinBox);
+	TileCacheSize_Sizer.AddSpacing(8);
+	TileCacheSize_Sizer.Add(TileCacheDiskSize_Label);
+	TileCacheSize_Sizer.Add(TileCacheDiskSize_SpinBox);
+	TileCacheSize_Sizer.AddStretch();
+
+	const char* tileCacheDirectoryToolTip = "<p>Directory receiving tiles evicted from memory. They are reused by later executions, "
+		"also in later sessions. Leave empty to keep the cache in memory only.</p>";
+
+	TileCacheDirectory_Label.SetText("Spill Directory:");
+	TileCacheDirectory_Label.SetFixedWidth(labelWidth1);
+	TileCacheDirectory_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	TileCacheDirectory_Label.SetToolTip(tileCacheDirectoryToolTip);
+
+	TileCacheDirectory_Edit.SetToolTip(tileCacheDirectoryToolTip);
+	TileCacheDirectory_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	TileCacheDirectory_ToolButton.SetIcon(w.ScaledResource(":/browser/select-file.png"));
+	TileCacheDirectory_ToolButton.SetScaledFixedSize(20, 20);
+	TileCacheDirectory_ToolButton.SetToolTip("<p>Select tile cache directory</p>");
+	TileCacheDirectory_ToolButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	TileCacheDirectory_Sizer.SetSpacing(4);
+	TileCacheDirectory_Sizer.Add(TileCacheDirectory_Label);
+	TileCacheDirectory_Sizer.Add(TileCacheDirectory_Edit, 100);
+	TileCacheDirectory_Sizer.Add(TileCacheDirectory_ToolButton);
+
+	UseTileStore_CheckBox.SetText("Use Tile Store");
+	UseTileStore_CheckBox.SetToolTip("<p>Record the raw engine output of every tile, before blending, in a memory-mapped tile store file "
+									 "next to the image (or in the temporary directory for unsaved images).</p>"
+									 "<p>A later execution on the same image with the same engine and tile plan only redoes the blending and "
+									 "finalization, so output options such as Keep Output Dimension can be changed without running inference again.</p>");
+	UseTileStore_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	UseCheckpoints_CheckBox.SetText("Checkpoints");
+	UseCheckpoints_CheckBox.SetToolTip("<p>Periodically save the finished output rows and a list of the tiles done to a scratch "
+									   "file, so a run interrupted by a crash, a driver reset or an abort can be resumed.</p>"
+									   "<p>Running again with the same engine, image and parameters continues after the last saved rows, "
+									   "in any tile order. Checkpoints are written by a worker thread and removed when the run completes.</p>");
+	UseCheckpoints_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	CheckpointInterval_NumericControl.label.SetText("Save Interval:");
+	CheckpointInterval_NumericControl.label.SetFixedWidth(labelWidth1);
+	CheckpointInterval_NumericControl.slider.SetRange(10, 3600);
+	CheckpointInterval_NumericControl.slider.SetScaledMinWidth(300);
+	CheckpointInterval_NumericControl.SetReal();
+	CheckpointInterval_NumericControl.SetRange(TheTRTInferenceCheckpointIntervalParameter->MinimumValue(), TheTRTInferenceCheckpointIntervalParameter->MaximumValue());
+	CheckpointInterval_NumericControl.SetPrecision(TheTRTInferenceCheckpointIntervalParameter->Precision());
+	CheckpointInterval_NumericControl.edit.SetFixedWidth(editWidth1);
+	CheckpointInterval_NumericControl.SetToolTip("<p>Minimum time in seconds between two checkpoints.</p>");
+	CheckpointInterval_NumericControl.OnValueUpdated((NumericEdit::value_event_handler)&TRTInferenceInterface::__EditValueUpdated, w);
+
+	const char* checkpointDirectoryToolTip = "<p>Directory receiving checkpoint files. Leave empty to use the temporary directory.</p>";
+
+	CheckpointDirectory_Label.SetText("Scratch Directory:");
+	CheckpointDirectory_Label.SetFixedWidth(labelWidth1);
+	CheckpointDirectory_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	CheckpointDirectory_Label.SetToolTip(checkpointDirectoryToolTip);
+
+	CheckpointDirectory_Edit.SetToolTip(checkpointDirectoryToolTip);
+	CheckpointDirectory_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	CheckpointDirectory_ToolButton.SetIcon(w.ScaledResource(":/browser/select-file.png"));
+	CheckpointDirectory_ToolButton.SetScaledFixedSize(20, 20);
+	CheckpointDirectory_ToolButton.SetToolTip("<p>Select checkpoint directory</p>");
+	CheckpointDirectory_ToolButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	CheckpointDirectory_Sizer.SetSpacing(4);
+	CheckpointDirectory_Sizer.Add(CheckpointDirectory_Label);
+	CheckpointDirectory_Sizer.Add(CheckpointDirectory_Edit, 100);
+	CheckpointDirectory_Sizer.Add(CheckpointDirectory_ToolButton);
+
+	TileCache_Sizer.SetSpacing(4);
+	TileCache_Sizer.Add(UseTileCache_CheckBox);
+	TileCache_Sizer.Add(TileCacheSize_Sizer);
+	TileCache_Sizer.Add(TileCacheDirectory_Sizer);
+	TileCache_Sizer.Add(UseTileStore_CheckBox);
+	TileCache_Sizer.Add(UseCheckpoints_CheckBox);
+	TileCache_Sizer.Add(CheckpointInterval_NumericControl);
+	TileCache_Sizer.Add(CheckpointDirectory_Sizer);
+
+	TileCache_Control.SetSizer(TileCache_Sizer);
+
+	UseROI_CheckBox.SetText("Region of Interest");
+	UseROI_CheckBox.SetToolTip("<p>Process only a rectangular region of the image, for example to tune parameters on a single object "
+							   "of a large field.</p>"
+							   "<p>Tiles cover the region plus a margin of half a tile for context, and only the region is written back. "
+							   "The rest of the image is left untouched. Requires the result to keep the original image dimension.</p>");
+	UseROI_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	ROIX0_Label.SetText("Left:");
+	ROIX0_Label.SetFixedWidth(labelWidth1);
+	ROIX0_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	ROIX0_SpinBox.SetRange(0, int_max);
+	ROIX0_SpinBox.SetToolTip("<p>X pixel coordinate of the upper-left corner of the region of interest.</p>");
+	ROIX0_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	ROIY0_Label.SetText("Top:");
+	ROIY0_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	ROIY0_SpinBox.SetRange(0, int_max);
+	ROIY0_SpinBox.SetToolTip("<p>Y pixel coordinate of the upper-left corner of the region of interest.</p>");
+	ROIY0_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	ROIPosition_Sizer.SetSpacing(4);
+	ROIPosition_Sizer.Add(ROIX0_Label);
+	ROIPosition_Sizer.Add(ROIX0_SpinBox);
+	ROIPosition_Sizer.AddSpacing(8);
+	ROIPosition_Sizer.Add(ROIY0_Label);
+	ROIPosition_Sizer.Add(ROIY0_SpinBox);
+	ROIPosition_Sizer.AddStretch();
+
+	ROIWidth_Label.SetText("Width:");
+	ROIWidth_Label.SetFixedWidth(labelWidth1);
+	ROIWidth_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	ROIWidth_SpinBox.SetRange(0, int_max);
+	ROIWidth_SpinBox.SetToolTip("<p>Width of the region of interest in pixels.</p>");
+	ROIWidth_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	ROIHeight_Label.SetText("Height:");
+	ROIHeight_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	ROIHeight_SpinBox.SetRange(0, int_max);
+	ROIHeight_SpinBox.SetToolTip("<p>Height of the region of interest in pixels.</p>");
+	ROIHeight_SpinBox.OnValueUpdated((SpinBox::value_event_handler)&TRTInferenceInterface::__SpinValueUpdated, w);
+
+	ROISelectPreview_Button.SetText("From Preview");
+	ROISelectPreview_Button.SetToolTip("<p>Import the region of interest from an existing preview.</p>");
+	ROISelectPreview_Button.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	ROISize_Sizer.SetSpacing(4);
+	ROISize_Sizer.Add(ROIWidth_Label);
+	ROISize_Sizer.Add(ROIWidth_SpinBox);
+	ROISize_Sizer.AddSpacing(8);
+	ROISize_Sizer.Add(ROIHeight_Label);
+	ROISize_Sizer.Add(ROIHeight_SpinBox);
+	ROISize_Sizer.AddStretch();
+	ROISize_Sizer.Add(ROISelectPreview_Button);
+
+	ROI_Sizer.SetSpacing(4);
+	ROI_Sizer.Add(UseROI_CheckBox);
+	ROI_Sizer.Add(ROIPosition_Sizer);
+	ROI_Sizer.Add(ROISize_Sizer);
+
+	ROI_Control.SetSizer(ROI_Sizer);
+
+	InputFiles_TreeBox.SetMinHeight(fnt.Height() * 8);
+	InputFiles_TreeBox.SetScaledMinWidth(300);
+	InputFiles_TreeBox.SetNumberOfColumns(1);
+	InputFiles_TreeBox.HideHeader();
+	InputFiles_TreeBox.EnableMultipleSelections();
+	InputFiles_TreeBox.DisableRootDecoration();
+	InputFiles_TreeBox.EnableAlternateRowColor();
+	InputFiles_TreeBox.SetToolTip("<p>Image files processed by a global execution. Unchecked files are skipped.</p>"
+								  "<p>The engine is loaded once for the whole batch. The next file is read and the previous result "
+								  "is written while the current image is being processed.</p>");
+	InputFiles_TreeBox.OnNodeUpdated((TreeBox::node_event_handler)&TRTInferenceInterface::__InputFiles_NodeUpdated, w);
+
+	AddFiles_PushButton.SetText("Add Files");
+	AddFiles_PushButton.SetToolTip("<p>Add image files to the list of input files.</p>");
+	AddFiles_PushButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	RemoveFiles_PushButton.SetText("Remove");
+	RemoveFiles_PushButton.SetToolTip("<p>Remove the selected files from the list.</p>");
+	RemoveFiles_PushButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	ClearFiles_PushButton.SetText("Clear");
+	ClearFiles_PushButton.SetToolTip("<p>Remove all files from the list.</p>");
+	ClearFiles_PushButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	InputFilesButtons_Sizer.SetSpacing(4);
+	InputFilesButtons_Sizer.Add(AddFiles_PushButton);
+	InputFilesButtons_Sizer.Add(RemoveFiles_PushButton);
+	InputFilesButtons_Sizer.Add(ClearFiles_PushButton);
+	InputFilesButtons_Sizer.AddStretch();
+
+	InputFiles_Sizer.SetSpacing(4);
+	InputFiles_Sizer.Add(InputFiles_TreeBox, 100);
+	InputFiles_Sizer.Add(InputFilesButtons_Sizer);
+
+	const char* outputDirectoryToolTip = "<p>Directory receiving the output files. Leave empty to write each output file "
+		"next to its input file.</p>";
+
+	OutputDirectory_Label.SetText("Output Directory:");
+	OutputDirectory_Label.SetFixedWidth(labelWidth1);
+	OutputDirectory_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	OutputDirectory_Label.SetToolTip(outputDirectoryToolTip);
+
+	OutputDirectory_Edit.SetToolTip(outputDirectoryToolTip);
+	OutputDirectory_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	OutputDirectory_ToolButton.SetIcon(w.ScaledResource(":/browser/select-file.png"));
+	OutputDirectory_ToolButton.SetScaledFixedSize(20, 20);
+	OutputDirectory_ToolButton.SetToolTip("<p>Select output directory</p>");
+	OutputDirectory_ToolButton.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	OutputDirectory_Sizer.SetSpacing(4);
+	OutputDirectory_Sizer.Add(OutputDirectory_Label);
+	OutputDirectory_Sizer.Add(OutputDirectory_Edit, 100);
+	OutputDirectory_Sizer.Add(OutputDirectory_ToolButton);
+
+	const char* outputPostfixToolTip = "<p>Appended to the name of each input file to build the output file name. "
+		"The output file has the format of the input file.</p>";
+
+	OutputPostfix_Label.SetText("Postfix:");
+	OutputPostfix_Label.SetFixedWidth(labelWidth1);
+	OutputPostfix_Label.SetTextAlignment(TextAlign::Right | TextAlign::VertCenter);
+	OutputPostfix_Label.SetToolTip(outputPostfixToolTip);
+
+	OutputPostfix_Edit.SetToolTip(outputPostfixToolTip);
+	OutputPostfix_Edit.SetFixedWidth(editWidth1);
+	OutputPostfix_Edit.OnEditCompleted((Edit::edit_event_handler)&TRTInferenceInterface::__EditCompleted, w);
+
+	OverwriteExistingFiles_CheckBox.SetText("Overwrite");
+	OverwriteExistingFiles_CheckBox.SetToolTip("<p>Overwrite existing output files. When disabled, a numeric suffix is "
+											   "added to the name of the new file.</p>");
+	OverwriteExistingFiles_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	OutputPostfix_Sizer.SetSpacing(4);
+	OutputPostfix_Sizer.Add(OutputPostfix_Label);
+	OutputPostfix_Sizer.Add(OutputPostfix_Edit);
+	OutputPostfix_Sizer.AddSpacing(8);
+	OutputPostfix_Sizer.Add(OverwriteExistingFiles_CheckBox);
+	OutputPostfix_Sizer.AddStretch();
+
+	OutOfCore_CheckBox.SetText("Out-of-Core");
+	OutOfCore_CheckBox.SetToolTip("<p>Stream each image from its file and write the output file as it is produced, one row of tiles at "
+								  "a time, for images larger than the available memory. The result is identical to in-memory processing.</p>"
+								  "<p>Requires a file format supporting incremental reads and writes, such as XISF or FITS; other files are "
+								  "processed in memory. Same-Size Fast Mode is not available.</p>");
+	OutOfCore_CheckBox.OnClick((Button::click_event_handler)&TRTInferenceInterface::__Click, w);
+
+	Batch_Sizer.SetSpacing(4);
+	Batch_Sizer.Add(InputFiles_Sizer);
+	Batch_Sizer.Add(OutputDirectory_Sizer);
+	Batch_Sizer.Add(OutputPostfix_Sizer);
+	Batch_Sizer.Add(OutOfCore_CheckBox);
+
+	Batch_Control.SetSizer(Batch_Sizer);
+
+	UpdateRealTimePreview_Timer.SetSingleShot();
+	UpdateRealTimePreview_Timer.SetInterval(0.025);
+	UpdateRealTimePreview_Timer.OnTimer((Timer::timer_event_handler)&TRTInferenceInterface::__RealTimePreview_Timer, w);
+
+	RefineRealTimePreview_Timer.SetSingleShot();
+	RefineRealTimePreview_Timer.SetInterval(0.1);
+	RefineRealTimePreview_Timer.OnTimer((Timer::timer_event_handler)&TRTInferenceInterface::__RealTimePreview_Timer, w);
+
+	EngineCatalog_Timer.SetInterval(0.25);
+	EngineCatalog_Timer.OnTimer((Timer::timer_event_handler)&TRTInferenceInterface::__EngineCatalog_Timer, w);
+
 	Global_Sizer.SetMargin(8);
 	Global_Sizer.SetSpacing(6);
 	Global_Sizer.Add(TRTEngine_Control);
 	Global_Sizer.Add(Inference_Control);
+	Global_Sizer.Add(TileCache_Control);
+	Global_Sizer.Add(ROI_Control);
+	Global_Sizer.Add(Batch_Control);
 
 	w.SetSizer(Global_Sizer);
 
@@ -2,12 +2,21 @@
 #define __TRTInferenceInterface_h
 
 #include <pcl/CheckBox.h>
+#include <pcl/ComboBox.h>
 #include <pcl/NumericControl.h>
 #include <pcl/ProcessInterface.h>
+#include <pcl/PushButton.h>
 #include <pcl/Sizer.h>
+#include <pcl/SpinBox.h>
+#include <pcl/Timer.h>
 #include <pcl/ToolButton.h>
+#include <pcl/TreeBox.h>
 
+#include <memory>
+
+#include "TRTInferenceCatalog.h"
 #include "TRTInferenceInstance.h"
+#include "TRTInferencePreview.h"
 
 namespace pcl {
 
@@ -29,10 +38,29 @@ public:
     bool ImportProcess(const ProcessImplementation&) override;
     void SaveSettings() const override;
 
+    void RealTimePreviewUpdated(bool active) override;
+    bool RequiresRealTimePreviewUpdate(const UInt16Image&, const View&, const Rect&, int zoomLevel) const override;
+    bool GenerateRealTimePreview(UInt16Image&, const View&, const Rect&, int zoomLevel, String& info) const override;
+
 private:
 
     TRTInferenceInstance m_instance;
 
+    // Real-time preview state. The engine is kept loaded between updates, and a coarse rendition is
+    // followed by a full one unless parameters change in between.
+    mutable TRTPreviewThread* m_realTimeThread = nullptr;
+    mutable std::unique_ptr<TRTEngine> m_previewEngine;
+    mutable String m_previewEnginePath;
+    mutable bool m_previewEngineShared = false;
+    mutable String m_previewPipelineEngines;
+    mutable double m_previewTileOverlap = 0;
+    mutable bool m_refinePreview = false;
+
+    // Engines of the directory of the selected engine, refreshed on a worker thread when another engine
+    // is selected
+    std::unique_ptr<TRTEngineCatalog> m_catalog;
+    String m_catalogEnginePath;
+
     struct GUIData
     {
         GUIData(TRTInferenceInterface&);
@@ -40,23 +68,138 @@ private:
         VerticalSizer   Global_Sizer;
 
         Control         TRTEngine_Control;
-            HorizontalSizer TRTEngine_Sizer;
-                Label           TRTEngine_Label;
-                Edit            TRTEngine_Edit;
-                ToolButton      TRTEngine_ToolButton;
+            VerticalSizer   Engine_Sizer;
+                HorizontalSizer TRTEngine_Sizer;
+                    Label           TRTEngine_Label;
+                    Edit            TRTEngine_Edit;
+                    ToolButton      TRTEngine_ToolButton;
+                    CheckBox        UseInferenceServer_CheckBox;
+                HorizontalSizer PipelineEngines_Sizer;
+                    Label           PipelineEngines_Label;
+                    Edit            PipelineEngines_Edit;
+                    ToolButton      PipelineEngines_ToolButton;
+                HorizontalSizer EngineCatalog_Sizer;
+                    Label           EngineCatalog_Label;
+                    ComboBox        EngineCatalog_ComboBox;
+                HorizontalSizer EngineInfo_Sizer;
+                    Label           EngineInfo_Label;
+                    Label           EngineInfoText_Label;
+                HorizontalSizer Backend_Sizer;
+                    Label           Backend_Label;
+                    Label           BackendStatus_Label;
+                    Label           GpuMemoryBudget_Label;
+                    SpinBox         GpuMemoryBudget_SpinBox;
+                HorizontalSizer Tuning_Sizer;
+                    Label           Tuning_Label;
+                    CheckBox        UseTuningProfile_CheckBox;
+                    Label           TuningStatus_Label;
+                    PushButton      Autotune_PushButton;
+                    PushButton      ProfileLayers_PushButton;
 
         Control         Inference_Control;
             VerticalSizer   Inference_Sizer;
                 NumericControl  TileOverlap_NumericControl;
+                CheckBox        AutoTileOverlap_CheckBox;
+                NumericControl  SeamErrorThreshold_NumericControl;
+                HorizontalSizer BlendMode_Sizer;
+                    Label           BlendMode_Label;
+                    ComboBox        BlendMode_ComboBox;
+                HorizontalSizer TileOrder_Sizer;
+                    Label           TileOrder_Label;
+                    ComboBox        TileOrder_ComboBox;
+                    Label           TileBandHeight_Label;
+                    SpinBox         TileBandHeight_SpinBox;
+                HorizontalSizer TileFarmWorkers_Sizer;
+                    Label           TileFarmWorkers_Label;
+                    Edit            TileFarmWorkers_Edit;
                 CheckBox        KeepOutputDimension_CheckBox;
+                CheckBox        BinInput_CheckBox;
+                CheckBox        MonoChannelAverage_CheckBox;
+                CheckBox        SkipUniformTiles_CheckBox;
+                NumericControl  UniformTileTolerance_NumericControl;
+                HorizontalSizer UniformTilePolicy_Sizer;
+                    Label           UniformTilePolicy_Label;
+                    ComboBox        UniformTilePolicy_ComboBox;
+                CheckBox        LiveDisplay_CheckBox;
+                NumericControl  LiveDisplayInterval_NumericControl;
+
+        Control         TileCache_Control;
+            VerticalSizer   TileCache_Sizer;
+                CheckBox        UseTileCache_CheckBox;
+                HorizontalSizer TileCacheSize_Sizer;
+                    Label           TileCacheSize_Label;
+                    SpinBox         TileCacheSize_SpinBox;
+                    Label           TileCacheDiskSize_Label;
+                    SpinBox         TileCacheDiskSize_SpinBox;
+                HorizontalSizer TileCacheDirectory_Sizer;
+                    Label           TileCacheDirectory_Label;
+                    Edit            TileCacheDirectory_Edit;
+                    ToolButton      TileCacheDirectory_ToolButton;
+                CheckBox        UseTileStore_CheckBox;
+                CheckBox        UseCheckpoints_CheckBox;
+                NumericControl  CheckpointInterval_NumericControl;
+                HorizontalSizer CheckpointDirectory_Sizer;
+                    Label           CheckpointDirectory_Label;
+                    Edit            CheckpointDirectory_Edit;
+                    ToolButton      CheckpointDirectory_ToolButton;
+
+        Control         ROI_Control;
+            VerticalSizer   ROI_Sizer;
+                CheckBox        UseROI_CheckBox;
+                HorizontalSizer ROIPosition_Sizer;
+                    Label           ROIX0_Label;
+                    SpinBox         ROIX0_SpinBox;
+                    Label           ROIY0_Label;
+                    SpinBox         ROIY0_SpinBox;
+                HorizontalSizer ROISize_Sizer;
+                    Label           ROIWidth_Label;
+                    SpinBox         ROIWidth_SpinBox;
+                    Label           ROIHeight_Label;
+                    SpinBox         ROIHeight_SpinBox;
+                    PushButton      ROISelectPreview_Button;
+
+        Control         Batch_Control;
+            VerticalSizer   Batch_Sizer;
+                HorizontalSizer InputFiles_Sizer;
+                    TreeBox         InputFiles_TreeBox;
+                    VerticalSizer   InputFilesButtons_Sizer;
+                        PushButton      AddFiles_PushButton;
+                        PushButton      RemoveFiles_PushButton;
+                        PushButton      ClearFiles_PushButton;
+                HorizontalSizer OutputDirectory_Sizer;
+                    Label           OutputDirectory_Label;
+                    Edit            OutputDirectory_Edit;
+                    ToolButton      OutputDirectory_ToolButton;
+                HorizontalSizer OutputPostfix_Sizer;
+                    Label           OutputPostfix_Label;
+                    Edit            OutputPostfix_Edit;
+                    CheckBox        OverwriteExistingFiles_CheckBox;
+                CheckBox        OutOfCore_CheckBox;
+
+        Timer           UpdateRealTimePreview_Timer;
+        Timer           RefineRealTimePreview_Timer;
+        Timer           EngineCatalog_Timer;
     };
 
     GUIData* GUI = nullptr;
 
     void UpdateControls();
+    void UpdateEngineCatalog();
+    void ListEngineCatalog();
+    void UpdateInputFilesList();
+    void UpdateRealTimePreview();
+    // Benchmarks the engine on a crop of the active image and saves the fastest settings
+    void Autotune();
+    // Reports the time of each layer of the engine on a few tiles of the active image
+    void ProfileLayers();
     void __Click(Button& sender, bool checked);
     void __EditCompleted(Edit& sender);
     void __EditValueUpdated(NumericEdit& sender, double value);
+    void __ItemSelected(ComboBox& sender, int itemIndex);
+    void __SpinValueUpdated(SpinBox& sender, int value);
+    void __RealTimePreview_Timer(Timer& sender);
+    void __EngineCatalog_Timer(Timer& sender);
+    void __InputFiles_NodeUpdated(TreeBox& sender, TreeBox::Node& node, int col);
 
     friend struct GUIData;
 };
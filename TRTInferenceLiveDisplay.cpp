@@ -0,0 +1,84 @@
+#include <pcl/View.h>
+
+#include "TRTInferenceLiveDisplay.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+TRTLiveDisplay::TRTLiveDisplay(const FImage& accumulator, const FImage* weight, double interval, int maxSize)
+    : m_accumulator(accumulator)
+    , m_weight(weight)
+    , m_interval(interval)
+    , m_reduction(Max(1, (Max(accumulator.Width(), accumulator.Height()) + maxSize - 1) / maxSize))
+    , m_window((accumulator.Width() + m_reduction - 1) / m_reduction,
+               (accumulator.Height() + m_reduction - 1) / m_reduction,
+               accumulator.NumberOfChannels(), 32, true, accumulator.NumberOfChannels() == 3, false, "TRTInference_live")
+{
+    ImageVariant image = m_window.MainView().Image();
+    m_staging.AllocateData(image.Width(), image.Height(), image.NumberOfChannels(), image.ColorSpace());
+    m_window.Show();
+    m_window.ZoomToFit(false);
+    m_thread = std::thread(&TRTLiveDisplay::run, this);
+}
+
+TRTLiveDisplay::~TRTLiveDisplay()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_requested.notify_one();
+    m_thread.join();
+    m_window.ForceClose();
+}
+
+void TRTLiveDisplay::update(int finishedRows)
+{
+    int composedRows;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        composedRows = m_composedRows;
+        m_requestedRows = Max(m_requestedRows, finishedRows);
+    }
+    m_requested.notify_one();
+
+    // Rows past composedRows may be in the works, but these are complete
+    if (composedRows > m_shownRows)
+    {
+        ImageVariant image = m_window.MainView().Image();
+        FImage& display = static_cast<FImage&>(*image);
+        size_type rowSize = size_type(display.Width()) * sizeof(float);
+        for (int c = 0; c < display.NumberOfChannels(); c++)
+            ::memcpy(display.ScanLine(m_shownRows, c), m_staging.ScanLine(m_shownRows, c), (composedRows - m_shownRows) * rowSize);
+        m_shownRows = composedRows;
+        m_window.Regenerate();
+    }
+    m_timer.Reset();
+}
+
+void TRTLiveDisplay::run()
+{
+    for (;;)
+    {
+        int startRow, endRow;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_requested.wait(lock, [this] { return m_stop || ((m_requestedRows + m_reduction - 1) / m_reduction > m_composedRows); });
+            if (m_stop)
+                return;
+            startRow = m_composedRows;
+            endRow = Min((m_requestedRows + m_reduction - 1) / m_reduction, m_staging.Height());
+        }
+
+        // Nearest-neighbor reduction is good enough for monitoring
+        reduceForDisplay(m_accumulator, m_weight, m_reduction, startRow, endRow, m_staging);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_composedRows = endRow;
+        }
+    }
+}
+
+}	// namespace pcl
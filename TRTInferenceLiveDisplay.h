@@ -0,0 +1,60 @@
+#ifndef __TRTInferenceLiveDisplay_h
+#define __TRTInferenceLiveDisplay_h
+
+#include <pcl/ElapsedTime.h>
+#include <pcl/Image.h>
+#include <pcl/ImageWindow.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace pcl
+{
+
+// Temporary image window showing the blended output while tiles are still being processed. Finished
+// accumulator rows are composited into a staging image by a worker thread; the calling thread, which
+// owns the GUI, only copies the composited rows to the window and redraws it, at most once per
+// interval. The window is reduced so its longest side does not exceed maxSize pixels.
+class TRTLiveDisplay
+{
+public:
+    TRTLiveDisplay(const FImage& accumulator, const FImage* weight, double interval, int maxSize = 4096);
+    ~TRTLiveDisplay();
+
+    // True once the interval has elapsed since the last update
+    bool due() const
+    {
+        return m_timer() >= m_interval;
+    }
+
+    // Shows the rows composited since the last call and starts compositing the accumulator rows up to
+    // finishedRows, which must not be written anymore by the caller
+    void update(int finishedRows);
+
+private:
+    const FImage& m_accumulator;
+    const FImage* m_weight;
+    double m_interval;
+    int m_reduction;
+    ElapsedTime m_timer;
+
+    ImageWindow m_window;
+    FImage m_staging;
+    // Display rows composited into the staging image, and those already shown
+    int m_composedRows = 0;
+    int m_shownRows = 0;
+
+    // Accumulator rows requested from the worker
+    int m_requestedRows = 0;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_requested;
+    std::thread m_thread;
+
+    void run();
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceLiveDisplay_h
@@ -0,0 +1,137 @@
+#include <pcl/Exception.h>
+#include <pcl/File.h>
+
+#ifdef __PCL_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "TRTInferenceMappedFile.h"
+
+namespace pcl
+{
+
+#ifdef __PCL_WINDOWS
+
+TRTMappedFile::TRTMappedFile(const String& path, bool writable, size_type size)
+{
+    String winPath = File::UnixPathToWindows(path);
+    HANDLE file = ::CreateFileW(reinterpret_cast<LPCWSTR>(winPath.c_str()),
+                                writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                nullptr,
+                                writable ? OPEN_ALWAYS : OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw Error("Unable to open file " + path);
+    m_fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (writable && (size > 0))
+    {
+        fileSize.QuadPart = LONGLONG(size);
+        if (!::SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !::SetEndOfFile(file))
+        {
+            ::CloseHandle(file);
+            throw Error("Unable to resize file " + path);
+        }
+    }
+    if (!::GetFileSizeEx(file, &fileSize))
+    {
+        ::CloseHandle(file);
+        throw Error("Unable to get size of file " + path);
+    }
+    m_size = size_type(fileSize.QuadPart);
+    if (m_size == 0)
+        return;
+
+    m_mappingHandle = ::CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+        ::CloseHandle(file);
+        throw Error("Unable to map file " + path);
+    }
+    m_data = ::MapViewOfFile(m_mappingHandle, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0);
+    if (m_data == nullptr)
+    {
+        ::CloseHandle(m_mappingHandle);
+        ::CloseHandle(file);
+        throw Error("Unable to map file " + path);
+    }
+}
+
+TRTMappedFile::~TRTMappedFile()
+{
+    if (m_data != nullptr)
+        ::UnmapViewOfFile(m_data);
+    if (m_mappingHandle != nullptr)
+        ::CloseHandle(m_mappingHandle);
+    if (m_fileHandle != nullptr)
+        ::CloseHandle(m_fileHandle);
+}
+
+bool TRTMappedFile::flush(bool wait)
+{
+    if (m_data == nullptr)
+        return true;
+    // FlushViewOfFile only starts the writes; the file buffers hold them until flushed
+    return ::FlushViewOfFile(m_data, 0) && (!wait || ::FlushFileBuffers(m_fileHandle));
+}
+
+#else
+
+TRTMappedFile::TRTMappedFile(const String& path, bool writable, size_type size)
+{
+    m_fd = ::open(path.ToUTF8().c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (m_fd < 0)
+        throw Error("Unable to open file " + path);
+
+    if (writable && (size > 0))
+        if (::ftruncate(m_fd, off_t(size)) != 0)
+        {
+            ::close(m_fd);
+            throw Error("Unable to resize file " + path);
+        }
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0)
+    {
+        ::close(m_fd);
+        throw Error("Unable to get size of file " + path);
+    }
+    m_size = size_type(st.st_size);
+    if (m_size == 0)
+        return;
+
+    void* data = ::mmap(nullptr, m_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(m_fd);
+        throw Error("Unable to map file " + path);
+    }
+    m_data = data;
+}
+
+TRTMappedFile::~TRTMappedFile()
+{
+    if (m_data != nullptr)
+        ::munmap(m_data, m_size);
+    if (m_fd >= 0)
+        ::close(m_fd);
+}
+
+bool TRTMappedFile::flush(bool wait)
+{
+    if (m_data == nullptr)
+        return true;
+    return ::msync(m_data, m_size, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+#endif
+
+}	// namespace pcl
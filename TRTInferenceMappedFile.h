@@ -0,0 +1,49 @@
+#ifndef __TRTInferenceMappedFile_h
+#define __TRTInferenceMappedFile_h
+
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+// A file mapped into memory, either read-only or read/write. A writable mapping of a nonzero size
+// creates the file if needed and resizes it to that size. Several processes mapping the same file share
+// its contents.
+class TRTMappedFile
+{
+private:
+    void* m_data = nullptr;
+    size_type m_size = 0;
+#ifdef __PCL_WINDOWS
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+public:
+    TRTMappedFile(const String& path, bool writable, size_type size = 0);
+    ~TRTMappedFile();
+
+    TRTMappedFile(const TRTMappedFile&) = delete;
+    TRTMappedFile& operator=(const TRTMappedFile&) = delete;
+
+    uint8* data() const
+    {
+        return static_cast<uint8*>(m_data);
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    // Schedules modified pages to be written back to the file. With wait, returns once they are on disk,
+    // so they survive a system crash or power loss as well as a crash of the process. Returns false if
+    // the pages could not be written.
+    bool flush(bool wait = false);
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceMappedFile_h
@@ -0,0 +1,1231 @@
+#include <pcl/File.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "TRTInferenceCpuKernels.h"
+#include "TRTInferenceOnnx.h"
+
+namespace pcl
+{
+
+// Reader of the protocol buffer wire format ONNX models are serialized in
+class ProtoReader
+{
+public:
+    ProtoReader(const uint8* begin, const uint8* end)
+        : m_p(begin)
+        , m_end(end)
+    {
+    }
+
+    // Key of the next field; false at the end of the message
+    bool next(uint32& field, uint32& wireType)
+    {
+        if (m_p >= m_end)
+            return false;
+        uint64 key = varint();
+        field = uint32(key >> 3);
+        wireType = uint32(key & 7);
+        return true;
+    }
+
+    uint64 varint()
+    {
+        uint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (m_p >= m_end)
+                throw Error("Truncated ONNX model.");
+            uint8 b = *m_p++;
+            value |= uint64(b & 0x7f) << shift;
+            if ((b & 0x80) == 0)
+                return value;
+        }
+        throw Error("Corrupted ONNX model.");
+    }
+
+    float fixed32()
+    {
+        float value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    double fixed64()
+    {
+        double value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    // Length-delimited field: embedded message, string or bytes
+    ProtoReader message()
+    {
+        uint64 length = varint();
+        if (length > uint64(m_end - m_p))
+            throw Error("Truncated ONNX model.");
+        ProtoReader r(m_p, m_p + length);
+        m_p += length;
+        return r;
+    }
+
+    IsoString string()
+    {
+        ProtoReader r = message();
+        return IsoString(reinterpret_cast<const char*>(r.m_p), reinterpret_cast<const char*>(r.m_end));
+    }
+
+    void skip(uint32 wireType)
+    {
+        switch (wireType)
+        {
+        case 0:
+            varint();
+            break;
+        case 1:
+            advance(8);
+            break;
+        case 2:
+            message();
+            break;
+        case 5:
+            advance(4);
+            break;
+        default:
+            throw Error("Corrupted ONNX model.");
+        }
+    }
+
+    // Repeated scalar fields may be packed or not
+    void int64s(uint32 wireType, std::vector<int64>& values)
+    {
+        if (wireType != 2)
+        {
+            values.push_back(int64(varint()));
+            return;
+        }
+        ProtoReader r = message();
+        while (r.m_p < r.m_end)
+            values.push_back(int64(r.varint()));
+    }
+
+    void floats(uint32 wireType, std::vector<float>& values)
+    {
+        if (wireType != 2)
+        {
+            values.push_back(fixed32());
+            return;
+        }
+        ProtoReader r = message();
+        while (r.m_p < r.m_end)
+            values.push_back(r.fixed32());
+    }
+
+    void doubles(uint32 wireType, std::vector<float>& values)
+    {
+        if (wireType != 2)
+        {
+            values.push_back(float(fixed64()));
+            return;
+        }
+        ProtoReader r = message();
+        while (r.m_p < r.m_end)
+            values.push_back(float(r.fixed64()));
+    }
+
+    const uint8* begin() const
+    {
+        return m_p;
+    }
+
+    size_type size() const
+    {
+        return m_end - m_p;
+    }
+
+private:
+    const uint8* m_p;
+    const uint8* m_end;
+
+    void advance(size_type n)
+    {
+        if (n > size())
+            throw Error("Truncated ONNX model.");
+        m_p += n;
+    }
+
+    void read(void* data, size_type n)
+    {
+        if (n > size())
+            throw Error("Truncated ONNX model.");
+        ::memcpy(data, m_p, n);
+        m_p += n;
+    }
+};
+
+// Constant tensors are kept as floats whatever their element type
+struct OnnxTensor
+{
+    std::vector<int64> dims;
+    std::vector<float> values;
+};
+
+struct OnnxAttribute
+{
+    IsoString name;
+    float f = 0;
+    int64 i = 0;
+    IsoString s;
+    std::vector<float> floats;
+    std::vector<int64> ints;
+    OnnxTensor t;
+};
+
+struct OnnxNode
+{
+    IsoString opType;
+    IsoString name;
+    std::vector<IsoString> inputs;
+    std::vector<IsoString> outputs;
+    std::vector<OnnxAttribute> attributes;
+
+    const OnnxAttribute* attribute(const char* attributeName) const
+    {
+        for (const OnnxAttribute& a : attributes)
+            if (a.name == attributeName)
+                return &a;
+        return nullptr;
+    }
+
+    int64 intAttribute(const char* attributeName, int64 defaultValue) const
+    {
+        const OnnxAttribute* a = attribute(attributeName);
+        return (a != nullptr) ? a->i : defaultValue;
+    }
+
+    float floatAttribute(const char* attributeName, float defaultValue) const
+    {
+        const OnnxAttribute* a = attribute(attributeName);
+        return (a != nullptr) ? a->f : defaultValue;
+    }
+
+    IsoString stringAttribute(const char* attributeName, const char* defaultValue) const
+    {
+        const OnnxAttribute* a = attribute(attributeName);
+        return (a != nullptr) ? a->s : IsoString(defaultValue);
+    }
+
+    std::vector<int64> intsAttribute(const char* attributeName) const
+    {
+        const OnnxAttribute* a = attribute(attributeName);
+        return (a != nullptr) ? a->ints : std::vector<int64>();
+    }
+
+    // Inputs may be omitted by an empty name
+    bool hasInput(size_type index) const
+    {
+        return (index < inputs.size()) && !inputs[index].IsEmpty();
+    }
+};
+
+struct OnnxModel
+{
+    std::vector<OnnxNode> nodes;
+    std::map<IsoString, OnnxTensor> initializers;
+    IsoString inputName;
+    std::vector<int64> inputDims;
+    IsoString outputName;
+};
+
+static float halfToFloat(uint16 h)
+{
+    uint32 sign = uint32(h & 0x8000) << 16;
+    uint32 exponent = (h >> 10) & 0x1f;
+    uint32 mantissa = h & 0x3ff;
+    uint32 bits;
+    if (exponent == 0x1f)
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    else if (exponent != 0)
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    else if (mantissa == 0)
+        bits = sign;
+    else
+    {
+        // Subnormal: normalize the mantissa
+        exponent = 113;
+        while ((mantissa & 0x400) == 0)
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+    float f;
+    ::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static OnnxTensor parseTensor(ProtoReader r, IsoString* name = nullptr)
+{
+    enum { Float = 1, Int32 = 6, Int64 = 7, Float16 = 10, Double = 11 };
+
+    OnnxTensor tensor;
+    int64 dataType = Float;
+    const uint8* raw = nullptr;
+    size_type rawSize = 0;
+    std::vector<int64> integers;
+    bool external = false;
+
+    uint32 field, wireType;
+    while (r.next(field, wireType))
+        switch (field)
+        {
+        case 1:
+            r.int64s(wireType, tensor.dims);
+            break;
+        case 2:
+            dataType = int64(r.varint());
+            break;
+        case 4:
+            r.floats(wireType, tensor.values);
+            break;
+        case 5:
+        case 7:
+            r.int64s(wireType, integers);
+            break;
+        case 8:
+            if (name != nullptr)
+                *name = r.string();
+            else
+                r.skip(wireType);
+            break;
+        case 9:
+            {
+                ProtoReader data = r.message();
+                raw = data.begin();
+                rawSize = data.size();
+            }
+            break;
+        case 10:
+            r.doubles(wireType, tensor.values);
+            break;
+        case 14:
+            external = r.varint() == 1;
+            break;
+        default:
+            r.skip(wireType);
+            break;
+        }
+
+    if (external)
+        throw Error("ONNX models with external tensor data are not supported.");
+
+    if (raw != nullptr)
+    {
+        tensor.values.clear();
+        switch (dataType)
+        {
+        case Float:
+            tensor.values.resize(rawSize / 4);
+            if (!tensor.values.empty())
+                ::memcpy(tensor.values.data(), raw, tensor.values.size() * 4);
+            break;
+        case Float16:
+            for (size_type i = 0; i + 1 < rawSize; i += 2)
+                tensor.values.push_back(halfToFloat(uint16(raw[i] | (raw[i + 1] << 8))));
+            break;
+        case Int32:
+            for (size_type i = 0; i + 3 < rawSize; i += 4)
+            {
+                int32 v;
+                ::memcpy(&v, raw + i, 4);
+                tensor.values.push_back(float(v));
+            }
+            break;
+        case Int64:
+            for (size_type i = 0; i + 7 < rawSize; i += 8)
+            {
+                int64 v;
+                ::memcpy(&v, raw + i, 8);
+                tensor.values.push_back(float(v));
+            }
+            break;
+        case Double:
+            for (size_type i = 0; i + 7 < rawSize; i += 8)
+            {
+                double v;
+                ::memcpy(&v, raw + i, 8);
+                tensor.values.push_back(float(v));
+            }
+            break;
+        default:
+            throw Error(String().Format("Unsupported ONNX tensor element type %d.", int(dataType)));
+        }
+    }
+    else if (!integers.empty())
+    {
+        // Half-precision values are stored as their bit patterns in int32_data
+        for (int64 v : integers)
+            tensor.values.push_back((dataType == Float16) ? halfToFloat(uint16(v)) : float(v));
+    }
+    return tensor;
+}
+
+static OnnxAttribute parseAttribute(ProtoReader r)
+{
+    OnnxAttribute attribute;
+    uint32 field, wireType;
+    while (r.next(field, wireType))
+        switch (field)
+        {
+        case 1:
+            attribute.name = r.string();
+            break;
+        case 2:
+            attribute.f = r.fixed32();
+            break;
+        case 3:
+            attribute.i = int64(r.varint());
+            break;
+        case 4:
+            attribute.s = r.string();
+            break;
+        case 5:
+            attribute.t = parseTensor(r.message());
+            break;
+        case 7:
+            r.floats(wireType, attribute.floats);
+            break;
+        case 8:
+            r.int64s(wireType, attribute.ints);
+            break;
+        default:
+            r.skip(wireType);
+            break;
+        }
+    return attribute;
+}
+
+static OnnxNode parseNode(ProtoReader r)
+{
+    OnnxNode node;
+    uint32 field, wireType;
+    while (r.next(field, wireType))
+        switch (field)
+        {
+        case 1:
+            node.inputs.push_back(r.string());
+            break;
+        case 2:
+            node.outputs.push_back(r.string());
+            break;
+        case 3:
+            node.name = r.string();
+            break;
+        case 4:
+            node.opType = r.string();
+            break;
+        case 5:
+            node.attributes.push_back(parseAttribute(r.message()));
+            break;
+        default:
+            r.skip(wireType);
+            break;
+        }
+    return node;
+}
+
+// Name and dimensions of a graph input or output; symbolic dimensions are -1
+static IsoString parseValueInfo(ProtoReader r, std::vector<int64>& dims)
+{
+    IsoString name;
+    uint32 field, wireType;
+    while (r.next(field, wireType))
+        if (field == 1)
+            name = r.string();
+        else if (field == 2)
+        {
+            // TypeProto.tensor_type.shape.dim
+            ProtoReader type = r.message();
+            while (type.next(field, wireType))
+                if (field == 1)
+                {
+                    ProtoReader tensorType = type.message();
+                    while (tensorType.next(field, wireType))
+                        if (field == 2)
+                        {
+                            ProtoReader shape = tensorType.message();
+                            while (shape.next(field, wireType))
+                                if (field == 1)
+                                {
+                                    ProtoReader dim = shape.message();
+                                    int64 value = -1;
+                                    while (dim.next(field, wireType))
+                                        if (field == 1)
+                                            value = int64(dim.varint());
+                                        else
+                                            dim.skip(wireType);
+                                    dims.push_back(value);
+                                }
+                                else
+                                    shape.skip(wireType);
+                        }
+                        else
+                            tensorType.skip(wireType);
+                }
+                else
+                    type.skip(wireType);
+        }
+        else
+            r.skip(wireType);
+    return name;
+}
+
+static OnnxModel parseModel(const ByteArray& data)
+{
+    OnnxModel model;
+    std::vector<std::pair<IsoString, std::vector<int64>>> inputs;
+    std::vector<IsoString> outputs;
+
+    ProtoReader r(data.Begin(), data.End());
+    bool hasGraph = false;
+    uint32 field, wireType;
+    while (r.next(field, wireType))
+        if (field == 7)
+        {
+            hasGraph = true;
+            ProtoReader graph = r.message();
+            while (graph.next(field, wireType))
+                switch (field)
+                {
+                case 1:
+                    model.nodes.push_back(parseNode(graph.message()));
+                    break;
+                case 5:
+                    {
+                        IsoString name;
+                        OnnxTensor tensor = parseTensor(graph.message(), &name);
+                        model.initializers[name] = std::move(tensor);
+                    }
+                    break;
+                case 11:
+                    {
+                        std::vector<int64> dims;
+                        IsoString name = parseValueInfo(graph.message(), dims);
+                        inputs.push_back({ name, dims });
+                    }
+                    break;
+                case 12:
+                    {
+                        std::vector<int64> dims;
+                        outputs.push_back(parseValueInfo(graph.message(), dims));
+                    }
+                    break;
+                default:
+                    graph.skip(wireType);
+                    break;
+                }
+        }
+        else
+            r.skip(wireType);
+
+    if (!hasGraph)
+        throw Error("Not an ONNX model.");
+
+    // Older models also list their initializers as graph inputs
+    for (const auto& input : inputs)
+        if (model.initializers.count(input.first) == 0)
+        {
+            model.inputName = input.first;
+            model.inputDims = input.second;
+            break;
+        }
+    if (model.inputName.IsEmpty() || outputs.empty())
+        throw Error("The ONNX model has no input or no output.");
+    if (model.inputDims.size() != 4)
+        throw Error("The input of the ONNX model is not 4-dimensional.");
+    model.outputName = outputs[0];
+    return model;
+}
+
+namespace OnnxStep
+{
+    enum value_type { Conv, Activation, Binary, Concat, DepthToSpace, Resize };
+}
+
+struct OnnxStepData
+{
+    int op;
+    std::vector<int> inputs;
+    int output;
+
+    TRTCpuConvParams conv;
+    const float* weights = nullptr;
+    const float* bias = nullptr;
+
+    TRTCpuActivationParams activation;
+
+    int binaryOp = 0;
+    // Constant operand of a binary operation, or none if both operands are values
+    const float* operand = nullptr;
+    size_type operandSize = 0;
+    bool operandFirst = false;
+
+    int blockSize = 0;
+    bool crd = false;
+
+    TRTCpuResizeTable rows;
+    TRTCpuResizeTable columns;
+    bool nearest = false;
+};
+
+// Shape and storage of an intermediate tensor
+struct OnnxValue
+{
+    int channels = 0;
+    int height = 0;
+    int width = 0;
+    int lastUse = -1;
+    int buffer = -1;
+};
+
+class TRTOnnxGraph
+{
+public:
+    TRTOnnxGraph(OnnxModel&& model, int tileH, int tileW)
+        : m_model(std::move(model))
+    {
+        compile(tileH, tileW);
+    }
+
+    void setNumberOfThreads(int numThreads)
+    {
+        m_pool.setNumberOfThreads(numThreads);
+    }
+
+    int inputChannels() const
+    {
+        return m_values[0].channels;
+    }
+
+    const OnnxValue& output() const
+    {
+        return m_values[m_output];
+    }
+
+    void run(const float* input, float* output)
+    {
+        for (const OnnxStepData& step : m_steps)
+        {
+            auto tensor = [&](int v)
+            {
+                const OnnxValue& value = m_values[v];
+                TRTCpuTensor t;
+                t.channels = value.channels;
+                t.height = value.height;
+                t.width = value.width;
+                t.data = (v == 0) ? const_cast<float*>(input) : ((v == m_output) ? output : m_buffers[value.buffer].data());
+                return t;
+            };
+
+            TRTCpuTensor result = tensor(step.output);
+            switch (step.op)
+            {
+            case OnnxStep::Conv:
+                convolve(m_pool, tensor(step.inputs[0]), step.weights, step.bias, step.conv, result, m_scratch);
+                break;
+            case OnnxStep::Activation:
+                activate(m_pool, tensor(step.inputs[0]), step.activation, result);
+                break;
+            case OnnxStep::Binary:
+                if (step.operand != nullptr)
+                    binaryOp(m_pool, step.binaryOp, tensor(step.inputs[0]), step.operand, step.operandSize, step.operandFirst, result);
+                else
+                {
+                    TRTCpuTensor b = tensor(step.inputs[1]);
+                    binaryOp(m_pool, step.binaryOp, tensor(step.inputs[0]), b.data, b.size(), false, result);
+                }
+                break;
+            case OnnxStep::Concat:
+                {
+                    std::vector<TRTCpuTensor> inputs;
+                    for (int v : step.inputs)
+                        inputs.push_back(tensor(v));
+                    std::vector<const TRTCpuTensor*> pointers;
+                    for (const TRTCpuTensor& t : inputs)
+                        pointers.push_back(&t);
+                    concatenate(m_pool, pointers, result);
+                }
+                break;
+            case OnnxStep::DepthToSpace:
+                depthToSpace(m_pool, tensor(step.inputs[0]), step.blockSize, step.crd, result);
+                break;
+            case OnnxStep::Resize:
+                resize(m_pool, tensor(step.inputs[0]), step.rows, step.columns, step.nearest, result);
+                break;
+            }
+        }
+
+        // A model without operators copies its input
+        if (m_output == 0)
+            ::memcpy(output, input, m_values[0].channels * size_type(m_values[0].height) * m_values[0].width * sizeof(float));
+    }
+
+private:
+    OnnxModel m_model;
+    std::map<IsoString, int> m_valueIndices;
+    std::map<IsoString, IsoString> m_aliases;
+    std::vector<OnnxValue> m_values;
+    std::vector<OnnxStepData> m_steps;
+    std::vector<std::vector<float>> m_buffers;
+    std::vector<float> m_scratch;
+    int m_output = 0;
+    TRTCpuThreadPool m_pool;
+
+    IsoString resolve(const IsoString& name) const
+    {
+        auto alias = m_aliases.find(name);
+        return (alias != m_aliases.end()) ? alias->second : name;
+    }
+
+    const OnnxTensor* constant(const IsoString& name) const
+    {
+        auto c = m_model.initializers.find(resolve(name));
+        return (c != m_model.initializers.end()) ? &c->second : nullptr;
+    }
+
+    const OnnxTensor& requireConstant(const OnnxNode& node, size_type index) const
+    {
+        const OnnxTensor* c = node.hasInput(index) ? constant(node.inputs[index]) : nullptr;
+        if (c == nullptr)
+            throw Error("Input " + String(index) + " of ONNX " + String(node.opType) + " node " + String(node.name) + " must be a constant.");
+        return *c;
+    }
+
+    int value(const OnnxNode& node, size_type index) const
+    {
+        auto v = node.hasInput(index) ? m_valueIndices.find(resolve(node.inputs[index])) : m_valueIndices.end();
+        if (v == m_valueIndices.end())
+            throw Error("Input " + String(index) + " of ONNX " + String(node.opType) + " node " + String(node.name) + " is not available.");
+        return v->second;
+    }
+
+    int addValue(const IsoString& name, int channels, int height, int width)
+    {
+        if ((channels <= 0) || (height <= 0) || (width <= 0))
+            throw Error("ONNX tensor " + String(name) + " would be empty at this tile size.");
+        OnnxValue v;
+        v.channels = channels;
+        v.height = height;
+        v.width = width;
+        m_values.push_back(v);
+        m_valueIndices[name] = int(m_values.size()) - 1;
+        return int(m_values.size()) - 1;
+    }
+
+    void compile(int tileH, int tileW);
+    void compileConv(const OnnxNode& node);
+    void compileActivation(const OnnxNode& node, const std::map<IsoString, int>& uses);
+    void compileBinary(const OnnxNode& node);
+    void compileConcat(const OnnxNode& node);
+    void compileDepthToSpace(const OnnxNode& node);
+    void compileResize(const OnnxNode& node);
+    void allocateBuffers();
+};
+
+void TRTOnnxGraph::compile(int tileH, int tileW)
+{
+    addValue(m_model.inputName, int(m_model.inputDims[1]), tileH, tileW);
+
+    // Activations are fused into a convolution whose output has no other use
+    std::map<IsoString, int> uses;
+    for (const OnnxNode& node : m_model.nodes)
+        for (const IsoString& input : node.inputs)
+            uses[input]++;
+    uses[m_model.outputName]++;
+
+    for (const OnnxNode& node : m_model.nodes)
+    {
+        const IsoString& op = node.opType;
+        if (node.outputs.empty())
+            continue;
+        if (op == "Constant")
+        {
+            const OnnxAttribute* a = node.attribute("value");
+            OnnxTensor tensor;
+            if (a != nullptr)
+                tensor = a->t;
+            else if ((a = node.attribute("value_float")) != nullptr)
+                tensor.values.push_back(a->f);
+            else if ((a = node.attribute("value_floats")) != nullptr)
+            {
+                tensor.values = a->floats;
+                tensor.dims.push_back(int64(a->floats.size()));
+            }
+            else if ((a = node.attribute("value_int")) != nullptr)
+                tensor.values.push_back(float(a->i));
+            else if ((a = node.attribute("value_ints")) != nullptr)
+            {
+                for (int64 i : a->ints)
+                    tensor.values.push_back(float(i));
+                tensor.dims.push_back(int64(a->ints.size()));
+            }
+            else
+                throw Error("Unsupported ONNX Constant node " + String(node.name));
+            m_model.initializers[node.outputs[0]] = std::move(tensor);
+        }
+        else if ((op == "Identity") || (op == "Dropout"))
+            m_aliases[node.outputs[0]] = resolve(node.inputs[0]);
+        else if (op == "Conv")
+            compileConv(node);
+        else if ((op == "Relu") || (op == "LeakyRelu") || (op == "PRelu") || (op == "Sigmoid") || (op == "Tanh") || (op == "Clip"))
+            compileActivation(node, uses);
+        else if ((op == "Add") || (op == "Sub") || (op == "Mul") || (op == "Div"))
+            compileBinary(node);
+        else if (op == "Concat")
+            compileConcat(node);
+        else if (op == "DepthToSpace")
+            compileDepthToSpace(node);
+        else if ((op == "Resize") || (op == "Upsample"))
+            compileResize(node);
+        else
+            throw Error("ONNX operator " + String(op) + " is not supported by the CPU backend.");
+    }
+
+    auto output = m_valueIndices.find(resolve(m_model.outputName));
+    if (output == m_valueIndices.end())
+        throw Error("The output of the ONNX model is not computed from its input.");
+    m_output = output->second;
+
+    allocateBuffers();
+}
+
+void TRTOnnxGraph::compileConv(const OnnxNode& node)
+{
+    const OnnxValue& x = m_values[value(node, 0)];
+    const OnnxTensor& w = requireConstant(node, 1);
+    if (w.dims.size() != 4)
+        throw Error("Only 2-D ONNX convolutions are supported: " + String(node.name));
+
+    OnnxStepData step;
+    step.op = OnnxStep::Conv;
+    step.inputs.push_back(value(node, 0));
+    step.weights = w.values.data();
+    if (node.hasInput(2))
+        step.bias = requireConstant(node, 2).values.data();
+
+    TRTCpuConvParams& p = step.conv;
+    int outputChannels = int(w.dims[0]);
+    p.groups = int(node.intAttribute("group", 1));
+    p.kernelH = int(w.dims[2]);
+    p.kernelW = int(w.dims[3]);
+    std::vector<int64> strides = node.intsAttribute("strides");
+    if (strides.size() == 2)
+    {
+        p.strideH = int(strides[0]);
+        p.strideW = int(strides[1]);
+    }
+    std::vector<int64> dilations = node.intsAttribute("dilations");
+    if (dilations.size() == 2)
+    {
+        p.dilationH = int(dilations[0]);
+        p.dilationW = int(dilations[1]);
+    }
+    if ((x.channels % p.groups != 0) || (outputChannels % p.groups != 0) || (w.dims[1] * p.groups != x.channels))
+        throw Error("Inconsistent channels in ONNX convolution " + String(node.name));
+
+    int extentH = p.dilationH * (p.kernelH - 1) + 1;
+    int extentW = p.dilationW * (p.kernelW - 1) + 1;
+    IsoString autoPad = node.stringAttribute("auto_pad", "NOTSET");
+    if ((autoPad == "SAME_UPPER") || (autoPad == "SAME_LOWER"))
+    {
+        // Output size is the input size divided by the stride, rounded up
+        int padH = Max(0, ((x.height + p.strideH - 1) / p.strideH - 1) * p.strideH + extentH - x.height);
+        int padW = Max(0, ((x.width + p.strideW - 1) / p.strideW - 1) * p.strideW + extentW - x.width);
+        bool upper = autoPad == "SAME_UPPER";
+        p.padTop = upper ? padH / 2 : padH - padH / 2;
+        p.padBottom = padH - p.padTop;
+        p.padLeft = upper ? padW / 2 : padW - padW / 2;
+        p.padRight = padW - p.padLeft;
+    }
+    else if (autoPad != "VALID")
+    {
+        std::vector<int64> pads = node.intsAttribute("pads");
+        if (pads.size() == 4)
+        {
+            p.padTop = int(pads[0]);
+            p.padLeft = int(pads[1]);
+            p.padBottom = int(pads[2]);
+            p.padRight = int(pads[3]);
+        }
+    }
+
+    int height = (x.height + p.padTop + p.padBottom - extentH) / p.strideH + 1;
+    int width = (x.width + p.padLeft + p.padRight - extentW) / p.strideW + 1;
+    step.output = addValue(node.outputs[0], outputChannels, height, width);
+    m_steps.push_back(step);
+}
+
+void TRTOnnxGraph::compileActivation(const OnnxNode& node, const std::map<IsoString, int>& uses)
+{
+    TRTCpuActivationParams a;
+    const IsoString& op = node.opType;
+    if (op == "Relu")
+        a.type = TRTCpuActivation::Relu;
+    else if (op == "LeakyRelu")
+    {
+        a.type = TRTCpuActivation::LeakyRelu;
+        a.alpha = node.floatAttribute("alpha", 0.01f);
+    }
+    else if (op == "PRelu")
+    {
+        const OnnxTensor& slopes = requireConstant(node, 1);
+        a.type = TRTCpuActivation::PRelu;
+        a.slopes = slopes.values.data();
+        a.numSlopes = int(slopes.values.size());
+        if ((a.numSlopes != 1) && (a.numSlopes != m_values[value(node, 0)].channels))
+            throw Error("Only scalar or per-channel PRelu slopes are supported: " + String(node.name));
+    }
+    else if (op == "Sigmoid")
+        a.type = TRTCpuActivation::Sigmoid;
+    else if (op == "Tanh")
+        a.type = TRTCpuActivation::Tanh;
+    else
+    {
+        // Bounds are attributes up to opset 10, optional inputs since
+        a.type = TRTCpuActivation::Clip;
+        a.alpha = node.floatAttribute("min", -3.402823e38f);
+        a.beta = node.floatAttribute("max", 3.402823e38f);
+        if (node.hasInput(1))
+            a.alpha = requireConstant(node, 1).values.at(0);
+        if (node.hasInput(2))
+            a.beta = requireConstant(node, 2).values.at(0);
+    }
+
+    int input = value(node, 0);
+    const IsoString& inputName = node.inputs[0];
+    auto inputUses = uses.find(inputName);
+    if (!m_steps.empty() && (m_steps.back().op == OnnxStep::Conv) && (m_steps.back().output == input) &&
+        (m_steps.back().conv.activation.type == TRTCpuActivation::None) && (inputName == resolve(inputName)) &&
+        (inputUses != uses.end()) && (inputUses->second == 1))
+    {
+        m_steps.back().conv.activation = a;
+        m_valueIndices[node.outputs[0]] = input;
+        return;
+    }
+
+    OnnxStepData step;
+    step.op = OnnxStep::Activation;
+    step.activation = a;
+    step.inputs.push_back(input);
+    const OnnxValue& x = m_values[input];
+    step.output = addValue(node.outputs[0], x.channels, x.height, x.width);
+    m_steps.push_back(step);
+}
+
+void TRTOnnxGraph::compileBinary(const OnnxNode& node)
+{
+    OnnxStepData step;
+    step.op = OnnxStep::Binary;
+    const IsoString& op = node.opType;
+    step.binaryOp = (op == "Add") ? TRTCpuBinaryOp::Add : ((op == "Sub") ? TRTCpuBinaryOp::Sub :
+                    ((op == "Mul") ? TRTCpuBinaryOp::Mul : TRTCpuBinaryOp::Div));
+
+    const OnnxTensor* c0 = constant(node.inputs.at(0));
+    const OnnxTensor* c1 = constant(node.inputs.at(1));
+    if ((c0 != nullptr) && (c1 != nullptr))
+        throw Error("ONNX " + String(op) + " node " + String(node.name) + " has no variable operand.");
+
+    int input;
+    if ((c0 == nullptr) && (c1 == nullptr))
+    {
+        input = value(node, 0);
+        int other = value(node, 1);
+        const OnnxValue& a = m_values[input];
+        const OnnxValue& b = m_values[other];
+        if ((a.channels != b.channels) || (a.height != b.height) || (a.width != b.width))
+            throw Error("Broadcasting between variable tensors is not supported: " + String(node.name));
+        step.inputs.push_back(input);
+        step.inputs.push_back(other);
+    }
+    else
+    {
+        const OnnxTensor& c = (c0 != nullptr) ? *c0 : *c1;
+        input = value(node, (c0 != nullptr) ? 1 : 0);
+        const OnnxValue& a = m_values[input];
+
+        // Broadcasting a constant: leading unit dimensions aside, it must be a scalar, one value per
+        // channel, or the whole tensor
+        std::vector<int64> dims = c.dims;
+        while (!dims.empty() && (dims[0] == 1) && (dims.size() > 3))
+            dims.erase(dims.begin());
+        bool scalar = c.values.size() == 1;
+        bool perChannel = (dims.size() == 3) && (dims[0] == a.channels) && (dims[1] == 1) && (dims[2] == 1);
+        bool whole = (dims.size() == 3) && (dims[0] == a.channels) && (dims[1] == a.height) && (dims[2] == a.width);
+        if (!scalar && !perChannel && !whole)
+            throw Error("Unsupported broadcasting in ONNX " + String(op) + " node " + String(node.name));
+        step.inputs.push_back(input);
+        step.operand = c.values.data();
+        step.operandSize = c.values.size();
+        step.operandFirst = c0 != nullptr;
+    }
+
+    const OnnxValue& a = m_values[input];
+    step.output = addValue(node.outputs[0], a.channels, a.height, a.width);
+    m_steps.push_back(step);
+}
+
+void TRTOnnxGraph::compileConcat(const OnnxNode& node)
+{
+    int64 axis = node.intAttribute("axis", 1);
+    if ((axis != 1) && (axis != -3))
+        throw Error("Only channel concatenation is supported: " + String(node.name));
+
+    OnnxStepData step;
+    step.op = OnnxStep::Concat;
+    int channels = 0;
+    for (size_type i = 0; i < node.inputs.size(); i++)
+    {
+        int v = value(node, i);
+        const OnnxValue& x = m_values[v];
+        const OnnxValue& first = m_values[value(node, 0)];
+        if ((x.height != first.height) || (x.width != first.width))
+            throw Error("Concatenated tensors of different dimensions: " + String(node.name));
+        step.inputs.push_back(v);
+        channels += x.channels;
+    }
+    const OnnxValue& first = m_values[step.inputs[0]];
+    step.output = addValue(node.outputs[0], channels, first.height, first.width);
+    m_steps.push_back(step);
+}
+
+void TRTOnnxGraph::compileDepthToSpace(const OnnxNode& node)
+{
+    OnnxStepData step;
+    step.op = OnnxStep::DepthToSpace;
+    step.inputs.push_back(value(node, 0));
+    step.blockSize = int(node.intAttribute("blocksize", 1));
+    step.crd = node.stringAttribute("mode", "DCR") == "CRD";
+    const OnnxValue& x = m_values[step.inputs[0]];
+    int r2 = step.blockSize * step.blockSize;
+    if ((step.blockSize < 1) || (x.channels % r2 != 0))
+        throw Error("Invalid ONNX DepthToSpace block size: " + String(node.name));
+    step.output = addValue(node.outputs[0], x.channels / r2, x.height * step.blockSize, x.width * step.blockSize);
+    m_steps.push_back(step);
+}
+
+// Source coordinates of the output indices of one dimension, as defined by the ONNX Resize operator
+static TRTCpuResizeTable resizeTable(int inputSize, int outputSize, float scale, const IsoString& transform, const IsoString& nearestMode,
+                                     bool nearest)
+{
+    TRTCpuResizeTable table;
+    for (int i = 0; i < outputSize; i++)
+    {
+        double x;
+        if (transform == "align_corners")
+            x = (outputSize > 1) ? double(i) * (inputSize - 1) / (outputSize - 1) : 0.0;
+        else if (transform == "asymmetric")
+            x = i / double(scale);
+        else if (transform == "tf_half_pixel_for_nn")
+            x = (i + 0.5) / scale;
+        else if ((transform == "pytorch_half_pixel") && (outputSize <= 1))
+            x = 0;
+        else
+            x = (i + 0.5) / scale - 0.5;
+
+        if (nearest)
+        {
+            int index;
+            if (nearestMode == "floor")
+                index = int(std::floor(x));
+            else if (nearestMode == "ceil")
+                index = int(std::ceil(x));
+            else if (nearestMode == "round_prefer_ceil")
+                index = int(std::floor(x + 0.5));
+            else
+                index = int(std::ceil(x - 0.5));
+            index = Range(index, 0, inputSize - 1);
+            table.index0.push_back(index);
+            table.index1.push_back(index);
+            table.fraction.push_back(0.0f);
+        }
+        else
+        {
+            x = Range(x, 0.0, double(inputSize - 1));
+            int index = int(x);
+            table.index0.push_back(index);
+            table.index1.push_back(Min(index + 1, inputSize - 1));
+            table.fraction.push_back(float(x - index));
+        }
+    }
+    return table;
+}
+
+void TRTOnnxGraph::compileResize(const OnnxNode& node)
+{
+    OnnxStepData step;
+    step.op = OnnxStep::Resize;
+    step.inputs.push_back(value(node, 0));
+    const OnnxValue& x = m_values[step.inputs[0]];
+
+    // Upsample and the first Resize take the scales as attribute or second input, later versions of
+    // Resize as third input, or output sizes as fourth input
+    std::vector<float> scales;
+    std::vector<float> sizes;
+    IsoString transform = "asymmetric";
+    IsoString nearestMode = "floor";
+    if (node.opType == "Upsample")
+    {
+        const OnnxAttribute* a = node.attribute("scales");
+        if (a != nullptr)
+            scales = a->floats;
+        else
+            scales = requireConstant(node, 1).values;
+    }
+    else if (node.inputs.size() == 2)
+        scales = requireConstant(node, 1).values;
+    else
+    {
+        transform = node.stringAttribute("coordinate_transformation_mode", "half_pixel");
+        nearestMode = node.stringAttribute("nearest_mode", "round_prefer_floor");
+        if (node.hasInput(3))
+            sizes = requireConstant(node, 3).values;
+        else
+            scales = requireConstant(node, 2).values;
+    }
+
+    IsoString mode = node.stringAttribute("mode", "nearest");
+    step.nearest = mode == "nearest";
+    if (!step.nearest && (mode != "linear") && (mode != "bilinear"))
+        throw Error("Unsupported ONNX resize mode " + String(mode) + ": " + String(node.name));
+
+    int height, width;
+    float scaleH, scaleW;
+    if (!sizes.empty())
+    {
+        if ((sizes.size() != 4) || (int(sizes[1]) != x.channels))
+            throw Error("Only spatial ONNX resizing is supported: " + String(node.name));
+        height = int(sizes[2]);
+        width = int(sizes[3]);
+        scaleH = float(height) / x.height;
+        scaleW = float(width) / x.width;
+    }
+    else
+    {
+        if ((scales.size() != 4) || (scales[0] != 1) || (scales[1] != 1))
+            throw Error("Only spatial ONNX resizing is supported: " + String(node.name));
+        scaleH = scales[2];
+        scaleW = scales[3];
+        height = int(std::floor(x.height * scaleH));
+        width = int(std::floor(x.width * scaleW));
+    }
+
+    step.rows = resizeTable(x.height, height, scaleH, transform, nearestMode, step.nearest);
+    step.columns = resizeTable(x.width, width, scaleW, transform, nearestMode, step.nearest);
+    step.output = addValue(node.outputs[0], x.channels, height, width);
+    m_steps.push_back(step);
+}
+
+void TRTOnnxGraph::allocateBuffers()
+{
+    for (size_type s = 0; s < m_steps.size(); s++)
+        for (int v : m_steps[s].inputs)
+            m_values[v].lastUse = int(s);
+
+    // A buffer is reused once the last step reading its value is done. The input and output of the
+    // graph live in the buffers of the engine.
+    std::vector<int> free;
+    for (size_type s = 0; s < m_steps.size(); s++)
+    {
+        int v = m_steps[s].output;
+        if (v != m_output)
+        {
+            size_type size = m_values[v].channels * size_type(m_values[v].height) * m_values[v].width;
+            int best = -1;
+            for (size_type i = 0; i < free.size(); i++)
+                if (m_buffers[free[i]].size() >= size)
+                    if ((best < 0) || (m_buffers[free[i]].size() < m_buffers[free[best]].size()))
+                        best = int(i);
+            if (best >= 0)
+            {
+                m_values[v].buffer = free[best];
+                free.erase(free.begin() + best);
+            }
+            else
+            {
+                m_values[v].buffer = int(m_buffers.size());
+                m_buffers.emplace_back(size);
+            }
+        }
+
+        for (int input : m_steps[s].inputs)
+            if ((m_values[input].lastUse == int(s)) && (m_values[input].buffer >= 0))
+                if (std::find(free.begin(), free.end(), m_values[input].buffer) == free.end())
+                    free.push_back(m_values[input].buffer);
+    }
+}
+
+TRTOnnxEngine::TRTOnnxEngine(const String& modelPath, int tileSize)
+{
+    File file(modelPath, FileMode::Read);
+    if (!file.IsOpen())
+        throw Error("Unable to open ONNX model file " + modelPath);
+    auto size = file.Size();
+    ByteArray buffer(size);
+    file.Read(buffer.Begin(), size);
+    file.Close();
+    m_engineHash = Hash64(buffer.Begin(), size);
+
+    OnnxModel model = parseModel(buffer);
+    int channels = int(model.inputDims[1]);
+    if ((channels != 1) && (channels != 3))
+        throw Error("The input of the ONNX model does not have 1 or 3 channels.");
+    m_numChannels = channels;
+    m_inputName = model.inputName;
+    m_outputName = model.outputName;
+    m_dynamic = (model.inputDims[2] <= 0) || (model.inputDims[3] <= 0);
+    m_inputTileH = (model.inputDims[2] > 0) ? int(model.inputDims[2]) : tileSize;
+    m_inputTileW = (model.inputDims[3] > 0) ? int(model.inputDims[3]) : tileSize;
+
+    m_graph = std::make_unique<TRTOnnxGraph>(std::move(model), m_inputTileH, m_inputTileW);
+    const OnnxValue& output = m_graph->output();
+    if (output.channels != m_numChannels)
+        throw Error("The output of the ONNX model does not have the same number of channels as its input.");
+    m_outputTileH = output.height;
+    m_outputTileW = output.width;
+    if (((m_outputTileW % m_inputTileW) != 0) || ((m_outputTileH % m_inputTileH) != 0))
+        throw Error("Shape of the output of the ONNX model is not multiple of its input.");
+
+    setNumberOfPlanes(m_numChannels);
+}
+
+TRTOnnxEngine::~TRTOnnxEngine()
+{
+}
+
+void TRTOnnxEngine::setNumberOfPlanes(int32_t numPlanes)
+{
+    if ((numPlanes != m_numChannels) && (m_numChannels != 1))
+        throw Error(String().Format("A %d-channel engine cannot process %d-plane tiles.", m_numChannels, numPlanes));
+    m_numPlanes = numPlanes;
+    m_inputBuffer.resize(size_type(numPlanes) * m_inputTileW * m_inputTileH);
+    m_outputBuffer.resize(size_type(numPlanes) * m_outputTileW * m_outputTileH);
+}
+
+void TRTOnnxEngine::runInference()
+{
+    // Single-channel models process the planes one at a time
+    size_type inputSize = size_type(m_numChannels) * m_inputTileW * m_inputTileH;
+    size_type outputSize = size_type(m_numChannels) * m_outputTileW * m_outputTileH;
+    for (int32_t plane = 0; plane < m_numPlanes; plane += m_numChannels)
+        m_graph->run(m_inputBuffer.data() + plane / m_numChannels * inputSize, m_outputBuffer.data() + plane / m_numChannels * outputSize);
+}
+
+void TRTOnnxEngine::setNumberOfThreads(int numThreads)
+{
+    m_graph->setNumberOfThreads(numThreads);
+}
+
+}	// namespace pcl
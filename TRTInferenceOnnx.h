@@ -0,0 +1,68 @@
+#ifndef __TRTInferenceOnnx_h
+#define __TRTInferenceOnnx_h
+
+#include <memory>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+class TRTOnnxGraph;
+
+// ONNX model run on the CPU, for machines without a TensorRT backend. The model is compiled for fixed
+// tile dimensions: those of its input, or tileSize pixels when they are dynamic. Covers the operators
+// of typical denoising and upscaling networks: Conv, including grouped and depthwise; Relu, LeakyRelu,
+// PRelu, Sigmoid, Tanh and Clip, fused into the preceding convolution when possible; Add, Sub, Mul
+// and Div; Concat; DepthToSpace; Resize and Upsample, nearest or linear; Identity, Dropout and Constant.
+class TRTOnnxEngine : public TRTEngine
+{
+public:
+    explicit TRTOnnxEngine(const String& modelPath, int tileSize = 256);
+    ~TRTOnnxEngine() override;
+
+    void setNumberOfPlanes(int32_t numPlanes) override;
+
+    float* getInputBuffer() override
+    {
+        return m_inputBuffer.data();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return m_outputBuffer.data();
+    }
+
+    void runInference() override;
+
+    void setNumberOfThreads(int numThreads) override;
+
+    const IsoString& getInputName() const
+    {
+        return m_inputName;
+    }
+
+    const IsoString& getOutputName() const
+    {
+        return m_outputName;
+    }
+
+    // True when the model leaves the tile dimensions open
+    bool isDynamic() const
+    {
+        return m_dynamic;
+    }
+
+private:
+    std::unique_ptr<TRTOnnxGraph> m_graph;
+    IsoString m_inputName;
+    IsoString m_outputName;
+    bool m_dynamic = false;
+    std::vector<float> m_inputBuffer;
+    std::vector<float> m_outputBuffer;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceOnnx_h
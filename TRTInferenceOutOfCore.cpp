@@ -0,0 +1,196 @@
+#include <pcl/File.h>
+
+#include "TRTInferenceOutOfCore.h"
+
+namespace pcl
+{
+
+void shiftBandRows(FImage& band, int numRows)
+{
+    numRows = Min(numRows, band.Height());
+    size_type rowSize = size_type(band.Width()) * sizeof(float);
+    for (int c = 0; c < band.NumberOfChannels(); c++)
+    {
+        if (numRows < band.Height())
+            ::memmove(band.ScanLine(0, c), band.ScanLine(numRows, c), (band.Height() - numRows) * rowSize);
+        ::memset(band.ScanLine(band.Height() - numRows, c), 0, numRows * rowSize);
+    }
+}
+
+TRTBandReader::TRTBandReader(const String& path)
+    : m_format(File::ExtractExtension(path), true, false)
+    , m_file(m_format)
+{
+    if (!m_format.CanReadIncrementally())
+        throw Error("The " + m_format.Name() + " format does not support incremental reads: " + path);
+
+    ImageDescriptionArray images;
+    if (!m_file.Open(images, path))
+        throw Error("Unable to open file: " + path);
+    if (images.IsEmpty())
+        throw Error("Empty image file: " + path);
+    m_info = images[0].info;
+    m_options = images[0].options;
+    if (m_options.complexSample || (m_options.bitsPerSample == 64))
+        throw Error("Unsupported sample format: " + path);
+    if ((m_info.numberOfChannels != 1) && (m_info.numberOfChannels != 3))
+        throw Error("Only single-channel or RGB images can be processed: " + path);
+    if (m_format.CanStoreKeywords())
+        m_file.ReadFITSKeywords(m_keywords);
+
+    m_rows.CreateImage(m_options.ieeefpSampleFormat, false, m_options.bitsPerSample);
+}
+
+TRTBandReader::~TRTBandReader()
+{
+    if (m_file.IsOpen())
+        m_file.Close();
+}
+
+bool TRTBandReader::canRead(const String& path)
+{
+    return FileFormat(File::ExtractExtension(path), true, false).CanReadIncrementally();
+}
+
+void TRTBandReader::read(int startRow, FImage& band)
+{
+    int endRow = Min(startRow + band.Height(), m_info.height);
+    int firstNewRow = startRow;
+    if ((startRow >= m_bandTop) && (startRow < m_bandEnd))
+    {
+        shiftBandRows(band, startRow - m_bandTop);
+        firstNewRow = m_bandEnd;
+    }
+    if (firstNewRow < endRow)
+        readRows(firstNewRow, endRow - firstNewRow, band, firstNewRow - startRow);
+
+    int lastRow = endRow - startRow - 1;
+    size_type rowSize = size_type(band.Width()) * sizeof(float);
+    for (int c = 0; c < band.NumberOfChannels(); c++)
+        for (int y = lastRow + 1; y < band.Height(); y++)
+            ::memcpy(band.ScanLine(y, c), band.ScanLine(lastRow, c), rowSize);
+
+    m_bandTop = startRow;
+    m_bandEnd = endRow;
+}
+
+template <class P>
+static void convertRows(const GenericImage<P>& rows, FImage& band, int bandRow)
+{
+    // Same conversion as GenericImage::Assign, so the samples match those of an image read in memory
+    for (int c = 0; c < rows.NumberOfChannels(); c++)
+        for (int y = 0; y < rows.Height(); y++)
+        {
+            const typename P::sample* __restrict s = rows.ScanLine(y, c);
+            float* __restrict d = band.ScanLine(bandRow + y, c);
+            for (int x = 0; x < rows.Width(); x++)
+                FloatPixelTraits::FromSample(d[x], s[x]);
+        }
+}
+
+template <class P>
+static void readRows(FileFormatInstance& file, GenericImage<P>& rows, int startRow, FImage& band, int bandRow)
+{
+    for (int c = 0; c < rows.NumberOfChannels(); c++)
+        if (!file.ReadSamples(rows.PixelData(c), startRow, rows.Height(), c))
+            throw Error(String().Format("Unable to read rows %d to %d of the input file.", startRow, startRow + rows.Height() - 1));
+    convertRows(rows, band, bandRow);
+}
+
+void TRTBandReader::readRows(int startRow, int numRows, FImage& band, int bandRow)
+{
+    m_rows.AllocateImage(m_info.width, numRows, m_info.numberOfChannels, ColorSpace::value_type(m_info.colorSpace));
+    if (m_rows.IsFloatSample())
+        pcl::readRows(m_file, static_cast<FImage&>(*m_rows), startRow, band, bandRow);
+    else
+        switch (m_rows.BitsPerSample())
+        {
+        case 8:
+            pcl::readRows(m_file, static_cast<UInt8Image&>(*m_rows), startRow, band, bandRow);
+            break;
+        case 16:
+            pcl::readRows(m_file, static_cast<UInt16Image&>(*m_rows), startRow, band, bandRow);
+            break;
+        case 32:
+            pcl::readRows(m_file, static_cast<UInt32Image&>(*m_rows), startRow, band, bandRow);
+            break;
+        }
+}
+
+TRTBandWriter::TRTBandWriter(const String& path, const ImageInfo& info, const ImageOptions& options, const FITSKeywordArray& keywords)
+    : m_format(File::ExtractExtension(path), false, true)
+    , m_file(m_format)
+    , m_path(path)
+    , m_height(info.height)
+{
+    if (!m_format.CanWriteIncrementally())
+        throw Error("The " + m_format.Name() + " format does not support incremental writes: " + path);
+    if (!m_file.Create(path))
+        throw Error("Unable to create file: " + path);
+    m_file.SetOptions(options);
+    if (m_format.CanStoreKeywords())
+        m_file.WriteFITSKeywords(keywords);
+    if (!m_file.CreateImage(info))
+        throw Error("Unable to create the output image: " + path);
+    m_open = true;
+}
+
+TRTBandWriter::~TRTBandWriter()
+{
+    // An incomplete file is useless; drop it rather than leave it looking valid. This runs while an
+    // exception unwinds the band loop, so failures are ignored.
+    if (m_open)
+        try
+        {
+            m_file.Close();
+            File::Remove(m_path);
+        }
+        catch (...)
+        {
+        }
+}
+
+bool TRTBandWriter::canWrite(const String& path)
+{
+    return FileFormat(File::ExtractExtension(path), false, true).CanWriteIncrementally();
+}
+
+template <class P>
+static void writeRows(FileFormatInstance& file, const GenericImage<P>& band, int startRow)
+{
+    for (int c = 0; c < band.NumberOfChannels(); c++)
+        if (!file.WriteSamples(band.PixelData(c), startRow, band.Height(), c))
+            throw Error(String().Format("Unable to write rows %d to %d of the output file.", startRow, startRow + band.Height() - 1));
+}
+
+void TRTBandWriter::write(const ImageVariant& band)
+{
+    if (band.IsFloatSample())
+        writeRows(m_file, static_cast<const FImage&>(*band), m_numWritten);
+    else
+        switch (band.BitsPerSample())
+        {
+        case 8:
+            writeRows(m_file, static_cast<const UInt8Image&>(*band), m_numWritten);
+            break;
+        case 16:
+            writeRows(m_file, static_cast<const UInt16Image&>(*band), m_numWritten);
+            break;
+        case 32:
+            writeRows(m_file, static_cast<const UInt32Image&>(*band), m_numWritten);
+            break;
+        }
+    m_numWritten += band.Height();
+}
+
+void TRTBandWriter::close()
+{
+    if (m_numWritten != m_height)
+        throw Error(String().Format("Incomplete output image: %d of %d rows written: ", m_numWritten, m_height) + m_path);
+    if (!m_file.CloseImage())
+        throw Error("Unable to complete the output image: " + m_path);
+    m_file.Close();
+    m_open = false;
+}
+
+}	// namespace pcl
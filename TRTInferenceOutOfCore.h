@@ -0,0 +1,86 @@
+#ifndef __TRTInferenceOutOfCore_h
+#define __TRTInferenceOutOfCore_h
+
+#include <pcl/FileFormat.h>
+#include <pcl/FileFormatInstance.h>
+#include <pcl/ImageVariant.h>
+
+namespace pcl
+{
+
+// Moves the rows of an image up by numRows and zeros the rows freed at the bottom.
+void shiftBandRows(FImage& band, int numRows);
+
+// Reads an image file in horizontal bands, for images which do not fit in memory. Consecutive bands
+// may overlap; the rows shared with the previous band are moved instead of being read again.
+class TRTBandReader
+{
+public:
+    explicit TRTBandReader(const String& path);
+    ~TRTBandReader();
+
+    // True if the format of the file supports incremental reads
+    static bool canRead(const String& path);
+
+    const ImageInfo& info() const
+    {
+        return m_info;
+    }
+
+    const ImageOptions& options() const
+    {
+        return m_options;
+    }
+
+    const FITSKeywordArray& keywords() const
+    {
+        return m_keywords;
+    }
+
+    // Fills the band with the image rows from startRow down, converted to floating point. Band rows past
+    // the bottom of the image replicate the last image row, as extractTile does at the image edge.
+    void read(int startRow, FImage& band);
+
+private:
+    FileFormat m_format;
+    FileFormatInstance m_file;
+    ImageInfo m_info;
+    ImageOptions m_options;
+    FITSKeywordArray m_keywords;
+    // Rows in native sample format, before conversion
+    ImageVariant m_rows;
+    // Image rows held by the band after the last read
+    int m_bandTop = -1;
+    int m_bandEnd = -1;
+
+    void readRows(int startRow, int numRows, FImage& band, int bandRow);
+};
+
+// Writes an image file in consecutive horizontal bands, top to bottom.
+class TRTBandWriter
+{
+public:
+    TRTBandWriter(const String& path, const ImageInfo& info, const ImageOptions& options, const FITSKeywordArray& keywords);
+    ~TRTBandWriter();
+
+    // True if the format of the file supports incremental writes
+    static bool canWrite(const String& path);
+
+    // Writes the band below the rows written so far. Its sample type must match the image options.
+    void write(const ImageVariant& band);
+
+    // Completes the file; all rows must have been written
+    void close();
+
+private:
+    FileFormat m_format;
+    FileFormatInstance m_file;
+    String m_path;
+    int m_height;
+    int m_numWritten = 0;
+    bool m_open = false;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceOutOfCore_h
@@ -0,0 +1,182 @@
+#include <algorithm>
+
+#include "TRTInferenceOverlap.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+static inline float clampSample(float v)
+{
+    return Range(v, 0.0f, 1.0f);
+}
+
+double seamError(const float* a, const float* b, int w, int h, int numChannels, const Point& shift, int seam)
+{
+    double sum = 0;
+    size_type count = 0;
+    for (int c = 0; c < numChannels; c++)
+    {
+        const float* ac = a + size_type(c) * w * h;
+        const float* bc = b + size_type(c) * w * h;
+        if (shift.y == 0)
+        {
+            for (int y = 0; y < h; y++)
+                for (int x = seam - 1; x <= seam; x++)
+                    sum += Abs(clampSample(ac[size_type(y) * w + x]) - clampSample(bc[size_type(y) * w + x - shift.x]));
+            count += size_type(h) * 2;
+        }
+        else
+        {
+            for (int y = seam - 1; y <= seam; y++)
+                for (int x = 0; x < w; x++)
+                    sum += Abs(clampSample(ac[size_type(y) * w + x]) - clampSample(bc[size_type(y - shift.y) * w + x]));
+            count += size_type(w) * 2;
+        }
+    }
+    return (count > 0) ? sum / count : 0.0;
+}
+
+int tileCount(int imageW, int imageH, int tileW, int tileH, double tileOverlap)
+{
+    int stepX = Max(1, int(tileW * (1.0f - tileOverlap)));
+    int stepY = Max(1, int(tileH * (1.0f - tileOverlap)));
+    return ((imageW + stepX - 1) / stepX) * ((imageH + stepY - 1) / stepY);
+}
+
+// Variance of the first channel over a region, sampled sparsely
+static double regionVariance(const FImage& image, const Rect& rect)
+{
+    double sum = 0, sum2 = 0;
+    size_type count = 0;
+    for (int y = rect.y0; y < rect.y1; y += 4)
+    {
+        const float* row = image.ScanLine(y, 0);
+        for (int x = rect.x0; x < rect.x1; x += 4)
+        {
+            sum += row[x];
+            sum2 += double(row[x]) * row[x];
+            count++;
+        }
+    }
+    if (count == 0)
+        return 0;
+    double mean = sum / count;
+    return sum2 / count - mean * mean;
+}
+
+std::vector<TRTOverlapCandidate> probeOverlaps(TRTEngine& engine, const FImage& input, int numPlanes,
+                                               const std::vector<double>& overlaps, double threshold, int numAnchors)
+{
+    int inputTileW = engine.getInputTileW();
+    int inputTileH = engine.getInputTileH();
+    int outputTileW = engine.getOutputTileW();
+    int outputTileH = engine.getOutputTileH();
+    int factorW = outputTileW / inputTileW;
+    int factorH = outputTileH / inputTileH;
+    int imageW = input.Width();
+    int imageH = input.Height();
+
+    std::vector<double> sorted;
+    for (double overlap : overlaps)
+    {
+        int stepX = int(inputTileW * (1.0f - overlap));
+        int stepY = int(inputTileH * (1.0f - overlap));
+        if ((stepX > 0) && (stepY > 0) && (inputTileW - stepX >= 2) && (inputTileH - stepY >= 2))
+            sorted.push_back(overlap);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted.empty())
+        return {};
+
+    // The pairs of the smallest overlap reach farthest from their anchor tile
+    int maxStepX = int(inputTileW * (1.0f - sorted.front()));
+    int maxStepY = int(inputTileH * (1.0f - sorted.front()));
+
+    struct Anchor
+    {
+        Point pos;
+        bool right;
+        bool down;
+        double variance;
+        std::vector<float> output;
+    };
+    std::vector<Anchor> anchors;
+    for (int y = 0; y + inputTileH <= imageH; y += Max(1, inputTileH / 2))
+        for (int x = 0; x + inputTileW <= imageW; x += Max(1, inputTileW / 2))
+        {
+            Anchor anchor;
+            anchor.pos = Point(x, y);
+            anchor.right = x + maxStepX + inputTileW <= imageW;
+            anchor.down = y + maxStepY + inputTileH <= imageH;
+            if (!anchor.right && !anchor.down)
+                continue;
+            anchor.variance = regionVariance(input, Rect(x, y, Min(x + maxStepX + inputTileW, imageW), Min(y + maxStepY + inputTileH, imageH)));
+            anchors.push_back(std::move(anchor));
+        }
+    if (anchors.empty())
+        return {};
+    std::stable_sort(anchors.begin(), anchors.end(), [](const Anchor& a, const Anchor& b) { return a.variance > b.variance; });
+    if (int(anchors.size()) > numAnchors)
+        anchors.resize(numAnchors);
+
+    size_type tileSize = size_type(numPlanes) * outputTileW * outputTileH;
+    auto infer = [&](const Point& pos, std::vector<float>& output)
+    {
+        extractTile(input, pos, inputTileW, inputTileH, numPlanes, engine.getInputBuffer());
+        engine.runInference();
+        output.assign(engine.getOutputBuffer(), engine.getOutputBuffer() + tileSize);
+    };
+    for (Anchor& anchor : anchors)
+        infer(anchor.pos, anchor.output);
+
+    std::vector<TRTOverlapCandidate> candidates;
+    std::vector<float> neighbor;
+    for (double overlap : sorted)
+    {
+        int stepX = int(inputTileW * (1.0f - overlap));
+        int stepY = int(inputTileH * (1.0f - overlap));
+        TRTOverlapCandidate candidate;
+        candidate.overlap = overlap;
+        candidate.numTiles = tileCount(imageW, imageH, inputTileW, inputTileH, overlap);
+        for (const Anchor& anchor : anchors)
+        {
+            if (anchor.right)
+            {
+                infer(Point(anchor.pos.x + stepX, anchor.pos.y), neighbor);
+                candidate.seamError = Max(candidate.seamError,
+                                          seamError(anchor.output.data(), neighbor.data(), outputTileW, outputTileH, numPlanes,
+                                                    Point(stepX * factorW, 0), (stepX + (inputTileW - stepX) / 2) * factorW));
+            }
+            if (anchor.down)
+            {
+                infer(Point(anchor.pos.x, anchor.pos.y + stepY), neighbor);
+                candidate.seamError = Max(candidate.seamError,
+                                          seamError(anchor.output.data(), neighbor.data(), outputTileW, outputTileH, numPlanes,
+                                                    Point(0, stepY * factorH), (stepY + (inputTileH - stepY) / 2) * factorH));
+            }
+        }
+        candidates.push_back(candidate);
+        if (candidate.seamError <= threshold)
+            break;
+    }
+    return candidates;
+}
+
+int selectOverlap(const std::vector<TRTOverlapCandidate>& candidates, double threshold)
+{
+    int best = -1;
+    for (size_type i = 0; i < candidates.size(); i++)
+    {
+        if (candidates[i].seamError <= threshold)
+        {
+            if ((best < 0) || (candidates[best].seamError > threshold) || (candidates[i].overlap < candidates[best].overlap))
+                best = int(i);
+        }
+        else if ((best < 0) || ((candidates[best].seamError > threshold) && (candidates[i].seamError < candidates[best].seamError)))
+            best = int(i);
+    }
+    return best;
+}
+
+}	// namespace pcl
@@ -0,0 +1,44 @@
+#ifndef __TRTInferenceOverlap_h
+#define __TRTInferenceOverlap_h
+
+#include <pcl/Image.h>
+
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Disagreement of two overlapping output tiles where center-crop placement puts the seam between them:
+// the mean absolute difference of their clamped samples on the two lines either side of the seam.
+// Pixel (x, y) of b lies on pixel (x + shift.x, y + shift.y) of a, with one of the shifts zero, and
+// seam is the first column (or row) of a written from b.
+double seamError(const float* a, const float* b, int w, int h, int numChannels, const Point& shift, int seam);
+
+// Number of tiles of the plan of an image at a tile overlap
+int tileCount(int imageW, int imageH, int tileW, int tileH, double tileOverlap);
+
+struct TRTOverlapCandidate
+{
+    double overlap = 0;
+    // Largest seam error of the probed tile pairs
+    double seamError = 0;
+    int numTiles = 0;
+};
+
+// Measures the seam error of tile overlaps in increasing order, up to the first one whose seam error
+// does not exceed threshold. Each overlap is probed on the right and lower neighbors of a few tiles
+// placed where the image has the most structure, as seams do not show in flat areas. Overlaps leaving
+// fewer than two shared pixels are not probed. Returns the measured candidates, empty if the image
+// holds no pair of tiles.
+std::vector<TRTOverlapCandidate> probeOverlaps(TRTEngine& engine, const FImage& input, int numPlanes,
+                                               const std::vector<double>& overlaps, double threshold, int numAnchors = 4);
+
+// Smallest overlap whose seam error does not exceed threshold, or the one with the least seam error
+// when none does. Returns an index into candidates, -1 if there are none.
+int selectOverlap(const std::vector<TRTOverlapCandidate>& candidates, double threshold);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceOverlap_h
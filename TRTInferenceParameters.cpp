@@ -5,6 +5,41 @@ namespace pcl
 
 TRTInferenceTileOverlap* TheTRTInferenceTileOverlapParameter = nullptr;
 TRTInferenceKeepOutputDimension* TheTRTInferenceKeepOutputDimensionParameter = nullptr;
+TRTInferenceSkipUniformTiles* TheTRTInferenceSkipUniformTilesParameter = nullptr;
+TRTInferenceUniformTileTolerance* TheTRTInferenceUniformTileToleranceParameter = nullptr;
+TRTInferenceUniformTilePolicy* TheTRTInferenceUniformTilePolicyParameter = nullptr;
+TRTInferenceUseTileCache* TheTRTInferenceUseTileCacheParameter = nullptr;
+TRTInferenceTileCacheSize* TheTRTInferenceTileCacheSizeParameter = nullptr;
+TRTInferenceTileCacheDiskSize* TheTRTInferenceTileCacheDiskSizeParameter = nullptr;
+TRTInferenceUseTileStore* TheTRTInferenceUseTileStoreParameter = nullptr;
+TRTInferenceBlendMode* TheTRTInferenceBlendModeParameter = nullptr;
+TRTInferenceMonoChannelAverage* TheTRTInferenceMonoChannelAverageParameter = nullptr;
+TRTInferenceBinInput* TheTRTInferenceBinInputParameter = nullptr;
+TRTInferenceUseROI* TheTRTInferenceUseROIParameter = nullptr;
+TRTInferenceROIX0* TheTRTInferenceROIX0Parameter = nullptr;
+TRTInferenceROIY0* TheTRTInferenceROIY0Parameter = nullptr;
+TRTInferenceROIX1* TheTRTInferenceROIX1Parameter = nullptr;
+TRTInferenceROIY1* TheTRTInferenceROIY1Parameter = nullptr;
+TRTInferenceLiveDisplay* TheTRTInferenceLiveDisplayParameter = nullptr;
+TRTInferenceLiveDisplayInterval* TheTRTInferenceLiveDisplayIntervalParameter = nullptr;
+TRTInferenceInputFiles* TheTRTInferenceInputFilesParameter = nullptr;
+TRTInferenceInputFileEnabled* TheTRTInferenceInputFileEnabledParameter = nullptr;
+TRTInferenceInputFilePath* TheTRTInferenceInputFilePathParameter = nullptr;
+TRTInferenceOutputDirectory* TheTRTInferenceOutputDirectoryParameter = nullptr;
+TRTInferenceOutputPostfix* TheTRTInferenceOutputPostfixParameter = nullptr;
+TRTInferenceOverwriteExistingFiles* TheTRTInferenceOverwriteExistingFilesParameter = nullptr;
+TRTInferenceOutOfCore* TheTRTInferenceOutOfCoreParameter = nullptr;
+TRTInferenceUseCheckpoints* TheTRTInferenceUseCheckpointsParameter = nullptr;
+TRTInferenceCheckpointInterval* TheTRTInferenceCheckpointIntervalParameter = nullptr;
+TRTInferenceTileOrder* TheTRTInferenceTileOrderParameter = nullptr;
+TRTInferenceTileBandHeight* TheTRTInferenceTileBandHeightParameter = nullptr;
+TRTInferenceUseInferenceServer* TheTRTInferenceUseInferenceServerParameter = nullptr;
+TRTInferenceTileFarmWorkers* TheTRTInferenceTileFarmWorkersParameter = nullptr;
+TRTInferenceGpuMemoryBudget* TheTRTInferenceGpuMemoryBudgetParameter = nullptr;
+TRTInferenceUseTuningProfile* TheTRTInferenceUseTuningProfileParameter = nullptr;
+TRTInferenceAutoTileOverlap* TheTRTInferenceAutoTileOverlapParameter = nullptr;
+TRTInferenceSeamErrorThreshold* TheTRTInferenceSeamErrorThresholdParameter = nullptr;
+TRTInferencePipelineEngines* TheTRTInferencePipelineEnginesParameter = nullptr;
 
 TRTInferenceTileOverlap::TRTInferenceTileOverlap(MetaProcess* P) : MetaFloat(P)
 {
@@ -51,4 +86,716 @@ bool TRTInferenceKeepOutputDimension::DefaultValue() const
     return false;
 }
 
+TRTInferenceSkipUniformTiles::TRTInferenceSkipUniformTiles(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceSkipUniformTilesParameter = this;
+}
+
+IsoString TRTInferenceSkipUniformTiles::Id() const
+{
+    return "skipUniformTiles";
+}
+
+bool TRTInferenceSkipUniformTiles::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceUniformTileTolerance::TRTInferenceUniformTileTolerance(MetaProcess* P) : MetaFloat(P)
+{
+    TheTRTInferenceUniformTileToleranceParameter = this;
+}
+
+IsoString TRTInferenceUniformTileTolerance::Id() const
+{
+    return "uniformTileTolerance";
+}
+
+int TRTInferenceUniformTileTolerance::Precision() const
+{
+    return 5;
+}
+
+double TRTInferenceUniformTileTolerance::MinimumValue() const
+{
+    return 0.0;
+}
+
+double TRTInferenceUniformTileTolerance::MaximumValue() const
+{
+    return 0.01;
+}
+
+double TRTInferenceUniformTileTolerance::DefaultValue() const
+{
+    return 0.0001;
+}
+
+TRTInferenceUniformTilePolicy::TRTInferenceUniformTilePolicy(MetaProcess* P) : MetaEnumeration(P)
+{
+    TheTRTInferenceUniformTilePolicyParameter = this;
+}
+
+IsoString TRTInferenceUniformTilePolicy::Id() const
+{
+    return "uniformTilePolicy";
+}
+
+size_type TRTInferenceUniformTilePolicy::NumberOfElements() const
+{
+    return NumberOfItems;
+}
+
+IsoString TRTInferenceUniformTilePolicy::ElementId(size_type i) const
+{
+    switch (i)
+    {
+    case Passthrough:
+        return "UniformTile_Passthrough";
+    case Zero:
+        return "UniformTile_Zero";
+    default:
+    case CachedResponse:
+        return "UniformTile_CachedResponse";
+    }
+}
+
+int TRTInferenceUniformTilePolicy::ElementValue(size_type i) const
+{
+    return int(i);
+}
+
+size_type TRTInferenceUniformTilePolicy::DefaultValueIndex() const
+{
+    return size_type(Default);
+}
+
+TRTInferenceUseTileCache::TRTInferenceUseTileCache(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseTileCacheParameter = this;
+}
+
+IsoString TRTInferenceUseTileCache::Id() const
+{
+    return "useTileCache";
+}
+
+bool TRTInferenceUseTileCache::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceTileCacheSize::TRTInferenceTileCacheSize(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceTileCacheSizeParameter = this;
+}
+
+IsoString TRTInferenceTileCacheSize::Id() const
+{
+    return "tileCacheSize";
+}
+
+double TRTInferenceTileCacheSize::MinimumValue() const
+{
+    return 16;
+}
+
+double TRTInferenceTileCacheSize::MaximumValue() const
+{
+    return 65536;
+}
+
+double TRTInferenceTileCacheSize::DefaultValue() const
+{
+    return 1024;
+}
+
+TRTInferenceTileCacheDiskSize::TRTInferenceTileCacheDiskSize(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceTileCacheDiskSizeParameter = this;
+}
+
+IsoString TRTInferenceTileCacheDiskSize::Id() const
+{
+    return "tileCacheDiskSize";
+}
+
+double TRTInferenceTileCacheDiskSize::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceTileCacheDiskSize::MaximumValue() const
+{
+    return 1048576;
+}
+
+double TRTInferenceTileCacheDiskSize::DefaultValue() const
+{
+    return 8192;
+}
+
+TRTInferenceUseTileStore::TRTInferenceUseTileStore(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseTileStoreParameter = this;
+}
+
+IsoString TRTInferenceUseTileStore::Id() const
+{
+    return "useTileStore";
+}
+
+bool TRTInferenceUseTileStore::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceBlendMode::TRTInferenceBlendMode(MetaProcess* P) : MetaEnumeration(P)
+{
+    TheTRTInferenceBlendModeParameter = this;
+}
+
+IsoString TRTInferenceBlendMode::Id() const
+{
+    return "blendMode";
+}
+
+size_type TRTInferenceBlendMode::NumberOfElements() const
+{
+    return NumberOfItems;
+}
+
+IsoString TRTInferenceBlendMode::ElementId(size_type i) const
+{
+    switch (i)
+    {
+    default:
+    case Weighted:
+        return "Blend_Weighted";
+    case CenterCrop:
+        return "Blend_CenterCrop";
+    }
+}
+
+int TRTInferenceBlendMode::ElementValue(size_type i) const
+{
+    return int(i);
+}
+
+size_type TRTInferenceBlendMode::DefaultValueIndex() const
+{
+    return size_type(Default);
+}
+
+TRTInferenceMonoChannelAverage::TRTInferenceMonoChannelAverage(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceMonoChannelAverageParameter = this;
+}
+
+IsoString TRTInferenceMonoChannelAverage::Id() const
+{
+    return "monoChannelAverage";
+}
+
+bool TRTInferenceMonoChannelAverage::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceBinInput::TRTInferenceBinInput(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceBinInputParameter = this;
+}
+
+IsoString TRTInferenceBinInput::Id() const
+{
+    return "binInput";
+}
+
+bool TRTInferenceBinInput::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceUseROI::TRTInferenceUseROI(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseROIParameter = this;
+}
+
+IsoString TRTInferenceUseROI::Id() const
+{
+    return "useROI";
+}
+
+bool TRTInferenceUseROI::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceROIX0::TRTInferenceROIX0(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceROIX0Parameter = this;
+}
+
+IsoString TRTInferenceROIX0::Id() const
+{
+    return "roiX0";
+}
+
+double TRTInferenceROIX0::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceROIX0::MaximumValue() const
+{
+    return int_max;
+}
+
+double TRTInferenceROIX0::DefaultValue() const
+{
+    return 0;
+}
+
+TRTInferenceROIY0::TRTInferenceROIY0(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceROIY0Parameter = this;
+}
+
+IsoString TRTInferenceROIY0::Id() const
+{
+    return "roiY0";
+}
+
+double TRTInferenceROIY0::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceROIY0::MaximumValue() const
+{
+    return int_max;
+}
+
+double TRTInferenceROIY0::DefaultValue() const
+{
+    return 0;
+}
+
+TRTInferenceROIX1::TRTInferenceROIX1(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceROIX1Parameter = this;
+}
+
+IsoString TRTInferenceROIX1::Id() const
+{
+    return "roiX1";
+}
+
+double TRTInferenceROIX1::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceROIX1::MaximumValue() const
+{
+    return int_max;
+}
+
+double TRTInferenceROIX1::DefaultValue() const
+{
+    return 0;
+}
+
+TRTInferenceROIY1::TRTInferenceROIY1(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceROIY1Parameter = this;
+}
+
+IsoString TRTInferenceROIY1::Id() const
+{
+    return "roiY1";
+}
+
+double TRTInferenceROIY1::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceROIY1::MaximumValue() const
+{
+    return int_max;
+}
+
+double TRTInferenceROIY1::DefaultValue() const
+{
+    return 0;
+}
+
+TRTInferenceLiveDisplay::TRTInferenceLiveDisplay(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceLiveDisplayParameter = this;
+}
+
+IsoString TRTInferenceLiveDisplay::Id() const
+{
+    return "liveDisplay";
+}
+
+bool TRTInferenceLiveDisplay::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceLiveDisplayInterval::TRTInferenceLiveDisplayInterval(MetaProcess* P) : MetaFloat(P)
+{
+    TheTRTInferenceLiveDisplayIntervalParameter = this;
+}
+
+IsoString TRTInferenceLiveDisplayInterval::Id() const
+{
+    return "liveDisplayInterval";
+}
+
+int TRTInferenceLiveDisplayInterval::Precision() const
+{
+    return 1;
+}
+
+double TRTInferenceLiveDisplayInterval::MinimumValue() const
+{
+    return 1.0;
+}
+
+double TRTInferenceLiveDisplayInterval::MaximumValue() const
+{
+    return 300.0;
+}
+
+double TRTInferenceLiveDisplayInterval::DefaultValue() const
+{
+    return 10.0;
+}
+
+TRTInferenceInputFiles::TRTInferenceInputFiles(MetaProcess* P) : MetaTable(P)
+{
+    TheTRTInferenceInputFilesParameter = this;
+}
+
+IsoString TRTInferenceInputFiles::Id() const
+{
+    return "inputFiles";
+}
+
+TRTInferenceInputFileEnabled::TRTInferenceInputFileEnabled(MetaTable* T) : MetaBoolean(T)
+{
+    TheTRTInferenceInputFileEnabledParameter = this;
+}
+
+IsoString TRTInferenceInputFileEnabled::Id() const
+{
+    return "enabled";
+}
+
+bool TRTInferenceInputFileEnabled::DefaultValue() const
+{
+    return true;
+}
+
+TRTInferenceInputFilePath::TRTInferenceInputFilePath(MetaTable* T) : MetaString(T)
+{
+    TheTRTInferenceInputFilePathParameter = this;
+}
+
+IsoString TRTInferenceInputFilePath::Id() const
+{
+    return "path";
+}
+
+TRTInferenceOutputDirectory::TRTInferenceOutputDirectory(MetaProcess* P) : MetaString(P)
+{
+    TheTRTInferenceOutputDirectoryParameter = this;
+}
+
+IsoString TRTInferenceOutputDirectory::Id() const
+{
+    return "outputDirectory";
+}
+
+TRTInferenceOutputPostfix::TRTInferenceOutputPostfix(MetaProcess* P) : MetaString(P)
+{
+    TheTRTInferenceOutputPostfixParameter = this;
+}
+
+IsoString TRTInferenceOutputPostfix::Id() const
+{
+    return "outputPostfix";
+}
+
+String TRTInferenceOutputPostfix::DefaultValue() const
+{
+    return "_trt";
+}
+
+TRTInferenceOverwriteExistingFiles::TRTInferenceOverwriteExistingFiles(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceOverwriteExistingFilesParameter = this;
+}
+
+IsoString TRTInferenceOverwriteExistingFiles::Id() const
+{
+    return "overwriteExistingFiles";
+}
+
+bool TRTInferenceOverwriteExistingFiles::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceOutOfCore::TRTInferenceOutOfCore(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceOutOfCoreParameter = this;
+}
+
+IsoString TRTInferenceOutOfCore::Id() const
+{
+    return "outOfCore";
+}
+
+bool TRTInferenceOutOfCore::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceUseCheckpoints::TRTInferenceUseCheckpoints(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseCheckpointsParameter = this;
+}
+
+IsoString TRTInferenceUseCheckpoints::Id() const
+{
+    return "useCheckpoints";
+}
+
+bool TRTInferenceUseCheckpoints::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceCheckpointInterval::TRTInferenceCheckpointInterval(MetaProcess* P) : MetaFloat(P)
+{
+    TheTRTInferenceCheckpointIntervalParameter = this;
+}
+
+IsoString TRTInferenceCheckpointInterval::Id() const
+{
+    return "checkpointInterval";
+}
+
+int TRTInferenceCheckpointInterval::Precision() const
+{
+    return 0;
+}
+
+double TRTInferenceCheckpointInterval::MinimumValue() const
+{
+    return 10;
+}
+
+double TRTInferenceCheckpointInterval::MaximumValue() const
+{
+    return 3600;
+}
+
+double TRTInferenceCheckpointInterval::DefaultValue() const
+{
+    return 300;
+}
+
+TRTInferenceTileOrder::TRTInferenceTileOrder(MetaProcess* P) : MetaEnumeration(P)
+{
+    TheTRTInferenceTileOrderParameter = this;
+}
+
+IsoString TRTInferenceTileOrder::Id() const
+{
+    return "tileOrder";
+}
+
+size_type TRTInferenceTileOrder::NumberOfElements() const
+{
+    return NumberOfItems;
+}
+
+IsoString TRTInferenceTileOrder::ElementId(size_type i) const
+{
+    switch (i)
+    {
+    default:
+    case Raster:
+        return "Order_Raster";
+    case Serpentine:
+        return "Order_Serpentine";
+    case ZOrder:
+        return "Order_ZOrder";
+    case BandMajor:
+        return "Order_BandMajor";
+    }
+}
+
+int TRTInferenceTileOrder::ElementValue(size_type i) const
+{
+    return int(i);
+}
+
+size_type TRTInferenceTileOrder::DefaultValueIndex() const
+{
+    return size_type(Default);
+}
+
+TRTInferenceTileBandHeight::TRTInferenceTileBandHeight(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceTileBandHeightParameter = this;
+}
+
+IsoString TRTInferenceTileBandHeight::Id() const
+{
+    return "tileBandHeight";
+}
+
+double TRTInferenceTileBandHeight::MinimumValue() const
+{
+    return 1;
+}
+
+double TRTInferenceTileBandHeight::MaximumValue() const
+{
+    return 64;
+}
+
+double TRTInferenceTileBandHeight::DefaultValue() const
+{
+    return 4;
+}
+
+TRTInferenceUseInferenceServer::TRTInferenceUseInferenceServer(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseInferenceServerParameter = this;
+}
+
+IsoString TRTInferenceUseInferenceServer::Id() const
+{
+    return "useInferenceServer";
+}
+
+bool TRTInferenceUseInferenceServer::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceTileFarmWorkers::TRTInferenceTileFarmWorkers(MetaProcess* P) : MetaString(P)
+{
+    TheTRTInferenceTileFarmWorkersParameter = this;
+}
+
+IsoString TRTInferenceTileFarmWorkers::Id() const
+{
+    return "tileFarmWorkers";
+}
+
+TRTInferenceGpuMemoryBudget::TRTInferenceGpuMemoryBudget(MetaProcess* P) : MetaInt32(P)
+{
+    TheTRTInferenceGpuMemoryBudgetParameter = this;
+}
+
+IsoString TRTInferenceGpuMemoryBudget::Id() const
+{
+    return "gpuMemoryBudget";
+}
+
+double TRTInferenceGpuMemoryBudget::MinimumValue() const
+{
+    return 0;
+}
+
+double TRTInferenceGpuMemoryBudget::MaximumValue() const
+{
+    return 262144;
+}
+
+double TRTInferenceGpuMemoryBudget::DefaultValue() const
+{
+    return 0;
+}
+
+TRTInferenceUseTuningProfile::TRTInferenceUseTuningProfile(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceUseTuningProfileParameter = this;
+}
+
+IsoString TRTInferenceUseTuningProfile::Id() const
+{
+    return "useTuningProfile";
+}
+
+bool TRTInferenceUseTuningProfile::DefaultValue() const
+{
+    return true;
+}
+
+TRTInferenceAutoTileOverlap::TRTInferenceAutoTileOverlap(MetaProcess* P) : MetaBoolean(P)
+{
+    TheTRTInferenceAutoTileOverlapParameter = this;
+}
+
+IsoString TRTInferenceAutoTileOverlap::Id() const
+{
+    return "autoTileOverlap";
+}
+
+bool TRTInferenceAutoTileOverlap::DefaultValue() const
+{
+    return false;
+}
+
+TRTInferenceSeamErrorThreshold::TRTInferenceSeamErrorThreshold(MetaProcess* P) : MetaFloat(P)
+{
+    TheTRTInferenceSeamErrorThresholdParameter = this;
+}
+
+IsoString TRTInferenceSeamErrorThreshold::Id() const
+{
+    return "seamErrorThreshold";
+}
+
+int TRTInferenceSeamErrorThreshold::Precision() const
+{
+    return 4;
+}
+
+double TRTInferenceSeamErrorThreshold::MinimumValue() const
+{
+    return 0.0001;
+}
+
+double TRTInferenceSeamErrorThreshold::MaximumValue() const
+{
+    return 0.1;
+}
+
+double TRTInferenceSeamErrorThreshold::DefaultValue() const
+{
+    return 0.002;
+}
+
+TRTInferencePipelineEngines::TRTInferencePipelineEngines(MetaProcess* P) : MetaString(P)
+{
+    TheTRTInferencePipelineEnginesParameter = this;
+}
+
+IsoString TRTInferencePipelineEngines::Id() const
+{
+    return "pipelineEngines";
+}
+
 }	// namespace pcl
\ No newline at end of file
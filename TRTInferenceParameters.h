@@ -33,6 +33,441 @@ public:
 
 extern TRTInferenceKeepOutputDimension* TheTRTInferenceKeepOutputDimensionParameter;
 
+class TRTInferenceSkipUniformTiles : public MetaBoolean
+{
+public:
+    TRTInferenceSkipUniformTiles(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceSkipUniformTiles* TheTRTInferenceSkipUniformTilesParameter;
+
+class TRTInferenceUniformTileTolerance : public MetaFloat
+{
+public:
+    TRTInferenceUniformTileTolerance(MetaProcess*);
+
+    IsoString Id() const override;
+    int Precision() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceUniformTileTolerance* TheTRTInferenceUniformTileToleranceParameter;
+
+class TRTInferenceUniformTilePolicy : public MetaEnumeration
+{
+public:
+    enum { Passthrough,
+           Zero,
+           CachedResponse,
+           NumberOfItems,
+           Default = CachedResponse };
+
+    TRTInferenceUniformTilePolicy(MetaProcess*);
+
+    IsoString Id() const override;
+    size_type NumberOfElements() const override;
+    IsoString ElementId(size_type) const override;
+    int ElementValue(size_type) const override;
+    size_type DefaultValueIndex() const override;
+};
+
+extern TRTInferenceUniformTilePolicy* TheTRTInferenceUniformTilePolicyParameter;
+
+class TRTInferenceUseTileCache : public MetaBoolean
+{
+public:
+    TRTInferenceUseTileCache(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseTileCache* TheTRTInferenceUseTileCacheParameter;
+
+class TRTInferenceTileCacheSize : public MetaInt32
+{
+public:
+    TRTInferenceTileCacheSize(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceTileCacheSize* TheTRTInferenceTileCacheSizeParameter;
+
+class TRTInferenceTileCacheDiskSize : public MetaInt32
+{
+public:
+    TRTInferenceTileCacheDiskSize(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceTileCacheDiskSize* TheTRTInferenceTileCacheDiskSizeParameter;
+
+class TRTInferenceUseTileStore : public MetaBoolean
+{
+public:
+    TRTInferenceUseTileStore(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseTileStore* TheTRTInferenceUseTileStoreParameter;
+
+class TRTInferenceBlendMode : public MetaEnumeration
+{
+public:
+    enum { Weighted,
+           CenterCrop,
+           NumberOfItems,
+           Default = Weighted };
+
+    TRTInferenceBlendMode(MetaProcess*);
+
+    IsoString Id() const override;
+    size_type NumberOfElements() const override;
+    IsoString ElementId(size_type) const override;
+    int ElementValue(size_type) const override;
+    size_type DefaultValueIndex() const override;
+};
+
+extern TRTInferenceBlendMode* TheTRTInferenceBlendModeParameter;
+
+class TRTInferenceMonoChannelAverage : public MetaBoolean
+{
+public:
+    TRTInferenceMonoChannelAverage(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceMonoChannelAverage* TheTRTInferenceMonoChannelAverageParameter;
+
+class TRTInferenceBinInput : public MetaBoolean
+{
+public:
+    TRTInferenceBinInput(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceBinInput* TheTRTInferenceBinInputParameter;
+
+class TRTInferenceUseROI : public MetaBoolean
+{
+public:
+    TRTInferenceUseROI(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseROI* TheTRTInferenceUseROIParameter;
+
+class TRTInferenceROIX0 : public MetaInt32
+{
+public:
+    TRTInferenceROIX0(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceROIX0* TheTRTInferenceROIX0Parameter;
+
+class TRTInferenceROIY0 : public MetaInt32
+{
+public:
+    TRTInferenceROIY0(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceROIY0* TheTRTInferenceROIY0Parameter;
+
+class TRTInferenceROIX1 : public MetaInt32
+{
+public:
+    TRTInferenceROIX1(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceROIX1* TheTRTInferenceROIX1Parameter;
+
+class TRTInferenceROIY1 : public MetaInt32
+{
+public:
+    TRTInferenceROIY1(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceROIY1* TheTRTInferenceROIY1Parameter;
+
+class TRTInferenceLiveDisplay : public MetaBoolean
+{
+public:
+    TRTInferenceLiveDisplay(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceLiveDisplay* TheTRTInferenceLiveDisplayParameter;
+
+class TRTInferenceLiveDisplayInterval : public MetaFloat
+{
+public:
+    TRTInferenceLiveDisplayInterval(MetaProcess*);
+
+    IsoString Id() const override;
+    int Precision() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceLiveDisplayInterval* TheTRTInferenceLiveDisplayIntervalParameter;
+
+class TRTInferenceInputFiles : public MetaTable
+{
+public:
+    TRTInferenceInputFiles(MetaProcess*);
+
+    IsoString Id() const override;
+};
+
+extern TRTInferenceInputFiles* TheTRTInferenceInputFilesParameter;
+
+class TRTInferenceInputFileEnabled : public MetaBoolean
+{
+public:
+    TRTInferenceInputFileEnabled(MetaTable*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceInputFileEnabled* TheTRTInferenceInputFileEnabledParameter;
+
+class TRTInferenceInputFilePath : public MetaString
+{
+public:
+    TRTInferenceInputFilePath(MetaTable*);
+
+    IsoString Id() const override;
+};
+
+extern TRTInferenceInputFilePath* TheTRTInferenceInputFilePathParameter;
+
+class TRTInferenceOutputDirectory : public MetaString
+{
+public:
+    TRTInferenceOutputDirectory(MetaProcess*);
+
+    IsoString Id() const override;
+};
+
+extern TRTInferenceOutputDirectory* TheTRTInferenceOutputDirectoryParameter;
+
+class TRTInferenceOutputPostfix : public MetaString
+{
+public:
+    TRTInferenceOutputPostfix(MetaProcess*);
+
+    IsoString Id() const override;
+    String DefaultValue() const override;
+};
+
+extern TRTInferenceOutputPostfix* TheTRTInferenceOutputPostfixParameter;
+
+class TRTInferenceOverwriteExistingFiles : public MetaBoolean
+{
+public:
+    TRTInferenceOverwriteExistingFiles(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceOverwriteExistingFiles* TheTRTInferenceOverwriteExistingFilesParameter;
+
+class TRTInferenceOutOfCore : public MetaBoolean
+{
+public:
+    TRTInferenceOutOfCore(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceOutOfCore* TheTRTInferenceOutOfCoreParameter;
+
+class TRTInferenceUseCheckpoints : public MetaBoolean
+{
+public:
+    TRTInferenceUseCheckpoints(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseCheckpoints* TheTRTInferenceUseCheckpointsParameter;
+
+class TRTInferenceCheckpointInterval : public MetaFloat
+{
+public:
+    TRTInferenceCheckpointInterval(MetaProcess*);
+
+    IsoString Id() const override;
+    int Precision() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceCheckpointInterval* TheTRTInferenceCheckpointIntervalParameter;
+
+class TRTInferenceTileOrder : public MetaEnumeration
+{
+public:
+    enum { Raster,
+           Serpentine,
+           ZOrder,
+           BandMajor,
+           NumberOfItems,
+           Default = Raster };
+
+    TRTInferenceTileOrder(MetaProcess*);
+
+    IsoString Id() const override;
+    size_type NumberOfElements() const override;
+    IsoString ElementId(size_type) const override;
+    int ElementValue(size_type) const override;
+    size_type DefaultValueIndex() const override;
+};
+
+extern TRTInferenceTileOrder* TheTRTInferenceTileOrderParameter;
+
+class TRTInferenceTileBandHeight : public MetaInt32
+{
+public:
+    TRTInferenceTileBandHeight(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceTileBandHeight* TheTRTInferenceTileBandHeightParameter;
+
+class TRTInferenceUseInferenceServer : public MetaBoolean
+{
+public:
+    TRTInferenceUseInferenceServer(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseInferenceServer* TheTRTInferenceUseInferenceServerParameter;
+
+class TRTInferenceTileFarmWorkers : public MetaString
+{
+public:
+    TRTInferenceTileFarmWorkers(MetaProcess*);
+
+    IsoString Id() const override;
+};
+
+extern TRTInferenceTileFarmWorkers* TheTRTInferenceTileFarmWorkersParameter;
+
+class TRTInferenceGpuMemoryBudget : public MetaInt32
+{
+public:
+    TRTInferenceGpuMemoryBudget(MetaProcess*);
+
+    IsoString Id() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceGpuMemoryBudget* TheTRTInferenceGpuMemoryBudgetParameter;
+
+class TRTInferenceUseTuningProfile : public MetaBoolean
+{
+public:
+    TRTInferenceUseTuningProfile(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceUseTuningProfile* TheTRTInferenceUseTuningProfileParameter;
+
+class TRTInferenceAutoTileOverlap : public MetaBoolean
+{
+public:
+    TRTInferenceAutoTileOverlap(MetaProcess*);
+
+    IsoString Id() const override;
+    bool DefaultValue() const override;
+};
+
+extern TRTInferenceAutoTileOverlap* TheTRTInferenceAutoTileOverlapParameter;
+
+class TRTInferenceSeamErrorThreshold : public MetaFloat
+{
+public:
+    TRTInferenceSeamErrorThreshold(MetaProcess*);
+
+    IsoString Id() const override;
+    int Precision() const override;
+    double MinimumValue() const override;
+    double MaximumValue() const override;
+    double DefaultValue() const override;
+};
+
+extern TRTInferenceSeamErrorThreshold* TheTRTInferenceSeamErrorThresholdParameter;
+
+class TRTInferencePipelineEngines : public MetaString
+{
+public:
+    TRTInferencePipelineEngines(MetaProcess*);
+
+    IsoString Id() const override;
+};
+
+extern TRTInferencePipelineEngines* TheTRTInferencePipelineEnginesParameter;
+
 PCL_END_LOCAL
 
 }	// namespace pcl
@@ -0,0 +1,196 @@
+#include <pcl/Console.h>
+#include <pcl/File.h>
+
+#include <cmath>
+
+#include "TRTInferenceClient.h"
+#include "TRTInferencePipeline.h"
+#include "TRTInferenceProfile.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+TRTPipelineEngine::TRTPipelineEngine(std::vector<std::unique_ptr<TRTEngine>> stages, double tileOverlap)
+    : m_tileOverlap(tileOverlap)
+{
+    if (stages.empty())
+        throw Error("An engine pipeline needs at least one engine.");
+
+    m_inputTileW = stages.front()->getInputTileW();
+    m_inputTileH = stages.front()->getInputTileH();
+    m_numChannels = 1;
+
+    // Receptive fields of chained engines add up; margins of later stages are in the pixels of the
+    // upscaled image they see
+    int imageW = m_inputTileW;
+    int imageH = m_inputTileH;
+    double scaleX = 1, scaleY = 1;
+    double marginX = 0, marginY = 0;
+    std::vector<uint64> hashes;
+    for (std::unique_ptr<TRTEngine>& engine : stages)
+    {
+        Stage stage;
+        stage.imageW = imageW;
+        stage.imageH = imageH;
+        stage.direct = (engine->getInputTileW() == imageW) && (engine->getInputTileH() == imageH);
+        if (engine->getNumberOfChannels() == 3)
+            m_numChannels = 3;
+        marginX += engine->getContextMarginX() / scaleX;
+        marginY += engine->getContextMarginY() / scaleY;
+
+        int factorW = engine->getOutputTileW() / engine->getInputTileW();
+        int factorH = engine->getOutputTileH() / engine->getInputTileH();
+        if (!stage.direct)
+        {
+            int stepX = Max(1, int(engine->getInputTileW() * (1.0f - tileOverlap)));
+            int stepY = Max(1, int(engine->getInputTileH() * (1.0f - tileOverlap)));
+            for (int y = 0; y < imageH; y += stepY)
+                for (int x = 0; x < imageW; x += stepX)
+                    stage.tiles.Add(Point(x, y));
+        }
+        imageW *= factorW;
+        imageH *= factorH;
+        scaleX *= factorW;
+        scaleY *= factorH;
+
+        hashes.push_back(engine->getEngineHash());
+        stage.engine = std::move(engine);
+        m_stages.push_back(std::move(stage));
+    }
+    m_outputTileW = imageW;
+    m_outputTileH = imageH;
+    m_contextMarginX = int32_t(std::ceil(marginX));
+    m_contextMarginY = int32_t(std::ceil(marginY));
+
+    // Tiled stages depend on the overlap of their tiles
+    uint64 overlapBits;
+    ::memcpy(&overlapBits, &m_tileOverlap, sizeof(overlapBits));
+    hashes.push_back(overlapBits);
+    m_engineHash = Hash64(hashes.data(), hashes.size() * sizeof(uint64));
+
+    setNumberOfPlanes(m_numChannels);
+}
+
+void TRTPipelineEngine::setNumberOfPlanes(int32_t numPlanes)
+{
+    m_numPlanes = numPlanes;
+    for (Stage& stage : m_stages)
+    {
+        stage.engine->setNumberOfPlanes(numPlanes);
+        if (stage.direct)
+        {
+            stage.input.FreeData();
+            stage.output.FreeData();
+            stage.outputBuffer.clear();
+            continue;
+        }
+        ColorSpace::value_type colorSpace = (numPlanes == 3) ? ColorSpace::RGB : ColorSpace::Gray;
+        int factorW = stage.engine->getOutputTileW() / stage.engine->getInputTileW();
+        int factorH = stage.engine->getOutputTileH() / stage.engine->getInputTileH();
+        stage.input.AllocateData(stage.imageW, stage.imageH, numPlanes, colorSpace);
+        stage.output.AllocateData(stage.imageW * factorW, stage.imageH * factorH, numPlanes, colorSpace);
+        stage.outputBuffer.resize(size_type(numPlanes) * stage.output.Width() * stage.output.Height());
+    }
+}
+
+void TRTPipelineEngine::runInference()
+{
+    const float* data = nullptr;
+    for (size_type i = 0; i < m_stages.size(); i++)
+    {
+        Stage& stage = m_stages[i];
+        TRTEngine& engine = *stage.engine;
+        if (m_profile != nullptr)
+            m_profile->setLayerPrefix(IsoString().Format("%d/", int(i + 1)));
+        size_type planeSize = size_type(stage.imageW) * stage.imageH;
+        if (stage.direct)
+        {
+            // The first stage reads the input buffer of the pipeline
+            if (data != nullptr)
+                ::memcpy(engine.getInputBuffer(), data, m_numPlanes * planeSize * sizeof(float));
+            engine.runInference();
+            data = engine.getOutputBuffer();
+            continue;
+        }
+
+        for (int c = 0; c < m_numPlanes; c++)
+            ::memcpy(stage.input.PixelData(c), data + c * planeSize, planeSize * sizeof(float));
+
+        int tileW = engine.getInputTileW();
+        int tileH = engine.getInputTileH();
+        int factorW = engine.getOutputTileW() / tileW;
+        int factorH = engine.getOutputTileH() / tileH;
+        int stepX = Max(1, int(tileW * (1.0f - m_tileOverlap)));
+        int stepY = Max(1, int(tileH * (1.0f - m_tileOverlap)));
+        for (const Point& tilePos : stage.tiles)
+        {
+            extractTile(stage.input, tilePos, tileW, tileH, m_numPlanes, engine.getInputBuffer());
+            engine.runInference();
+            Rect rect = cropRegion(tilePos, tileW, tileH, stepX, stepY, stage.imageW, stage.imageH);
+            placeTile(engine.getOutputBuffer(), engine.getOutputTileW(), engine.getOutputTileH(), m_numPlanes,
+                      Point(tilePos.x * factorW, tilePos.y * factorH),
+                      Rect(rect.x0 * factorW, rect.y0 * factorH, rect.x1 * factorW, rect.y1 * factorH), stage.output);
+        }
+
+        size_type outputPlaneSize = size_type(stage.output.Width()) * stage.output.Height();
+        for (int c = 0; c < m_numPlanes; c++)
+            ::memcpy(stage.outputBuffer.data() + c * outputPlaneSize, stage.output.PixelData(c), outputPlaneSize * sizeof(float));
+        data = stage.outputBuffer.data();
+    }
+    m_output = data;
+}
+
+bool TRTPipelineEngine::setLayerProfile(TRTLayerProfile* profile)
+{
+    for (Stage& stage : m_stages)
+        if (!stage.engine->setLayerProfile(profile))
+        {
+            for (Stage& other : m_stages)
+                other.engine->setLayerProfile(nullptr);
+            m_profile = nullptr;
+            return false;
+        }
+    if ((profile == nullptr) && (m_profile != nullptr))
+        m_profile->setLayerPrefix(IsoString());
+    m_profile = profile;
+    return true;
+}
+
+void TRTPipelineEngine::setBatchLimit(int32_t batchLimit)
+{
+    for (Stage& stage : m_stages)
+        stage.engine->setBatchLimit(batchLimit);
+}
+
+void TRTPipelineEngine::setNumberOfThreads(int numThreads)
+{
+    for (Stage& stage : m_stages)
+        stage.engine->setNumberOfThreads(numThreads);
+}
+
+std::unique_ptr<TRTEngine> openEngineChain(const String& enginePath, const String& pipelineEngines, bool useServer,
+                                           int32 imageW, int32 imageH, uint64 memoryBudget, double tileOverlap)
+{
+    StringList paths;
+    pipelineEngines.Break(paths, ';', true);
+    paths.Remove(String());
+    if (paths.IsEmpty())
+        return openEngine(enginePath, useServer, imageW, imageH, memoryBudget);
+
+    paths.Prepend(enginePath);
+    String chain;
+    std::vector<std::unique_ptr<TRTEngine>> stages;
+    for (const String& path : paths)
+    {
+        stages.push_back(openEngine(path, useServer, imageW, imageH, memoryBudget));
+        const TRTEngine& stage = *stages.back();
+        imageW *= stage.getOutputTileW() / stage.getInputTileW();
+        imageH *= stage.getOutputTileH() / stage.getInputTileH();
+        chain << (chain.IsEmpty() ? "" : " -> ") << File::ExtractNameAndExtension(path);
+    }
+    Console().WriteLn("<end><cbr>Engine pipeline: " + chain);
+    return std::make_unique<TRTPipelineEngine>(std::move(stages), tileOverlap);
+}
+
+}	// namespace pcl
@@ -0,0 +1,99 @@
+#ifndef __TRTInferencePipeline_h
+#define __TRTInferencePipeline_h
+
+#include <pcl/Array.h>
+#include <pcl/Image.h>
+
+#include <memory>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Engines run back to back on each tile, as a single engine: the output tile of each stage is the input
+// of the next, and only the output of the last stage leaves the pipeline. The tile of the pipeline is
+// that of the first stage. A stage whose tile matches the output of the previous stage takes it as it
+// is; any other stage runs over that output in tiles of its own, overlapping by tileOverlap and
+// center-cropped. Intermediate buffers are allocated by setNumberOfPlanes() and reused for every tile.
+// The pipeline is a 3-channel engine if any stage is.
+class TRTPipelineEngine : public TRTEngine
+{
+public:
+    TRTPipelineEngine(std::vector<std::unique_ptr<TRTEngine>> stages, double tileOverlap);
+
+    void setNumberOfPlanes(int32_t numPlanes) override;
+
+    float* getInputBuffer() override
+    {
+        return m_stages.front().engine->getInputBuffer();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return m_output;
+    }
+
+    void runInference() override;
+
+    void setBatchLimit(int32_t batchLimit) override;
+
+    void setNumberOfThreads(int numThreads) override;
+
+    int32_t getContextMarginX() const override
+    {
+        return m_contextMarginX;
+    }
+
+    int32_t getContextMarginY() const override
+    {
+        return m_contextMarginY;
+    }
+
+    int numStages() const
+    {
+        return int(m_stages.size());
+    }
+
+    const TRTEngine& stage(int index) const
+    {
+        return *m_stages[index].engine;
+    }
+
+    // Profiles the layers of all stages, whose names are prefixed with the number of their stage, as
+    // "2/conv1". Stages that tile the output of the previous stage report once per tile of theirs.
+    bool setLayerProfile(TRTLayerProfile* profile) override;
+
+private:
+    struct Stage
+    {
+        std::unique_ptr<TRTEngine> engine;
+        // Dimensions of the output of the previous stage, which this stage processes
+        int imageW = 0;
+        int imageH = 0;
+        // False when the stage tiles the output of the previous stage
+        bool direct = true;
+        Array<Point> tiles;
+        FImage input;
+        FImage output;
+        std::vector<float> outputBuffer;
+    };
+
+    std::vector<Stage> m_stages;
+    double m_tileOverlap;
+    TRTLayerProfile* m_profile = nullptr;
+    int32_t m_contextMarginX = 0;
+    int32_t m_contextMarginY = 0;
+    const float* m_output = nullptr;
+};
+
+// Opens an engine followed by the engines at the semicolon-separated paths of pipelineEngines, as a
+// pipeline, or the engine alone when there are none. Bundles are selected for the image dimensions
+// each stage works at.
+std::unique_ptr<TRTEngine> openEngineChain(const String& enginePath, const String& pipelineEngines, bool useServer,
+                                           int32 imageW, int32 imageH, uint64 memoryBudget, double tileOverlap);
+
+}	// namespace pcl
+
+#endif	// __TRTInferencePipeline_h
@@ -0,0 +1,143 @@
+#include <pcl/Resample.h>
+
+#include "TRTInferencePreview.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+Array<Point> previewTiles(int imageW, int imageH, int tileW, int tileH, double tileOverlap)
+{
+    int stepX = Max(1, int(tileW * (1.0 - tileOverlap)));
+    int stepY = Max(1, int(tileH * (1.0 - tileOverlap)));
+    Array<Point> tiles;
+    for (int y = 0; y < imageH; y += stepY)
+        for (int x = 0; x < imageW; x += stepX)
+            tiles.Add(Point(x, y));
+    return tiles;
+}
+
+TRTPreviewPass::TRTPreviewPass(TRTEngine& engine, double tileOverlap, bool centerCrop, int coarseFactor)
+    : m_engine(engine)
+    , m_tileOverlap(tileOverlap)
+    , m_centerCrop(centerCrop)
+    , m_coarseFactor(coarseFactor)
+{
+}
+
+bool TRTPreviewPass::infer(const FImage& image)
+{
+    FImage input(image);
+    if (m_coarseFactor > 1)
+    {
+        FImage binned;
+        binned.AllocateData((input.Width() + m_coarseFactor - 1) / m_coarseFactor,
+                            (input.Height() + m_coarseFactor - 1) / m_coarseFactor,
+                            input.NumberOfChannels(), input.ColorSpace());
+        binImage(input, m_coarseFactor, binned);
+        input = binned;
+    }
+
+    int inputTileW = m_engine.getInputTileW();
+    int inputTileH = m_engine.getInputTileH();
+    int outputTileW = m_engine.getOutputTileW();
+    int outputTileH = m_engine.getOutputTileH();
+    int factorW = outputTileW / inputTileW;
+    int factorH = outputTileH / inputTileH;
+    int numPlanes = (m_engine.getNumberOfChannels() == 3) ? 3 : input.NumberOfChannels();
+    m_engine.setNumberOfPlanes(numPlanes);
+
+    m_accumulator.AllocateData(input.Width() * factorW, input.Height() * factorH, numPlanes,
+                               (numPlanes == 3) ? ColorSpace::RGB : ColorSpace::Gray);
+    m_accumulator.Zero();
+    if (!m_centerCrop)
+    {
+        m_weight.AllocateData(m_accumulator.Width(), m_accumulator.Height());
+        m_weight.Zero();
+    }
+    m_numInferredTiles = 0;
+
+    int stepX = inputTileW * (1.0 - m_tileOverlap);
+    int stepY = inputTileH * (1.0 - m_tileOverlap);
+    for (const Point& tilePos : previewTiles(input.Width(), input.Height(), inputTileW, inputTileH, m_tileOverlap))
+    {
+        if (m_cancelled)
+            return false;
+
+        extractTile(input, tilePos, inputTileW, inputTileH, numPlanes, m_engine.getInputBuffer());
+        m_engine.runInference();
+        m_numInferredTiles++;
+
+        Point outputPos(tilePos.x * factorW, tilePos.y * factorH);
+        if (m_centerCrop)
+        {
+            Rect rect = cropRegion(tilePos, inputTileW, inputTileH, stepX, stepY, input.Width(), input.Height());
+            placeTile(m_engine.getOutputBuffer(), outputTileW, outputTileH, numPlanes, outputPos,
+                      Rect(rect.x0 * factorW, rect.y0 * factorH, rect.x1 * factorW, rect.y1 * factorH), m_accumulator);
+        }
+        else
+            accumulateTile(m_engine.getOutputBuffer(), outputTileW, outputTileH, numPlanes, outputPos, m_accumulator, m_weight);
+    }
+    return true;
+}
+
+void TRTPreviewPass::finish(UInt16Image& image) const
+{
+    int factorW = m_engine.getOutputTileW() / m_engine.getInputTileW();
+    int factorH = m_engine.getOutputTileH() / m_engine.getInputTileH();
+
+    // Back to the color space and scale of the preview
+    FImage output;
+    output.AllocateData(1, 1, image.NumberOfChannels(), image.ColorSpace());
+    ImageVariant target(&output);
+    if (factorW == factorH)
+        finalizeOutput(m_accumulator, weight(), factorW, target);
+    else
+    {
+        finalizeOutput(m_accumulator, weight(), 1, target);
+        BicubicFilterPixelInterpolation bf(factorW / 2, factorH / 2, CubicBSplineFilter());
+        Resample r(bf, 1.0 / factorW, 1.0 / factorH);
+        r >> output;
+    }
+
+    // Nearest-neighbor enlargement of coarse passes
+    for (int c = 0; c < image.NumberOfChannels(); c++)
+        for (int y = 0; y < image.Height(); y++)
+        {
+            const float* s = output.ScanLine(Min(y * output.Height() / image.Height(), output.Height() - 1), c);
+            uint16* d = image.ScanLine(y, c);
+            for (int x = 0; x < image.Width(); x++)
+                d[x] = UInt16PixelTraits::ToSample(s[Min(x * output.Width() / image.Width(), output.Width() - 1)]);
+        }
+}
+
+TRTPreviewThread::TRTPreviewThread(TRTEngine& engine)
+    : m_engine(engine)
+{
+}
+
+void TRTPreviewThread::Reset(const UInt16Image& image, double tileOverlap, bool centerCrop, int coarseFactor)
+{
+    m_image.Assign(image);
+    m_pass = std::make_unique<TRTPreviewPass>(m_engine, tileOverlap, centerCrop, coarseFactor);
+}
+
+void TRTPreviewThread::Run()
+{
+    m_error.Clear();
+    try
+    {
+        if (m_pass->infer(FImage(m_image)))
+            m_pass->finish(m_image);
+    }
+    catch (const Exception& x)
+    {
+        m_error = x.Message();
+    }
+    catch (...)
+    {
+        m_error = "Unknown error";
+    }
+}
+
+}	// namespace pcl
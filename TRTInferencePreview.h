@@ -0,0 +1,119 @@
+#ifndef __TRTInferencePreview_h
+#define __TRTInferencePreview_h
+
+#include <pcl/Array.h>
+#include <pcl/Exception.h>
+#include <pcl/Image.h>
+#include <pcl/Thread.h>
+
+#include <atomic>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Positions of the tiles covering an image of the given size, in the order they are processed. A
+// real-time preview image only holds the visible part of the view at the current zoom level, so these
+// are the only tiles a preview pass infers.
+Array<Point> previewTiles(int imageW, int imageH, int tileW, int tileH, double tileOverlap);
+
+// One pass of the engine over a real-time preview image. A coarse pass bins the image first and
+// enlarges the result back, for a quick first rendition; a pass with a coarse factor of 1 infers the
+// image as it is shown. The pass knows nothing of the thread running it, so the tile loop can be
+// driven directly.
+class TRTPreviewPass
+{
+public:
+    // The engine must outlive the pass
+    TRTPreviewPass(TRTEngine& engine, double tileOverlap, bool centerCrop, int coarseFactor);
+
+    // Coarse factor of a pass over a preview image of w x h pixels: large previews get a binned pass
+    // first, and the full pass follows once it is shown and refinement is requested
+    static int coarseFactorFor(int w, int h, bool refine)
+    {
+        return (!refine && (Max(w, h) > 512)) ? 4 : 1;
+    }
+
+    // Makes the pass stop before its next tile. May be called from any thread.
+    void cancel()
+    {
+        m_cancelled = true;
+    }
+
+    bool isCancelled() const
+    {
+        return m_cancelled;
+    }
+
+    // Runs the engine on the tiles of the image, binned by the coarse factor, into the accumulator.
+    // Returns false if the pass was cancelled.
+    bool infer(const FImage& image);
+
+    // Writes the finalized output of a completed pass to the image, enlarged back from a coarse pass.
+    // Needs the PixInsight thread API.
+    void finish(UInt16Image& image) const;
+
+    // Blended engine output so far, and its weights; null weights for center-crop placement
+    const FImage& accumulator() const
+    {
+        return m_accumulator;
+    }
+
+    const FImage* weight() const
+    {
+        return m_centerCrop ? nullptr : &m_weight;
+    }
+
+    // Tiles the engine has run on
+    int numInferredTiles() const
+    {
+        return m_numInferredTiles;
+    }
+
+private:
+    TRTEngine& m_engine;
+    double m_tileOverlap;
+    bool m_centerCrop;
+    int m_coarseFactor;
+    std::atomic<bool> m_cancelled { false };
+
+    FImage m_accumulator;
+    FImage m_weight;
+    int m_numInferredTiles = 0;
+};
+
+// Runs a preview pass on a thread of its own. Cancel() stops the pass between two tiles, leaving the
+// image unchanged.
+class TRTPreviewThread : public Thread
+{
+public:
+    UInt16Image m_image;
+    // Message of the exception that ended the last pass, if any
+    String m_error;
+
+    // The engine must outlive the thread
+    explicit TRTPreviewThread(TRTEngine& engine);
+
+    void Reset(const UInt16Image& image, double tileOverlap, bool centerCrop, int coarseFactor);
+    void Run() override;
+
+    void Cancel()
+    {
+        if (m_pass)
+            m_pass->cancel();
+    }
+
+    bool IsCancelled() const
+    {
+        return m_pass && m_pass->isCancelled();
+    }
+
+private:
+    TRTEngine& m_engine;
+    std::unique_ptr<TRTPreviewPass> m_pass;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferencePreview_h
@@ -20,6 +20,41 @@ TRTInferenceProcess::TRTInferenceProcess()
     // Instantiate process parameters
     new TRTInferenceTileOverlap(this);
     new TRTInferenceKeepOutputDimension(this);
+    new TRTInferenceSkipUniformTiles(this);
+    new TRTInferenceUniformTileTolerance(this);
+    new TRTInferenceUniformTilePolicy(this);
+    new TRTInferenceUseTileCache(this);
+    new TRTInferenceTileCacheSize(this);
+    new TRTInferenceTileCacheDiskSize(this);
+    new TRTInferenceUseTileStore(this);
+    new TRTInferenceBlendMode(this);
+    new TRTInferenceMonoChannelAverage(this);
+    new TRTInferenceBinInput(this);
+    new TRTInferenceUseROI(this);
+    new TRTInferenceROIX0(this);
+    new TRTInferenceROIY0(this);
+    new TRTInferenceROIX1(this);
+    new TRTInferenceROIY1(this);
+    new TRTInferenceLiveDisplay(this);
+    new TRTInferenceLiveDisplayInterval(this);
+    new TRTInferenceInputFiles(this);
+    new TRTInferenceInputFileEnabled(TheTRTInferenceInputFilesParameter);
+    new TRTInferenceInputFilePath(TheTRTInferenceInputFilesParameter);
+    new TRTInferenceOutputDirectory(this);
+    new TRTInferenceOutputPostfix(this);
+    new TRTInferenceOverwriteExistingFiles(this);
+    new TRTInferenceOutOfCore(this);
+    new TRTInferenceUseCheckpoints(this);
+    new TRTInferenceCheckpointInterval(this);
+    new TRTInferenceTileOrder(this);
+    new TRTInferenceTileBandHeight(this);
+    new TRTInferenceUseInferenceServer(this);
+    new TRTInferenceTileFarmWorkers(this);
+    new TRTInferenceGpuMemoryBudget(this);
+    new TRTInferenceUseTuningProfile(this);
+    new TRTInferenceAutoTileOverlap(this);
+    new TRTInferenceSeamErrorThreshold(this);
+    new TRTInferencePipelineEngines(this);
 }
 
 IsoString TRTInferenceProcess::Id() const
@@ -108,6 +143,13 @@ ProcessImplementation* TRTInferenceProcess::Clone(const ProcessImplementation& p
 
 // ----------------------------------------------------------------------------
 
+bool TRTInferenceProcess::CanProcessGlobal() const
+{
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
 bool TRTInferenceProcess::NeedsValidation() const
 {
     return false;
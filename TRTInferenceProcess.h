@@ -24,6 +24,7 @@ public:
     ProcessInterface* DefaultInterface() const override;
     ProcessImplementation* Create() const override;
     ProcessImplementation* Clone(const ProcessImplementation&) const override;
+    bool CanProcessGlobal() const override;
     bool NeedsValidation() const override;
     bool CanProcessCommandLines() const override;
 };
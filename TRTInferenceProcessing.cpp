@@ -0,0 +1,580 @@
+#include <pcl/Console.h>
+#include <pcl/ElapsedTime.h>
+#include <pcl/Resample.h>
+#include <pcl/StandardStatus.h>
+
+#include "TRTInferenceCheckpoint.h"
+#include "TRTInferenceFarm.h"
+#include "TRTInferenceLiveDisplay.h"
+#include "TRTInferenceOutOfCore.h"
+#include "TRTInferenceOverlap.h"
+#include "TRTInferenceProcessing.h"
+#include "TRTInferenceTileCache.h"
+#include "TRTInferenceTileProducer.h"
+#include "TRTInferenceTileStore.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+// The part of the tile loop shared by in-memory and out-of-core processing, so that both write the same
+// output samples: output tiles are averaged to a single plane for mono output, then accumulated with
+// blending weights or placed by center crop. The accumulator may hold a band of the output, starting
+// at a given input row.
+class TileBlender
+{
+public:
+    TileBlender(const TRTProcessingSettings& settings, TRTEngine& engine, int numImageChannels)
+        : m_engine(engine)
+        // Tiles carry one plane per engine channel, or one plane per image channel for single-channel
+        // engines, which process them as a batch
+        , m_numPlanes((engine.getNumberOfChannels() == 3) ? 3 : numImageChannels)
+        // Mono images are accumulated in a single channel when the engine is single-channel, or on
+        // request as the average of the channels of a 3-channel engine
+        , m_monoOutput((numImageChannels == 1) && ((m_numPlanes == 1) || settings.monoChannelAverage))
+        // Center-crop placement writes every output pixel exactly once, so it needs neither a cleared
+        // accumulator nor blending weights
+        , m_weighted(settings.blendMode == TRTInferenceBlendMode::Weighted)
+        , m_factorW(engine.getOutputTileW() / engine.getInputTileW())
+        , m_factorH(engine.getOutputTileH() / engine.getInputTileH())
+        , m_placementThreads(settings.tuning.placementThreads)
+        , m_inFlightTiles(settings.tuning.inFlightTiles)
+        , m_producer(engine, m_numPlanes, settings.skipUniformTiles, settings.uniformTileTolerance, settings.uniformTilePolicy,
+                     settings.useTileCache)
+    {
+        engine.setNumberOfPlanes(m_numPlanes);
+        if (settings.useTileCache)
+            TRTTileCache::instance().configure(size_type(settings.tileCacheSize) << 20, size_type(settings.tileCacheDiskSize) << 20,
+                                               settings.tileCacheDirectory);
+        if (numOutputChannels() != m_numPlanes)
+            m_monoTile.resize(size_type(engine.getOutputTileW()) * engine.getOutputTileH());
+    }
+
+    int numPlanes() const
+    {
+        return m_numPlanes;
+    }
+
+    bool isMonoOutput() const
+    {
+        return m_monoOutput;
+    }
+
+    int numOutputChannels() const
+    {
+        return m_monoOutput ? 1 : 3;
+    }
+
+    bool isWeighted() const
+    {
+        return m_weighted;
+    }
+
+    TRTTileProducer& producer()
+    {
+        return m_producer;
+    }
+
+    // Starts blending into the accumulator, and the weights of weighted blending, the tiles of a plan
+    // with the given steps over an input image of width x height pixels
+    void start(FImage& accumulator, FImage* weight, int tileStepX, int tileStepY, int width, int height)
+    {
+        m_accumulator = &accumulator;
+        m_weight = weight;
+        m_tileStepX = tileStepX;
+        m_tileStepY = tileStepY;
+        m_width = width;
+        m_height = height;
+        if (!m_weighted)
+            m_placer = std::make_unique<TRTTilePlacer>(accumulator, m_engine.getOutputTileW(), m_engine.getOutputTileH(),
+                                                       numOutputChannels(), m_placementThreads, m_inFlightTiles);
+    }
+
+    // Blends the output of the input tile at pos; bandTop is the input row at the top of the accumulator
+    void add(const float* outputTile, const Point& pos, int bandTop = 0)
+    {
+        int outputTileW = m_engine.getOutputTileW();
+        int outputTileH = m_engine.getOutputTileH();
+        if (!m_monoTile.empty())
+        {
+            averageTilePlanes(outputTile, outputTileW, outputTileH, m_numPlanes, m_monoTile.data());
+            outputTile = m_monoTile.data();
+        }
+
+        Point outputPos(pos.x * m_factorW, (pos.y - bandTop) * m_factorH);
+        if (m_weighted)
+            accumulateTile(outputTile, outputTileW, outputTileH, numOutputChannels(), outputPos, *m_accumulator, *m_weight);
+        else
+        {
+            Rect rect = cropRegion(pos, m_engine.getInputTileW(), m_engine.getInputTileH(), m_tileStepX, m_tileStepY, m_width, m_height);
+            m_placer->place(outputTile, outputPos, Rect(rect.x0 * m_factorW, (rect.y0 - bandTop) * m_factorH,
+                                                        rect.x1 * m_factorW, (rect.y1 - bandTop) * m_factorH));
+        }
+    }
+
+    // Returns once the placed tiles are in the accumulator
+    void wait()
+    {
+        if (m_placer)
+            m_placer->wait();
+    }
+
+private:
+    TRTEngine& m_engine;
+    int m_numPlanes;
+    bool m_monoOutput;
+    bool m_weighted;
+    int m_factorW;
+    int m_factorH;
+    int m_placementThreads;
+    int m_inFlightTiles;
+    TRTTileProducer m_producer;
+    std::vector<float> m_monoTile;
+
+    FImage* m_accumulator = nullptr;
+    FImage* m_weight = nullptr;
+    int m_tileStepX = 0;
+    int m_tileStepY = 0;
+    int m_width = 0;
+    int m_height = 0;
+    std::unique_ptr<TRTTilePlacer> m_placer;
+};
+
+void processImage(const TRTProcessingSettings& settings, TRTEngine& trtEngine, ImageVariant& image, const FImage* imageMask,
+                  const String& tileStorePath, TRTTileFarm* farm)
+{
+    StandardStatus status;
+    Console console;
+
+    int factorW = trtEngine.getOutputTileW() / trtEngine.getInputTileW();
+    int factorH = trtEngine.getOutputTileH() / trtEngine.getInputTileH();
+
+    // Same-size fast mode: bin the input by the engine scale, so the upscaled output lands at the
+    // original dimensions without the final downsampling, at about 1/factor^2 of the tiles
+    bool binned = settings.binInput && !settings.keepOutputDimension && (factorW > 1) && (factorW == factorH);
+    bool masked = imageMask != nullptr;
+
+    ImageVariant imgToTRT;
+    imgToTRT.CreateFloatImage();
+    imgToTRT.AllocateImage(image.Width(), image.Height(), image.NumberOfChannels(), image.ColorSpace());
+    imgToTRT.CopyImage(image);
+    imgToTRT.SetStatusCallback(nullptr);
+
+    // Mask at the resolution of the tile plan
+    const FImage* maskedTiles = imageMask;
+    FImage binnedMask;
+    if (binned)
+    {
+        ImageVariant binnedImage;
+        binnedImage.CreateFloatImage();
+        binnedImage.AllocateImage((image.Width() + factorW - 1) / factorW, (image.Height() + factorH - 1) / factorH, image.NumberOfChannels(), image.ColorSpace());
+        binImage(static_cast<const FImage&>(*imgToTRT), factorW, static_cast<FImage&>(*binnedImage));
+        imgToTRT = binnedImage;
+
+        if (masked)
+        {
+            binnedMask.AllocateData(binnedImage.Width(), binnedImage.Height(), imageMask->NumberOfChannels(), imageMask->ColorSpace());
+            binImage(*imageMask, factorW, binnedMask);
+            maskedTiles = &binnedMask;
+        }
+    }
+
+    TileBlender blender(settings, trtEngine, image.NumberOfChannels());
+    int numPlanes = blender.numPlanes();
+    int numOutputChannels = blender.numOutputChannels();
+    bool weighted = blender.isWeighted();
+
+    ImageVariant imgFromTRT, mask;
+    imgFromTRT.CreateFloatImage();
+    // Binned output is cropped to the original dimensions by the accumulator bounds
+    int outputW = binned ? image.Width() : image.Width() * factorW;
+    int outputH = binned ? image.Height() : image.Height() * factorH;
+    imgFromTRT.AllocateImage(outputW, outputH, numOutputChannels,
+                             blender.isMonoOutput() ? ImageVariant::color_space::Gray : ImageVariant::color_space::RGB);
+    // Skipped masked tiles leave their pixels unwritten
+    if (weighted || masked)
+        imgFromTRT.Zero();
+    imgFromTRT.SetStatusCallback(nullptr);
+    if (weighted)
+    {
+        // Blending weights are the same for all channels
+        mask.CreateFloatImage();
+        mask.AllocateImage(imgFromTRT.Width(), imgFromTRT.Height(), 1, ImageVariant::color_space::Gray);
+        mask.Zero();
+        mask.SetStatusCallback(nullptr);
+    }
+
+    // Tile processing
+    const FImage& input = static_cast<const FImage&>(*imgToTRT);
+    FImage& accumulator = static_cast<FImage&>(*imgFromTRT);
+    FImage* weight = weighted ? &static_cast<FImage&>(*mask) : nullptr;
+    int inputTileW = trtEngine.getInputTileW();
+    int inputTileH = trtEngine.getInputTileH();
+    int outputTileW = trtEngine.getOutputTileW();
+    int outputTileH = trtEngine.getOutputTileH();
+
+    TRTTileProducer& producer = blender.producer();
+    std::vector<float> storedTile(size_type(numPlanes) * outputTileW * outputTileH);
+
+    double tileOverlap = settings.autoTileOverlap ? selectTileOverlap(settings, trtEngine, input, numPlanes) : settings.tileOverlap;
+    int tileStepX = inputTileW * (1.0f - tileOverlap);
+    int tileStepY = inputTileH * (1.0f - tileOverlap);
+    int n = (input.Width() + tileStepX - 1) / tileStepX;
+    n *= (input.Height() + tileStepY - 1) / tileStepY;
+
+    if (binned)
+    {
+        // Compared at the same tile overlap, which is selected on the binned input when automatic
+        int fullTiles = ((image.Width() + tileStepX - 1) / tileStepX) * ((image.Height() + tileStepY - 1) / tileStepY);
+        console.NoteLn(String().Format("<end><cbr>Same-size fast mode: input binned %dx%d, %d tiles instead of %d.", factorW, factorH, n, fullTiles));
+        console.WriteLn("Detail finer than the binned resolution cannot be recovered by the engine, so results are softer than "
+                        "full-resolution inference followed by downsampling.");
+    }
+
+    std::unique_ptr<TRTTileStore> tileStore;
+    int numStored = 0;
+    if (!tileStorePath.IsEmpty())
+    {
+        TRTTileStoreLayout layout = { trtEngine.getEngineHash(), TRTTileStore::imageHash(input),
+                                      input.Width(), input.Height(), numPlanes,
+                                      inputTileW, inputTileH, outputTileW, outputTileH,
+                                      tileStepX, tileStepY, n,
+                                      settings.skipUniformTiles ? int32(settings.uniformTilePolicy) : -1,
+                                      settings.skipUniformTiles ? settings.uniformTileTolerance : 0.0f };
+        tileStore = std::make_unique<TRTTileStore>(tileStorePath, layout);
+        if (tileStore->numStoredTiles() > 0)
+            console.WriteLn(String().Format("<end><cbr>Reusing %d of %d raw tiles from ", tileStore->numStoredTiles(), n) + tileStorePath);
+        else
+            console.WriteLn("<end><cbr>Recording raw tiles to " + tileStorePath);
+    }
+
+    int numMasked = 0;
+
+    blender.start(accumulator, weight, tileStepX, tileStepY, input.Width(), input.Height());
+
+    // Rows above the first incomplete row of tiles are final, so they can be shown while the rest is processed
+    std::unique_ptr<TRTLiveDisplay> liveDisplay;
+    if (settings.liveDisplay)
+        liveDisplay = std::make_unique<TRTLiveDisplay>(accumulator, weight, settings.liveDisplayInterval);
+
+    // Resume from an interrupted run on the same image with the same engine and parameters
+    std::unique_ptr<TRTCheckpoint> checkpoint;
+    int tilesPerRow = (input.Width() + tileStepX - 1) / tileStepX;
+    int numTileRows = (input.Height() + tileStepY - 1) / tileStepY;
+    std::vector<uint8> doneTiles(size_type(tilesPerRow) * numTileRows, 0);
+    int startTileRow = 0;
+    if (settings.useCheckpoints)
+    {
+        uint64 hashes[] = { TRTTileStore::imageHash(input), masked ? TRTTileStore::imageHash(*maskedTiles) : 0 };
+        float parameters[] = { float(inputTileW), float(inputTileH), float(outputTileW), float(outputTileH),
+                               float(tileStepX), float(tileStepY), float(numPlanes), float(binned), float(settings.blendMode),
+                               float(settings.skipUniformTiles), settings.uniformTileTolerance, float(settings.uniformTilePolicy) };
+        TRTCheckpointLayout layout = { trtEngine.getEngineHash(), Hash64(hashes, sizeof(hashes)), Hash64(parameters, sizeof(parameters)),
+                                       accumulator.Width(), accumulator.Height(), accumulator.NumberOfChannels(), int32(weighted),
+                                       tilesPerRow, numTileRows };
+        String checkpointPath = TRTCheckpoint::checkpointPath(settings.checkpointDirectory, layout);
+        checkpoint = std::make_unique<TRTCheckpoint>(checkpointPath, layout, accumulator, weight, settings.checkpointInterval);
+        int finishedRows = checkpoint->resume();
+        if (finishedRows > 0)
+        {
+            // Tiles reaching the rows that were still being accumulated run again
+            startTileRow = TRTCheckpoint::firstTileRowBelow(finishedRows, numTileRows, tileStepY, inputTileH, factorH);
+            for (size_type i = 0; i < size_type(startTileRow) * tilesPerRow; i++)
+                doneTiles[i] = checkpoint->doneTiles()[i];
+            console.WriteLn(String().Format("<end><cbr>Resuming with %d of %d output rows finished, from row %d of %d rows of tiles, from ",
+                                            finishedRows, accumulator.Height(), startTileRow, numTileRows) + checkpointPath);
+        }
+        else
+            console.WriteLn("<end><cbr>Saving checkpoints to " + checkpointPath);
+    }
+    auto isResumedTile = [&](const Point& tile)
+    {
+        return (tile.y < startTileRow) && (doneTiles[tile.y * tilesPerRow + tile.x] != 0);
+    };
+
+    // A row of tiles is complete once all its tiles are done. Output rows above the first incomplete row
+    // of tiles are final, whatever the order of the tiles.
+    std::vector<int> remainingTiles(numTileRows, tilesPerRow);
+    int completedTileRows = 0;
+    int numDone = 0;
+    for (int row = 0; row < startTileRow; row++)
+        for (int column = 0; column < tilesPerRow; column++)
+            if (isResumedTile(Point(column, row)))
+            {
+                remainingTiles[row]--;
+                numDone++;
+            }
+    while ((completedTileRows < numTileRows) && (remainingTiles[completedTileRows] == 0))
+        completedTileRows++;
+
+    Array<Point> order = tileOrder(settings.tileOrder, tilesPerRow, numTileRows, settings.tileBandHeight);
+    auto isMaskedTile = [&](int x, int y)
+    {
+        return (maskedTiles != nullptr) && isMaskedOut(*maskedTiles, Rect(x, y, x + inputTileW, y + inputTileH));
+    };
+
+    // The farm produces the tiles to be inferred in the order they are consumed below
+    if (farm != nullptr)
+    {
+        Array<Point> positions;
+        for (const Point& tile : order)
+            if (!isResumedTile(tile))
+            {
+                int x = tile.x * tileStepX;
+                int y = tile.y * tileStepY;
+                if (!isMaskedTile(x, y) && !(tileStore && tileStore->hasTile(tile.y * tilesPerRow + tile.x)))
+                    positions.Add(Point(x, y));
+            }
+        farm->start(input, positions, numPlanes, settings.skipUniformTiles, settings.uniformTileTolerance, settings.uniformTilePolicy,
+                    settings.useTileCache);
+    }
+
+    ElapsedTime T;
+    image.Status().Initialize("Running inference", n);
+    image.Status() += size_type(numDone);
+    for (const Point& tile : order)
+    {
+        if (isResumedTile(tile))
+            continue;
+
+        int x = tile.x * tileStepX;
+        int y = tile.y * tileStepY;
+        int tileIndex = tile.y * tilesPerRow + tile.x;
+
+        if (isMaskedTile(x, y))
+            numMasked++;
+        else
+        {
+            const float* outputTile;
+            if (tileStore && tileStore->hasTile(tileIndex))
+            {
+                tileStore->readTile(tileIndex, storedTile.data());
+                outputTile = storedTile.data();
+                numStored++;
+            }
+            else
+            {
+                outputTile = (farm != nullptr) ? farm->next() : producer.produce(input, Point(x, y));
+                if (tileStore)
+                    tileStore->writeTile(tileIndex, outputTile);
+            }
+            blender.add(outputTile, Point(x, y));
+        }
+        image.Status() += 1;
+
+        doneTiles[tileIndex] = 1;
+        numDone++;
+        if (--remainingTiles[tile.y] > 0)
+            continue;
+        int previousCompleted = completedTileRows;
+        while ((completedTileRows < numTileRows) && (remainingTiles[completedTileRows] == 0))
+            completedTileRows++;
+        if ((completedTileRows == previousCompleted) || (completedTileRows == numTileRows))
+            continue;
+
+        bool showRows = liveDisplay && liveDisplay->due();
+        bool saveRows = checkpoint && checkpoint->due();
+        if (showRows || saveRows)
+        {
+            blender.wait();
+            int finishedY = completedTileRows * tileStepY;
+            if (showRows)
+                liveDisplay->update(finishedY * factorH);
+            if (saveRows)
+                checkpoint->save(Min(finishedY * factorH, accumulator.Height()), doneTiles);
+        }
+    }
+    blender.wait();
+    image.Status().Complete();
+    liveDisplay.reset();
+    if (checkpoint)
+    {
+        checkpoint->restoreFinishedRows();
+        checkpoint->discard();
+    }
+    double tileTime = T();
+
+    int numSkipped = (farm != nullptr) ? farm->numSkipped() : producer.numSkipped();
+    int numCached = (farm != nullptr) ? farm->numCached() : producer.numCached();
+    if (settings.skipUniformTiles)
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were uniform and skipped inference.", numSkipped, n));
+    if (masked)
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were fully masked and skipped.", numMasked, n));
+    if (settings.useTileCache)
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were served from the tile cache.", numCached, n));
+    if ((farm != nullptr) && (farm->numFailedWorkers() > 0))
+        console.WriteLn(String().Format("<end><cbr>%d tile farm workers failed; their tiles were retried on the others.", farm->numFailedWorkers()));
+    if (tileStore)
+    {
+        tileStore->flush();
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were reused from the tile store.", numStored, n));
+    }
+
+    T.Reset();
+    ImageVariant original;
+    if (masked)
+    {
+        original.CreateImageAs(image);
+        original.AllocateImage(image.Width(), image.Height(), image.NumberOfChannels(), image.ColorSpace());
+        original.CopyImage(image);
+        original.SetStatusCallback(nullptr);
+    }
+
+    if (!settings.keepOutputDimension && (factorW > 1) && (factorW != factorH))
+    {
+        // Non-uniform scale: normalize in float, then resample
+        ImageVariant normalized;
+        normalized.CreateFloatImage();
+        normalized.AllocateImage(imgFromTRT.Width(), imgFromTRT.Height(), image.NumberOfChannels(), image.ColorSpace());
+        normalized.SetStatusCallback(&status);
+        finalizeOutput(accumulator, weight, 1, normalized);
+
+        BicubicFilterPixelInterpolation bf(factorW / 2, factorH / 2, CubicBSplineFilter());
+        Resample r(bf, 1.0 / factorW, 1.0 / factorH);
+        r >> normalized;
+
+        image.CopyImage(normalized);
+    }
+    else
+    {
+        // Normalize, keep original color space, downsample and write back in a single pass
+        int factor = (!settings.keepOutputDimension && !binned && (factorW > 1)) ? factorW : 1;
+        finalizeOutput(accumulator, weight, factor, image);
+    }
+
+    if (masked)
+        blendByMask(original, *imageMask, image);
+
+    console.WriteLn("<end><cbr>" + String(weighted ? "Weighted blend" : "Center-crop placement") + ": tiles " +
+                    ElapsedTime::ToString(tileTime) + ", finalization " + T.ToString());
+}
+
+void processFileOutOfCore(const TRTProcessingSettings& settings, TRTEngine& trtEngine, const String& inputPath, const String& outputPath)
+{
+    StandardStatus status;
+    Console console;
+
+    TRTBandReader reader(inputPath);
+    const ImageInfo& info = reader.info();
+
+    int factorW = trtEngine.getOutputTileW() / trtEngine.getInputTileW();
+    int factorH = trtEngine.getOutputTileH() / trtEngine.getInputTileH();
+    if (settings.binInput && !settings.keepOutputDimension && (factorW > 1) && (factorW == factorH))
+        throw Error("Same-size fast mode is not available in out-of-core mode.");
+    if (!settings.keepOutputDimension && (factorW > 1) && (factorW != factorH))
+        throw Error("Engines with different horizontal and vertical scales cannot be used in out-of-core mode "
+                    "unless the output dimension is kept.");
+
+    // Same tile plan, blending and finalization as processImage in raster order with a fixed tile
+    // overlap, so the output is identical to that case; only the rows held in memory differ. Bands are
+    // read and written top to bottom, so other tile orders do not apply, and there is never a whole
+    // image to probe overlaps on, show, or save checkpoints of.
+    if (settings.tileOrder != TRTInferenceTileOrder::Raster)
+        console.WarningLn("<end><cbr>** Warning: Out-of-core processing uses raster tile order.");
+    if (settings.autoTileOverlap)
+        console.WarningLn(String().Format("<end><cbr>** Warning: Automatic tile overlap is not available out of core. Using a tile overlap of %.2f.", settings.tileOverlap));
+    if (settings.liveDisplay)
+        console.WarningLn("<end><cbr>** Warning: Live display is not available out of core.");
+    if (settings.useCheckpoints)
+        console.WarningLn("<end><cbr>** Warning: Checkpoints are not available out of core.");
+
+    TileBlender blender(settings, trtEngine, info.numberOfChannels);
+    bool weighted = blender.isWeighted();
+    int factor = (!settings.keepOutputDimension && (factorW > 1)) ? factorW : 1;
+
+    int inputTileH = trtEngine.getInputTileH();
+    int outputTileH = trtEngine.getOutputTileH();
+    int tileStepX = trtEngine.getInputTileW() * (1.0f - settings.tileOverlap);
+    int tileStepY = inputTileH * (1.0f - settings.tileOverlap);
+    int n = (info.width + tileStepX - 1) / tileStepX;
+    n *= (info.height + tileStepY - 1) / tileStepY;
+
+    // One row of tiles of input, and the output rows it writes. Rows shared with the next row of tiles
+    // move up in both bands instead of being read or accumulated again.
+    FImage input;
+    input.AllocateData(info.width, inputTileH, info.numberOfChannels, ColorSpace::value_type(info.colorSpace));
+    FImage accumulator;
+    accumulator.AllocateData(info.width * factorW, outputTileH, blender.numOutputChannels(),
+                             blender.isMonoOutput() ? ColorSpace::Gray : ColorSpace::RGB);
+    accumulator.Zero();
+    FImage weightBand;
+    FImage* weight = nullptr;
+    if (weighted)
+    {
+        weightBand.AllocateData(accumulator.Width(), outputTileH);
+        weightBand.Zero();
+        weight = &weightBand;
+    }
+    blender.start(accumulator, weight, tileStepX, tileStepY, info.width, info.height);
+
+    ImageVariant output;
+    output.CreateImage(reader.options().ieeefpSampleFormat, false, reader.options().bitsPerSample);
+    output.AllocateImage(1, 1, info.numberOfChannels, ColorSpace::value_type(info.colorSpace));
+    ImageInfo outputInfo = info;
+    outputInfo.width = accumulator.Width() / factor;
+    outputInfo.height = info.height * factorH / factor;
+    TRTBandWriter writer(outputPath, outputInfo, reader.options(), reader.keywords());
+
+    ElapsedTime T;
+    StatusMonitor monitor;
+    monitor.SetCallback(&status);
+    monitor.Initialize("Running inference out of core", n);
+    for (int y = 0; y < info.height; y += tileStepY)
+    {
+        reader.read(y, input);
+
+        for (int x = 0; x < info.width; x += tileStepX)
+        {
+            blender.add(blender.producer().produce(input, Point(x, 0)), Point(x, y), y);
+            ++monitor;
+        }
+        blender.wait();
+
+        // No later tile reaches above the next row of tiles
+        int finishedRows = (Min(y + tileStepY, info.height) - y) * factorH;
+        finalizeOutput(accumulator, weight, factor, finishedRows, output);
+        writer.write(output);
+        shiftBandRows(accumulator, finishedRows);
+        if (weighted)
+            shiftBandRows(weightBand, finishedRows);
+    }
+    writer.close();
+    monitor.Complete();
+
+    if (settings.skipUniformTiles)
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were uniform and skipped inference.", blender.producer().numSkipped(), n));
+    if (settings.useTileCache)
+        console.WriteLn(String().Format("<end><cbr>%d of %d tiles were served from the tile cache.", blender.producer().numCached(), n));
+    console.WriteLn(String().Format("<end><cbr>Out of core: %d input rows and %d output rows held in memory, ", inputTileH, outputTileH) + T.ToString());
+}
+
+double selectTileOverlap(const TRTProcessingSettings& settings, TRTEngine& trtEngine, const FImage& input, int numPlanes)
+{
+    Console console;
+    std::vector<double> overlaps;
+    for (int i = 1; i <= 10; i++)
+        overlaps.push_back(i * 0.05);
+    std::vector<TRTOverlapCandidate> candidates = probeOverlaps(trtEngine, input, numPlanes, overlaps, settings.seamErrorThreshold);
+    int best = selectOverlap(candidates, settings.seamErrorThreshold);
+    if (best < 0)
+    {
+        console.WarningLn(String().Format("<end><cbr>** Warning: The image is too small to probe tile overlaps. Using a tile overlap of %.2f.", settings.tileOverlap));
+        return settings.tileOverlap;
+    }
+
+    for (const TRTOverlapCandidate& candidate : candidates)
+        console.WriteLn(String().Format("<end><cbr>Tile overlap %.2f: seam error %.5f, %d tiles", candidate.overlap, candidate.seamError, candidate.numTiles));
+    const TRTOverlapCandidate& selected = candidates[best];
+    if (selected.seamError > settings.seamErrorThreshold)
+        console.WarningLn(String().Format("** Warning: No tile overlap up to %.2f has a seam error below %.4f.", overlaps.back(), settings.seamErrorThreshold));
+
+    int numTiles = tileCount(input.Width(), input.Height(), trtEngine.getInputTileW(), trtEngine.getInputTileH(), settings.tileOverlap);
+    String change = (selected.numTiles <= numTiles) ?
+                    String().Format("%.0f%% fewer", 100.0 * (numTiles - selected.numTiles) / numTiles) :
+                    String().Format("%.0f%% more", 100.0 * (selected.numTiles - numTiles) / numTiles);
+    console.NoteLn(String().Format("Automatic tile overlap: %.2f, %d tiles instead of %d at %.2f, ",
+                                   selected.overlap, selected.numTiles, numTiles, settings.tileOverlap) + change + '.');
+    return selected.overlap;
+}
+
+}	// namespace pcl
@@ -0,0 +1,63 @@
+#ifndef __TRTInferenceProcessing_h
+#define __TRTInferenceProcessing_h
+
+#include <pcl/ImageVariant.h>
+
+#include "TRTInferenceAutotune.h"
+#include "TRTInferenceEngine.h"
+#include "TRTInferenceParameters.h"
+
+namespace pcl
+{
+
+class TRTTileFarm;
+
+// Parameters of a TRTInference instance that apply to the processing of each image, and the tuned
+// settings of the execution. The defaults leave every optional feature off.
+struct TRTProcessingSettings
+{
+    double tileOverlap = 0.2;
+    // Select the smallest tile overlap whose seams, as probed on the image, differ by at most the threshold
+    bool autoTileOverlap = false;
+    float seamErrorThreshold = 0.002f;
+    bool keepOutputDimension = false;
+    bool binInput = false;
+    pcl_enum blendMode = TRTInferenceBlendMode::Default;
+    bool monoChannelAverage = false;
+    bool skipUniformTiles = false;
+    float uniformTileTolerance = 0.0001f;
+    pcl_enum uniformTilePolicy = TRTInferenceUniformTilePolicy::Default;
+    bool useTileCache = false;
+    // Tile cache limits in MiB
+    int32 tileCacheSize = 1024;
+    int32 tileCacheDiskSize = 8192;
+    String tileCacheDirectory;
+    bool liveDisplay = false;
+    float liveDisplayInterval = 10;
+    bool useCheckpoints = false;
+    float checkpointInterval = 300;
+    String checkpointDirectory;
+    pcl_enum tileOrder = TRTInferenceTileOrder::Default;
+    int32 tileBandHeight = 4;
+    TRTTuning tuning;
+};
+
+// Runs the engine over image and replaces it with the result. imageMask, in the coordinates of image,
+// restricts processing as a view mask does. An empty tile store path disables the store. With a tile
+// farm, tiles are produced by its workers and trtEngine must be the farm engine.
+void processImage(const TRTProcessingSettings& settings, TRTEngine& trtEngine, ImageVariant& image, const FImage* imageMask,
+                  const String& tileStorePath, TRTTileFarm* farm = nullptr);
+
+// Processes an image file without loading it, reading and writing one row of tiles at a time. Both
+// file formats must support incremental access. The output is identical to that of processImage in
+// raster tile order with a fixed tile overlap; options which need the whole image are reported and
+// ignored.
+void processFileOutOfCore(const TRTProcessingSettings& settings, TRTEngine& trtEngine, const String& inputPath,
+                          const String& outputPath);
+
+// Tile overlap selected by probing the seam errors of the engine on the input of processImage
+double selectTileOverlap(const TRTProcessingSettings& settings, TRTEngine& trtEngine, const FImage& input, int numPlanes);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceProcessing_h
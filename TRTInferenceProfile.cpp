@@ -0,0 +1,151 @@
+#include <algorithm>
+
+#include "TRTInferenceProfile.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+double TRTLayerProfile::Layer::totalMs() const
+{
+    double total = 0;
+    for (float t : times)
+        total += t;
+    return total;
+}
+
+double TRTLayerProfile::Layer::medianMs() const
+{
+    if (times.empty())
+        return 0;
+    std::vector<float> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    size_type n = sorted.size();
+    return (n & 1) ? sorted[n / 2] : 0.5 * (double(sorted[n / 2 - 1]) + sorted[n / 2]);
+}
+
+void TRTLayerProfile::addLayerTime(const char* layerName, float ms)
+{
+    IsoString name = m_prefix + layerName;
+    auto i = m_index.find(name);
+    if (i == m_index.end())
+    {
+        i = m_index.insert({ name, m_layers.size() }).first;
+        m_layers.push_back({ name, {} });
+    }
+    m_layers[i->second].times.push_back(ms);
+}
+
+std::vector<const TRTLayerProfile::Layer*> TRTLayerProfile::sortedLayers() const
+{
+    std::vector<const Layer*> sorted;
+    for (const Layer& layer : m_layers)
+        sorted.push_back(&layer);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Layer* a, const Layer* b) { return a->totalMs() > b->totalMs(); });
+    return sorted;
+}
+
+int TRTLayerProfile::numRuns() const
+{
+    size_type n = 0;
+    for (const Layer& layer : m_layers)
+        n = Max(n, layer.times.size());
+    return int(n);
+}
+
+double TRTLayerProfile::totalMs() const
+{
+    double total = 0;
+    for (const Layer& layer : m_layers)
+        total += layer.totalMs();
+    return total;
+}
+
+String TRTLayerProfile::formatTable() const
+{
+    int runs = Max(1, numRuns());
+    double total = totalMs();
+    String table = String().Format("Layer times over %d inferences:\n", numRuns());
+    table << String().Format("%12s %12s %12s %8s   %s\n", "Time(ms)", "Avg.(ms)", "Median(ms)", "Time(%)", "Layer");
+    for (const Layer* layer : sortedLayers())
+    {
+        double t = layer->totalMs();
+        table << String().Format("%12.3f %12.4f %12.4f %8.1f   ", t, t / runs, layer->medianMs(), (total > 0) ? 100 * t / total : 0.0)
+              << String::UTF8ToUTF16(layer->name.c_str()) << '\n';
+    }
+    table << String().Format("%12.3f %12.4f %12s %8.1f   Total", total, total / runs, "", (total > 0) ? 100.0 : 0.0);
+    return table;
+}
+
+static IsoString jsonString(const IsoString& s)
+{
+    IsoString quoted = "\"";
+    for (char c : s)
+        switch (c)
+        {
+        case '\"':
+            quoted << "\\\"";
+            break;
+        case '\\':
+            quoted << "\\\\";
+            break;
+        default:
+            if (uint8(c) < 0x20)
+                quoted << IsoString().Format("\\u%04x", unsigned(uint8(c)));
+            else
+                quoted << c;
+        }
+    quoted << '\"';
+    return quoted;
+}
+
+IsoString TRTLayerProfile::toJSON() const
+{
+    int runs = Max(1, numRuns());
+    double total = totalMs();
+    IsoString json = IsoString().Format("[\n  { \"count\" : %d }", numRuns());
+    for (const Layer* layer : sortedLayers())
+    {
+        double t = layer->totalMs();
+        json << ",\n  { \"name\" : " << jsonString(layer->name)
+             << IsoString().Format(", \"timeMs\" : %.6f, \"averageMs\" : %.6f, \"medianMs\" : %.6f, \"percentage\" : %.4f }",
+                                   t, t / runs, layer->medianMs(), (total > 0) ? 100 * t / total : 0.0);
+    }
+    json << "\n]\n";
+    return json;
+}
+
+void profileEngine(TRTEngine& engine, const FImage& image, int numPlanes, int numTiles, TRTLayerProfile& profile)
+{
+    engine.setNumberOfPlanes(numPlanes);
+    int tileW = engine.getInputTileW();
+    int tileH = engine.getInputTileH();
+    Array<Point> tiles;
+    for (int y = 0; y < image.Height(); y += tileH)
+        for (int x = 0; x < image.Width(); x += tileW)
+            tiles.Add(Point(x, y));
+    if (tiles.IsEmpty())
+        throw Error("Layer profile: empty image.");
+
+    extractTile(image, tiles[0], tileW, tileH, numPlanes, engine.getInputBuffer());
+    engine.runInference();
+
+    if (!engine.setLayerProfile(&profile))
+        throw Error("Layer profiles are only available for TensorRT engines running in this process.");
+    try
+    {
+        for (int i = 0; i < numTiles; i++)
+        {
+            extractTile(image, tiles[i % tiles.Length()], tileW, tileH, numPlanes, engine.getInputBuffer());
+            engine.runInference();
+        }
+    }
+    catch (...)
+    {
+        engine.setLayerProfile(nullptr);
+        throw;
+    }
+    engine.setLayerProfile(nullptr);
+}
+
+}	// namespace pcl
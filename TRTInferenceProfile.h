@@ -0,0 +1,73 @@
+#ifndef __TRTInferenceProfile_h
+#define __TRTInferenceProfile_h
+
+#include <pcl/Image.h>
+#include <pcl/String.h>
+
+#include <map>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Execution times of the layers of an engine over several inferences, as reported by the TensorRT
+// layer profiler. Layers are reported once per inference, and keep the order of their first report.
+// An inference is one enqueue of the engine: a single-channel engine running the planes of a tile in
+// batches reports once per batch, so its inferences count batches, not tiles.
+class TRTLayerProfile
+{
+public:
+    struct Layer
+    {
+        IsoString name;
+        // Milliseconds of each inference
+        std::vector<float> times;
+
+        double totalMs() const;
+        double medianMs() const;
+    };
+
+    void addLayerTime(const char* layerName, float ms);
+
+    // Prefix of the names of the layers reported from now on, as the stage of a pipeline
+    void setLayerPrefix(const IsoString& prefix)
+    {
+        m_prefix = prefix;
+    }
+
+    const std::vector<Layer>& layers() const
+    {
+        return m_layers;
+    }
+
+    // Layers by decreasing total time
+    std::vector<const Layer*> sortedLayers() const;
+
+    // Inferences (enqueues) profiled, as the most reports of any layer
+    int numRuns() const;
+
+    double totalMs() const;
+
+    // Table of the layers by decreasing cost, as trtexec prints it: total, average and median time,
+    // share of the total, and name, followed by the total of all layers
+    String formatTable() const;
+
+    // As exported by trtexec --exportProfile: an array of a {"count"} object with the number of
+    // inferences, then one object per layer by decreasing cost
+    IsoString toJSON() const;
+
+private:
+    std::vector<Layer> m_layers;
+    std::map<IsoString, size_type> m_index;
+    IsoString m_prefix;
+};
+
+// Runs the engine on numTiles tiles of an image with the layer profiler attached, after one inference
+// without it, which includes one-time initialization. Throws Error if the engine cannot be profiled.
+void profileEngine(TRTEngine& engine, const FImage& image, int numPlanes, int numTiles, TRTLayerProfile& profile);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceProfile_h
@@ -0,0 +1,343 @@
+#include <pcl/Compression.h>
+#include <pcl/File.h>
+
+#ifdef __PCL_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "TRTInferenceProtocol.h"
+
+namespace pcl
+{
+
+String serverSocketPath()
+{
+    // Named after the user, as the server of another user sharing the temporary directory can neither
+    // be used nor replaced
+#ifdef __PCL_WINDOWS
+    wchar_t name[257];
+    DWORD length = DWORD(sizeof(name) / sizeof(name[0]));
+    String user = ::GetUserNameW(name, &length) ? String(name) : String("user");
+    return File::SystemTempDirectory() + "/TRTInferenceServer-" + user + ".sock";
+#else
+    return File::SystemTempDirectory() + String().Format("/TRTInferenceServer-%u.sock", unsigned(::getuid()));
+#endif
+}
+
+#ifdef __PCL_WINDOWS
+typedef SOCKET socket_type;
+static const intptr_t s_invalidSocket = intptr_t(INVALID_SOCKET);
+
+static void initializeSockets()
+{
+    static bool initialized = false;
+    if (!initialized)
+    {
+        WSADATA data;
+        if (::WSAStartup(MAKEWORD(2, 2), &data) != 0)
+            throw Error("Unable to initialize Windows sockets.");
+        initialized = true;
+    }
+}
+
+static void closeSocket(intptr_t socket)
+{
+    ::closesocket(socket_type(socket));
+}
+
+static void removeSocketFile(const String& path)
+{
+    ::DeleteFileW(reinterpret_cast<LPCWSTR>(File::UnixPathToWindows(path).c_str()));
+}
+#else
+typedef int socket_type;
+static const intptr_t s_invalidSocket = -1;
+
+static void initializeSockets()
+{
+}
+
+static void closeSocket(intptr_t socket)
+{
+    ::close(int(socket));
+}
+
+static void removeSocketFile(const String& path)
+{
+    ::unlink(path.ToUTF8().c_str());
+}
+#endif
+
+// A closed peer must not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+static const int s_sendFlags = MSG_NOSIGNAL;
+#else
+static const int s_sendFlags = 0;
+#endif
+
+// Tiles are sent as soon as they are written
+static void disableNagle(intptr_t socket)
+{
+    int enable = 1;
+    ::setsockopt(socket_type(socket), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enable), sizeof(enable));
+}
+
+static sockaddr_un socketAddress(const String& path)
+{
+#ifdef __PCL_WINDOWS
+    IsoString address = File::UnixPathToWindows(path).ToUTF8();
+#else
+    IsoString address = path.ToUTF8();
+#endif
+    sockaddr_un addr = {};
+    if (address.Length() >= sizeof(addr.sun_path))
+        throw Error("Socket path too long: " + path);
+    addr.sun_family = AF_UNIX;
+    ::memcpy(addr.sun_path, address.c_str(), address.Length());
+    return addr;
+}
+
+TRTSocket::~TRTSocket()
+{
+    close();
+}
+
+TRTSocket& TRTSocket::operator=(TRTSocket&& x)
+{
+    if (&x != this)
+    {
+        close();
+        m_socket = x.m_socket;
+        x.m_socket = -1;
+    }
+    return *this;
+}
+
+void TRTSocket::close()
+{
+    if (m_socket != -1)
+    {
+        closeSocket(m_socket);
+        m_socket = -1;
+    }
+}
+
+TRTSocket TRTSocket::connect(const String& path)
+{
+    initializeSockets();
+    sockaddr_un addr = socketAddress(path);
+    intptr_t s = intptr_t(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (s == s_invalidSocket)
+        throw Error("Unable to create socket.");
+    if (::connect(socket_type(s), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        closeSocket(s);
+        throw TRTConnectionError("No inference server is listening at " + path);
+    }
+    return TRTSocket(s);
+}
+
+TRTSocket TRTSocket::connectTcp(const String& address)
+{
+    initializeSockets();
+    IsoString hostPort = address.Trimmed().ToUTF8();
+    size_type colon = hostPort.FindLast(':');
+    if (colon == IsoString::notFound)
+        throw Error("Invalid worker address, expected host:port: " + address);
+    IsoString host = hostPort.Left(colon);
+    IsoString port = hostPort.Substring(colon + 1);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0)
+        throw TRTConnectionError("Unable to resolve " + address);
+
+    intptr_t s = s_invalidSocket;
+    for (addrinfo* a = addresses; a != nullptr; a = a->ai_next)
+    {
+        s = intptr_t(::socket(a->ai_family, a->ai_socktype, a->ai_protocol));
+        if (s == s_invalidSocket)
+            continue;
+        if (::connect(socket_type(s), a->ai_addr, int(a->ai_addrlen)) == 0)
+            break;
+        closeSocket(s);
+        s = s_invalidSocket;
+    }
+    ::freeaddrinfo(addresses);
+    if (s == s_invalidSocket)
+        throw TRTConnectionError("No worker is listening at " + address);
+    disableNagle(s);
+    return TRTSocket(s);
+}
+
+TRTSocket TRTSocket::listen(const String& path)
+{
+    initializeSockets();
+    sockaddr_un addr = socketAddress(path);
+    // File::Exists does not report socket files, so whether one is left over from a server which did not
+    // exit cleanly, and can be removed, or in use is told by connecting to it
+    intptr_t probe = intptr_t(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (probe == s_invalidSocket)
+        throw Error("Unable to create socket.");
+    bool live = ::connect(socket_type(probe), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    closeSocket(probe);
+    if (live)
+        throw Error("An inference server is already listening at " + path);
+    removeSocketFile(path);
+    intptr_t s = intptr_t(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (s == s_invalidSocket)
+        throw Error("Unable to create socket.");
+    if ((::bind(socket_type(s), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) ||
+        (::listen(socket_type(s), 16) != 0))
+    {
+        closeSocket(s);
+        throw Error("Unable to listen at " + path);
+    }
+    return TRTSocket(s);
+}
+
+TRTSocket TRTSocket::listenTcp(int port, const String& bindAddress)
+{
+    initializeSockets();
+    IsoString host = bindAddress.Trimmed().ToUTF8();
+    IsoString service = IsoString().Format("%d", port);
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0)
+        throw Error("Unable to resolve " + bindAddress);
+
+    intptr_t s = s_invalidSocket;
+    for (addrinfo* a = addresses; a != nullptr; a = a->ai_next)
+    {
+        s = intptr_t(::socket(a->ai_family, a->ai_socktype, a->ai_protocol));
+        if (s == s_invalidSocket)
+            continue;
+        int enable = 1;
+        ::setsockopt(socket_type(s), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&enable), sizeof(enable));
+        if ((::bind(socket_type(s), a->ai_addr, int(a->ai_addrlen)) == 0) && (::listen(socket_type(s), 16) == 0))
+            break;
+        closeSocket(s);
+        s = s_invalidSocket;
+    }
+    ::freeaddrinfo(addresses);
+    if (s == s_invalidSocket)
+        throw Error(String().Format("Unable to listen on port %d of ", port) + bindAddress);
+    return TRTSocket(s);
+}
+
+TRTSocket TRTSocket::accept() const
+{
+    intptr_t s = intptr_t(::accept(socket_type(m_socket), nullptr, nullptr));
+    if (s == s_invalidSocket)
+        throw Error("Unable to accept a connection.");
+    // Fails harmlessly on Unix-domain sockets
+    disableNagle(s);
+    return TRTSocket(s);
+}
+
+void TRTSocket::send(const void* data, size_type size) const
+{
+    const char* p = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        int n = int(::send(socket_type(m_socket), p, int(Min(size, size_type(1 << 20))), s_sendFlags));
+        if (n <= 0)
+            throw TRTConnectionError("Connection to the inference server lost.");
+        p += n;
+        size -= n;
+    }
+}
+
+void TRTSocket::receive(void* data, size_type size) const
+{
+    char* p = static_cast<char*>(data);
+    while (size > 0)
+    {
+        int n = int(::recv(socket_type(m_socket), p, int(Min(size, size_type(1 << 20))), 0));
+        if (n <= 0)
+            throw TRTConnectionError("Connection to the inference server lost.");
+        p += n;
+        size -= n;
+    }
+}
+
+// Tiles are sent as subblocks compressed with byte shuffling, which groups the bytes of equal
+// significance of the samples, or raw if they do not compress: a subblock count followed by the size
+// and data of each subblock.
+void TRTSocket::sendTile(const float* tile, size_type count) const
+{
+    LZ4Compression compression;
+    compression.EnableByteShuffling();
+    compression.SetItemSize(sizeof(float));
+    Compression::subblock_list subblocks = compression.Compress(tile, count * sizeof(float));
+
+    uint32 numSubblocks = uint32(subblocks.Length());
+    send(&numSubblocks, sizeof(numSubblocks));
+    if (numSubblocks == 0)
+        send(tile, count * sizeof(float));
+    for (const Compression::Subblock& subblock : subblocks)
+    {
+        uint64 sizes[] = { subblock.uncompressedSize, subblock.compressedData.Length() };
+        send(sizes, sizeof(sizes));
+        send(subblock.compressedData.Begin(), subblock.compressedData.Length());
+    }
+}
+
+void TRTSocket::receiveTile(float* tile, size_type count) const
+{
+    size_type size = count * sizeof(float);
+    uint32 numSubblocks;
+    receive(&numSubblocks, sizeof(numSubblocks));
+    if (numSubblocks == 0)
+    {
+        receive(tile, size);
+        return;
+    }
+    // Subblocks are never empty
+    if (numSubblocks > size)
+        throw TRTConnectionError("Tile size mismatch.");
+
+    // Sizes are checked before anything is allocated for them
+    Compression::subblock_list subblocks;
+    size_type totalSize = 0;
+    for (uint32 i = 0; i < numSubblocks; i++)
+    {
+        uint64 sizes[2];
+        receive(sizes, sizeof(sizes));
+        if ((sizes[0] == 0) || (sizes[0] > size - totalSize))
+            throw TRTConnectionError("Tile size mismatch.");
+        // The worst case of LZ4, LZ4_COMPRESSBOUND
+        if (sizes[1] > sizes[0] + sizes[0] / 255 + 16)
+            throw TRTConnectionError("Corrupted tile data.");
+        Compression::Subblock subblock;
+        subblock.uncompressedSize = size_type(sizes[0]);
+        subblock.compressedData = ByteArray(size_type(sizes[1]));
+        receive(subblock.compressedData.Begin(), subblock.compressedData.Length());
+        totalSize += subblock.uncompressedSize;
+        subblocks << subblock;
+    }
+    if (totalSize != size)
+        throw TRTConnectionError("Tile size mismatch.");
+
+    LZ4Compression compression;
+    compression.EnableByteShuffling();
+    compression.SetItemSize(sizeof(float));
+    if (compression.Uncompress(tile, size, subblocks) != size)
+        throw TRTConnectionError("Corrupted tile data.");
+}
+
+}	// namespace pcl
@@ -0,0 +1,130 @@
+#ifndef __TRTInferenceProtocol_h
+#define __TRTInferenceProtocol_h
+
+#include <pcl/Exception.h>
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+// Protocol between the module and the inference server, a separate process keeping engines loaded
+// for several PixInsight instances. Fixed-size requests and replies travel over a Unix-domain socket;
+// tiles travel through a file mapped by both sides, so pixel data never goes through the socket.
+//
+// A client opens an engine, then announces its tile buffer file and number of planes, then requests
+// inference for each tile. The tile buffer holds the input tile followed by the output tile, both
+// planar, sized for the announced number of planes.
+//
+// Worker nodes of a tile farm are reached over TCP instead, and share no files with the client: Open
+// and SetPlanes come without a path, the worker serving the engine it was started with, and each
+// InferTile request is followed by the compressed input tile, and its reply by the compressed output
+// tile. Workers reject paths and Infer requests from TCP clients, so that the network cannot make them
+// load or map files of their choice.
+
+static const uint32 TRTProtocolMagic = 0x54525431; // 'TRT1'
+
+// Most planes a tile may have, which bounds what a peer can make the other side allocate
+static const int32 TRTMaxPlanes = 64;
+
+namespace TRTRequestType
+{
+    enum value_type { Open = 1, SetPlanes, Infer, Close, InferTile };
+}
+
+struct TRTRequest
+{
+    uint32 magic;
+    uint32 type;
+    int32 numPlanes;
+    int32 reserved;
+    // UTF-8 path of the engine file for Open, of the tile buffer file for SetPlanes
+    char path[1024];
+};
+
+struct TRTReply
+{
+    uint32 magic;
+    // Zero on success; otherwise message explains the failure
+    int32 status;
+    int32 inputTileW;
+    int32 inputTileH;
+    int32 outputTileW;
+    int32 outputTileH;
+    int32 numChannels;
+    int32 reserved;
+    uint64 engineHash;
+    char message[512];
+};
+
+// Default socket path of the inference server of the current user
+String serverSocketPath();
+
+// Failure of the connection itself, as opposed to an error reported by the server
+class TRTConnectionError : public Error
+{
+public:
+    using Error::Error;
+};
+
+// Connected stream socket, closed on destruction
+class TRTSocket
+{
+public:
+    TRTSocket() = default;
+    ~TRTSocket();
+
+    TRTSocket(TRTSocket&& x)
+        : m_socket(x.m_socket)
+    {
+        x.m_socket = -1;
+    }
+
+    TRTSocket& operator=(TRTSocket&& x);
+
+    TRTSocket(const TRTSocket&) = delete;
+    TRTSocket& operator=(const TRTSocket&) = delete;
+
+    // Connects to a listening socket; throws TRTConnectionError if there is none at path
+    static TRTSocket connect(const String& path);
+
+    // Connects to a TCP address given as "host:port"
+    static TRTSocket connectTcp(const String& address);
+
+    // Listens at path, replacing a stale socket file; throws if a server is listening there already
+    static TRTSocket listen(const String& path);
+
+    // Listens on a TCP port of the interface with the given address, only reachable from this machine
+    // by default
+    static TRTSocket listenTcp(int port, const String& bindAddress = "127.0.0.1");
+
+    // Waits for the next client of a listening socket
+    TRTSocket accept() const;
+
+    bool isValid() const
+    {
+        return m_socket != -1;
+    }
+
+    // Transfers exactly size bytes; throws TRTConnectionError if the connection is closed or fails
+    void send(const void* data, size_type size) const;
+    void receive(void* data, size_type size) const;
+
+    // Transfers a tile of count samples, compressed. The receiver validates the announced sizes against
+    // count before allocating, and throws TRTConnectionError if they do not match.
+    void sendTile(const float* tile, size_type count) const;
+    void receiveTile(float* tile, size_type count) const;
+
+private:
+    intptr_t m_socket = -1;
+
+    explicit TRTSocket(intptr_t socket)
+        : m_socket(socket)
+    {
+    }
+
+    void close();
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceProtocol_h
@@ -0,0 +1,154 @@
+#include <pcl/Exception.h>
+
+#include <NvInferVersion.h>
+
+#include <mutex>
+
+#ifdef __PCL_WINDOWS
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "TRTInferenceRuntime.h"
+
+namespace pcl
+{
+
+#ifdef __PCL_WINDOWS
+static const char* s_inferLibraries[] = { "nvinfer.dll" };
+static const char* s_cudaLibraries[] = { "cudart64_110.dll", "cudart64_12.dll" };
+
+static void* openLibrary(const char* name)
+{
+    return reinterpret_cast<void*>(::LoadLibraryA(name));
+}
+
+static void* librarySymbol(void* library, const char* name)
+{
+    return reinterpret_cast<void*>(::GetProcAddress(reinterpret_cast<HMODULE>(library), name));
+}
+#else
+static const char* s_inferLibraries[] = { "libnvinfer.so.8", "libnvinfer.so" };
+static const char* s_cudaLibraries[] = { "libcudart.so.11.0", "libcudart.so.12", "libcudart.so" };
+
+static void* openLibrary(const char* name)
+{
+    return ::dlopen(name, RTLD_NOW | RTLD_LOCAL);
+}
+
+static void* librarySymbol(void* library, const char* name)
+{
+    return ::dlsym(library, name);
+}
+#endif
+
+static std::mutex s_mutex;
+static int s_state = TRTRuntimeState::NotLoaded;
+static String s_description;
+static TRTRuntime s_runtime;
+
+template <size_t N>
+static void* openFirstLibrary(const char* (&names)[N])
+{
+    for (const char* name : names)
+        if (void* library = openLibrary(name))
+            return library;
+    String list;
+    for (const char* name : names)
+        list << (list.IsEmpty() ? "" : ", ") << name;
+    throw Error("None of " + list + " could be loaded.");
+}
+
+template <typename T>
+static void resolve(void* library, T& function, const char* name)
+{
+    function = reinterpret_cast<T>(librarySymbol(library, name));
+    if (function == nullptr)
+        throw Error(String("Missing runtime entry point ") + name);
+}
+
+static void loadRuntime()
+{
+    // The libraries stay loaded until the module is unloaded
+    void* infer = openFirstLibrary(s_inferLibraries);
+    resolve(infer, s_runtime.createInferRuntime, "createInferRuntime_INTERNAL");
+    resolve(infer, s_runtime.getInferLibVersion, "getInferLibVersion");
+
+    void* cuda = openFirstLibrary(s_cudaLibraries);
+    resolve(cuda, s_runtime.setDevice, "cudaSetDevice");
+    resolve(cuda, s_runtime.streamCreate, "cudaStreamCreate");
+    resolve(cuda, s_runtime.streamDestroy, "cudaStreamDestroy");
+    resolve(cuda, s_runtime.streamSynchronize, "cudaStreamSynchronize");
+    resolve(cuda, s_runtime.deviceMalloc, "cudaMalloc");
+    resolve(cuda, s_runtime.deviceFree, "cudaFree");
+    resolve(cuda, s_runtime.memcpyAsync, "cudaMemcpyAsync");
+    resolve(cuda, s_runtime.runtimeGetVersion, "cudaRuntimeGetVersion");
+    resolve(cuda, s_runtime.deviceGetAttribute, "cudaDeviceGetAttribute");
+    resolve(cuda, s_runtime.memGetInfo, "cudaMemGetInfo");
+
+    // Engines are bound to the TensorRT major version the module was built for
+    int32_t inferVersion = s_runtime.getInferLibVersion();
+    if (inferVersion / 1000 != NV_TENSORRT_MAJOR)
+        throw Error(String().Format("TensorRT %d.%d found, version %d required.", inferVersion / 1000, inferVersion / 100 % 10, NV_TENSORRT_MAJOR));
+
+    int cudaVersion = 0;
+    s_runtime.runtimeGetVersion(&cudaVersion);
+    s_description = String().Format("TensorRT %d.%d.%d, CUDA %d.%d", inferVersion / 1000, inferVersion / 100 % 10, inferVersion % 100,
+                                    cudaVersion / 1000, cudaVersion / 10 % 100);
+}
+
+const TRTRuntime& trtRuntime()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_state == TRTRuntimeState::NotLoaded)
+    {
+        try
+        {
+            loadRuntime();
+            s_state = TRTRuntimeState::Loaded;
+        }
+        catch (const Error& x)
+        {
+            s_state = TRTRuntimeState::Unavailable;
+            s_description = "No inference backend: " + x.Message();
+        }
+    }
+    if (s_state == TRTRuntimeState::Unavailable)
+        throw Error(s_description);
+    return s_runtime;
+}
+
+int trtRuntimeState(String& description)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    description = (s_state == TRTRuntimeState::NotLoaded) ? String("TensorRT, loaded at first use") : s_description;
+    return s_state;
+}
+
+TRTDeviceBuffer::~TRTDeviceBuffer()
+{
+    if (m_data != nullptr)
+        trtRuntime().deviceFree(m_data);
+}
+
+void TRTDeviceBuffer::resize(size_type size)
+{
+    if (size > m_capacity)
+    {
+        const TRTRuntime& runtime = trtRuntime();
+        if (m_data != nullptr)
+            runtime.deviceFree(m_data);
+        m_data = nullptr;
+        m_capacity = 0;
+        if (runtime.deviceMalloc(&m_data, size) != cudaSuccess)
+        {
+            m_data = nullptr;
+            throw Error("Failed to allocate GPU memory.");
+        }
+        m_capacity = size;
+    }
+    m_size = size;
+}
+
+}	// namespace pcl
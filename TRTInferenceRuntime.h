@@ -0,0 +1,72 @@
+#ifndef __TRTInferenceRuntime_h
+#define __TRTInferenceRuntime_h
+
+#include <pcl/String.h>
+#include <cuda_runtime_api.h>
+
+namespace pcl
+{
+
+// Entry points of the TensorRT and CUDA runtime libraries. The module does not link these libraries:
+// they are loaded at the first inference, so loading the module does not pull them in, and the module
+// still loads on machines without them. Everything else in TensorRT is reached through its interfaces.
+struct TRTRuntime
+{
+    void* (*createInferRuntime)(void* logger, int32_t version);
+    int32_t (*getInferLibVersion)();
+    cudaError_t (*setDevice)(int device);
+    cudaError_t (*streamCreate)(cudaStream_t* stream);
+    cudaError_t (*streamDestroy)(cudaStream_t stream);
+    cudaError_t (*streamSynchronize)(cudaStream_t stream);
+    cudaError_t (*deviceMalloc)(void** pointer, size_t size);
+    cudaError_t (*deviceFree)(void* pointer);
+    cudaError_t (*memcpyAsync)(void* destination, const void* source, size_t size, cudaMemcpyKind kind, cudaStream_t stream);
+    cudaError_t (*runtimeGetVersion)(int* version);
+    cudaError_t (*deviceGetAttribute)(int* value, cudaDeviceAttr attribute, int device);
+    cudaError_t (*memGetInfo)(size_t* free, size_t* total);
+};
+
+namespace TRTRuntimeState
+{
+    enum value_type { NotLoaded, Loaded, Unavailable };
+}
+
+// The runtime, loaded on the first call. Throws Error explaining what is missing when there is no
+// usable runtime on this machine.
+const TRTRuntime& trtRuntime();
+
+// State of the runtime, without loading it, and a description for display
+int trtRuntimeState(String& description);
+
+// Device memory allocated through the runtime
+class TRTDeviceBuffer
+{
+public:
+    TRTDeviceBuffer() = default;
+    ~TRTDeviceBuffer();
+
+    TRTDeviceBuffer(const TRTDeviceBuffer&) = delete;
+    TRTDeviceBuffer& operator=(const TRTDeviceBuffer&) = delete;
+
+    // Reallocates only to grow
+    void resize(size_type size);
+
+    void* data() const
+    {
+        return m_data;
+    }
+
+    size_type size() const
+    {
+        return m_size;
+    }
+
+private:
+    void* m_data = nullptr;
+    size_type m_size = 0;
+    size_type m_capacity = 0;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceRuntime_h
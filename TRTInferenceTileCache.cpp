@@ -0,0 +1,181 @@
+#include <pcl/AutoLock.h>
+#include <pcl/File.h>
+
+#include "TRTInferenceTileCache.h"
+
+namespace pcl
+{
+
+TRTTileCache& TRTTileCache::instance()
+{
+    static TRTTileCache cache;
+    return cache;
+}
+
+TRTTileCache::Key TRTTileCache::makeKey(uint64 engineHash, int inputTileW, int inputTileH, int outputTileW, int outputTileH, int numChannels, const float* inputTile)
+{
+    int32 geometry[] = { inputTileW, inputTileH, outputTileW, outputTileH, numChannels };
+    uint64 seed = Hash64(geometry, sizeof(geometry), engineHash);
+    size_type size = size_type(numChannels) * inputTileW * inputTileH * sizeof(float);
+    return { Hash64(inputTile, size, seed), Hash64(inputTile, size, ~seed) };
+}
+
+void TRTTileCache::configure(size_type memoryLimit, size_type diskLimit, const String& spillDirectory)
+{
+    volatile AutoLock lock(m_mutex);
+
+    m_memoryLimit = memoryLimit;
+    m_diskLimit = diskLimit;
+    if (spillDirectory != m_spillDirectory)
+    {
+        m_spillDirectory = spillDirectory;
+        scanSpillDirectory();
+    }
+    evict();
+}
+
+bool TRTTileCache::lookup(const Key& key, float* outputTile, size_type count)
+{
+    volatile AutoLock lock(m_mutex);
+
+    auto i = m_index.find(key);
+    if (i != m_index.end())
+    {
+        if (i->second->data.size() != count)
+        {
+            // A tile of another size cannot be returned; drop it so that store can replace it
+            m_memoryUsage -= i->second->data.size() * sizeof(float);
+            m_entries.erase(i->second);
+            m_index.erase(i);
+            return false;
+        }
+        m_entries.splice(m_entries.begin(), m_entries, i->second);
+        ::memcpy(outputTile, i->second->data.data(), count * sizeof(float));
+        return true;
+    }
+
+    if (m_spillDirectory.IsEmpty())
+        return false;
+
+    String path = spillFilePath(key);
+    if (!File::Exists(path))
+        return false;
+    try
+    {
+        File file = File::OpenFileForReading(path);
+        if (file.Size() != fsize_type(count * sizeof(float)))
+            return false;
+        file.Read(outputTile, count * sizeof(float));
+        file.Close();
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // Bring it back into memory; the spill file stays valid
+    m_entries.push_front({ key, std::vector<float>(outputTile, outputTile + count) });
+    m_index[key] = m_entries.begin();
+    m_memoryUsage += count * sizeof(float);
+    evict();
+    return true;
+}
+
+void TRTTileCache::store(const Key& key, const float* outputTile, size_type count)
+{
+    volatile AutoLock lock(m_mutex);
+
+    if (m_index.find(key) != m_index.end())
+        return;
+    m_entries.push_front({ key, std::vector<float>(outputTile, outputTile + count) });
+    m_index[key] = m_entries.begin();
+    m_memoryUsage += count * sizeof(float);
+    evict();
+}
+
+void TRTTileCache::clear()
+{
+    volatile AutoLock lock(m_mutex);
+
+    m_entries.clear();
+    m_index.clear();
+    m_memoryUsage = 0;
+}
+
+String TRTTileCache::spillFilePath(const Key& key) const
+{
+    return m_spillDirectory + '/' + String().Format("%016llx%016llx", key.hash1, key.hash2) + ".tile";
+}
+
+void TRTTileCache::evict()
+{
+    while ((m_memoryUsage > m_memoryLimit) && !m_entries.empty())
+    {
+        const Entry& entry = m_entries.back();
+        if (!m_spillDirectory.IsEmpty())
+            spill(entry);
+        m_memoryUsage -= entry.data.size() * sizeof(float);
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+void TRTTileCache::spill(const Entry& entry)
+{
+    String path = spillFilePath(entry.key);
+    if (File::Exists(path))
+        return;
+
+    size_type size = entry.data.size() * sizeof(float);
+    try
+    {
+        File file = File::CreateFileForWriting(path);
+        file.Write(entry.data.data(), size);
+        file.Close();
+    }
+    catch (...)
+    {
+        // A full or read-only spill directory only costs cache hits
+        return;
+    }
+    m_spillFiles.push_back({ path, size });
+    m_diskUsage += size;
+
+    while ((m_diskUsage > m_diskLimit) && !m_spillFiles.empty())
+    {
+        try
+        {
+            File::Remove(m_spillFiles.front().path);
+        }
+        catch (...)
+        {
+        }
+        m_diskUsage -= m_spillFiles.front().size;
+        m_spillFiles.pop_front();
+    }
+}
+
+void TRTTileCache::scanSpillDirectory()
+{
+    m_spillFiles.clear();
+    m_diskUsage = 0;
+    if (m_spillDirectory.IsEmpty())
+        return;
+    if (!File::DirectoryExists(m_spillDirectory))
+        File::CreateDirectory(m_spillDirectory);
+
+    // Tiles spilled by earlier sessions, oldest first so they are the first to go
+    Array<FindFileInfo> found;
+    FindFileInfo info;
+    for (File::Find f(m_spillDirectory + "/*.tile"); f.NextItem(info);)
+        if (!info.IsDirectory())
+            found.Add(info);
+    found.Sort([](const FindFileInfo& a, const FindFileInfo& b) { return a.lastModified < b.lastModified; });
+    for (const FindFileInfo& file : found)
+    {
+        m_spillFiles.push_back({ m_spillDirectory + '/' + file.name, size_type(file.size) });
+        m_diskUsage += size_type(file.size);
+    }
+}
+
+}	// namespace pcl
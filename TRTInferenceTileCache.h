@@ -0,0 +1,84 @@
+#ifndef __TRTInferenceTileCache_h
+#define __TRTInferenceTileCache_h
+
+#include <pcl/Mutex.h>
+#include <pcl/String.h>
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace pcl
+{
+
+// Session-wide cache of engine output tiles, keyed by engine identity, tile geometry and a hash of the
+// input tile data. Least recently used tiles are evicted once the memory limit is reached; if a spill
+// directory is configured, evicted tiles are written there and can be read back by later lookups,
+// also in later sessions.
+class TRTTileCache
+{
+public:
+    struct Key
+    {
+        uint64 hash1;
+        uint64 hash2;
+
+        bool operator==(const Key& k) const
+        {
+            return (hash1 == k.hash1) && (hash2 == k.hash2);
+        }
+    };
+
+    static TRTTileCache& instance();
+
+    static Key makeKey(uint64 engineHash, int inputTileW, int inputTileH, int outputTileW, int outputTileH, int numChannels, const float* inputTile);
+
+    // Limits are in bytes. An empty spill directory disables spilling to disk.
+    void configure(size_type memoryLimit, size_type diskLimit, const String& spillDirectory);
+
+    bool lookup(const Key& key, float* outputTile, size_type count);
+    void store(const Key& key, const float* outputTile, size_type count);
+    void clear();
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& k) const
+        {
+            return size_t(k.hash1);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::vector<float> data;
+    };
+
+    struct SpillFile
+    {
+        String path;
+        size_type size;
+    };
+
+    Mutex m_mutex;
+    // Most recently used entries first
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+    size_type m_memoryUsage = 0;
+    size_type m_memoryLimit = 0;
+    // Oldest spill files first
+    std::list<SpillFile> m_spillFiles;
+    size_type m_diskUsage = 0;
+    size_type m_diskLimit = 0;
+    String m_spillDirectory;
+
+    String spillFilePath(const Key& key) const;
+    void evict();
+    void spill(const Entry& entry);
+    void scanSpillDirectory();
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceTileCache_h
@@ -0,0 +1,97 @@
+#include <algorithm>
+
+#include "TRTInferenceParameters.h"
+#include "TRTInferenceTileCache.h"
+#include "TRTInferenceTileProducer.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+TRTTileProducer::TRTTileProducer(TRTEngine& engine, int numPlanes, bool skipUniformTiles, float uniformTileTolerance,
+                                 pcl_enum uniformTilePolicy, bool useTileCache)
+    : m_engine(engine)
+    , m_numPlanes(numPlanes)
+    , m_skipUniformTiles(skipUniformTiles)
+    , m_uniformTileTolerance(uniformTileTolerance)
+    , m_uniformTilePolicy(uniformTilePolicy)
+    , m_useTileCache(useTileCache)
+    , m_fillTile(size_type(numPlanes) * engine.getOutputTileW() * engine.getOutputTileH())
+{
+}
+
+const float* TRTTileProducer::produce(const FImage& input, const Point& tilePos)
+{
+    int inputTileW = m_engine.getInputTileW();
+    int inputTileH = m_engine.getInputTileH();
+    int outputTileW = m_engine.getOutputTileW();
+    int outputTileH = m_engine.getOutputTileH();
+
+    float* inputTile = m_engine.getInputBuffer();
+    extractTile(input, tilePos, inputTileW, inputTileH, m_numPlanes, inputTile);
+
+    float uniformValues[3];
+    const float* outputTile = nullptr;
+    if (m_skipUniformTiles && isUniformTile(inputTile, inputTileW, inputTileH, m_numPlanes, m_uniformTileTolerance, uniformValues))
+    {
+        switch (m_uniformTilePolicy)
+        {
+        case TRTInferenceUniformTilePolicy::Passthrough:
+            upscaleTile(inputTile, inputTileW, inputTileH, m_numPlanes, outputTileW / inputTileW, outputTileH / inputTileH, m_fillTile.data());
+            outputTile = m_fillTile.data();
+            break;
+        case TRTInferenceUniformTilePolicy::Zero:
+            std::fill(m_fillTile.begin(), m_fillTile.end(), 0.0f);
+            outputTile = m_fillTile.data();
+            break;
+        default:
+        case TRTInferenceUniformTilePolicy::CachedResponse:
+            {
+                float uniformStep = Max(m_uniformTileTolerance, 1.0f / 65535);
+                std::array<int64, 3> key = { 0, 0, 0 };
+                for (int c = 0; c < m_numPlanes; c++)
+                    key[c] = RoundInt64(uniformValues[c] / uniformStep);
+                auto response = m_uniformResponses.find(key);
+                if (response != m_uniformResponses.end())
+                    outputTile = response->second.data();
+                else
+                {
+                    // First tile of this level: infer it and remember the response
+                    m_engine.runInference();
+                    const float* p = m_engine.getOutputBuffer();
+                    m_uniformResponses[key].assign(p, p + m_fillTile.size());
+                    outputTile = p;
+                    m_numSkipped--;
+                }
+            }
+            break;
+        }
+        m_numSkipped++;
+    }
+
+    if (outputTile == nullptr)
+    {
+        TRTTileCache& tileCache = TRTTileCache::instance();
+        TRTTileCache::Key key;
+        if (m_useTileCache)
+        {
+            key = TRTTileCache::makeKey(m_engine.getEngineHash(), inputTileW, inputTileH, outputTileW, outputTileH, m_numPlanes, inputTile);
+            if (tileCache.lookup(key, m_fillTile.data(), m_fillTile.size()))
+            {
+                outputTile = m_fillTile.data();
+                m_numCached++;
+            }
+        }
+        if (outputTile == nullptr)
+        {
+            m_engine.runInference();
+            outputTile = m_engine.getOutputBuffer();
+            if (m_useTileCache)
+                tileCache.store(key, outputTile, m_fillTile.size());
+        }
+    }
+
+    return outputTile;
+}
+
+}	// namespace pcl
@@ -0,0 +1,51 @@
+#ifndef __TRTInferenceTileProducer_h
+#define __TRTInferenceTileProducer_h
+
+#include <pcl/Image.h>
+
+#include <array>
+#include <map>
+#include <vector>
+
+#include "TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Engine output for the input tiles of an image, taking the uniform tile and tile cache shortcuts
+// when enabled. The tile cache must be configured by the caller.
+class TRTTileProducer
+{
+public:
+    TRTTileProducer(TRTEngine& engine, int numPlanes, bool skipUniformTiles, float uniformTileTolerance,
+                    pcl_enum uniformTilePolicy, bool useTileCache);
+
+    // The returned tile is valid until the next call
+    const float* produce(const FImage& input, const Point& tilePos);
+
+    int numSkipped() const
+    {
+        return m_numSkipped;
+    }
+
+    int numCached() const
+    {
+        return m_numCached;
+    }
+
+private:
+    TRTEngine& m_engine;
+    int m_numPlanes;
+    bool m_skipUniformTiles;
+    float m_uniformTileTolerance;
+    pcl_enum m_uniformTilePolicy;
+    bool m_useTileCache;
+    std::vector<float> m_fillTile;
+    std::map<std::array<int64, 3>, std::vector<float>> m_uniformResponses;
+    int m_numSkipped = 0;
+    int m_numCached = 0;
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceTileProducer_h
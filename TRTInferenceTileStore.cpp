@@ -0,0 +1,119 @@
+#include <pcl/File.h>
+
+#include "TRTInferenceTileStore.h"
+
+namespace pcl
+{
+
+static const char s_magic[8] = { 'T', 'R', 'T', 'T', 'I', 'L', 'E', 'S' };
+static const uint32 s_version = 2;
+static const size_type s_headerSize = 128;
+
+struct TileStoreHeader
+{
+    char magic[8];
+    uint32 version;
+    uint32 reserved;
+    TRTTileStoreLayout layout;
+};
+
+static size_type alignedSize(size_type size)
+{
+    return (size + 63) & ~size_type(63);
+}
+
+TRTTileStore::TRTTileStore(const String& path, const TRTTileStoreLayout& layout)
+    : m_layout(layout)
+    , m_numStored(0)
+{
+    m_tileSize = size_type(layout.numChannels) * layout.outputTileW * layout.outputTileH;
+    size_type totalSize = alignedSize(s_headerSize + layout.numTiles) + m_tileSize * layout.numTiles * sizeof(uint16);
+
+    if (File::Exists(path))
+    {
+        bool valid = false;
+        {
+            TRTMappedFile existing(path, false);
+            if (existing.size() == totalSize)
+            {
+                const TileStoreHeader* header = reinterpret_cast<const TileStoreHeader*>(existing.data());
+                valid = (::memcmp(header->magic, s_magic, sizeof(s_magic)) == 0) &&
+                        (header->version == s_version) &&
+                        (::memcmp(&header->layout, &layout, sizeof(layout)) == 0);
+            }
+        }
+        if (valid)
+        {
+            m_file = std::make_unique<TRTMappedFile>(path, true);
+            for (int i = 0; i < layout.numTiles; i++)
+                if (hasTile(i))
+                    m_numStored++;
+            return;
+        }
+        File::Remove(path);
+    }
+
+    // A new file is zero-filled, so no tile is flagged as stored
+    m_file = std::make_unique<TRTMappedFile>(path, true, totalSize);
+    TileStoreHeader* header = reinterpret_cast<TileStoreHeader*>(m_file->data());
+    ::memcpy(header->magic, s_magic, sizeof(s_magic));
+    header->version = s_version;
+    header->reserved = 0;
+    header->layout = layout;
+}
+
+String TRTTileStore::storePath(const String& imageFilePath, const IsoString& viewId)
+{
+    if (imageFilePath.IsEmpty())
+        return File::SystemTempDirectory() + '/' + String(viewId) + ".trttiles";
+    return File::ChangeExtension(imageFilePath, String()) + '_' + String(viewId) + ".trttiles";
+}
+
+uint64 TRTTileStore::imageHash(const FImage& image)
+{
+    int32 geometry[] = { image.Width(), image.Height(), image.NumberOfChannels() };
+    uint64 hash = Hash64(geometry, sizeof(geometry));
+    for (int c = 0; c < image.NumberOfChannels(); c++)
+        hash = Hash64(image.PixelData(c), image.NumberOfPixels() * sizeof(float), hash);
+    return hash;
+}
+
+uint8* TRTTileStore::flags() const
+{
+    return m_file->data() + s_headerSize;
+}
+
+uint16* TRTTileStore::tileData(int index) const
+{
+    uint8* data = m_file->data() + alignedSize(s_headerSize + m_layout.numTiles);
+    return reinterpret_cast<uint16*>(data) + m_tileSize * index;
+}
+
+void TRTTileStore::readTile(int index, float* tile) const
+{
+    const uint16* s = tileData(index);
+    for (size_type i = 0; i < m_tileSize; i++)
+        tile[i] = s[i] * (1.0f / 65535);
+}
+
+void TRTTileStore::writeTile(int index, const float* tile)
+{
+    uint16* d = tileData(index);
+    for (size_type i = 0; i < m_tileSize; i++)
+    {
+        float v = tile[i];
+        d[i] = uint16(RoundInt(((v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v)) * 65535));
+    }
+    if (!hasTile(index))
+    {
+        flags()[index] = 1;
+        m_numStored++;
+    }
+}
+
+void TRTTileStore::flush()
+{
+    m_file->flush();
+}
+
+}	// namespace pcl
@@ -0,0 +1,79 @@
+#ifndef __TRTInferenceTileStore_h
+#define __TRTInferenceTileStore_h
+
+#include <pcl/Image.h>
+
+#include <memory>
+
+#include "TRTInferenceMappedFile.h"
+
+namespace pcl
+{
+
+// Identifies the engine, input image and tile plan a tile store was recorded for
+struct TRTTileStoreLayout
+{
+    uint64 engineHash;
+    uint64 imageHash;
+    int32 imageW;
+    int32 imageH;
+    int32 numChannels;
+    int32 inputTileW;
+    int32 inputTileH;
+    int32 outputTileW;
+    int32 outputTileH;
+    int32 tileStepX;
+    int32 tileStepY;
+    int32 numTiles;
+    // Uniform tile skipping the tiles were produced with: the TRTInferenceUniformTilePolicy, or -1 if
+    // uniform tiles were not skipped, and the uniformity tolerance, 0 if not skipped
+    int32 uniformTilePolicy;
+    float uniformTileTolerance;
+};
+
+// Memory-mapped file of raw engine output tiles, indexed by their position in the tile plan. Tiles are
+// stored clamped to [0,1] as 16-bit samples, before blending, so a later execution on the same image
+// with the same engine and tile plan can redo the blending and finalization without inference. Tiles
+// are flagged as they are written, so an interrupted recording remains usable.
+//
+// Rounding to 16 bits moves each stored sample by at most 0.5/65535 (7.6e-6). Blending is a weighted
+// average of clamped samples, so output blended from stored tiles stays within the same bound of the
+// output of the recording run, before its conversion to the sample type of the image.
+class TRTTileStore
+{
+private:
+    std::unique_ptr<TRTMappedFile> m_file;
+    TRTTileStoreLayout m_layout;
+    size_type m_tileSize;
+    int m_numStored;
+
+    uint8* flags() const;
+    uint16* tileData(int index) const;
+
+public:
+    // Opens the store at path if it was recorded for the same layout, and creates a new empty one otherwise
+    TRTTileStore(const String& path, const TRTTileStoreLayout& layout);
+
+    // Path of the tile store belonging to an image file, or to an unsaved view
+    static String storePath(const String& imageFilePath, const IsoString& viewId);
+
+    static uint64 imageHash(const FImage& image);
+
+    int numStoredTiles() const
+    {
+        return m_numStored;
+    }
+
+    bool hasTile(int index) const
+    {
+        return flags()[index] != 0;
+    }
+
+    void readTile(int index, float* tile) const;
+    void writeTile(int index, const float* tile);
+    void flush();
+};
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceTileStore_h
@@ -0,0 +1,620 @@
+#include <pcl/AbstractImage.h>
+#include <pcl/Thread.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "TRTInferenceParameters.h"
+#include "TRTInferenceTiling.h"
+
+namespace pcl
+{
+
+void binImage(const FImage& input, int factor, FImage& output)
+{
+    std::vector<float> sums(output.Width());
+    std::vector<int> counts(output.Width());
+    for (int c = 0; c < output.NumberOfChannels(); c++)
+        for (int y = 0; y < output.Height(); y++)
+        {
+            std::fill(sums.begin(), sums.end(), 0.0f);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (int sy = y * factor, sy1 = Min(sy + factor, input.Height()); sy < sy1; sy++)
+            {
+                const float* __restrict s = input.ScanLine(sy, c);
+                for (int x = 0; x < input.Width(); x++)
+                {
+                    sums[x / factor] += s[x];
+                    counts[x / factor]++;
+                }
+            }
+            float* __restrict d = output.ScanLine(y, c);
+            for (int x = 0; x < output.Width(); x++)
+                d[x] = sums[x] / counts[x];
+        }
+}
+
+void extractTile(const FImage& input, const Point& pos, int w, int h, int numChannels, float* tile)
+{
+    for (int c = 0; c < numChannels; c++)
+    {
+        int c0 = (input.NumberOfChannels() == numChannels) ? c : 0;
+        for (int y = 0; y < h; y++)
+        {
+            int y0 = y + pos.y;
+            if (y0 >= input.Height())
+                y0 = input.Height() - 1;
+            const float* __restrict s = input.ScanLine(y0, c0);
+            int x1 = Min(w, input.Width() - pos.x);
+            for (int x = 0; x < x1; x++)
+                *tile++ = s[x + pos.x];
+            for (int x = x1; x < w; x++)
+                *tile++ = s[input.Width() - 1];
+        }
+    }
+}
+
+void accumulateTile(const float* tile, int w, int h, int numChannels, const Point& pos, FImage& accumulator, FImage& weight)
+{
+    int padX = w / 16;
+    int padY = h / 16;
+    for (int c = 0; c < numChannels; c++)
+        for (int y = 0; y < h; y++)
+        {
+            int y0 = y + pos.y;
+            for (int x = 0; x < w; x++)
+            {
+                int x0 = x + pos.x;
+                if ((x0 >= accumulator.Width()) || (y0 >= accumulator.Height()))
+                {
+                    tile++;
+                    continue;
+                }
+                float rx = 0.5f - Abs(x - w / 2) * 1.0f / (w - 2 * padX);
+                if (rx < 0.001f)
+                    rx = 0.001f;
+                float ry = 0.5f - Abs(y - h / 2) * 1.0f / (h - 2 * padY);
+                if (ry < 0.001f)
+                    ry = 0.001f;
+                float r = rx * ry;
+                float v = *tile++;
+                if (v < 0.0f)
+                    v = 0.0f;
+                else if (v > 1.0f)
+                    v = 1.0f;
+                accumulator.Pixel(x0, y0, c) += v * r;
+                if (c == 0)
+                    weight.Pixel(x0, y0) += r;
+            }
+        }
+}
+
+// Coordinate held in the even bits of a Morton code
+static int mortonCoordinate(uint32 code)
+{
+    code &= 0x55555555;
+    code = (code | (code >> 1)) & 0x33333333;
+    code = (code | (code >> 2)) & 0x0f0f0f0f;
+    code = (code | (code >> 4)) & 0x00ff00ff;
+    code = (code | (code >> 8)) & 0x0000ffff;
+    return int(code);
+}
+
+Array<Point> tileOrder(pcl_enum order, int numColumns, int numRows, int bandRows)
+{
+    Array<Point> tiles;
+    switch (order)
+    {
+    default:
+    case TRTInferenceTileOrder::Raster:
+        for (int y = 0; y < numRows; y++)
+            for (int x = 0; x < numColumns; x++)
+                tiles.Add(Point(x, y));
+        break;
+    case TRTInferenceTileOrder::Serpentine:
+        for (int y = 0; y < numRows; y++)
+            for (int i = 0; i < numColumns; i++)
+                tiles.Add(Point((y & 1) ? numColumns - 1 - i : i, y));
+        break;
+    case TRTInferenceTileOrder::ZOrder:
+        {
+            // Codes of the enclosing power-of-two square, skipping those outside the plan
+            uint32 side = 1;
+            while (side < uint32(Max(numColumns, numRows)))
+                side <<= 1;
+            for (uint32 code = 0; code < side * side; code++)
+            {
+                int x = mortonCoordinate(code);
+                int y = mortonCoordinate(code >> 1);
+                if ((x < numColumns) && (y < numRows))
+                    tiles.Add(Point(x, y));
+            }
+        }
+        break;
+    case TRTInferenceTileOrder::BandMajor:
+        bandRows = Max(1, bandRows);
+        for (int y0 = 0; y0 < numRows; y0 += bandRows)
+            for (int x = 0; x < numColumns; x++)
+                for (int y = y0, y1 = Min(y0 + bandRows, numRows); y < y1; y++)
+                    tiles.Add(Point(x, y));
+        break;
+    }
+    return tiles;
+}
+
+Rect contextRegion(const Rect& roi, int marginX, int marginY, int imageW, int imageH)
+{
+    return Rect(Max(roi.x0 - marginX, 0), Max(roi.y0 - marginY, 0), Min(roi.x1 + marginX, imageW), Min(roi.y1 + marginY, imageH));
+}
+
+Rect cropRegion(const Point& tilePos, int tileW, int tileH, int stepX, int stepY, int imageW, int imageH)
+{
+    int overlapX = tileW - stepX;
+    int overlapY = tileH - stepY;
+    int x0 = (tilePos.x == 0) ? 0 : tilePos.x + overlapX / 2;
+    int y0 = (tilePos.y == 0) ? 0 : tilePos.y + overlapY / 2;
+    int x1 = (tilePos.x + stepX >= imageW) ? imageW : Min(tilePos.x + stepX + overlapX / 2, imageW);
+    int y1 = (tilePos.y + stepY >= imageH) ? imageH : Min(tilePos.y + stepY + overlapY / 2, imageH);
+    return Rect(x0, y0, x1, y1);
+}
+
+void placeTile(const float* tile, int w, int h, int numChannels, const Point& pos, const Rect& rect, FImage& output)
+{
+    int x0 = Max(rect.x0, pos.x);
+    int x1 = Min(rect.x1, Min(pos.x + w, output.Width()));
+    int y0 = Max(rect.y0, pos.y);
+    int y1 = Min(rect.y1, Min(pos.y + h, output.Height()));
+    for (int c = 0; c < numChannels; c++)
+        for (int y = y0; y < y1; y++)
+        {
+            const float* __restrict s = tile + (size_type(c) * h + y - pos.y) * w;
+            float* __restrict d = output.ScanLine(y, c);
+            for (int x = x0; x < x1; x++)
+            {
+                float v = s[x - pos.x];
+                d[x] = (v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v);
+            }
+        }
+}
+
+TRTTilePlacer::TRTTilePlacer(FImage& output, int tileW, int tileH, int numChannels, int numThreads, int numBuffers)
+    : m_output(output)
+    , m_tileW(tileW)
+    , m_tileH(tileH)
+    , m_numChannels(numChannels)
+{
+    if (numThreads <= 0)
+        numThreads = Range(int(std::thread::hardware_concurrency()) - 1, 1, 8);
+    if (numBuffers <= 0)
+        numBuffers = 2 * numThreads;
+    for (int i = 0; i < numBuffers; i++)
+    {
+        m_jobs.push_back(std::make_unique<Job>());
+        m_jobs.back()->tile.resize(size_type(numChannels) * tileW * tileH);
+        m_free.push_back(m_jobs.back().get());
+    }
+    for (int i = 0; i < numThreads; i++)
+        m_threads.emplace_back(&TRTTilePlacer::run, this);
+}
+
+TRTTilePlacer::~TRTTilePlacer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobQueued.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+void TRTTilePlacer::place(const float* tile, const Point& pos, const Rect& rect)
+{
+    Job* job;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobDone.wait(lock, [this] { return !m_free.empty(); });
+        job = m_free.back();
+        m_free.pop_back();
+    }
+
+    ::memcpy(job->tile.data(), tile, job->tile.size() * sizeof(float));
+    job->pos = pos;
+    job->rect = rect;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(job);
+    }
+    m_jobQueued.notify_one();
+}
+
+void TRTTilePlacer::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this] { return m_free.size() == m_jobs.size(); });
+}
+
+void TRTTilePlacer::run()
+{
+    for (;;)
+    {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobQueued.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+            if (m_pending.empty())
+                return;
+            job = m_pending.front();
+            m_pending.pop_front();
+        }
+
+        placeTile(job->tile.data(), m_tileW, m_tileH, m_numChannels, job->pos, job->rect, m_output);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(job);
+        }
+        m_jobDone.notify_all();
+    }
+}
+
+bool isUniformTile(const float* tile, int w, int h, int numChannels, float tolerance, float* values)
+{
+    size_type n = size_type(w) * h;
+    for (int c = 0; c < numChannels; c++, tile += n)
+    {
+        float minValue = tile[0];
+        float maxValue = tile[0];
+        double sum = 0;
+        for (size_type i = 0; i < n; i++)
+        {
+            float v = tile[i];
+            if (v < minValue)
+                minValue = v;
+            else if (v > maxValue)
+                maxValue = v;
+            // Bail out on the first real structure, which is the common case
+            if (maxValue - minValue > tolerance)
+                return false;
+            sum += v;
+        }
+        values[c] = float(sum / n);
+    }
+    return true;
+}
+
+bool isMaskedOut(const FImage& mask, const Rect& rect)
+{
+    Rect r = rect.Intersection(mask.Bounds());
+    for (int c = 0; c < mask.NumberOfChannels(); c++)
+        for (int y = r.y0; y < r.y1; y++)
+        {
+            const float* __restrict m = mask.ScanLine(y, c);
+            for (int x = r.x0; x < r.x1; x++)
+                if (m[x] > 0.0f)
+                    return false;
+        }
+    return true;
+}
+
+void averageTilePlanes(const float* tile, int w, int h, int numPlanes, float* output)
+{
+    size_type n = size_type(w) * h;
+    float scale = 1.0f / numPlanes;
+    for (size_type i = 0; i < n; i++)
+        output[i] = tile[i];
+    for (int c = 1; c < numPlanes; c++)
+    {
+        const float* __restrict s = tile + c * n;
+        for (size_type i = 0; i < n; i++)
+            output[i] += s[i];
+    }
+    for (size_type i = 0; i < n; i++)
+        output[i] *= scale;
+}
+
+void upscaleTile(const float* tile, int w, int h, int numChannels, int factorX, int factorY, float* output)
+{
+    for (int c = 0; c < numChannels; c++, tile += size_type(w) * h)
+        for (int y = 0; y < h * factorY; y++)
+        {
+            const float* s = tile + size_type(y / factorY) * w;
+            for (int x = 0; x < w * factorX; x++)
+                *output++ = s[x / factorX];
+        }
+}
+
+void reduceForDisplay(const FImage& accumulator, const FImage* weight, int reduction, int startRow, int endRow, FImage& display)
+{
+    for (int y = startRow; y < endRow; y++)
+    {
+        int sy = y * reduction;
+        const float* w = (weight != nullptr) ? weight->ScanLine(sy) : nullptr;
+        for (int c = 0; c < display.NumberOfChannels(); c++)
+        {
+            const float* __restrict a = accumulator.ScanLine(sy, c);
+            float* __restrict d = display.ScanLine(y, c);
+            for (int x = 0, sx = 0; x < display.Width(); x++, sx += reduction)
+            {
+                float f = a[sx];
+                if (w != nullptr)
+                    f = (w[sx] > 0.0f) ? f / w[sx] : 0.0f;
+                d[x] = (f < 0.0f) ? 0.0f : ((f > 1.0f) ? 1.0f : f);
+            }
+        }
+    }
+}
+
+// Adds blocks of factor samples of a source row to the samples of a target row. Each factor has its own
+// inner loop over the target row, so the compiler can vectorize it.
+template <int F>
+static void addBlocks(const float* __restrict v, float* __restrict s, int width)
+{
+    for (int x = 0; x < width; x++)
+    {
+        float sum = v[x * F];
+        for (int k = 1; k < F; k++)
+            sum += v[x * F + k];
+        s[x] += sum;
+    }
+}
+
+static void addBlocks(const float* __restrict v, float* __restrict s, int width, int factor)
+{
+    switch (factor)
+    {
+    case 1:
+        addBlocks<1>(v, s, width);
+        break;
+    case 2:
+        addBlocks<2>(v, s, width);
+        break;
+    case 3:
+        addBlocks<3>(v, s, width);
+        break;
+    case 4:
+        addBlocks<4>(v, s, width);
+        break;
+    default:
+        for (int k = 0; k < factor; k++)
+            for (int x = 0; x < width; x++)
+                s[x] += v[x * factor + k];
+        break;
+    }
+}
+
+// RGB to gray conversion of an RGB working space in single precision: CIE L* of the luminance of the
+// linear RGB components, as RGBColorSystem::Lightness computes in double precision
+class GrayConversion
+{
+public:
+    GrayConversion(const RGBColorSystem& rgbws)
+        : m_isLinear(rgbws.IsLinear())
+        , m_isSRGB(rgbws.IsSRGB())
+        , m_gamma(rgbws.Gamma())
+    {
+        const FVector& Y = rgbws.LuminanceCoefficients();
+        m_kr = Y[0];
+        m_kg = Y[1];
+        m_kb = Y[2];
+    }
+
+    // Converts normalized source rows of r, g and b, overwriting them, to gray into l
+    void convert(float* __restrict r, float* __restrict g, float* __restrict b, float* __restrict l, int width) const
+    {
+        if (!m_isLinear)
+        {
+            linearize(r, width);
+            linearize(g, width);
+            linearize(b, width);
+        }
+
+        for (int x = 0; x < width; x++)
+            l[x] = m_kr * r[x] + m_kg * g[x] + m_kb * b[x];
+
+        for (int x = 0; x < width; x++)
+            l[x] = (l[x] > 0.008856f) ? 1.16f * std::cbrt(l[x]) - 0.16f : 9.033f * l[x];
+    }
+
+private:
+    bool m_isLinear;
+    bool m_isSRGB;
+    float m_gamma;
+    float m_kr, m_kg, m_kb;
+
+    void linearize(float* __restrict v, int width) const
+    {
+        if (m_isSRGB)
+            for (int x = 0; x < width; x++)
+                v[x] = (v[x] > 0.04045f) ? std::pow((v[x] + 0.055f) / 1.055f, 2.4f) : v[x] / 12.92f;
+        else
+            for (int x = 0; x < width; x++)
+                v[x] = std::pow(v[x], m_gamma);
+    }
+};
+
+template <class P>
+class FinalizeThread : public Thread
+{
+public:
+    FinalizeThread(const AbstractImage::ThreadData& data, const FImage& accumulator, const FImage* weight, int factor, GenericImage<P>& target, int startRow, int endRow)
+        : m_data(data)
+        , m_accumulator(accumulator)
+        , m_weight(weight)
+        , m_factor(factor)
+        , m_target(target)
+        , m_startRow(startRow)
+        , m_endRow(endRow)
+    {
+    }
+
+    void Run() override
+    {
+        INIT_THREAD_MONITOR()
+
+        const int width = m_target.Width();
+        const int srcWidth = width * m_factor;
+        const int numChannels = m_target.NumberOfChannels();
+        const bool toGray = (numChannels == 1) && (m_accumulator.NumberOfChannels() == 3);
+        const GrayConversion gray(m_accumulator.RGBWorkingSpace());
+        const float scale = 1.0f / (m_factor * m_factor);
+
+        // One normalized source row per accumulator channel, its gray conversion, plus the block sums of
+        // the target row
+        std::vector<float> invWeight(srcWidth);
+        std::vector<float> values(srcWidth * 3);
+        std::vector<float> lightness(toGray ? srcWidth : 0);
+        std::vector<float> sums(width * numChannels);
+
+        for (int y = m_startRow; y < m_endRow; y++)
+        {
+            for (float& s : sums)
+                s = 0.0f;
+
+            for (int sy = y * m_factor, sy1 = sy + m_factor; sy < sy1; sy++)
+            {
+                float* __restrict iw = invWeight.data();
+                if (m_weight != nullptr)
+                {
+                    const float* __restrict w = m_weight->ScanLine(sy);
+                    for (int x = 0; x < srcWidth; x++)
+                        iw[x] = (w[x] > 0.0f) ? 1.0f / w[x] : 0.0f;
+                }
+                else
+                    for (int x = 0; x < srcWidth; x++)
+                        iw[x] = 1.0f;
+
+                for (int c = 0; c < m_accumulator.NumberOfChannels(); c++)
+                {
+                    const float* __restrict a = m_accumulator.ScanLine(sy, c);
+                    float* __restrict v = values.data() + c * srcWidth;
+                    for (int x = 0; x < srcWidth; x++)
+                    {
+                        float f = a[x] * iw[x];
+                        v[x] = (f < 0.0f) ? 0.0f : ((f > 1.0f) ? 1.0f : f);
+                    }
+                }
+
+                if (toGray)
+                {
+                    float* r = values.data();
+                    gray.convert(r, r + srcWidth, r + 2 * srcWidth, lightness.data(), srcWidth);
+                    addBlocks(lightness.data(), sums.data(), width, m_factor);
+                }
+                else
+                    for (int c = 0; c < numChannels; c++)
+                        addBlocks(values.data() + c * srcWidth, sums.data() + c * width, width, m_factor);
+            }
+
+            for (int c = 0; c < numChannels; c++)
+            {
+                const float* __restrict s = sums.data() + c * width;
+                typename P::sample* __restrict d = m_target.ScanLine(y, c);
+                for (int x = 0; x < width; x++)
+                    d[x] = P::ToSample(s[x] * scale);
+            }
+
+            UPDATE_THREAD_MONITOR(16)
+        }
+    }
+
+private:
+    const AbstractImage::ThreadData& m_data;
+    const FImage& m_accumulator;
+    const FImage* m_weight;
+    int m_factor;
+    GenericImage<P>& m_target;
+    int m_startRow;
+    int m_endRow;
+};
+
+template <class P>
+static void finalizeOutput(const FImage& accumulator, const FImage* weight, int factor, GenericImage<P>& target)
+{
+    int rows = target.Height();
+    target.Status().Initialize("Finalizing output", rows);
+
+    Array<size_type> L = Thread::OptimalThreadLoads(rows, 16);
+    AbstractImage::ThreadData data(target, rows);
+    ReferenceArray<FinalizeThread<P>> threads;
+    for (int i = 0, n = 0; i < int(L.Length()); n += int(L[i++]))
+        threads.Add(new FinalizeThread<P>(data, accumulator, weight, factor, target, n, n + int(L[i])));
+    AbstractImage::RunThreads(threads, data);
+    threads.Destroy();
+
+    target.Status() = data.status;
+}
+
+void finalizeOutput(const FImage& accumulator, const FImage* weight, int factor, ImageVariant& target)
+{
+    finalizeOutput(accumulator, weight, factor, accumulator.Height(), target);
+}
+
+void finalizeOutput(const FImage& accumulator, const FImage* weight, int factor, int numRows, ImageVariant& target)
+{
+    target.AllocateImage(accumulator.Width() / factor, numRows / factor, target.NumberOfChannels(), target.ColorSpace());
+
+    if (target.IsFloatSample())
+        finalizeOutput(accumulator, weight, factor, static_cast<FImage&>(*target));
+    else
+        switch (target.BitsPerSample())
+        {
+        case 8:
+            finalizeOutput(accumulator, weight, factor, static_cast<UInt8Image&>(*target));
+            break;
+        case 16:
+            finalizeOutput(accumulator, weight, factor, static_cast<UInt16Image&>(*target));
+            break;
+        case 32:
+            finalizeOutput(accumulator, weight, factor, static_cast<UInt32Image&>(*target));
+            break;
+        }
+}
+
+template <class P>
+static void blendByMask(const GenericImage<P>& original, const FImage& mask, GenericImage<P>& target)
+{
+    for (int c = 0; c < target.NumberOfChannels(); c++)
+    {
+        int mc = Min(c, mask.NumberOfChannels() - 1);
+        for (int y = 0; y < target.Height(); y++)
+        {
+            const typename P::sample* __restrict o = original.ScanLine(y, c);
+            const float* __restrict m = mask.ScanLine(y, mc);
+            typename P::sample* __restrict t = target.ScanLine(y, c);
+            for (int x = 0; x < target.Width(); x++)
+                if (m[x] <= 0.0f)
+                    t[x] = o[x];
+                else if (m[x] < 1.0f)
+                {
+                    double a, b;
+                    P::ToSample(a, o[x]);
+                    P::ToSample(b, t[x]);
+                    t[x] = P::ToSample(a + m[x] * (b - a));
+                }
+        }
+    }
+}
+
+void blendByMask(const ImageVariant& original, const FImage& mask, ImageVariant& target)
+{
+    if (target.IsFloatSample())
+        blendByMask(static_cast<const FImage&>(*original), mask, static_cast<FImage&>(*target));
+    else
+        switch (target.BitsPerSample())
+        {
+        case 8:
+            blendByMask(static_cast<const UInt8Image&>(*original), mask, static_cast<UInt8Image&>(*target));
+            break;
+        case 16:
+            blendByMask(static_cast<const UInt16Image&>(*original), mask, static_cast<UInt16Image&>(*target));
+            break;
+        case 32:
+            blendByMask(static_cast<const UInt32Image&>(*original), mask, static_cast<UInt32Image&>(*target));
+            break;
+        }
+}
+
+}	// namespace pcl
@@ -0,0 +1,123 @@
+#ifndef __TRTInferenceTiling_h
+#define __TRTInferenceTiling_h
+
+#include <pcl/Array.h>
+#include <pcl/ImageVariant.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pcl
+{
+
+// Averages blocks of factor x factor pixels of the input image. Blocks at the right and bottom edges
+// may be partial; the output must be allocated with the rounded up dimensions.
+void binImage(const FImage& input, int factor, FImage& output);
+
+// Copies the tile at pos of the input image into a planar buffer of numChannels x h x w samples. The
+// last row and column are replicated past the image edges, and the first channel is replicated for
+// grayscale input.
+void extractTile(const FImage& input, const Point& pos, int w, int h, int numChannels, float* tile);
+
+// Clamps an engine output tile to [0,1] and adds it to the accumulator at pos, weighted by a feathered
+// window that fades towards the tile edges. The window weights are added to the single-channel weight
+// image. Samples falling outside the accumulator are ignored.
+void accumulateTile(const float* tile, int w, int h, int numChannels, const Point& pos, FImage& accumulator, FImage& weight);
+
+// Visiting order of the tiles of a plan of numColumns x numRows tiles, as grid coordinates, for an order
+// of TRTInferenceTileOrder. Raster order goes row by row, and serpentine order reverses every other row
+// so consecutive tiles stay adjacent. Z-order follows the Morton curve, so tiles visited close in time
+// are close in both directions. Band-major order goes column by column within bands of bandRows rows
+// of tiles, keeping the accumulator rows in use to one band.
+Array<Point> tileOrder(pcl_enum order, int numColumns, int numRows, int bandRows);
+
+// Region processed for a region of interest: the ROI extended by a margin of context on each side and
+// clipped to the image, so tiles at the ROI edges see the same surroundings as in a full execution.
+Rect contextRegion(const Rect& roi, int marginX, int marginY, int imageW, int imageH);
+
+// Region written by the tile at tilePos in center-crop mode, in input coordinates. Seams between
+// adjacent tiles fall in the middle of their overlap, so the regions of all tiles in a plan are
+// disjoint and together cover the whole image.
+Rect cropRegion(const Point& tilePos, int tileW, int tileH, int stepX, int stepY, int imageW, int imageH);
+
+// Copies the part of an output tile at pos that falls inside rect to the output image, clamped to [0,1].
+void placeTile(const float* tile, int w, int h, int numChannels, const Point& pos, const Rect& rect, FImage& output);
+
+// Places center-cropped output tiles on worker threads while the engine works on the following tiles.
+// Placement regions are disjoint, so the workers write to the output image without locking it.
+// numBuffers tiles can be in flight; zero picks up to 8 threads and two buffers per thread.
+class TRTTilePlacer
+{
+public:
+    TRTTilePlacer(FImage& output, int tileW, int tileH, int numChannels, int numThreads = 0, int numBuffers = 0);
+    ~TRTTilePlacer();
+
+    // Queues a copy of the tile; blocks only while all tile buffers are in use
+    void place(const float* tile, const Point& pos, const Rect& rect);
+
+    // Waits until all queued tiles have been placed
+    void wait();
+
+private:
+    struct Job
+    {
+        std::vector<float> tile;
+        Point pos;
+        Rect rect;
+    };
+
+    FImage& m_output;
+    int m_tileW;
+    int m_tileH;
+    int m_numChannels;
+    std::vector<std::unique_ptr<Job>> m_jobs;
+    std::vector<Job*> m_free;
+    std::deque<Job*> m_pending;
+    std::mutex m_mutex;
+    std::condition_variable m_jobQueued;
+    std::condition_variable m_jobDone;
+    bool m_stop = false;
+    std::vector<std::thread> m_threads;
+
+    void run();
+};
+
+// Returns true if every channel of a planar tile is constant within the given tolerance. The mean of
+// each channel is stored in values.
+bool isUniformTile(const float* tile, int w, int h, int numChannels, float tolerance, float* values);
+
+// Returns true if every sample of the mask within rect is zero. rect is clipped to the mask bounds.
+bool isMaskedOut(const FImage& mask, const Rect& rect);
+
+// Averages the planes of a tile into a single plane.
+void averageTilePlanes(const float* tile, int w, int h, int numPlanes, float* output);
+
+// Nearest-neighbor upscale of a planar tile by integer factors.
+void upscaleTile(const float* tile, int w, int h, int numChannels, int factorX, int factorY, float* output);
+
+// Writes rows [startRow,endRow) of a preview of the blended output reduced by an integer factor, with
+// nearest-neighbor sampling: accumulated samples are normalized by their weights, if any, and clamped.
+void reduceForDisplay(const FImage& accumulator, const FImage* weight, int reduction, int startRow, int endRow, FImage& display);
+
+// Turns the blended engine output into the final image in a single pass: each accumulated sample is
+// normalized by its blending weight, clamped, converted to the color space of the target, averaged
+// down by an integer factor and stored in the native sample type of the target. The target is
+// reallocated to the accumulator dimensions divided by the factor. A null weight image means the
+// accumulator holds final values, as written by center-crop placement.
+void finalizeOutput(const FImage& accumulator, const FImage* weight, int factor, ImageVariant& target);
+
+// Same, for the first numRows rows of the accumulator only. numRows must be a multiple of the factor.
+void finalizeOutput(const FImage& accumulator, const FImage* weight, int factor, int numRows, ImageVariant& target);
+
+// Blends target with the original image by mask weight, target = original + mask * (target - original).
+// Mask channels past the last one reuse the last. Where the mask is zero the original is kept exactly,
+// whatever target holds.
+void blendByMask(const ImageVariant& original, const FImage& mask, ImageVariant& target);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceTiling_h
@@ -0,0 +1,315 @@
+// Inference server shared by the PixInsight instances of a workstation. Engines are loaded once and
+// kept warm; tiles of all clients are run one at a time in arrival order, so each client gets its turn
+// on the GPU. Tiles are exchanged through the tile buffer files mapped by the clients.
+//
+// With --port, the server is a worker node of a tile farm instead, reached over TCP, and tiles travel
+// compressed through the connection. A worker serves the engine given with --engine and accepts no
+// paths from its clients. It listens on the loopback interface unless --bind gives the address of
+// another one; the protocol has no authentication, so only bind to interfaces of a trusted network.
+//
+// Usage: TRTInferenceServer [--socket <path> | --port <port> [--bind <address>]] [--engine <path>]
+//                           [--stand-in <tileSize> <factor>] [--fail-after <tiles>] [--delay <ms>]
+//
+// --engine serves the given engine whatever engine the clients ask for; workers require it.
+// --stand-in replaces TensorRT with a CPU backend upscaling 3-channel tiles by nearest neighbor, to
+// exercise the protocol on machines without a GPU.
+// --fail-after makes the server exit after inferring the given number of tiles, to exercise the
+// recovery of the coordinator from failed workers.
+// --delay makes every tile take at least the given number of milliseconds, to exercise the stealing of
+// tiles queued for slow workers.
+
+#include <pcl/Exception.h>
+#include <pcl/File.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../TRTInferenceEngine.h"
+#include "../TRTInferenceMappedFile.h"
+#include "../TRTInferenceProtocol.h"
+#include "../TRTInferenceTiling.h"
+
+using namespace pcl;
+
+// CPU backend with the behavior of a 3-channel upscaling engine
+class TRTStandInEngine : public TRTEngine
+{
+public:
+    TRTStandInEngine(const String& enginePath, int tileSize, int factor)
+    {
+        m_inputTileW = m_inputTileH = tileSize;
+        m_outputTileW = m_outputTileH = tileSize * factor;
+        m_numChannels = 3;
+        IsoString path = enginePath.ToUTF8();
+        m_engineHash = Hash64(path.c_str(), path.Length());
+        setNumberOfPlanes(3);
+    }
+
+    void setNumberOfPlanes(int32_t numPlanes) override
+    {
+        if (numPlanes != m_numChannels)
+            throw Error(String().Format("A %d-channel engine cannot process %d-plane tiles.", m_numChannels, numPlanes));
+        m_numPlanes = numPlanes;
+        m_input.resize(size_type(numPlanes) * m_inputTileW * m_inputTileH);
+        m_output.resize(size_type(numPlanes) * m_outputTileW * m_outputTileH);
+    }
+
+    float* getInputBuffer() override
+    {
+        return m_input.data();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return m_output.data();
+    }
+
+    void runInference() override
+    {
+        upscaleTile(m_input.data(), m_inputTileW, m_inputTileH, m_numPlanes, m_outputTileW / m_inputTileW, m_outputTileH / m_inputTileH, m_output.data());
+    }
+
+private:
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+};
+
+// First come, first served access to the GPU. Each client has at most one tile in flight, so clients
+// are served in turn.
+class FairLock
+{
+public:
+    void lock()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        uint64 ticket = m_next++;
+        m_turn.wait(lock, [&] { return m_serving == ticket; });
+    }
+
+    void unlock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_serving++;
+        }
+        m_turn.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_turn;
+    uint64 m_next = 0;
+    uint64 m_serving = 0;
+};
+
+static String s_enginePath;
+static int s_standInTileSize = 0;
+static int s_standInFactor = 1;
+static int s_failAfter = 0;
+static int s_delay = 0;
+static std::atomic<int> s_numTiles(0);
+static FairLock s_gpu;
+static std::mutex s_enginesMutex;
+static std::map<IsoString, std::shared_ptr<TRTEngine>> s_engines;
+
+// Loaded engines stay loaded for later clients
+static std::shared_ptr<TRTEngine> acquireEngine(IsoString path)
+{
+    if (!s_enginePath.IsEmpty())
+        path = s_enginePath.ToUTF8();
+
+    std::lock_guard<std::mutex> lock(s_enginesMutex);
+    auto i = s_engines.find(path);
+    if (i != s_engines.end())
+        return i->second;
+
+    std::shared_ptr<TRTEngine> engine;
+    if (s_standInTileSize > 0)
+        engine = std::make_shared<TRTStandInEngine>(String::UTF8ToUTF16(path.c_str()), s_standInTileSize, s_standInFactor);
+    else
+        engine = openLocalEngine(String::UTF8ToUTF16(path.c_str()));
+    s_engines[path] = engine;
+    std::printf("Loaded %s\n", path.c_str());
+    return engine;
+}
+
+// Clients reached over TCP are remote: they name no files, and exchange tiles through the connection
+static void serveClient(TRTSocket socket, bool remote)
+{
+    std::shared_ptr<TRTEngine> engine;
+    // Tiles of local clients are in their mapped tile buffer, those of remote clients are held here
+    std::unique_ptr<TRTMappedFile> tileBuffer;
+    std::vector<float> tiles;
+    int32 numPlanes = 0;
+
+    try
+    {
+        for (;;)
+        {
+            TRTRequest request;
+            socket.receive(&request, sizeof(request));
+            if ((request.magic != TRTProtocolMagic) || (request.type == TRTRequestType::Close))
+                return;
+            request.path[sizeof(request.path) - 1] = '\0';
+
+            if (request.type == TRTRequestType::InferTile)
+            {
+                if (tiles.empty())
+                    return;
+                socket.receiveTile(tiles.data(), size_type(numPlanes) * engine->getInputTileW() * engine->getInputTileH());
+            }
+
+            TRTReply reply = {};
+            reply.magic = TRTProtocolMagic;
+            try
+            {
+                switch (request.type)
+                {
+                case TRTRequestType::Open:
+                    if (remote && (request.path[0] != '\0'))
+                        throw Error("Engine paths are not accepted over TCP.");
+                    engine = acquireEngine(request.path);
+                    break;
+                case TRTRequestType::SetPlanes:
+                    if (!engine)
+                        throw Error("No engine open.");
+                    if (remote && (request.path[0] != '\0'))
+                        throw Error("Tile buffer files are not accepted over TCP.");
+                    if ((request.numPlanes < 1) || (request.numPlanes > TRTMaxPlanes))
+                        throw Error(String().Format("Invalid number of planes: %d", request.numPlanes));
+                    {
+                        // Validate the number of planes for this engine, then restore the shared state
+                        std::lock_guard<FairLock> lock(s_gpu);
+                        int32 previous = engine->getNumberOfPlanes();
+                        engine->setNumberOfPlanes(request.numPlanes);
+                        engine->setNumberOfPlanes(previous);
+                    }
+                    tileBuffer.reset();
+                    tiles.clear();
+                    if (request.path[0] != '\0')
+                        tileBuffer = std::make_unique<TRTMappedFile>(String::UTF8ToUTF16(request.path), true);
+                    else
+                        tiles.resize(size_type(request.numPlanes) * (engine->getInputTileW() * engine->getInputTileH() +
+                                                                     engine->getOutputTileW() * engine->getOutputTileH()));
+                    numPlanes = request.numPlanes;
+                    break;
+                case TRTRequestType::Infer:
+                case TRTRequestType::InferTile:
+                    if (remote && (request.type == TRTRequestType::Infer))
+                        throw Error("Tiles are only accepted inline over TCP.");
+                    if (!tileBuffer && tiles.empty())
+                        throw Error("No tile buffer.");
+                    {
+                        std::lock_guard<FairLock> lock(s_gpu);
+                        if (engine->getNumberOfPlanes() != numPlanes)
+                            engine->setNumberOfPlanes(numPlanes);
+                        size_type inputSize = size_type(numPlanes) * engine->getInputTileW() * engine->getInputTileH();
+                        size_type outputSize = size_type(numPlanes) * engine->getOutputTileW() * engine->getOutputTileH();
+                        if (tileBuffer && ((inputSize + outputSize) * sizeof(float) > tileBuffer->size()))
+                            throw Error("Tile buffer too small.");
+                        float* input = tileBuffer ? reinterpret_cast<float*>(tileBuffer->data()) : tiles.data();
+                        ::memcpy(engine->getInputBuffer(), input, inputSize * sizeof(float));
+                        engine->runInference();
+                        ::memcpy(input + inputSize, engine->getOutputBuffer(), outputSize * sizeof(float));
+                    }
+                    if (s_delay > 0)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(s_delay));
+                    if ((s_failAfter > 0) && (++s_numTiles > s_failAfter))
+                    {
+                        std::printf("Exiting after %d tiles\n", s_failAfter);
+                        std::exit(1);
+                    }
+                    break;
+                default:
+                    throw Error("Unknown request.");
+                }
+
+                if (engine)
+                {
+                    reply.inputTileW = engine->getInputTileW();
+                    reply.inputTileH = engine->getInputTileH();
+                    reply.outputTileW = engine->getOutputTileW();
+                    reply.outputTileH = engine->getOutputTileH();
+                    reply.numChannels = engine->getNumberOfChannels();
+                    reply.engineHash = engine->getEngineHash();
+                }
+            }
+            catch (const Exception& x)
+            {
+                reply.status = 1;
+                IsoString message = x.Message().ToUTF8();
+                ::strncpy(reply.message, message.c_str(), sizeof(reply.message) - 1);
+            }
+            socket.send(&reply, sizeof(reply));
+            if ((request.type == TRTRequestType::InferTile) && (reply.status == 0))
+                socket.sendTile(tiles.data() + size_type(numPlanes) * engine->getInputTileW() * engine->getInputTileH(),
+                                size_type(numPlanes) * engine->getOutputTileW() * engine->getOutputTileH());
+        }
+    }
+    catch (...)
+    {
+        // Client gone
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        String socketPath = serverSocketPath();
+        int port = 0;
+        String bindAddress = "127.0.0.1";
+        for (int i = 1; i < argc; i++)
+        {
+            IsoString arg(argv[i]);
+            if ((arg == "--socket") && (i + 1 < argc))
+                socketPath = String::UTF8ToUTF16(argv[++i]);
+            else if ((arg == "--port") && (i + 1 < argc))
+                port = IsoString(argv[++i]).ToInt();
+            else if ((arg == "--bind") && (i + 1 < argc))
+                bindAddress = String::UTF8ToUTF16(argv[++i]);
+            else if ((arg == "--engine") && (i + 1 < argc))
+                s_enginePath = String::UTF8ToUTF16(argv[++i]);
+            else if ((arg == "--stand-in") && (i + 2 < argc))
+            {
+                s_standInTileSize = IsoString(argv[++i]).ToInt();
+                s_standInFactor = IsoString(argv[++i]).ToInt();
+            }
+            else if ((arg == "--fail-after") && (i + 1 < argc))
+                s_failAfter = IsoString(argv[++i]).ToInt();
+            else if ((arg == "--delay") && (i + 1 < argc))
+                s_delay = IsoString(argv[++i]).ToInt();
+            else
+            {
+                std::fprintf(stderr, "Usage: TRTInferenceServer [--socket <path> | --port <port> [--bind <address>]] [--engine <path>]\n"
+                                     "                          [--stand-in <tileSize> <factor>] [--fail-after <tiles>] [--delay <ms>]\n");
+                return 1;
+            }
+        }
+
+        if ((port > 0) && s_enginePath.IsEmpty() && (s_standInTileSize <= 0))
+            throw Error("A worker node needs the engine to serve, given with --engine.");
+
+        TRTSocket listener = (port > 0) ? TRTSocket::listenTcp(port, bindAddress) : TRTSocket::listen(socketPath);
+        if (port > 0)
+            std::printf("Listening on port %d of %s\n", port, bindAddress.ToUTF8().c_str());
+        else
+            std::printf("Listening at %s\n", socketPath.ToUTF8().c_str());
+        for (;;)
+            std::thread(serveClient, listener.accept(), port > 0).detach();
+    }
+    catch (const Exception& x)
+    {
+        std::fprintf(stderr, "%s\n", x.Message().ToUTF8().c_str());
+        return 1;
+    }
+}
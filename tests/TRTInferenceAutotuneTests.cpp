@@ -0,0 +1,143 @@
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "../TRTInferenceAutotune.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+std::vector<int32> values(int32 first, int32 last)
+{
+    std::vector<int32> v;
+    for (int32 i = first; i <= last; i++)
+        v.push_back(i);
+    return v;
+}
+
+// Runs the search over a synthetic cost, checking that each tuning is measured once and recorded in
+// the results
+TRTTuning search(const TRTTuningSpace& space, const std::function<double(const TRTTuning&)>& cost)
+{
+    std::map<IsoString, int> numMeasured;
+    std::vector<TRTTuningResult> results;
+    TRTTuning best = searchTuning(space,
+                                  [&](const TRTTuning& tuning)
+                                  {
+                                      numMeasured[tuning.serialize()]++;
+                                      return cost(tuning);
+                                  },
+                                  results);
+    TRT_CHECK_EQUAL(results.size(), numMeasured.size());
+    for (const auto& m : numMeasured)
+        if (m.second != 1)
+            trtCheckFailed(__FILE__, __LINE__, String(m.first) + String().Format(" measured %d times", m.second));
+    for (const TRTTuningResult& r : results)
+        TRT_CHECK_EQUAL(r.secondsPerTile, cost(r.tuning));
+    return best;
+}
+
+bool sameTuning(const TRTTuning& a, const TRTTuning& b)
+{
+    return (a.batchSize == b.batchSize) && (a.placementThreads == b.placementThreads) && (a.inFlightTiles == b.inFlightTiles) &&
+           (a.cpuThreads == b.cpuThreads);
+}
+
+}	// namespace
+
+// Each setting is tuned with the others fixed: a cost with a minimum per setting is minimized
+TRT_TEST(autotuneConvergesToFastest)
+{
+    TRTTuningSpace space;
+    space.batchSizes = { 0, 1, 2, 4 };
+    space.placementThreads = { 0, 1, 2, 4, 8 };
+    space.inFlightTiles = { 0, 2, 4, 8, 16 };
+    space.cpuThreads = { 0 };
+    TRTTuning best = search(space,
+                            [](const TRTTuning& t)
+                            {
+                                return 1.0 + std::abs(t.batchSize - 2) + 0.5 * std::abs(t.placementThreads - 4) +
+                                       0.1 * std::abs(t.inFlightTiles - 8) + 0.01 * t.batchSize * t.placementThreads;
+                            });
+    TRT_CHECK_EQUAL(best.batchSize, 2);
+    TRT_CHECK_EQUAL(best.placementThreads, 4);
+    TRT_CHECK_EQUAL(best.inFlightTiles, 8);
+    TRT_CHECK_EQUAL(best.cpuThreads, 0);
+
+    // A space of single values is measured once, at the defaults
+    TRT_CHECK(search(TRTTuningSpace(), [](const TRTTuning&) { return 1.0; }).isDefault());
+}
+
+// A value is only taken if it is more than 2% faster than the current one
+TRT_TEST(autotuneIgnoresSmallImprovements)
+{
+    TRTTuningSpace space;
+    space.placementThreads = { 0, 2 };
+    space.inFlightTiles = { 0, 4 };
+    TRTTuning best = search(space,
+                            [](const TRTTuning& t)
+                            {
+                                return 1.0 - ((t.placementThreads == 2) ? 0.019 : 0.0) - ((t.inFlightTiles == 4) ? 0.021 : 0.0);
+                            });
+    TRT_CHECK_EQUAL(best.placementThreads, 0);
+    TRT_CHECK_EQUAL(best.inFlightTiles, 4);
+}
+
+// Settings that only pay off together take several passes, which are limited to three. Here each
+// setting may only move one step ahead of the other, so each pass advances both by two steps.
+TRT_TEST(autotuneStopsAfterPassLimit)
+{
+    TRTTuningSpace space;
+    space.batchSizes = values(0, 20);
+    space.placementThreads = values(0, 20);
+    TRTTuning best = search(space,
+                            [](const TRTTuning& t)
+                            {
+                                if (std::abs(t.batchSize - t.placementThreads) > 1)
+                                    return 10.0;
+                                return std::pow(0.5, t.batchSize + t.placementThreads);
+                            });
+    TRT_CHECK_EQUAL(best.batchSize, 5);
+    TRT_CHECK_EQUAL(best.placementThreads, 6);
+}
+
+// Settings text reads back as written; unknown keys, items without a value and negative values are
+// ignored, so profiles written by other versions of the module still load
+TRT_TEST(autotuneSerialization)
+{
+    TRTTuning tuning;
+    tuning.batchSize = 3;
+    tuning.placementThreads = 4;
+    tuning.inFlightTiles = 8;
+    tuning.cpuThreads = 15;
+    TRT_CHECK_EQUAL(tuning.serialize(), IsoString("batch=3 placement=4 inflight=8 cpu=15"));
+    TRT_CHECK(sameTuning(TRTTuning::deserialize(tuning.serialize()), tuning));
+    TRT_CHECK(TRTTuning::deserialize(TRTTuning().serialize()).isDefault());
+    TRT_CHECK(TRTTuning::deserialize("").isDefault());
+
+    TRTTuning read = TRTTuning::deserialize("precision=fp16 batch=2  junk placement= cpu=-3 inflight=16 streams=2");
+    TRT_CHECK_EQUAL(read.batchSize, 2);
+    TRT_CHECK_EQUAL(read.placementThreads, 0);
+    TRT_CHECK_EQUAL(read.inFlightTiles, 16);
+    TRT_CHECK_EQUAL(read.cpuThreads, 0);
+}
+
+// Profiles are kept per engine and device
+TRT_TEST(autotuneProfiles)
+{
+    TRTTuning tuning;
+    tuning.batchSize = 2;
+    tuning.inFlightTiles = 4;
+    saveTuning(0x1234, "cpu8", tuning);
+
+    TRTTuning read;
+    TRT_CHECK(loadTuning(0x1234, "cpu8", read));
+    TRT_CHECK(sameTuning(read, tuning));
+    TRT_CHECK(!loadTuning(0x1234, "cpu16", read));
+    TRT_CHECK(read.isDefault());
+    TRT_CHECK(!loadTuning(0x1235, "cpu8", read));
+    TRT_CHECK(!loadTuning(0x1234, "", read));
+}
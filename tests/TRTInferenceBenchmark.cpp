@@ -0,0 +1,342 @@
+#include <pcl/ElapsedTime.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef __PCL_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../TRTInferenceCpuKernels.h"
+#include "../TRTInferenceParameters.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTestEngines.h"
+
+namespace pcl
+{
+
+struct TRTBenchmark
+{
+    const char* name;
+    void (*function)();
+};
+
+static std::vector<TRTBenchmark>& benchmarks()
+{
+    static std::vector<TRTBenchmark> list;
+    return list;
+}
+
+struct TRTBenchmarkRegistration
+{
+    TRTBenchmarkRegistration(const char* name, void (*function)())
+    {
+        benchmarks().push_back({ name, function });
+    }
+};
+
+#define TRT_BENCHMARK(name) \
+    static void name(); \
+    static TRTBenchmarkRegistration name##_registration(#name, name); \
+    static void name()
+
+// Image size of the benchmarks, in megapixels
+static double s_megapixels = 4;
+
+static void imageSize(int& w, int& h)
+{
+    w = int(std::sqrt(s_megapixels * 1e6 * 4 / 3));
+    h = w * 3 / 4;
+}
+
+// Best wall time of a few runs, in seconds
+template <class F>
+static double bestTime(F f, int runs = 3)
+{
+    double best = 0;
+    for (int i = 0; i < runs; i++)
+    {
+        ElapsedTime T;
+        f();
+        double t = T();
+        if ((i == 0) || (t < best))
+            best = t;
+    }
+    return best;
+}
+
+// Counts last-level cache misses of the calling thread with a hardware performance counter, where the
+// system allows it
+class LLCMissCounter
+{
+public:
+    LLCMissCounter()
+    {
+#ifdef __PCL_LINUX
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        m_fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~LLCMissCounter()
+    {
+#ifdef __PCL_LINUX
+        if (m_fd >= 0)
+            ::close(m_fd);
+#endif
+    }
+
+    bool isAvailable() const
+    {
+        return m_fd >= 0;
+    }
+
+    // Cache misses while running f, or -1 if the counter is not available
+    template <class F>
+    long long count(F f)
+    {
+#ifdef __PCL_LINUX
+        if (m_fd >= 0)
+        {
+            ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            f();
+            ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long misses = 0;
+            if (::read(m_fd, &misses, sizeof(misses)) == sizeof(misses))
+                return misses;
+            return -1;
+        }
+#endif
+        f();
+        return -1;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+// Weighted blending against center-crop placement, with an identity engine so that the time is spent
+// stitching. The weighted time includes the normalizing pass of the finalization.
+TRT_BENCHMARK(blendModes)
+{
+    int w, h;
+    imageSize(w, h);
+    FImage input = testImage(w, h, 3);
+    TRTTestUpscaleEngine engine(256, 1);
+    std::printf("%dx%d RGB, 256 px tiles, identity engine\n", w, h);
+    std::printf("%-10s %-24s %10s\n", "overlap", "blend mode", "time (s)");
+    for (double overlap : { 0.125, 0.25, 0.5 })
+    {
+        double weighted = bestTime([&] { inferWeighted(engine, input, overlap); });
+        std::printf("%-10.3f %-24s %10.3f\n", overlap, "weighted", weighted);
+        for (int threads : { 1, 0 })
+        {
+            double crop = bestTime([&] { inferCenterCrop(engine, input, overlap, threads); });
+            std::printf("%-10.3f %-24s %10.3f\n", overlap, threads ? "center crop, 1 thread" : "center crop, auto", crop);
+        }
+    }
+}
+
+// Same-size fast mode against a full-resolution run of a 2x engine whose output is binned back to the
+// input size, as with Keep Output Dimension disabled. The stand-in engine is cheap, so the times mostly
+// measure tiling and binning; with a real engine the time follows the tile counts.
+TRT_BENCHMARK(binning)
+{
+    int w, h;
+    imageSize(w, h);
+    FImage input = testImage(w, h, 3);
+    std::printf("%dx%d RGB, 128 px tiles, 0.25 overlap\n", w, h);
+    std::printf("%-28s %10s %10s\n", "mode", "tiles", "time (s)");
+
+    TRTTestUpscaleEngine full(128, 2);
+    double fullTime = bestTime([&] {
+        full.m_numInferences = 0;
+        FImage upscaled = inferCenterCrop(full, input, 0.25);
+        FImage output;
+        output.AllocateData(w, h, 3, ColorSpace::RGB);
+        binImage(upscaled, 2, output);
+    });
+    std::printf("%-28s %10d %10.3f\n", "full resolution, binned out", full.m_numInferences, fullTime);
+
+    TRTTestUpscaleEngine fast(128, 2);
+    double fastTime = bestTime([&] {
+        fast.m_numInferences = 0;
+        FImage binned;
+        binned.AllocateData((w + 1) / 2, (h + 1) / 2, 3, ColorSpace::RGB);
+        binImage(input, 2, binned);
+        inferCenterCrop(fast, binned, 0.25);
+    });
+    std::printf("%-28s %10d %10.3f\n", "same-size fast mode", fast.m_numInferences, fastTime);
+}
+
+// Work of the live display against a weighted run of the box-blur engine. Every display row is
+// composited once per run by the display worker, so the composition time of the whole image bounds the
+// CPU time the display takes from inference; copying composited rows to the window on the GUI thread is
+// not measured. The stand-in engine is much faster than a real one, so the ratio is pessimistic.
+TRT_BENCHMARK(liveDisplay)
+{
+    int w, h;
+    imageSize(w, h);
+    FImage input = testImage(w, h, 3);
+    TRTTestBlurEngine engine(256, 1);
+    FImage output;
+    double inference = bestTime([&] { output = inferWeighted(engine, input, 0.125); });
+    std::printf("%dx%d RGB, 256 px tiles, 3x3 blur engine, weighted blending\n", w, h);
+    std::printf("%-24s %10s %10s\n", "", "time (s)", "overhead");
+    std::printf("%-24s %10.3f\n", "inference", inference);
+    for (int maxSize : { 4096, 1024 })
+    {
+        int reduction = Max(1, (Max(w, h) + maxSize - 1) / maxSize);
+        FImage display;
+        display.AllocateData((w + reduction - 1) / reduction, (h + reduction - 1) / reduction, 3);
+        double compose = bestTime([&] { reduceForDisplay(output, nullptr, reduction, 0, display.Height(), display); });
+        std::printf("%-24s %10.4f %9.2f%%\n", String().Format("display, reduction %d", reduction).ToUTF8().c_str(), compose, 100 * compose / inference);
+    }
+}
+
+// Wall time and last-level cache misses of a weighted run in each tile order, with the identity engine
+// so that the time is spent extracting and accumulating tiles. Run it at 50 to 200 megapixels, where
+// the accumulator rows of a row of tiles no longer fit in the cache. Where the system forbids
+// performance counters, run it under perf stat -e LLC-load-misses one order at a time instead.
+TRT_BENCHMARK(tileOrders)
+{
+    int w, h;
+    imageSize(w, h);
+    FImage input = testImage(w, h, 3);
+    TRTTestUpscaleEngine engine(256, 1);
+    LLCMissCounter counter;
+    std::printf("%dx%d RGB, 256 px tiles, 0.125 overlap, identity engine, weighted blending\n", w, h);
+    std::printf("%-12s %10s %16s\n", "order", "time (s)", "LLC misses");
+    const char* names[] = { "raster", "serpentine", "z-order", "band-major" };
+    for (pcl_enum order = 0; order < TRTInferenceTileOrder::NumberOfItems; order++)
+    {
+        long long misses = -1;
+        double time = bestTime([&] { misses = counter.count([&] { inferWeighted(engine, input, 0.125, order, 4); }); });
+        if (misses >= 0)
+            std::printf("%-12s %10.3f %16lld\n", names[order], time, misses);
+        else
+            std::printf("%-12s %10.3f %16s\n", names[order], time, "n/a");
+    }
+}
+
+// Plain direct convolution with zero padding, one thread, the baseline of the cpuConvolution benchmark
+static void naiveConvolution(const TRTCpuTensor& input, const float* weights, const TRTCpuConvParams& params, TRTCpuTensor& output)
+{
+    int inputChannelsPerGroup = input.channels / params.groups;
+    int outputChannelsPerGroup = output.channels / params.groups;
+    for (int oc = 0; oc < output.channels; oc++)
+    {
+        int group = oc / outputChannelsPerGroup;
+        for (int y = 0; y < output.height; y++)
+            for (int x = 0; x < output.width; x++)
+            {
+                float sum = 0;
+                for (int ic = 0; ic < inputChannelsPerGroup; ic++)
+                    for (int ky = 0; ky < params.kernelH; ky++)
+                        for (int kx = 0; kx < params.kernelW; kx++)
+                        {
+                            int sy = y + ky - params.padTop;
+                            int sx = x + kx - params.padLeft;
+                            if ((sy >= 0) && (sy < input.height) && (sx >= 0) && (sx < input.width))
+                                sum += weights[((size_type(oc) * inputChannelsPerGroup + ic) * params.kernelH + ky) * params.kernelW + kx] *
+                                       input.plane(group * inputChannelsPerGroup + ic)[size_type(sy) * input.width + sx];
+                        }
+                output.plane(oc)[size_type(y) * output.width + x] = sum;
+            }
+    }
+}
+
+// Throughput of the convolutions of the CPU backend, in GFLOP/s, for layer shapes typical of denoising
+// and upscaling networks on a 256 px tile, against a plain direct convolution on one thread
+TRT_BENCHMARK(cpuConvolution)
+{
+    struct Layer
+    {
+        const char* name;
+        int inputChannels, outputChannels, kernelSize, groups;
+    };
+    const Layer layers[] = { { "3x3, 64 -> 64", 64, 64, 3, 1 },
+                             { "3x3, 3 -> 64", 3, 64, 3, 1 },
+                             { "1x1, 64 -> 64", 64, 64, 1, 1 },
+                             { "3x3 depthwise, 64", 64, 64, 3, 64 } };
+    const int size = 256;
+    std::printf("%d x %d px tile, GFLOP/s\n", size, size);
+    std::printf("%-20s %10s %10s %10s\n", "layer", "naive", "1 thread", "all");
+    for (const Layer& layer : layers)
+    {
+        TRTCpuConvParams params;
+        params.kernelH = params.kernelW = layer.kernelSize;
+        params.padTop = params.padLeft = params.padBottom = params.padRight = layer.kernelSize / 2;
+        params.groups = layer.groups;
+
+        std::vector<float> inputData(size_type(layer.inputChannels) * size * size);
+        std::vector<float> outputData(size_type(layer.outputChannels) * size * size);
+        std::vector<float> weights(size_type(layer.outputChannels) * layer.inputChannels / layer.groups * layer.kernelSize * layer.kernelSize);
+        for (size_type i = 0; i < inputData.size(); i++)
+            inputData[i] = float(i % 251) / 251;
+        for (size_type i = 0; i < weights.size(); i++)
+            weights[i] = float(int(i % 17) - 8) / 64;
+        TRTCpuTensor input = { layer.inputChannels, size, size, inputData.data() };
+        TRTCpuTensor output = { layer.outputChannels, size, size, outputData.data() };
+        std::vector<float> scratch;
+
+        double flops = 2.0 * output.size() * (layer.inputChannels / layer.groups) * layer.kernelSize * layer.kernelSize;
+        double naive = bestTime([&] { naiveConvolution(input, weights.data(), params, output); }, 1);
+        TRTCpuThreadPool pool;
+        pool.setNumberOfThreads(1);
+        double single = bestTime([&] { convolve(pool, input, weights.data(), nullptr, params, output, scratch); });
+        pool.setNumberOfThreads(0);
+        double all = bestTime([&] { convolve(pool, input, weights.data(), nullptr, params, output, scratch); });
+        std::printf("%-20s %10.2f %10.2f %10.2f\n", layer.name, flops / naive * 1e-9, flops / single * 1e-9, flops / all * 1e-9);
+    }
+}
+
+}	// namespace pcl
+
+using namespace pcl;
+
+// Runs the benchmarks whose names contain any of the arguments, or all of them. --megapixels sets the
+// image size, 4 megapixels by default.
+int main(int argc, char** argv)
+{
+    std::vector<const char*> filters;
+    for (int i = 1; i < argc; i++)
+        if (!std::strcmp(argv[i], "--megapixels") && (i + 1 < argc))
+            s_megapixels = std::atof(argv[++i]);
+        else
+            filters.push_back(argv[i]);
+
+    for (const TRTBenchmark& benchmark : benchmarks())
+    {
+        bool selected = filters.empty();
+        for (const char* filter : filters)
+            selected = selected || (std::strstr(benchmark.name, filter) != nullptr);
+        if (!selected)
+            continue;
+        std::printf("== %s\n", benchmark.name);
+        try
+        {
+            benchmark.function();
+        }
+        catch (const Exception& x)
+        {
+            std::printf("Error: %s\n", x.Message().ToUTF8().c_str());
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
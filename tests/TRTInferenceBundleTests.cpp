@@ -0,0 +1,212 @@
+#include <pcl/File.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../TRTInferenceBundle.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+const uint64 s_MiB = 1048576;
+
+TRTBundleVariant variant(const char* name, int32 precision, int32 tileSize, int32 computeCapability = 86, int32 tensorrtVersion = 8601,
+                         uint64 deviceMemory = 512 * s_MiB)
+{
+    TRTBundleVariant v = {};
+    ::strncpy(v.name, name, sizeof(v.name) - 1);
+    v.precision = precision;
+    v.computeCapability = computeCapability;
+    v.tensorrtVersion = tensorrtVersion;
+    v.tileW = v.tileH = tileSize;
+    v.scaleFactor = 2;
+    v.deviceMemory = deviceMemory;
+    return v;
+}
+
+TRTBundleTarget target(int32 computeCapability = 86, int32 imageSize = 0, uint64 memoryBudget = 0)
+{
+    TRTBundleTarget t;
+    t.computeCapability = computeCapability;
+    t.tensorrtVersion = 8604;
+    t.imageW = t.imageH = imageSize;
+    t.memoryBudget = memoryBudget;
+    return t;
+}
+
+// Name of the variant selected for a target, or the reason none was
+String selected(const std::vector<TRTBundleVariant>& variants, const TRTBundleTarget& t)
+{
+    String whyNot;
+    int index = selectBundleVariant(variants, t, whyNot);
+    return (index < 0) ? whyNot : String(variants[index].name);
+}
+
+ByteArray engineData(size_type size, uint8 seed)
+{
+    ByteArray data(size);
+    for (size_type i = 0; i < size; i++)
+        data[i] = uint8(seed + i * 7);
+    return data;
+}
+
+// Writes a bundle of three variants, returning its variants and engines
+String writeBundle(std::vector<TRTBundleVariant>& variants, std::vector<ByteArray>& engines)
+{
+    variants = { variant("fp16-512", TRTBundlePrecision::FP16, 512), variant("fp32-256", TRTBundlePrecision::FP32, 256),
+                 variant("int8-512-sm75", TRTBundlePrecision::INT8, 512, 75) };
+    engines = { engineData(5000, 1), engineData(1, 2), engineData(8192, 3) };
+    String path = trtTestTempPath("bundle.trtb");
+    TRTEngineBundle::write(path, variants, engines);
+    return path;
+}
+
+}	// namespace
+
+// Engines only run on the architecture and TensorRT minor version they were built for, and within the
+// memory budget; the reason names the first requirement no variant meets
+TRT_TEST(bundleRejectsVariantsThatCannotRun)
+{
+    std::vector<TRTBundleVariant> variants = { variant("a", TRTBundlePrecision::FP16, 256, 86, 8601, 2048 * s_MiB),
+                                               variant("b", TRTBundlePrecision::FP32, 256, 86, 8501, 256 * s_MiB),
+                                               variant("c", TRTBundlePrecision::FP16, 256, 89, 8601, 256 * s_MiB) };
+    TRT_CHECK_EQUAL(selected(variants, target(75)), String("The bundle has no engine for compute capability 7.5."));
+
+    TRTBundleTarget t = target(89);
+    t.tensorrtVersion = 8501;
+    TRT_CHECK_EQUAL(selected(variants, t), String("The bundle has no engine for TensorRT 8.5."));
+
+    TRT_CHECK_EQUAL(selected(variants, target(86, 0, 1024 * s_MiB)),
+                    String("All engines of the bundle for this device need more than 1024 MiB of device memory."));
+
+    // Patch versions of TensorRT are compatible; an unlimited budget admits any engine
+    TRT_CHECK_EQUAL(selected(variants, target(89)), String("c"));
+    TRT_CHECK_EQUAL(selected(variants, target(86)), String("a"));
+    TRT_CHECK_EQUAL(selected(variants, target(86, 0, 4096 * s_MiB)), String("a"));
+
+    TRT_CHECK_EQUAL(selected({}, target(86)), String("The bundle has no engine for compute capability 8.6."));
+}
+
+// FP16 comes first on GPUs with tensor cores and FP32 on older ones; INT8 comes last on both
+TRT_TEST(bundlePrefersPrecisionOfArchitecture)
+{
+    for (int32 computeCapability : { 61, 86 })
+    {
+        std::vector<TRTBundleVariant> variants = { variant("int8", TRTBundlePrecision::INT8, 256, computeCapability),
+                                                   variant("fp32", TRTBundlePrecision::FP32, 256, computeCapability),
+                                                   variant("fp16", TRTBundlePrecision::FP16, 256, computeCapability) };
+        TRT_CHECK_EQUAL(selected(variants, target(computeCapability)), String((computeCapability < 70) ? "fp32" : "fp16"));
+        variants.pop_back();
+        variants.erase(variants.begin() + 1);
+        TRT_CHECK_EQUAL(selected(variants, target(computeCapability)), String("int8"));
+    }
+}
+
+// Tiles that fit the image come before precision; then the largest tiles, then the least memory. When
+// no tile fits, the smallest of the preferred precision is the least wasted work.
+TRT_TEST(bundlePrefersTilesThatFitTheImage)
+{
+    std::vector<TRTBundleVariant> variants = { variant("fp16-512", TRTBundlePrecision::FP16, 512),
+                                               variant("fp32-256", TRTBundlePrecision::FP32, 256),
+                                               variant("fp32-128", TRTBundlePrecision::FP32, 128),
+                                               variant("fp16-1024", TRTBundlePrecision::FP16, 1024) };
+    TRT_CHECK_EQUAL(selected(variants, target(86, 300)), String("fp32-256"));
+    TRT_CHECK_EQUAL(selected(variants, target(86, 100)), String("fp16-512"));
+    TRT_CHECK_EQUAL(selected(variants, target(86, 600)), String("fp16-512"));
+    TRT_CHECK_EQUAL(selected(variants, target(86, 2000)), String("fp16-1024"));
+    // Image dimensions not known
+    TRT_CHECK_EQUAL(selected(variants, target(86)), String("fp16-1024"));
+
+    // A tile fits only if it fits both dimensions
+    TRTBundleTarget t = target(86, 600);
+    t.imageH = 300;
+    TRT_CHECK_EQUAL(selected(variants, t), String("fp32-256"));
+
+    variants = { variant("large", TRTBundlePrecision::FP16, 256, 86, 8601, 900 * s_MiB),
+                 variant("small", TRTBundlePrecision::FP16, 256, 86, 8601, 300 * s_MiB) };
+    TRT_CHECK_EQUAL(selected(variants, target(86, 1000)), String("small"));
+}
+
+// The manifest and engines read back as written, with the engines aligned to pages
+TRT_TEST(bundleRoundTrip)
+{
+    std::vector<TRTBundleVariant> variants;
+    std::vector<ByteArray> engines;
+    String path = writeBundle(variants, engines);
+
+    TRT_CHECK(TRTEngineBundle::isBundle(path));
+    {
+        TRTEngineBundle bundle(path);
+        TRT_CHECK_EQUAL(bundle.variants().size(), variants.size());
+        for (size_type i = 0; i < variants.size(); i++)
+        {
+            const TRTBundleVariant& v = bundle.variants()[i];
+            TRT_CHECK_EQUAL(String(v.name), String(variants[i].name));
+            TRT_CHECK_EQUAL(v.precision, variants[i].precision);
+            TRT_CHECK_EQUAL(v.computeCapability, variants[i].computeCapability);
+            TRT_CHECK_EQUAL(v.tensorrtVersion, variants[i].tensorrtVersion);
+            TRT_CHECK_EQUAL(v.tileW, variants[i].tileW);
+            TRT_CHECK_EQUAL(v.tileH, variants[i].tileH);
+            TRT_CHECK_EQUAL(v.scaleFactor, variants[i].scaleFactor);
+            TRT_CHECK_EQUAL(v.deviceMemory, variants[i].deviceMemory);
+            TRT_CHECK_EQUAL(v.size, uint64(engines[i].Length()));
+            TRT_CHECK_EQUAL(v.offset % 4096, uint64(0));
+            TRT_CHECK(::memcmp(bundle.variantData(int(i)), engines[i].Begin(), engines[i].Length()) == 0);
+        }
+    }
+    File::Remove(path);
+}
+
+// Files that are not bundles, of another version, or cut short anywhere are rejected on opening
+TRT_TEST(bundleRejectsDamagedFiles)
+{
+    std::vector<TRTBundleVariant> variants;
+    std::vector<ByteArray> engines;
+    String path = writeBundle(variants, engines);
+    ByteArray data = File::ReadFile(path);
+
+    try
+    {
+        File::WriteFile(path, ByteArray());
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Not an engine bundle");
+        File::WriteFile(path, ByteArray(data.Begin(), data.At(6)));
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Not an engine bundle");
+
+        ByteArray damaged = data;
+        damaged[0] = 'X';
+        File::WriteFile(path, damaged);
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Not an engine bundle");
+
+        damaged = data;
+        damaged[8] = 99;
+        File::WriteFile(path, damaged);
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Unsupported engine bundle version");
+
+        // Within the manifest
+        File::WriteFile(path, ByteArray(data.Begin(), data.At(16 + sizeof(TRTBundleVariant) + 10)));
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Truncated engine bundle");
+
+        // Within the last engine
+        File::WriteFile(path, ByteArray(data.Begin(), data.At(data.Length() - 1)));
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Truncated engine bundle");
+
+        // A manifest claiming more variants than the file holds
+        damaged = data;
+        uint32 numVariants = 1000000;
+        ::memcpy(damaged.At(12), &numVariants, sizeof(numVariants));
+        File::WriteFile(path, damaged);
+        TRT_CHECK_THROWS(TRTEngineBundle bundle(path), "Truncated engine bundle");
+
+        File::WriteFile(path, data);
+        TRT_CHECK_EQUAL(TRTEngineBundle(path).variants().size(), size_type(3));
+    }
+    catch (...)
+    {
+        File::Remove(path);
+        throw;
+    }
+    File::Remove(path);
+}
@@ -0,0 +1,138 @@
+#include <pcl/File.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../TRTInferenceBundle.h"
+#include "../TRTInferenceCatalog.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+TRTBundleVariant bundleVariant(const char* name, int32 precision, int32 tileSize)
+{
+    TRTBundleVariant variant = {};
+    ::strncpy(variant.name, name, sizeof(variant.name) - 1);
+    variant.precision = precision;
+    variant.computeCapability = 86;
+    variant.tensorrtVersion = 8601;
+    variant.tileW = variant.tileH = tileSize;
+    variant.scaleFactor = 2;
+    return variant;
+}
+
+// Directory with an ONNX model, an engine bundle of two variants and a file that is not an engine
+String makeEngineDirectory()
+{
+    String model = trtTestDataPath("upscaler.onnx");
+    if (!File::Exists(model))
+        throw TRTTestSkipped{ "No test data at " + model };
+
+    String directory = trtTestTempPath("catalog");
+    File::CreateDirectory(directory);
+    File::CopyFile(directory + "/upscaler.onnx", model);
+    TRTEngineBundle::write(directory + "/upscaler.trtb",
+                           { bundleVariant("fp16-256", TRTBundlePrecision::FP16, 256), bundleVariant("fp32-128", TRTBundlePrecision::FP32, 128) },
+                           { ByteArray(100, uint8(1)), ByteArray(200, uint8(2)) });
+    File::WriteTextFile(directory + "/notes.txt", "Not an engine.");
+    return directory;
+}
+
+void removeEngineDirectory(const String& directory)
+{
+    for (const char* name : { "upscaler.onnx", "upscaler.trtb", "notes.txt", "TRTInference.index" })
+        if (File::Exists(directory + '/' + name))
+            File::Remove(directory + '/' + name);
+    File::RemoveDirectory(directory);
+}
+
+void waitForRefresh(TRTEngineCatalog& catalog)
+{
+    for (int i = 0; !catalog.finishRefresh(); i++)
+    {
+        if (i == 1000)
+            throw Error("Engine catalog refresh did not finish.");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+}	// namespace
+
+// A refresh runs on a worker thread; the first one has no index to list meanwhile, later ones list the
+// engines recorded by the first
+TRT_TEST(catalogRefreshesOnWorkerThread)
+{
+    String directory = makeEngineDirectory();
+    try
+    {
+        {
+            TRTEngineCatalog catalog(directory);
+            catalog.startRefresh();
+            TRT_CHECK(catalog.refreshing());
+            TRT_CHECK(catalog.engines().empty());
+            waitForRefresh(catalog);
+            TRT_CHECK(!catalog.refreshing());
+            TRT_CHECK_EQUAL(catalog.engines().size(), size_type(2));
+            TRT_CHECK(File::Exists(TRTEngineCatalog::indexPath(directory)));
+        }
+
+        TRTEngineCatalog catalog(directory);
+        catalog.startRefresh();
+        TRT_CHECK_EQUAL(catalog.engines().size(), size_type(2));
+        const TRTEngineInfo* model = catalog.find(directory + "/upscaler.onnx");
+        TRT_CHECK(model != nullptr);
+        TRT_CHECK(model->described);
+        TRT_CHECK(model->problem.IsEmpty());
+        TRT_CHECK_EQUAL(model->scaleFactor, 2);
+        waitForRefresh(catalog);
+        TRT_CHECK_EQUAL(catalog.engines().size(), size_type(2));
+    }
+    catch (...)
+    {
+        removeEngineDirectory(directory);
+        throw;
+    }
+    removeEngineDirectory(directory);
+}
+
+// Bundles list the variants of their manifest, also when read from the index
+TRT_TEST(catalogListsBundleVariants)
+{
+    String directory = makeEngineDirectory();
+    try
+    {
+        for (int pass = 0; pass < 2; pass++)
+        {
+            TRTEngineCatalog catalog(directory);
+            catalog.refresh();
+            const TRTEngineInfo* bundle = catalog.find(directory + "/upscaler.trtb");
+            TRT_CHECK(bundle != nullptr);
+            TRT_CHECK_EQUAL(bundle->variants.size(), size_type(2));
+            TRT_CHECK(bundle->variants[0].StartsWith("fp16-256, FP16, 256x256 tiles, compute capability 8.6"));
+            TRT_CHECK(bundle->variants[1].StartsWith("fp32-128, FP32, 128x128 tiles"));
+            TRT_CHECK(bundle->summary().Contains(bundle->variants[1]));
+        }
+    }
+    catch (...)
+    {
+        removeEngineDirectory(directory);
+        throw;
+    }
+    removeEngineDirectory(directory);
+}
+
+// Destroying a catalog while it refreshes waits for the worker thread
+TRT_TEST(catalogDestroyedWhileRefreshing)
+{
+    String directory = makeEngineDirectory();
+    {
+        TRTEngineCatalog catalog(directory);
+        catalog.startRefresh();
+    }
+    removeEngineDirectory(directory);
+}
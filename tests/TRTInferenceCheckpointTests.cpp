@@ -0,0 +1,194 @@
+#include <pcl/File.h>
+
+#include <vector>
+
+#include "../TRTInferenceCheckpoint.h"
+#include "../TRTInferenceParameters.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+TRTCheckpointLayout testLayout(const FImage& accumulator, bool weighted, int tilesPerRow, int numTileRows)
+{
+    return { 0x636b7074ull, 1, 2, accumulator.Width(), accumulator.Height(), accumulator.NumberOfChannels(), int32(weighted),
+             tilesPerRow, numTileRows };
+}
+
+// Normalized output of an accumulator
+FImage normalized(const FImage& accumulator, const FImage* weight)
+{
+    ImageVariant output;
+    output.CreateFloatImage();
+    output.AllocateImage(1, 1, accumulator.NumberOfChannels(), accumulator.ColorSpace());
+    finalizeOutput(accumulator, weight, 1, output);
+    return static_cast<const FImage&>(*output);
+}
+
+// Runs the tile loop of processImage with checkpoints saved whenever rows of tiles complete, resuming
+// from the checkpoint at path if any. Stops without completing, as a crash would, after stopAfter
+// inferences; otherwise returns true with the normalized output in output.
+bool runWithCheckpoints(TRTEngine& engine, const FImage& input, double overlap, bool weighted, pcl_enum order, const String& path,
+                        int stopAfter, FImage& output, int& resumedRows)
+{
+    int tileW = engine.getInputTileW(), tileH = engine.getInputTileH();
+    int stepX = tileW * (1.0f - overlap), stepY = tileH * (1.0f - overlap);
+    int tilesPerRow = (input.Width() + stepX - 1) / stepX;
+    int numTileRows = (input.Height() + stepY - 1) / stepY;
+    int numPlanes = input.NumberOfChannels();
+    engine.setNumberOfPlanes(numPlanes);
+
+    FImage accumulator, weight;
+    accumulator.AllocateData(input.Width(), input.Height(), numPlanes);
+    accumulator.Zero();
+    weight.AllocateData(input.Width(), input.Height());
+    weight.Zero();
+    FImage* w = weighted ? &weight : nullptr;
+
+    TRTCheckpoint checkpoint(path, testLayout(accumulator, weighted, tilesPerRow, numTileRows), accumulator, w, 0);
+    resumedRows = checkpoint.resume();
+    int startTileRow = (resumedRows > 0) ? TRTCheckpoint::firstTileRowBelow(resumedRows, numTileRows, stepY, tileH, 1) : 0;
+    std::vector<uint8> doneTiles(size_type(tilesPerRow) * numTileRows, 0);
+    std::vector<int> remainingTiles(numTileRows, tilesPerRow);
+    for (int i = 0; i < startTileRow * tilesPerRow; i++)
+        if (checkpoint.doneTiles()[i] != 0)
+        {
+            doneTiles[i] = 1;
+            remainingTiles[i / tilesPerRow]--;
+        }
+    int completedTileRows = 0;
+    while ((completedTileRows < numTileRows) && (remainingTiles[completedTileRows] == 0))
+        completedTileRows++;
+
+    int numInferred = 0;
+    for (const Point& tile : tileOrder(order, tilesPerRow, numTileRows, 2))
+    {
+        int index = tile.y * tilesPerRow + tile.x;
+        if ((tile.y < startTileRow) && (doneTiles[index] != 0))
+            continue;
+        if (numInferred++ == stopAfter)
+            return false;
+
+        Point pos(tile.x * stepX, tile.y * stepY);
+        extractTile(input, pos, tileW, tileH, numPlanes, engine.getInputBuffer());
+        engine.runInference();
+        if (weighted)
+            accumulateTile(engine.getOutputBuffer(), tileW, tileH, numPlanes, pos, accumulator, weight);
+        else
+            placeTile(engine.getOutputBuffer(), tileW, tileH, numPlanes, pos,
+                      cropRegion(pos, tileW, tileH, stepX, stepY, input.Width(), input.Height()), accumulator);
+
+        doneTiles[index] = 1;
+        if (--remainingTiles[tile.y] > 0)
+            continue;
+        int previousCompleted = completedTileRows;
+        while ((completedTileRows < numTileRows) && (remainingTiles[completedTileRows] == 0))
+            completedTileRows++;
+        if ((completedTileRows != previousCompleted) && (completedTileRows < numTileRows))
+            checkpoint.save(Min(completedTileRows * stepY, accumulator.Height()), doneTiles);
+    }
+
+    checkpoint.restoreFinishedRows();
+    checkpoint.discard();
+    output = normalized(accumulator, w);
+    return true;
+}
+
+}	// namespace
+
+// Finished rows are saved normalized and restored with unit weights, together with the tile manifest;
+// a checkpoint of another layout is discarded
+TRT_TEST(checkpointRoundTrip)
+{
+    String path = trtTestTempPath("roundtrip.trtckpt");
+    FImage accumulator = testImage(40, 30, 3);
+    FImage weight = testImage(40, 30, 1, 9);
+    weight.Pixel(3, 2) = 0;
+    accumulator.Pixel(5, 5, 1) = 3.0f;
+    std::vector<uint8> done(4 * 3, 0);
+    done[0] = done[1] = done[5] = 1;
+    {
+        TRTCheckpoint checkpoint(path, testLayout(accumulator, true, 4, 3), accumulator, &weight, 0);
+        TRT_CHECK_EQUAL(checkpoint.resume(), 0);
+        checkpoint.save(12, done);
+    }
+
+    FImage expected = normalized(accumulator, &weight);
+    FImage restored, restoredWeight;
+    restored.AllocateData(40, 30, 3);
+    restored.Zero();
+    restoredWeight.AllocateData(40, 30);
+    restoredWeight.Zero();
+    {
+        TRTCheckpoint checkpoint(path, testLayout(restored, true, 4, 3), restored, &restoredWeight, 0);
+        TRT_CHECK_EQUAL(checkpoint.resume(), 12);
+        TRT_CHECK(checkpoint.doneTiles() == done);
+        for (int y = 0; y < 30; y++)
+            for (int x = 0; x < 40; x++)
+            {
+                TRT_CHECK_EQUAL(restoredWeight.Pixel(x, y), (y < 12) ? 1.0f : 0.0f);
+                for (int c = 0; c < 3; c++)
+                    TRT_CHECK_EQUAL(restored.Pixel(x, y, c), (y < 12) ? expected.Pixel(x, y, c) : 0.0f);
+            }
+
+        // Rows accumulated to after resuming are restored again
+        restored.Pixel(1, 1, 0) += 1;
+        restoredWeight.Pixel(1, 1) += 1;
+        checkpoint.restoreFinishedRows();
+        TRT_CHECK_EQUAL(restored.Pixel(1, 1, 0), expected.Pixel(1, 1, 0));
+        TRT_CHECK_EQUAL(restoredWeight.Pixel(1, 1), 1.0f);
+    }
+
+    {
+        TRTCheckpointLayout other = testLayout(restored, true, 4, 3);
+        other.imageHash++;
+        TRTCheckpoint checkpoint(path, other, restored, &restoredWeight, 0);
+        TRT_CHECK_EQUAL(checkpoint.resume(), 0);
+        checkpoint.discard();
+    }
+    TRT_CHECK(!File::Exists(path));
+}
+
+TRT_TEST(checkpointFirstTileRowBelow)
+{
+    // Tiles of 32 rows every 24 rows: rows 0 and 1 end at rows 32 and 56
+    TRT_CHECK_EQUAL(TRTCheckpoint::firstTileRowBelow(31, 10, 24, 32, 1), 0);
+    TRT_CHECK_EQUAL(TRTCheckpoint::firstTileRowBelow(32, 10, 24, 32, 1), 1);
+    TRT_CHECK_EQUAL(TRTCheckpoint::firstTileRowBelow(56, 10, 24, 32, 1), 2);
+    TRT_CHECK_EQUAL(TRTCheckpoint::firstTileRowBelow(112, 10, 24, 32, 2), 2);
+    TRT_CHECK_EQUAL(TRTCheckpoint::firstTileRowBelow(100000, 10, 24, 32, 1), 10);
+}
+
+// A run interrupted at any tile and resumed from its checkpoint gives the output of an uninterrupted
+// run bit for bit, in every tile order and blend mode, and checkpoints are saved in every order
+TRT_TEST(checkpointResumeMatchesUninterruptedRun)
+{
+    FImage input = testImage(150, 130, 3);
+    String path = trtTestTempPath("resume.trtckpt");
+    for (bool weighted : { true, false })
+        for (pcl_enum order : { TRTInferenceTileOrder::Raster, TRTInferenceTileOrder::Serpentine, TRTInferenceTileOrder::ZOrder,
+                                TRTInferenceTileOrder::BandMajor })
+        {
+            TRTTestBlurEngine engine(32, 2);
+            FImage expected;
+            int resumedRows;
+            TRT_CHECK(runWithCheckpoints(engine, input, 0.25, weighted, order, path, -1, expected, resumedRows));
+            TRT_CHECK(!File::Exists(path));
+
+            int numTiles = engine.m_numInferences;
+            for (int stopAfter : { 1, numTiles / 3, numTiles / 2, numTiles - 1 })
+            {
+                FImage output;
+                TRT_CHECK(!runWithCheckpoints(engine, input, 0.25, weighted, order, path, stopAfter, output, resumedRows));
+                TRT_CHECK(File::Exists(path));
+                TRT_CHECK(runWithCheckpoints(engine, input, 0.25, weighted, order, path, -1, output, resumedRows));
+                if (stopAfter >= numTiles / 2)
+                    TRT_CHECK(resumedRows > 0);
+                TRT_CHECK(identical(output, expected));
+            }
+        }
+}
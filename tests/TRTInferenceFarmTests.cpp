@@ -0,0 +1,239 @@
+#include <pcl/File.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../TRTInferenceFarm.h"
+#include "../TRTInferenceParameters.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+extern char** environ;
+
+using namespace pcl;
+
+namespace
+{
+
+// Stand-in engine of the workers: 32 px tiles upscaled 2x, as TRTTestUpscaleEngine(32, 2)
+const int s_tileSize = 32;
+const int s_factor = 2;
+
+// Inference server started as a tile farm worker with a stand-in engine on a port of the loopback
+// interface, and killed on destruction
+class Worker
+{
+public:
+    explicit Worker(const std::vector<IsoString>& options = {})
+    {
+        static int s_numWorkers = 0;
+        m_port = 20000 + (int(::getpid()) * 37 + s_numWorkers++) % 30000;
+
+        String server = trtTestServerPath();
+        if (!File::Exists(server))
+            throw TRTTestSkipped{ "No inference server at " + server + "; build it with make or give it with --server." };
+
+        std::vector<IsoString> args = { server.ToUTF8(), "--port", IsoString().Format("%d", m_port), "--stand-in",
+                                        IsoString().Format("%d", s_tileSize), IsoString().Format("%d", s_factor) };
+        args.insert(args.end(), options.begin(), options.end());
+        std::vector<char*> argv;
+        for (IsoString& arg : args)
+            argv.push_back(arg.Begin());
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        ::posix_spawn_file_actions_init(&actions);
+        ::posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+        int result = ::posix_spawn(&m_pid, argv[0], &actions, nullptr, argv.data(), environ);
+        ::posix_spawn_file_actions_destroy(&actions);
+        if (result != 0)
+            throw Error("Unable to start " + server);
+
+        // Ready once it accepts connections
+        for (int attempt = 0;; attempt++)
+            try
+            {
+                TRTSocket::connectTcp(address());
+                break;
+            }
+            catch (const TRTConnectionError&)
+            {
+                if (attempt == 250)
+                    throw Error("Worker not listening at " + address());
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+    }
+
+    ~Worker()
+    {
+        ::kill(m_pid, SIGKILL);
+        ::waitpid(m_pid, nullptr, 0);
+    }
+
+    String address() const
+    {
+        return String().Format("127.0.0.1:%d", m_port);
+    }
+
+private:
+    pid_t m_pid = 0;
+    int m_port = 0;
+};
+
+String farmAddresses(const std::vector<std::unique_ptr<Worker>>& workers)
+{
+    String addresses;
+    for (const std::unique_ptr<Worker>& worker : workers)
+        addresses += (addresses.IsEmpty() ? "" : ", ") + worker->address();
+    return addresses;
+}
+
+// Runs the farm over an image in raster order with weighted blending, as inferWeighted runs a local
+// engine
+FImage inferOnFarm(TRTTileFarm& farm, const FImage& input, double tileOverlap)
+{
+    TRTEngine& engine = farm.engine();
+    int numPlanes = input.NumberOfChannels();
+    int stepX = engine.getInputTileW() * (1.0f - tileOverlap);
+    int stepY = engine.getInputTileH() * (1.0f - tileOverlap);
+    Array<Point> positions;
+    for (int y = 0; y < input.Height(); y += stepY)
+        for (int x = 0; x < input.Width(); x += stepX)
+            positions << Point(x, y);
+
+    FImage accumulator, weight;
+    accumulator.AllocateData(input.Width() * s_factor, input.Height() * s_factor, numPlanes, input.ColorSpace());
+    accumulator.Zero();
+    weight.AllocateData(accumulator.Width(), accumulator.Height());
+    weight.Zero();
+
+    farm.start(input, positions, numPlanes, false, 0, TRTInferenceUniformTilePolicy::Default, false);
+    for (const Point& position : positions)
+        accumulateTile(farm.next(), engine.getOutputTileW(), engine.getOutputTileH(), numPlanes,
+                       Point(position.x * s_factor, position.y * s_factor), accumulator, weight);
+    normalizeWeighted(accumulator, weight);
+    return accumulator;
+}
+
+FImage inferLocally(const FImage& input, double tileOverlap)
+{
+    TRTTestUpscaleEngine engine(s_tileSize, s_factor);
+    return inferWeighted(engine, input, tileOverlap);
+}
+
+// Raw protocol request to a worker; returns the reply
+TRTReply request(const TRTSocket& socket, uint32 type, int32 numPlanes = 0, const char* path = "")
+{
+    TRTRequest request = {};
+    request.magic = TRTProtocolMagic;
+    request.type = type;
+    request.numPlanes = numPlanes;
+    ::strncpy(request.path, path, sizeof(request.path) - 1);
+    socket.send(&request, sizeof(request));
+    TRTReply reply;
+    socket.receive(&reply, sizeof(reply));
+    reply.message[sizeof(reply.message) - 1] = '\0';
+    return reply;
+}
+
+}	// namespace
+
+// Tiles spread over several workers blend to the output of a single local engine, bit for bit
+TRT_TEST(farmMatchesLocalEngine)
+{
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < 3; i++)
+        workers.push_back(std::make_unique<Worker>());
+    TRTTileFarm farm(farmAddresses(workers));
+    TRT_CHECK_EQUAL(farm.numWorkers(), 3);
+
+    FImage input = testImage(200, 150, 3);
+    TRT_CHECK(identical(inferOnFarm(farm, input, 0.25), inferLocally(input, 0.25)));
+    for (int i = 0; i < 3; i++)
+        TRT_CHECK(farm.numProduced(i) > 0);
+    TRT_CHECK_EQUAL(farm.numFailedWorkers(), 0);
+}
+
+// Workers done with their queues take the tiles queued for a slow one. The image has as many tiles as
+// the first window, so no tile is dealt later and a slow worker keeps its initial run of 4 tiles unless
+// they are stolen.
+TRT_TEST(farmStealsFromSlowWorkers)
+{
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.push_back(std::make_unique<Worker>(std::vector<IsoString>{ "--delay", "300" }));
+    for (int i = 0; i < 2; i++)
+        workers.push_back(std::make_unique<Worker>());
+    TRTTileFarm farm(farmAddresses(workers));
+
+    // 3x4 tiles of 32 px at a step of 24 px
+    FImage input = testImage(72, 96, 3);
+    TRT_CHECK(identical(inferOnFarm(farm, input, 0.25), inferLocally(input, 0.25)));
+    TRT_CHECK(farm.numProduced(0) < 4);
+    TRT_CHECK_EQUAL(farm.numProduced(0) + farm.numProduced(1) + farm.numProduced(2), 12);
+}
+
+// The tiles of a worker that fails are requeued on the others, starting with the one in flight, and
+// the output is unchanged
+TRT_TEST(farmRequeuesTilesOfFailedWorkers)
+{
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < 2; i++)
+        workers.push_back(std::make_unique<Worker>());
+    workers.push_back(std::make_unique<Worker>(std::vector<IsoString>{ "--fail-after", "10" }));
+    TRTTileFarm farm(farmAddresses(workers));
+
+    // 10x10 tiles
+    FImage input = testImage(240, 240, 3);
+    TRT_CHECK(identical(inferOnFarm(farm, input, 0.25), inferLocally(input, 0.25)));
+    TRT_CHECK_EQUAL(farm.numProduced(2), 10);
+    TRT_CHECK_EQUAL(farm.numFailedWorkers(), 1);
+    TRT_CHECK_EQUAL(farm.numProduced(0) + farm.numProduced(1), 90);
+}
+
+// The farm fails once no worker is left
+TRT_TEST(farmFailsWhenAllWorkersFail)
+{
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < 2; i++)
+        workers.push_back(std::make_unique<Worker>(std::vector<IsoString>{ "--fail-after", "3" }));
+    TRTTileFarm farm(farmAddresses(workers));
+
+    FImage input = testImage(240, 240, 3);
+    TRT_CHECK_THROWS(inferOnFarm(farm, input, 0.25), "All tile farm workers failed");
+    TRT_CHECK_EQUAL(farm.numFailedWorkers(), 2);
+}
+
+// Workers serve the engine they were started with, and take no file paths nor tile buffer requests
+// from the network
+TRT_TEST(farmWorkerRejectsPaths)
+{
+    Worker worker;
+    TRTSocket socket = TRTSocket::connectTcp(worker.address());
+
+    TRTReply reply = request(socket, TRTRequestType::Open, 0, "/etc/passwd");
+    TRT_CHECK(reply.status != 0);
+    TRT_CHECK(IsoString(reply.message).Contains("not accepted over TCP"));
+
+    reply = request(socket, TRTRequestType::Open);
+    TRT_CHECK_EQUAL(reply.status, 0);
+    TRT_CHECK_EQUAL(reply.inputTileW, s_tileSize);
+
+    reply = request(socket, TRTRequestType::SetPlanes, 3, "/tmp/tiles");
+    TRT_CHECK(IsoString(reply.message).Contains("not accepted over TCP"));
+    reply = request(socket, TRTRequestType::SetPlanes, 100000);
+    TRT_CHECK(IsoString(reply.message).Contains("Invalid number of planes"));
+    reply = request(socket, TRTRequestType::SetPlanes, 3);
+    TRT_CHECK_EQUAL(reply.status, 0);
+    reply = request(socket, TRTRequestType::Infer);
+    TRT_CHECK(IsoString(reply.message).Contains("only accepted inline"));
+}
@@ -0,0 +1,166 @@
+#include <pcl/File.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "../TRTInferenceFilePipeline.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+// Waits, with a timeout, for events signaled by other threads
+class Events
+{
+public:
+    void signal(const String& event)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_events.push_back(event);
+        }
+        m_changed.notify_all();
+    }
+
+    bool waitFor(const String& event)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, std::chrono::seconds(10), [&] { return happened(event); });
+    }
+
+    bool happened(const String& event) const
+    {
+        for (const String& e : m_events)
+            if (e == event)
+                return true;
+        return false;
+    }
+
+private:
+    std::vector<String> m_events;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+};
+
+String inputPath(size_type i)
+{
+    return trtTestTempPath(String().Format("pipeline-in-%u.txt", unsigned(i)));
+}
+
+String outputPath(size_type i)
+{
+    return trtTestTempPath(String().Format("pipeline-out-%u.txt", unsigned(i)));
+}
+
+void writeInputs(size_type count)
+{
+    for (size_type i = 0; i < count; i++)
+        File::WriteTextFile(inputPath(i), IsoString().Format("file %u", unsigned(i)));
+}
+
+void removeFiles(size_type count)
+{
+    for (size_type i = 0; i < count; i++)
+        for (const String& path : { inputPath(i), outputPath(i) })
+            if (File::Exists(path))
+                File::Remove(path);
+}
+
+}	// namespace
+
+// Every file is read, processed and written once, to the file of its own index
+TRT_TEST(filePipelineProcessesEveryFile)
+{
+    for (size_type count : { 0, 1, 2, 5 })
+    {
+        writeInputs(count);
+        std::vector<int> processed;
+        runFilePipeline<IsoString>(
+            count,
+            [](size_type i) { return File::ReadTextFile(inputPath(i)); },
+            [&](size_type i, IsoString& text) {
+                processed.push_back(int(i));
+                text += " processed";
+            },
+            [](size_type i, IsoString&& text) { return [i, text]() { File::WriteTextFile(outputPath(i), text); }; });
+        TRT_CHECK_EQUAL(processed.size(), count);
+        for (size_type i = 0; i < count; i++)
+        {
+            TRT_CHECK_EQUAL(processed[i], int(i));
+            TRT_CHECK(File::ReadTextFile(outputPath(i)) == IsoString().Format("file %u processed", unsigned(i)));
+        }
+        removeFiles(count);
+    }
+}
+
+// The next file is read and the previous one written while a file is processed: processing file 1
+// waits for the read of file 2 and the write of file 0 to start, which only works if they overlap
+TRT_TEST(filePipelineOverlapsIO)
+{
+    writeInputs(3);
+    Events events;
+    bool overlapped = true;
+    runFilePipeline<IsoString>(
+        3,
+        [&](size_type i) {
+            events.signal(String().Format("read %u", unsigned(i)));
+            return File::ReadTextFile(inputPath(i));
+        },
+        [&](size_type i, IsoString&) {
+            if (i == 1)
+                overlapped = events.waitFor("read 2") && events.waitFor("write 0");
+        },
+        [&](size_type i, IsoString&& text) {
+            return [&events, i, text]() {
+                events.signal(String().Format("write %u", unsigned(i)));
+                File::WriteTextFile(outputPath(i), text);
+            };
+        });
+    TRT_CHECK(overlapped);
+    removeFiles(3);
+}
+
+// Errors of reads, processing and writes surface on the calling thread, after the write in flight
+TRT_TEST(filePipelinePropagatesErrors)
+{
+    writeInputs(4);
+    auto read = [](size_type i) { return File::ReadTextFile(inputPath(i)); };
+    auto write = [](size_type i, IsoString&& text) { return [i, text]() { File::WriteTextFile(outputPath(i), text); }; };
+    auto nothing = [](size_type, IsoString&) {};
+
+    // A missing input file
+    File::Remove(inputPath(2));
+    TRT_CHECK_THROWS(runFilePipeline<IsoString>(4, read, nothing, write), "");
+    TRT_CHECK(File::Exists(outputPath(0)) && File::Exists(outputPath(1)));
+    TRT_CHECK(!File::Exists(outputPath(2)));
+    removeFiles(4);
+
+    writeInputs(4);
+    TRT_CHECK_THROWS(runFilePipeline<IsoString>(4, read,
+                                                [](size_type i, IsoString&) {
+                                                    if (i == 1)
+                                                        throw Error("process failed");
+                                                },
+                                                write),
+                     "process failed");
+    TRT_CHECK(File::Exists(outputPath(0)));
+    TRT_CHECK(!File::Exists(outputPath(1)));
+    removeFiles(4);
+
+    writeInputs(4);
+    TRT_CHECK_THROWS(runFilePipeline<IsoString>(4, read, nothing,
+                                                [](size_type i, IsoString&& text) {
+                                                    return [i, text]() {
+                                                        if (i == 3)
+                                                            throw Error("write failed");
+                                                        File::WriteTextFile(outputPath(i), text);
+                                                    };
+                                                }),
+                     "write failed");
+    TRT_CHECK(File::Exists(outputPath(2)));
+    removeFiles(4);
+}
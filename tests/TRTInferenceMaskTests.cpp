@@ -0,0 +1,227 @@
+#include "../TRTInferenceProcessing.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+// Mask of a 96 x 64 image: selected left of x = 20, half selected up to x = 30, and not selected from
+// there on. With 16 px tiles at 25% overlap, tiles start every 12 px, so the first three of the eight
+// columns of tiles reach into the selection.
+FImage leftMask()
+{
+    FImage mask;
+    mask.AllocateData(96, 64);
+    for (int y = 0; y < mask.Height(); y++)
+        for (int x = 0; x < mask.Width(); x++)
+            mask.Pixel(x, y) = (x < 20) ? 1.0f : ((x < 30) ? 0.5f : 0.0f);
+    return mask;
+}
+
+// Runs processImage on a copy of the image, with the mask if any, and returns the result
+FImage process(const TRTProcessingSettings& settings, TRTEngine& engine, const FImage& image, const FImage* mask)
+{
+    FImage output(image);
+    ImageVariant target(&output);
+    processImage(settings, engine, target, mask, String());
+    return output;
+}
+
+// Each output pixel is the original where the mask is zero, the unmasked output where it is one, and
+// in between by mask weight; mask channels past the last one reuse the last
+void checkBlend(const FImage& output, const FImage& original, const FImage& unmasked, const FImage& mask)
+{
+    for (int c = 0; c < output.NumberOfChannels(); c++)
+    {
+        int mc = Min(c, mask.NumberOfChannels() - 1);
+        for (int y = 0; y < output.Height(); y++)
+            for (int x = 0; x < output.Width(); x++)
+            {
+                float m = mask.Pixel(x, y, mc);
+                if (m == 0)
+                    TRT_CHECK_EQUAL(output.Pixel(x, y, c), original.Pixel(x, y, c));
+                else if (m == 1)
+                    TRT_CHECK_EQUAL(output.Pixel(x, y, c), unmasked.Pixel(x, y, c));
+                else
+                    TRT_CHECK_CLOSE(output.Pixel(x, y, c), original.Pixel(x, y, c) + m * (unmasked.Pixel(x, y, c) - original.Pixel(x, y, c)), 1.0e-6);
+            }
+    }
+}
+
+// The samples as stored in an image of the given sample format
+FImage quantized(FImage samples, bool isFloat, int bitsPerSample)
+{
+    ImageVariant image;
+    image.CreateImage(isFloat, false, bitsPerSample);
+    image.CopyImage(ImageVariant(&samples));
+    FImage result;
+    result.AllocateData(samples.Width(), samples.Height(), samples.NumberOfChannels(), samples.ColorSpace());
+    ImageVariant(&result).CopyImage(image);
+    return result;
+}
+
+}	// namespace
+
+// A tile is masked out when no sample of any mask channel within it is positive; the tile is clipped
+// to the mask
+TRT_TEST(maskedOutTiles)
+{
+    FImage mask;
+    mask.AllocateData(40, 30, 3, ColorSpace::RGB);
+    mask.Zero();
+    TRT_CHECK(isMaskedOut(mask, Rect(0, 0, 40, 30)));
+    TRT_CHECK(isMaskedOut(mask, Rect(30, 20, 46, 36)));
+
+    mask.Pixel(35, 25, 2) = 0.001f;
+    TRT_CHECK(!isMaskedOut(mask, Rect(30, 20, 46, 36)));
+    TRT_CHECK(!isMaskedOut(mask, Rect(35, 25, 36, 26)));
+    TRT_CHECK(isMaskedOut(mask, Rect(0, 0, 35, 30)));
+    TRT_CHECK(isMaskedOut(mask, Rect(36, 0, 40, 30)));
+    TRT_CHECK(isMaskedOut(mask, Rect(0, 26, 40, 30)));
+
+    // Negative samples select nothing
+    mask.Pixel(35, 25, 2) = -0.5f;
+    TRT_CHECK(isMaskedOut(mask, Rect(0, 0, 40, 30)));
+}
+
+// Zero mask weights keep the original samples exactly, whatever the target holds; partial weights
+// interpolate in the sample type of the image; a single-channel mask applies to all channels
+TRT_TEST(blendByMaskWeights)
+{
+    FImage mask;
+    mask.AllocateData(4, 1);
+    mask.Pixel(0, 0) = 0.0f;
+    mask.Pixel(1, 0) = 1.0f;
+    mask.Pixel(2, 0) = 0.25f;
+    mask.Pixel(3, 0) = -1.0f;
+
+    FImage originalSamples, targetSamples;
+    originalSamples.AllocateData(4, 1, 3, ColorSpace::RGB);
+    targetSamples.AllocateData(4, 1, 3, ColorSpace::RGB);
+    for (int c = 0; c < 3; c++)
+        for (int x = 0; x < 4; x++)
+        {
+            originalSamples.Pixel(x, 0, c) = 0.1f + 0.2f * c + 0.01f * x;
+            targetSamples.Pixel(x, 0, c) = 0.9f - 0.3f * c;
+        }
+
+    for (int bits : { 8, 16, 32 })
+        for (bool isFloat : { false, true })
+        {
+            if (isFloat && (bits != 32))
+                continue;
+            // Quantize both images to the sample type first, so the expected values use the samples blended
+            FImage o = quantized(originalSamples, isFloat, bits);
+            FImage t = quantized(targetSamples, isFloat, bits);
+            ImageVariant original, target;
+            original.CreateImage(isFloat, false, bits);
+            original.CopyImage(ImageVariant(&o));
+            target.CreateImage(isFloat, false, bits);
+            target.CopyImage(ImageVariant(&t));
+            blendByMask(original, mask, target);
+
+            FImage r;
+            r.AllocateData(4, 1, 3, ColorSpace::RGB);
+            ImageVariant result(&r);
+            result.CopyImage(target);
+            // Within one quantum of the sample type, or float precision of the samples read back
+            double tolerance = isFloat ? 1.0e-6 : Max(1.0e-6, 1.0 / ((uint64(1) << bits) - 1));
+            for (int c = 0; c < 3; c++)
+            {
+                TRT_CHECK_EQUAL(r.Pixel(0, 0, c), o.Pixel(0, 0, c));
+                TRT_CHECK_EQUAL(r.Pixel(1, 0, c), t.Pixel(1, 0, c));
+                TRT_CHECK_CLOSE(r.Pixel(2, 0, c), o.Pixel(2, 0, c) + 0.25 * (t.Pixel(2, 0, c) - o.Pixel(2, 0, c)), tolerance);
+                TRT_CHECK_EQUAL(r.Pixel(3, 0, c), o.Pixel(3, 0, c));
+            }
+        }
+}
+
+// Tiles the mask leaves out never reach the engine, and each output pixel blends the original and
+// the unmasked output by its mask weight, with either blend mode
+TRT_TEST(maskedProcessingSkipsTiles)
+{
+    FImage image = testImage(96, 64, 3);
+    FImage mask = leftMask();
+    for (pcl_enum blendMode : { TRTInferenceBlendMode::Weighted, TRTInferenceBlendMode::CenterCrop })
+    {
+        TRTProcessingSettings settings;
+        settings.tileOverlap = 0.25;
+        settings.blendMode = blendMode;
+
+        TRTTestBlurEngine engine(16, 2);
+        FImage unmasked = process(settings, engine, image, nullptr);
+        TRT_CHECK_EQUAL(engine.m_numInferences, 8 * 6);
+
+        TRTTestBlurEngine maskedEngine(16, 2);
+        FImage output = process(settings, maskedEngine, image, &mask);
+        TRT_CHECK_EQUAL(maskedEngine.m_numInferences, 3 * 6);
+        checkBlend(output, image, unmasked, mask);
+
+        // Masks are inverted before processing, as for a view with an inverted mask: all but the first
+        // column of tiles reach into the selection
+        FImage inverted(mask);
+        inverted.Invert();
+        TRTTestBlurEngine invertedEngine(16, 2);
+        output = process(settings, invertedEngine, image, &inverted);
+        TRT_CHECK_EQUAL(invertedEngine.m_numInferences, 7 * 6);
+        checkBlend(output, image, unmasked, inverted);
+
+        // A mask selecting nothing leaves the image as it is without running the engine
+        FImage empty(mask);
+        empty.Zero();
+        TRTTestBlurEngine idleEngine(16, 2);
+        output = process(settings, idleEngine, image, &empty);
+        TRT_CHECK_EQUAL(idleEngine.m_numInferences, 0);
+        TRT_CHECK(identical(output, image));
+    }
+}
+
+// A mask of the color channels applies to each channel on its own, but a tile is only skipped when
+// all of them leave it out
+TRT_TEST(maskedProcessingColorMask)
+{
+    FImage image = testImage(96, 64, 3);
+    FImage mask;
+    mask.AllocateData(96, 64, 3, ColorSpace::RGB);
+    mask.Zero();
+    for (int y = 0; y < mask.Height(); y++)
+        for (int x = 0; x < mask.Width(); x++)
+        {
+            mask.Pixel(x, y, 0) = (x < 10) ? 1.0f : 0.0f;
+            mask.Pixel(x, y, 2) = (x >= 90) ? 0.5f : 0.0f;
+        }
+
+    TRTProcessingSettings settings;
+    settings.tileOverlap = 0.25;
+    TRTTestBlurEngine engine(16, 2);
+    FImage unmasked = process(settings, engine, image, nullptr);
+    TRTTestBlurEngine maskedEngine(16, 2);
+    FImage output = process(settings, maskedEngine, image, &mask);
+    // Columns of tiles at x = 0 and 84 reach into the selection
+    TRT_CHECK_EQUAL(maskedEngine.m_numInferences, 2 * 6);
+    checkBlend(output, image, unmasked, mask);
+}
+
+// In same-size fast mode the mask is binned with the image, and tiles are skipped by the binned mask
+TRT_TEST(maskedProcessingBinned)
+{
+    FImage image = testImage(96, 64, 3);
+    FImage mask = leftMask();
+    TRTProcessingSettings settings;
+    settings.tileOverlap = 0.25;
+    settings.binInput = true;
+
+    TRTTestUpscaleEngine engine(16, 2);
+    FImage unmasked = process(settings, engine, image, nullptr);
+    // The binned image of 48 x 32 pixels takes 4 x 3 tiles
+    TRT_CHECK_EQUAL(engine.m_numInferences, 4 * 3);
+
+    // The selection ends at x = 15 in the binned mask, within the first two columns of tiles
+    TRTTestUpscaleEngine maskedEngine(16, 2);
+    FImage output = process(settings, maskedEngine, image, &mask);
+    TRT_CHECK_EQUAL(maskedEngine.m_numInferences, 2 * 3);
+    checkBlend(output, image, unmasked, mask);
+}
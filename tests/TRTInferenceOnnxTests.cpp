@@ -0,0 +1,96 @@
+#include <pcl/File.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../TRTInferenceOnnx.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+std::vector<float> readFloats(const String& path)
+{
+    ByteArray data = File::ReadFile(path);
+    std::vector<float> values(data.Length() / sizeof(float));
+    if (!values.empty())
+        ::memcpy(values.data(), data.Begin(), values.size() * sizeof(float));
+    return values;
+}
+
+// Runs the model of the test data on its stored input, and checks the output against the one ONNX
+// Runtime computed, with the engine threads given. Written by data/make_onnx_references.py, where
+// models with dynamic dimensions run on tiles of 16 pixels.
+std::vector<float> checkReference(const String& name, int numThreads = 0)
+{
+    String path = trtTestDataPath(name + ".onnx");
+    if (!File::Exists(path))
+        throw TRTTestSkipped{ "No test data at " + path };
+    TRTOnnxEngine engine(path, 16);
+    engine.setNumberOfThreads(numThreads);
+
+    std::vector<float> input = readFloats(trtTestDataPath(name + ".input"));
+    std::vector<float> expected = readFloats(trtTestDataPath(name + ".output"));
+    TRT_CHECK_EQUAL(input.size(), size_type(engine.getNumberOfPlanes()) * engine.getInputTileW() * engine.getInputTileH());
+    TRT_CHECK_EQUAL(expected.size(), size_type(engine.getNumberOfPlanes()) * engine.getOutputTileW() * engine.getOutputTileH());
+
+    ::memcpy(engine.getInputBuffer(), input.data(), input.size() * sizeof(float));
+    engine.runInference();
+    std::vector<float> output(engine.getOutputBuffer(), engine.getOutputBuffer() + expected.size());
+
+    // Sums in another order than ONNX Runtime differ in the last bits
+    double maxError = 0;
+    for (size_type i = 0; i < expected.size(); i++)
+        maxError = Max(maxError, std::abs(double(output[i]) - expected[i]) / Max(1.0, std::abs(double(expected[i]))));
+    if (maxError > 1e-5)
+        trtCheckFailed(__FILE__, __LINE__, name + String().Format(": relative error %.3g", maxError));
+    return output;
+}
+
+}	// namespace
+
+TRT_TEST(onnxGroupedDilatedConvolution)
+{
+    checkReference("conv_grouped");
+}
+
+TRT_TEST(onnxPRelu)
+{
+    checkReference("prelu");
+}
+
+TRT_TEST(onnxDepthToSpace)
+{
+    checkReference("depth_to_space_dcr");
+    checkReference("depth_to_space_crd");
+}
+
+TRT_TEST(onnxResize)
+{
+    for (const char* transform : { "half_pixel", "pytorch_half_pixel", "align_corners", "asymmetric" })
+    {
+        checkReference(String("resize_linear_") + transform);
+        checkReference(String("resize_nearest_") + transform);
+    }
+    checkReference("resize_nearest_tf_half_pixel_for_nn");
+    for (const char* nearestMode : { "floor", "ceil", "round_prefer_ceil" })
+        checkReference(String("resize_nearest_asymmetric_") + nearestMode);
+    checkReference("resize_linear_sizes");
+    checkReference("upsample_nearest");
+}
+
+// Constants per channel, scalar and of the whole tensor, as first or second operand
+TRT_TEST(onnxBroadcastArithmetic)
+{
+    checkReference("broadcast");
+}
+
+// A small upscaling network of dynamic dimensions, run on one thread and on all of them, which split
+// the work differently but compute every output sample the same way
+TRT_TEST(onnxUpscaler)
+{
+    std::vector<float> output = checkReference("upscaler", 1);
+    TRT_CHECK(checkReference("upscaler") == output);
+}
@@ -0,0 +1,169 @@
+#include <pcl/File.h>
+#include <pcl/FileFormat.h>
+#include <pcl/FileFormatInstance.h>
+
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#include "../TRTInferenceProcessing.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+void writeImage(const String& path, const ImageVariant& image)
+{
+    FileFormat format(File::ExtractExtension(path), false, true);
+    FileFormatInstance file(format);
+    if (!file.Create(path))
+        throw Error("Unable to create file: " + path);
+    ImageOptions options;
+    options.bitsPerSample = image.BitsPerSample();
+    options.ieeefpSampleFormat = image.IsFloatSample();
+    file.SetOptions(options);
+    if (!file.WriteImage(image))
+        throw Error("Unable to write file: " + path);
+    file.Close();
+}
+
+ImageVariant readImage(const String& path)
+{
+    FileFormat format(File::ExtractExtension(path), true, false);
+    FileFormatInstance file(format);
+    ImageDescriptionArray images;
+    if (!file.Open(images, path) || images.IsEmpty())
+        throw Error("Unable to open file: " + path);
+    ImageVariant image;
+    image.CreateImage(images[0].options.ieeefpSampleFormat, false, images[0].options.bitsPerSample);
+    if (!file.ReadImage(image))
+        throw Error("Unable to read file: " + path);
+    file.Close();
+    return image;
+}
+
+// Test image in the given sample format
+ImageVariant sampleImage(int w, int h, int numChannels, bool isFloat, int bitsPerSample)
+{
+    FImage samples = testImage(w, h, numChannels);
+    ImageVariant image;
+    image.CreateImage(isFloat, false, bitsPerSample);
+    image.CopyImage(ImageVariant(&samples));
+    return image;
+}
+
+// True if both images have the same geometry and sample format and bit-identical samples
+bool identicalSamples(const ImageVariant& a, const ImageVariant& b)
+{
+    if ((a.IsFloatSample() != b.IsFloatSample()) || (a.BitsPerSample() != b.BitsPerSample()) || (a.Width() != b.Width()) ||
+        (a.Height() != b.Height()) || (a.NumberOfChannels() != b.NumberOfChannels()))
+        return false;
+    bool same = true;
+    a.dispatch([&](const auto& image) {
+        const auto& other = static_cast<decltype(image)>(*b);
+        for (int c = 0; c < image.NumberOfChannels(); c++)
+            same = same && (::memcmp(image.PixelData(c), other.PixelData(c), image.NumberOfPixels() * (image.BitsPerSample() / 8)) == 0);
+    });
+    return same;
+}
+
+// Processes the image out of core through files, and in memory, with a fresh engine each, and checks
+// that both outputs are identical
+void checkOutOfCore(const TRTProcessingSettings& settings, const std::function<std::unique_ptr<TRTEngine>()>& makeEngine,
+                    const ImageVariant& image)
+{
+    String inputPath = trtTestTempPath("outofcore-in.raw");
+    String outputPath = trtTestTempPath("outofcore-out.raw");
+    try
+    {
+        writeImage(inputPath, image);
+        processFileOutOfCore(settings, *makeEngine(), inputPath, outputPath);
+        ImageVariant outOfCore = readImage(outputPath);
+
+        ImageVariant inMemory = readImage(inputPath);
+        processImage(settings, *makeEngine(), inMemory, nullptr, String());
+        TRT_CHECK(identicalSamples(outOfCore, inMemory));
+    }
+    catch (...)
+    {
+        File::Remove(inputPath);
+        if (File::Exists(outputPath))
+            File::Remove(outputPath);
+        throw;
+    }
+    File::Remove(inputPath);
+    File::Remove(outputPath);
+}
+
+}	// namespace
+
+// The output is the same as in memory with either blend mode, for rows of tiles overlapping band
+// boundaries, image heights which are not a multiple of the tile step, and outputs at the engine scale
+// or downsampled back
+TRT_TEST(outOfCoreMatchesInMemory)
+{
+    auto upscale = []() -> std::unique_ptr<TRTEngine> { return std::make_unique<TRTTestUpscaleEngine>(16, 2); };
+    auto blur = []() -> std::unique_ptr<TRTEngine> { return std::make_unique<TRTTestBlurEngine>(16, 2); };
+    for (pcl_enum blendMode : { TRTInferenceBlendMode::Weighted, TRTInferenceBlendMode::CenterCrop })
+        for (bool keepOutputDimension : { false, true })
+        {
+            TRTProcessingSettings settings;
+            settings.blendMode = blendMode;
+            settings.keepOutputDimension = keepOutputDimension;
+            settings.tuning.placementThreads = 2;
+            checkOutOfCore(settings, upscale, sampleImage(61, 45, 3, true, 32));
+            checkOutOfCore(settings, blur, sampleImage(50, 37, 3, false, 16));
+
+            // Tiles larger than the image, and a tile overlap leaving odd steps
+            settings.tileOverlap = 0.3;
+            checkOutOfCore(settings, upscale, sampleImage(13, 40, 3, false, 8));
+        }
+}
+
+// Mono images are processed as one plane by single-channel engines, or as the average of the output
+// planes of 3-channel engines
+TRT_TEST(outOfCoreMatchesInMemoryMono)
+{
+    TRTProcessingSettings settings;
+    settings.monoChannelAverage = true;
+    for (pcl_enum blendMode : { TRTInferenceBlendMode::Weighted, TRTInferenceBlendMode::CenterCrop })
+    {
+        settings.blendMode = blendMode;
+        checkOutOfCore(settings, []() -> std::unique_ptr<TRTEngine> { return std::make_unique<TRTTestBlurEngine>(16, 1, 1); },
+                       sampleImage(45, 29, 1, false, 16));
+        checkOutOfCore(settings, []() -> std::unique_ptr<TRTEngine> { return std::make_unique<TRTTestUpscaleEngine>(16, 2); },
+                       sampleImage(45, 29, 1, true, 32));
+    }
+}
+
+// Same-size fast mode needs the whole image, and a failed run leaves no output file behind
+TRT_TEST(outOfCoreFailures)
+{
+    String inputPath = trtTestTempPath("outofcore-fail-in.raw");
+    String outputPath = trtTestTempPath("outofcore-fail-out.raw");
+    writeImage(inputPath, sampleImage(40, 40, 3, true, 32));
+    try
+    {
+        TRTTestUpscaleEngine engine(16, 2);
+        TRTProcessingSettings settings;
+        settings.binInput = true;
+        TRT_CHECK_THROWS(processFileOutOfCore(settings, engine, inputPath, outputPath), "Same-size fast mode");
+
+        settings.binInput = false;
+        engine.m_onInference = [](int i) {
+            if (i == 5)
+                throw Error("Inference failed");
+        };
+        TRT_CHECK_THROWS(processFileOutOfCore(settings, engine, inputPath, outputPath), "Inference failed");
+        TRT_CHECK(!File::Exists(outputPath));
+    }
+    catch (...)
+    {
+        File::Remove(inputPath);
+        throw;
+    }
+    File::Remove(inputPath);
+}
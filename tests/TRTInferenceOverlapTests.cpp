@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "../TRTInferenceOverlap.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+const int s_tileSize = 32;
+
+// Overlaps sharing 2, 4, ... 16 pixels of 32 px tiles
+std::vector<double> evenOverlaps()
+{
+    std::vector<double> overlaps;
+    for (int shared = 16; shared >= 2; shared -= 2)
+        overlaps.push_back(shared / double(s_tileSize));
+    return overlaps;
+}
+
+TRTOverlapCandidate candidate(double overlap, double seamError)
+{
+    TRTOverlapCandidate c;
+    c.overlap = overlap;
+    c.seamError = seamError;
+    return c;
+}
+
+}	// namespace
+
+// A blur of radius r only differs from the blur of the whole image within r pixels of a tile border,
+// where it clamps. Center-crop placement puts the seam in the middle of the shared pixels and compares
+// the lines either side of it, so the seam is exact once tiles share 2r + 2 pixels, and the probe stops
+// at the first overlap that does.
+TRT_TEST(overlapProbeFindsReceptiveField)
+{
+    FImage input = testImage(160, 128, 3);
+    for (int radius : { 1, 3, 5 })
+    {
+        TRTTestBlurEngine engine(s_tileSize, radius);
+        std::vector<TRTOverlapCandidate> candidates = probeOverlaps(engine, input, 3, evenOverlaps(), 0.0);
+        int exactShared = 2 * radius + 2;
+        TRT_CHECK_EQUAL(candidates.size(), size_type(exactShared / 2));
+        for (size_type i = 0; i < candidates.size(); i++)
+        {
+            int shared = int(candidates[i].overlap * s_tileSize + 0.5);
+            TRT_CHECK_EQUAL(shared, 2 * int(i + 1));
+            TRT_CHECK_EQUAL(candidates[i].numTiles, tileCount(input.Width(), input.Height(), s_tileSize, s_tileSize, candidates[i].overlap));
+            if (shared < exactShared)
+                TRT_CHECK(candidates[i].seamError > 0);
+            else
+                TRT_CHECK_EQUAL(candidates[i].seamError, 0.0);
+        }
+
+        int selected = selectOverlap(candidates, 0.0);
+        TRT_CHECK_EQUAL(selected, int(candidates.size()) - 1);
+        TRT_CHECK_CLOSE(candidates[selected].overlap, exactShared / double(s_tileSize), 1e-12);
+    }
+}
+
+// The seam error shrinks as the shared pixels move away from the clamped borders, and a threshold
+// above it stops the probe sooner
+TRT_TEST(overlapProbeStopsAtThreshold)
+{
+    FImage input = testImage(160, 128, 3);
+    TRTTestBlurEngine engine(s_tileSize, 5);
+    std::vector<TRTOverlapCandidate> all = probeOverlaps(engine, input, 3, evenOverlaps(), 0.0);
+    TRT_CHECK_EQUAL(all.size(), size_type(6));
+    for (size_type i = 1; i < all.size(); i++)
+        TRT_CHECK(all[i].seamError < all[i - 1].seamError);
+
+    double threshold = (all[2].seamError + all[3].seamError) / 2;
+    std::vector<TRTOverlapCandidate> probed = probeOverlaps(engine, input, 3, evenOverlaps(), threshold);
+    TRT_CHECK_EQUAL(probed.size(), size_type(4));
+    TRT_CHECK_EQUAL(selectOverlap(probed, threshold), 3);
+}
+
+// Overlaps sharing fewer than two pixels are not probed, nor images too small for a pair of tiles
+TRT_TEST(overlapProbeSkipsUnusableOverlaps)
+{
+    TRTTestBlurEngine engine(s_tileSize, 1);
+    FImage input = testImage(160, 128, 3);
+    std::vector<TRTOverlapCandidate> candidates = probeOverlaps(engine, input, 3, { 0.0, 1.0 / s_tileSize, 0.125 }, 0.0);
+    TRT_CHECK_EQUAL(candidates.size(), size_type(1));
+    TRT_CHECK_EQUAL(candidates[0].overlap, 0.125);
+
+    TRT_CHECK(probeOverlaps(engine, input, 3, { 0.0, 1.0 }, 0.0).empty());
+    TRT_CHECK(probeOverlaps(engine, testImage(40, 40, 3), 3, { 0.125 }, 0.0).empty());
+}
+
+// The smallest overlap within the threshold, else the one of least error
+TRT_TEST(overlapSelection)
+{
+    TRT_CHECK_EQUAL(selectOverlap({}, 0.01), -1);
+    TRT_CHECK_EQUAL(selectOverlap({ candidate(0.25, 0.005), candidate(0.125, 0.008), candidate(0.5, 0.001) }, 0.01), 1);
+    TRT_CHECK_EQUAL(selectOverlap({ candidate(0.125, 0.05), candidate(0.25, 0.02), candidate(0.375, 0.03) }, 0.01), 1);
+    TRT_CHECK_EQUAL(selectOverlap({ candidate(0.125, 0.05), candidate(0.25, 0.009) }, 0.01), 1);
+}
@@ -0,0 +1,88 @@
+#include <pcl/File.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../TRTInferenceAutotune.h"
+#include "../TRTInferenceClient.h"
+#include "../TRTInferencePipeline.h"
+#include "../TRTInferenceProfile.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+// Layers of each stage are profiled under the number of their stage; a stage tiling the output of the
+// previous one reports once per tile of its own
+TRT_TEST(pipelineProfilesStages)
+{
+    // 16 px tiles upscaled 2x, then blurred in 16 px tiles overlapping by 4 px: 3x3 tiles per inference
+    std::vector<std::unique_ptr<TRTEngine>> stages;
+    stages.push_back(std::make_unique<TRTTestProfiledEngine>(16, 2));
+    stages.push_back(std::make_unique<TRTTestProfiledEngine>(16, 1));
+    TRTTestProfiledEngine* first = static_cast<TRTTestProfiledEngine*>(stages[0].get());
+    TRTTestProfiledEngine* second = static_cast<TRTTestProfiledEngine*>(stages[1].get());
+    TRTPipelineEngine pipeline(std::move(stages), 0.25);
+
+    TRTLayerProfile profile;
+    profileEngine(pipeline, testImage(48, 32, 3), 3, 4, profile);
+    TRT_CHECK(first->m_profile == nullptr);
+    TRT_CHECK(second->m_profile == nullptr);
+    TRT_CHECK_EQUAL(first->m_numProfiled, 4);
+    TRT_CHECK_EQUAL(second->m_numProfiled, 36);
+
+    TRT_CHECK_EQUAL(profile.layers().size(), size_type(4));
+    TRT_CHECK_EQUAL(profile.layers()[0].name, IsoString("1/conv"));
+    TRT_CHECK_EQUAL(profile.layers()[1].name, IsoString("1/upsample"));
+    TRT_CHECK_EQUAL(profile.layers()[2].name, IsoString("2/conv"));
+    TRT_CHECK_EQUAL(profile.layers()[0].times.size(), size_type(4));
+    TRT_CHECK_EQUAL(profile.layers()[2].times.size(), size_type(36));
+    TRT_CHECK_EQUAL(profile.sortedLayers().front()->name, IsoString("2/conv"));
+
+    // Later reports are not prefixed
+    profile.addLayerTime("other", 1.0f);
+    TRT_CHECK_EQUAL(profile.layers().back().name, IsoString("other"));
+}
+
+// A pipeline is only profiled if all of its stages can be, and none stays attached otherwise
+TRT_TEST(pipelineProfileNeedsAllStages)
+{
+    std::vector<std::unique_ptr<TRTEngine>> stages;
+    stages.push_back(std::make_unique<TRTTestProfiledEngine>(16, 2));
+    stages.push_back(std::make_unique<TRTTestUpscaleEngine>(32, 1));
+    TRTTestProfiledEngine* first = static_cast<TRTTestProfiledEngine*>(stages[0].get());
+    TRTPipelineEngine pipeline(std::move(stages), 0.25);
+
+    TRTLayerProfile profile;
+    TRT_CHECK(!pipeline.setLayerProfile(&profile));
+    TRT_CHECK(first->m_profile == nullptr);
+}
+
+// Tuning profiles are kept by the hash of the engine Execute opens: the engine itself without pipeline
+// engines, else the pipeline, on the devices of its stages
+TRT_TEST(pipelineTuningKeys)
+{
+    String path = trtTestDataPath("upscaler.onnx");
+    if (!File::Exists(path))
+        throw TRTTestSkipped{ "No test data at " + path };
+
+    std::unique_ptr<TRTEngine> engine = openEngine(path, false);
+    std::unique_ptr<TRTEngine> chain = openEngineChain(path, "", false, 0, 0, 0, 0.25);
+    TRT_CHECK_EQUAL(chain->getEngineHash(), engine->getEngineHash());
+
+    std::unique_ptr<TRTEngine> pipeline = openEngineChain(path, path, false, 0, 0, 0, 0.25);
+    TRT_CHECK(dynamic_cast<TRTPipelineEngine*>(pipeline.get()) != nullptr);
+    TRT_CHECK(pipeline->getEngineHash() != engine->getEngineHash());
+    TRT_CHECK(openEngineChain(path, path, false, 0, 0, 0, 0.125)->getEngineHash() != pipeline->getEngineHash());
+
+    String cpuKey = String().Format("cpu%d", int(std::thread::hardware_concurrency()));
+    TRT_CHECK_EQUAL(tuningDeviceKey(*engine), cpuKey);
+    TRT_CHECK_EQUAL(tuningDeviceKey(*pipeline), cpuKey);
+
+    // Stand-in engines are not run by this process as far as tuning is concerned
+    std::vector<std::unique_ptr<TRTEngine>> stages;
+    stages.push_back(std::make_unique<TRTTestUpscaleEngine>(16, 2));
+    stages.push_back(std::make_unique<TRTTestUpscaleEngine>(32, 1));
+    TRT_CHECK(tuningDeviceKey(TRTPipelineEngine(std::move(stages), 0.25)).IsEmpty());
+}
@@ -0,0 +1,80 @@
+#include "../TRTInferencePreview.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+// Large previews start with a coarse pass, small ones and refinements infer the image as shown
+TRT_TEST(previewCoarseFactor)
+{
+    TRT_CHECK_EQUAL(TRTPreviewPass::coarseFactorFor(1024, 300, false), 4);
+    TRT_CHECK_EQUAL(TRTPreviewPass::coarseFactorFor(300, 513, false), 4);
+    TRT_CHECK_EQUAL(TRTPreviewPass::coarseFactorFor(512, 512, false), 1);
+    TRT_CHECK_EQUAL(TRTPreviewPass::coarseFactorFor(1024, 300, true), 1);
+}
+
+// A pass infers exactly the tiles covering the preview image, or the binned image of a coarse pass
+TRT_TEST(previewPassInfersVisibleTiles)
+{
+    FImage image = testImage(300, 200, 3);
+    for (int coarseFactor : { 1, 4 })
+    {
+        TRTTestUpscaleEngine engine(64, 1);
+        TRTPreviewPass pass(engine, 0.25, true, coarseFactor);
+        TRT_CHECK(pass.infer(image));
+        int w = (300 + coarseFactor - 1) / coarseFactor;
+        int h = (200 + coarseFactor - 1) / coarseFactor;
+        int numTiles = int(previewTiles(w, h, 64, 64, 0.25).Length());
+        TRT_CHECK_EQUAL(engine.m_numInferences, numTiles);
+        TRT_CHECK_EQUAL(pass.numInferredTiles(), numTiles);
+        TRT_CHECK_EQUAL(pass.accumulator().Width(), w);
+        TRT_CHECK_EQUAL(pass.accumulator().Height(), h);
+    }
+    TRT_CHECK_EQUAL(int(previewTiles(300, 200, 64, 64, 0.25).Length()), 7 * 5);
+    TRT_CHECK_EQUAL(int(previewTiles(75, 50, 64, 64, 0.25).Length()), 2 * 2);
+}
+
+// The accumulator of a center-crop pass of the identity engine is the preview image itself, and a
+// weighted pass normalizes back to it
+TRT_TEST(previewPassOutput)
+{
+    FImage image = testImage(130, 90, 3);
+    TRTTestUpscaleEngine engine(48, 1);
+    TRTPreviewPass crop(engine, 0.25, true, 1);
+    TRT_CHECK(crop.infer(image));
+    TRT_CHECK(crop.weight() == nullptr);
+    TRT_CHECK(identical(crop.accumulator(), image));
+
+    TRTPreviewPass weighted(engine, 0.25, false, 1);
+    TRT_CHECK(weighted.infer(image));
+    TRT_CHECK(weighted.weight() != nullptr);
+    const FImage& a = weighted.accumulator();
+    const FImage& w = *weighted.weight();
+    for (int c = 0; c < 3; c++)
+        for (int y = 0; y < 90; y++)
+            for (int x = 0; x < 130; x++)
+                TRT_CHECK_CLOSE(a.Pixel(x, y, c) / w.Pixel(x, y), image.Pixel(x, y, c), 1e-5);
+}
+
+// Cancelling stops the pass before its next tile, from within an inference as from another thread
+TRT_TEST(previewPassCancellation)
+{
+    FImage image = testImage(300, 200, 1);
+    TRTTestUpscaleEngine engine(32, 1, 1);
+    TRTPreviewPass pass(engine, 0, true, 1);
+    engine.m_onInference = [&](int n) {
+        if (n == 2)
+            pass.cancel();
+    };
+    TRT_CHECK(!pass.infer(image));
+    TRT_CHECK(pass.isCancelled());
+    TRT_CHECK_EQUAL(engine.m_numInferences, 3);
+    TRT_CHECK_EQUAL(pass.numInferredTiles(), 3);
+
+    // Cancelled before it starts, a pass infers nothing
+    TRTTestUpscaleEngine idle(32, 1, 1);
+    TRTPreviewPass cancelled(idle, 0, true, 1);
+    cancelled.cancel();
+    TRT_CHECK(!cancelled.infer(image));
+    TRT_CHECK_EQUAL(idle.m_numInferences, 0);
+}
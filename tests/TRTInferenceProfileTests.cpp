@@ -0,0 +1,107 @@
+#include <vector>
+
+#include "../TRTInferenceProfile.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+TRTLayerProfile::Layer layer(const std::vector<float>& times)
+{
+    TRTLayerProfile::Layer l;
+    l.name = "layer";
+    l.times = times;
+    return l;
+}
+
+}	// namespace
+
+TRT_TEST(profileMedian)
+{
+    TRT_CHECK_EQUAL(layer({}).medianMs(), 0.0);
+    TRT_CHECK_EQUAL(layer({ 4.0f }).medianMs(), 4.0);
+    TRT_CHECK_EQUAL(layer({ 3.0f, 1.0f, 2.0f }).medianMs(), 2.0);
+    TRT_CHECK_EQUAL(layer({ 4.0f, 1.0f, 3.0f, 2.0f }).medianMs(), 2.5);
+    TRT_CHECK_EQUAL(layer({ 5.0f, 5.0f, 1.0f, 9.0f, 5.0f }).medianMs(), 5.0);
+    TRT_CHECK_EQUAL(layer({ 1.0f, 2.0f, 3.0f, 4.0f }).totalMs(), 10.0);
+}
+
+// Layers sort by decreasing total time; layers of equal time keep the order of their first report
+TRT_TEST(profileOrdersLayersStably)
+{
+    TRTLayerProfile profile;
+    for (int run = 0; run < 2; run++)
+    {
+        profile.addLayerTime("a", 1.0f);
+        profile.addLayerTime("b", 2.0f);
+        profile.addLayerTime("c", 1.0f);
+        profile.addLayerTime("d", 2.0f);
+        profile.addLayerTime("e", 0.5f);
+    }
+    profile.addLayerTime("f", 2.0f);
+
+    TRT_CHECK_EQUAL(profile.layers().size(), size_type(6));
+    TRT_CHECK_EQUAL(profile.layers()[5].name, IsoString("f"));
+    IsoString order;
+    for (const TRTLayerProfile::Layer* l : profile.sortedLayers())
+        order << l->name;
+    TRT_CHECK_EQUAL(order, IsoString("bdacfe"));
+    TRT_CHECK_EQUAL(profile.totalMs(), 15.0);
+}
+
+// Runs count the most reports of any layer, as layers skipped by an inference report nothing
+TRT_TEST(profileCountsRuns)
+{
+    TRTLayerProfile profile;
+    TRT_CHECK_EQUAL(profile.numRuns(), 0);
+    TRT_CHECK_EQUAL(profile.toJSON(), IsoString("[\n  { \"count\" : 0 }\n]\n"));
+    TRT_CHECK(profile.formatTable().StartsWith("Layer times over 0 inferences:"));
+
+    for (int run = 0; run < 3; run++)
+    {
+        profile.addLayerTime("always", 1.0f);
+        if (run == 1)
+            profile.addLayerTime("sometimes", 3.0f);
+    }
+    TRT_CHECK_EQUAL(profile.numRuns(), 3);
+    TRT_CHECK(profile.formatTable().StartsWith("Layer times over 3 inferences:"));
+    TRT_CHECK(profile.formatTable().Contains("       3.000       1.0000       3.0000     50.0   sometimes\n"));
+}
+
+// Layer names are JSON strings: quotes, backslashes and control characters are escaped, other
+// characters, UTF-8 included, are kept
+TRT_TEST(profileJSON)
+{
+    TRTLayerProfile profile;
+    profile.addLayerTime("conv \"3x3\"\\relu\n\t\x01 \xc3\xa9", 3.0f);
+    profile.addLayerTime("[pad]", 1.0f);
+    profile.addLayerTime("[pad]", 2.0f);
+    TRT_CHECK_EQUAL(profile.toJSON(),
+                    IsoString("[\n"
+                              "  { \"count\" : 2 },\n"
+                              "  { \"name\" : \"conv \\\"3x3\\\"\\\\relu\\u000a\\u0009\\u0001 \xc3\xa9\", \"timeMs\" : 3.000000, "
+                              "\"averageMs\" : 1.500000, \"medianMs\" : 3.000000, \"percentage\" : 50.0000 },\n"
+                              "  { \"name\" : \"[pad]\", \"timeMs\" : 3.000000, \"averageMs\" : 1.500000, \"medianMs\" : 1.500000, "
+                              "\"percentage\" : 50.0000 }\n"
+                              "]\n"));
+}
+
+// The first inference, which includes one-time initialization, is not profiled, and the profile is
+// detached afterwards
+TRT_TEST(profileEngineSkipsWarmUp)
+{
+    TRTTestProfiledEngine engine(16, 2);
+    TRTLayerProfile profile;
+    profileEngine(engine, testImage(40, 20, 3), 3, 5, profile);
+    TRT_CHECK_EQUAL(engine.m_numInferences, 6);
+    TRT_CHECK_EQUAL(engine.m_numProfiled, 5);
+    TRT_CHECK(engine.m_profile == nullptr);
+    TRT_CHECK_EQUAL(profile.numRuns(), 5);
+    TRT_CHECK_EQUAL(profile.sortedLayers().front()->name, IsoString("conv"));
+
+    TRTTestUpscaleEngine unprofiled(16, 2);
+    TRT_CHECK_THROWS(profileEngine(unprofiled, testImage(40, 20, 3), 3, 5, profile), "only available for TensorRT engines");
+}
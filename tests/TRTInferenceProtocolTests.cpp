@@ -0,0 +1,182 @@
+#include <pcl/Compression.h>
+
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../TRTInferenceProtocol.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+// Both ends of a connection over a Unix-domain socket
+struct SocketPair
+{
+    TRTSocket client;
+    TRTSocket server;
+
+    SocketPair()
+    {
+        String path = trtTestTempPath("protocol.sock");
+        TRTSocket listener = TRTSocket::listen(path);
+        client = TRTSocket::connect(path);
+        server = listener.accept();
+    }
+};
+
+// Sends on a thread of its own, so that transfers larger than the socket buffers do not block
+void sendWhile(const std::function<void()>& send, const std::function<void()>& receive)
+{
+    std::thread sender(send);
+    try
+    {
+        receive();
+    }
+    catch (...)
+    {
+        sender.join();
+        throw;
+    }
+    sender.join();
+}
+
+std::vector<float> smoothTile(size_type count)
+{
+    std::vector<float> tile(count);
+    for (size_type i = 0; i < count; i++)
+        tile[i] = 0.25f + 0.5f * float(i % 509) / 509;
+    return tile;
+}
+
+// Random bit patterns, which do not compress even with byte shuffling
+std::vector<float> noiseTile(size_type count)
+{
+    std::vector<float> tile(count);
+    uint64 state = 12345;
+    for (size_type i = 0; i < count; i++)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint32 bits = uint32(state >> 32);
+        ::memcpy(&tile[i], &bits, sizeof(bits));
+    }
+    return tile;
+}
+
+// Bitwise, since noise tiles hold NaNs
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b)
+{
+    return (a.size() == b.size()) && (::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+}
+
+}	// namespace
+
+// Requests and replies arrive whole, however the stream splits them, and a closed connection is a
+// connection error
+TRT_TEST(protocolFramesMessages)
+{
+    SocketPair sockets;
+    TRTRequest request = {};
+    request.magic = TRTProtocolMagic;
+    request.type = TRTRequestType::InferTile;
+    request.numPlanes = 3;
+    std::vector<uint8> payload(3 << 20);
+    for (size_type i = 0; i < payload.size(); i++)
+        payload[i] = uint8(i * 7 + (i >> 11));
+
+    TRTRequest received;
+    std::vector<uint8> receivedPayload(payload.size());
+    sendWhile(
+        [&] {
+            sockets.client.send(&request, sizeof(request));
+            sockets.client.send(payload.data(), payload.size());
+        },
+        [&] {
+            sockets.server.receive(&received, sizeof(received));
+            sockets.server.receive(receivedPayload.data(), receivedPayload.size());
+        });
+    TRT_CHECK_EQUAL(received.magic, TRTProtocolMagic);
+    TRT_CHECK_EQUAL(received.type, uint32(TRTRequestType::InferTile));
+    TRT_CHECK_EQUAL(received.numPlanes, 3);
+    TRT_CHECK(receivedPayload == payload);
+
+    sockets.client = TRTSocket();
+    TRTReply reply;
+    TRT_CHECK_THROWS(sockets.server.receive(&reply, sizeof(reply)), "Connection to the inference server lost");
+}
+
+// A socket file left behind by a listener is replaced, but one a listener still answers at is not
+TRT_TEST(protocolListenReplacesStaleSockets)
+{
+    String path = trtTestTempPath("listen.sock");
+    {
+        TRTSocket listener = TRTSocket::listen(path);
+        TRT_CHECK_THROWS(TRTSocket::listen(path), "already listening");
+        TRTSocket client = TRTSocket::connect(path);
+        TRT_CHECK(listener.accept().isValid());
+    }
+    TRT_CHECK_THROWS(TRTSocket::connect(path), "No inference server is listening");
+    TRTSocket listener = TRTSocket::listen(path);
+    TRTSocket client = TRTSocket::connect(path);
+    TRT_CHECK(listener.accept().isValid());
+}
+
+// Tiles arrive bit for bit, compressed with byte shuffling over one or several subblocks, or raw when
+// they do not compress
+TRT_TEST(protocolTileRoundTrip)
+{
+    SocketPair sockets;
+    for (size_type count : { size_type(1), size_type(64 * 64 * 3), size_type(512 * 512 * 3) })
+        for (bool noise : { false, true })
+        {
+            std::vector<float> tile = noise ? noiseTile(count) : smoothTile(count);
+            if (noise && (count > 1))
+            {
+                // Noise takes the raw path
+                LZ4Compression compression;
+                compression.EnableByteShuffling();
+                compression.SetItemSize(sizeof(float));
+                TRT_CHECK(compression.Compress(tile.data(), count * sizeof(float)).IsEmpty());
+            }
+            std::vector<float> received(count, -1.0f);
+            sendWhile([&] { sockets.client.sendTile(tile.data(), count); },
+                      [&] { sockets.server.receiveTile(received.data(), count); });
+            TRT_CHECK(sameBits(received, tile));
+        }
+}
+
+// A compressed tile of another size than expected is rejected
+TRT_TEST(protocolRejectsTileSizeMismatch)
+{
+    SocketPair sockets;
+    std::vector<float> tile = smoothTile(64 * 64);
+    std::vector<float> received(64 * 64 + 1);
+    TRT_CHECK_THROWS(sendWhile([&] { sockets.client.sendTile(tile.data(), tile.size()); },
+                               [&] { sockets.server.receiveTile(received.data(), received.size()); }),
+                     "Tile size mismatch");
+}
+
+// Announced subblock counts and sizes beyond the expected tile are rejected before anything is
+// allocated for them
+TRT_TEST(protocolRejectsOversizedTiles)
+{
+    SocketPair sockets;
+    std::vector<float> received(64 * 64);
+    uint32 tooManySubblocks = 0xffffffffu;
+    sockets.client.send(&tooManySubblocks, sizeof(tooManySubblocks));
+    TRT_CHECK_THROWS(sockets.server.receiveTile(received.data(), received.size()), "Tile size mismatch");
+
+    uint32 numSubblocks = 1;
+    uint64 tooLarge[] = { uint64(received.size() * sizeof(float) + 1), 16 };
+    sockets.client.send(&numSubblocks, sizeof(numSubblocks));
+    sockets.client.send(tooLarge, sizeof(tooLarge));
+    TRT_CHECK_THROWS(sockets.server.receiveTile(received.data(), received.size()), "Tile size mismatch");
+
+    uint64 hugeCompressed[] = { uint64(received.size() * sizeof(float)), uint64(1) << 40 };
+    sockets.client.send(&numSubblocks, sizeof(numSubblocks));
+    sockets.client.send(hugeCompressed, sizeof(hugeCompressed));
+    TRT_CHECK_THROWS(sockets.server.receiveTile(received.data(), received.size()), "Corrupted tile data");
+}
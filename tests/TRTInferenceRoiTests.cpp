@@ -0,0 +1,61 @@
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+// Runs an engine over the context region of an ROI and writes the ROI back to a copy of the image, as
+// ExecuteOn does with a region of interest
+static FImage inferRegion(TRTEngine& engine, const FImage& image, const Rect& roi, int marginX, int marginY, double tileOverlap)
+{
+    Rect context = contextRegion(roi, marginX, marginY, image.Width(), image.Height());
+    FImage region;
+    region.Assign(image, context);
+    FImage processed = inferCenterCrop(engine, region, tileOverlap);
+    FImage view(image);
+    view.Apply(processed, ImageOp::Mov, roi.LeftTop(), -1, roi.MovedBy(-context.x0, -context.y0));
+    return view;
+}
+
+// The context region extends the ROI by the margins and stops at the image edges
+TRT_TEST(contextRegionClipsToImage)
+{
+    TRT_CHECK(contextRegion(Rect(40, 30, 60, 50), 8, 5, 100, 80) == Rect(32, 25, 68, 55));
+    TRT_CHECK(contextRegion(Rect(3, 2, 97, 79), 8, 5, 100, 80) == Rect(0, 0, 100, 80));
+    TRT_CHECK(contextRegion(Rect(0, 0, 100, 80), 8, 5, 100, 80) == Rect(0, 0, 100, 80));
+    TRT_CHECK(contextRegion(Rect(10, 10, 20, 20), 0, 0, 100, 80) == Rect(10, 10, 20, 20));
+}
+
+// With a margin covering the receptive field, ROI execution reproduces a full execution inside the ROI
+// exactly, and leaves every pixel outside the ROI untouched
+TRT_TEST(roiExecutionMatchesFullExecution)
+{
+    FImage input = testImage(150, 110, 3);
+    TRTTestBlurEngine engine(32, 3);
+    FImage full = inferCenterCrop(engine, input, 0.25);
+
+    const Rect rois[] = { Rect(40, 30, 90, 70), Rect(0, 0, 37, 21), Rect(120, 95, 150, 110), Rect(1, 50, 149, 51) };
+    for (const Rect& roi : rois)
+    {
+        FImage view = inferRegion(engine, input, roi, engine.getContextMarginX(), engine.getContextMarginY(), 0.25);
+        for (int c = 0; c < 3; c++)
+            for (int y = 0; y < input.Height(); y++)
+                for (int x = 0; x < input.Width(); x++)
+                {
+                    float expected = roi.Includes(Point(x, y)) ? full.Pixel(x, y, c) : input.Pixel(x, y, c);
+                    TRT_CHECK_EQUAL(view.Pixel(x, y, c), expected);
+                }
+    }
+}
+
+// Without context the engine sees replicated edges at the ROI border, so the border differs
+TRT_TEST(roiExecutionNeedsContext)
+{
+    FImage input = testImage(150, 110, 1, 3);
+    TRTTestBlurEngine engine(32, 3, 1);
+    FImage full = inferCenterCrop(engine, input, 0.25);
+    Rect roi(40, 30, 90, 70);
+    FImage view = inferRegion(engine, input, roi, 0, 0, 0.25);
+    TRT_CHECK(view.Pixel(roi.x0, roi.y0 + 10) != full.Pixel(roi.x0, roi.y0 + 10));
+    TRT_CHECK_EQUAL(view.Pixel(roi.x0 + 10, roi.y0 + 10), full.Pixel(roi.x0 + 10, roi.y0 + 10));
+}
@@ -0,0 +1,39 @@
+#include <pcl/File.h>
+
+#include "../TRTInferenceEngine.h"
+#include "../TRTInferenceRuntime.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+// Without the TensorRT and CUDA libraries, the runtime reports that there is no backend instead of
+// failing to load, and keeps reporting it; engines that need it fail with the same explanation. The
+// test executable links no TensorRT or CUDA library, as the module, so it starts on any machine.
+TRT_TEST(runtimeWithoutBackend)
+{
+    String description;
+    if (trtRuntimeState(description) == TRTRuntimeState::NotLoaded)
+        TRT_CHECK(description.Contains("loaded at first use"));
+
+    try
+    {
+        trtRuntime();
+        throw TRTTestSkipped{ "A TensorRT runtime is installed on this machine." };
+    }
+    catch (const Error&)
+    {
+    }
+
+    TRT_CHECK_EQUAL(trtRuntimeState(description), int(TRTRuntimeState::Unavailable));
+    TRT_CHECK(description.StartsWith("No inference backend"));
+    TRT_CHECK(description.Contains("could be loaded"));
+    TRT_CHECK_THROWS(trtRuntime(), "No inference backend");
+
+    String enginePath = trtTestTempPath("model.engine");
+    File::WriteFile(enginePath, ByteArray(size_type(64), uint8(0)));
+    TRT_CHECK_THROWS(openLocalEngine(enginePath), "No inference backend");
+    File::Remove(enginePath);
+
+    TRTDeviceBuffer buffer;
+    TRT_CHECK_THROWS(buffer.resize(1024), "No inference backend");
+}
@@ -0,0 +1,115 @@
+#ifndef __TRTInferenceTest_h
+#define __TRTInferenceTest_h
+
+#include <pcl/Exception.h>
+#include <pcl/String.h>
+
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+namespace pcl
+{
+
+// A test case of the module, registered at static initialization by TRT_TEST
+struct TRTTestCase
+{
+    const char* name;
+    void (*function)();
+};
+
+struct TRTTestRegistration
+{
+    TRTTestRegistration(const char* name, void (*function)());
+};
+
+// Thrown by a failed check, ending the test case
+struct TRTTestFailure
+{
+    String message;
+};
+
+// Thrown to skip a test case that cannot run on this machine
+struct TRTTestSkipped
+{
+    String reason;
+};
+
+[[noreturn]] void trtCheckFailed(const char* file, int line, const String& what);
+
+// Path of a file in the test data directory
+String trtTestDataPath(const String& name);
+
+// Path of the inference server executable
+String trtTestServerPath();
+
+// Path of a scratch file in the system temporary directory, unique to this test run
+String trtTestTempPath(const String& name);
+
+template <typename T>
+String trtDescribe(const T& value)
+{
+    if constexpr (std::is_same<T, bool>::value)
+        return value ? "true" : "false";
+    else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value)
+        return String().Format("%lld", static_cast<long long>(value));
+    else if constexpr (std::is_floating_point<T>::value)
+        return String().Format("%.9g", double(value));
+    else if constexpr (std::is_convertible<T, String>::value)
+        return '"' + String(value) + '"';
+    else
+        return "<value>";
+}
+
+}	// namespace pcl
+
+#define TRT_TEST(name) \
+    static void name(); \
+    static pcl::TRTTestRegistration name##_registration(#name, name); \
+    static void name()
+
+#define TRT_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+            pcl::trtCheckFailed(__FILE__, __LINE__, #condition); \
+    } while (false)
+
+#define TRT_CHECK_EQUAL(actual, expected) \
+    do \
+    { \
+        auto a_ = (actual); \
+        auto e_ = (expected); \
+        if (!(a_ == e_)) \
+            pcl::trtCheckFailed(__FILE__, __LINE__, pcl::String(#actual " == " #expected ": ") + pcl::trtDescribe(a_) + " != " + pcl::trtDescribe(e_)); \
+    } while (false)
+
+#define TRT_CHECK_CLOSE(actual, expected, tolerance) \
+    do \
+    { \
+        double a_ = double(actual); \
+        double e_ = double(expected); \
+        if (!(std::abs(a_ - e_) <= double(tolerance))) \
+            pcl::trtCheckFailed(__FILE__, __LINE__, pcl::String(#actual " ~ " #expected ": ") + pcl::trtDescribe(a_) + " != " + pcl::trtDescribe(e_)); \
+    } while (false)
+
+// Checks that statement throws Error with a message containing text
+#define TRT_CHECK_THROWS(statement, text) \
+    do \
+    { \
+        bool thrown_ = false; \
+        try \
+        { \
+            statement; \
+        } \
+        catch (const pcl::Error& x) \
+        { \
+            thrown_ = true; \
+            if (!x.Message().Has(pcl::String(text))) \
+                pcl::trtCheckFailed(__FILE__, __LINE__, pcl::String(#statement " threw: ") + x.Message()); \
+        } \
+        if (!thrown_) \
+            pcl::trtCheckFailed(__FILE__, __LINE__, pcl::String(#statement " did not throw")); \
+    } while (false)
+
+#endif	// __TRTInferenceTest_h
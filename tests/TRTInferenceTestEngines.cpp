@@ -0,0 +1,206 @@
+#include "../TRTInferenceProfile.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTestEngines.h"
+
+namespace pcl
+{
+
+TRTTestEngine::TRTTestEngine(int tileW, int tileH, int factor, int numChannels)
+{
+    m_inputTileW = tileW;
+    m_inputTileH = tileH;
+    m_outputTileW = tileW * factor;
+    m_outputTileH = tileH * factor;
+    m_numChannels = numChannels;
+    setNumberOfPlanes(numChannels);
+}
+
+void TRTTestEngine::setNumberOfPlanes(int32_t numPlanes)
+{
+    m_numPlanes = numPlanes;
+    m_input.resize(size_type(numPlanes) * m_inputTileW * m_inputTileH);
+    m_output.resize(size_type(numPlanes) * m_outputTileW * m_outputTileH);
+}
+
+void TRTTestEngine::runInference()
+{
+    if (m_onInference)
+        m_onInference(m_numInferences);
+    m_numInferences++;
+    for (int c = 0; c < m_numPlanes; c++)
+        inferPlane(m_input.data() + size_type(c) * m_inputTileW * m_inputTileH, m_output.data() + size_type(c) * m_outputTileW * m_outputTileH);
+}
+
+TRTTestUpscaleEngine::TRTTestUpscaleEngine(int tileSize, int factor, int numChannels)
+    : TRTTestEngine(tileSize, tileSize, factor, numChannels)
+    , m_factor(factor)
+{
+    m_engineHash = 0x7570736361000000ull + uint64(factor);
+}
+
+void TRTTestUpscaleEngine::inferPlane(const float* input, float* output) const
+{
+    upscaleTile(input, m_inputTileW, m_inputTileH, 1, m_factor, m_factor, output);
+}
+
+TRTTestBlurEngine::TRTTestBlurEngine(int tileSize, int radius, int numChannels)
+    : TRTTestEngine(tileSize, tileSize, 1, numChannels)
+    , m_radius(radius)
+{
+    m_engineHash = 0x626c757200000000ull + uint64(radius);
+}
+
+void TRTTestBlurEngine::inferPlane(const float* input, float* output) const
+{
+    int w = m_inputTileW;
+    int h = m_inputTileH;
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+        {
+            float sum = 0;
+            for (int dy = -m_radius; dy <= m_radius; dy++)
+                for (int dx = -m_radius; dx <= m_radius; dx++)
+                    sum += input[Range(y + dy, 0, h - 1) * w + Range(x + dx, 0, w - 1)];
+            output[y * w + x] = sum / ((2 * m_radius + 1) * (2 * m_radius + 1));
+        }
+}
+
+TRTTestProfiledEngine::TRTTestProfiledEngine(int tileSize, int factor, int numChannels)
+    : TRTTestUpscaleEngine(tileSize, factor, numChannels)
+{
+}
+
+void TRTTestProfiledEngine::runInference()
+{
+    TRTTestUpscaleEngine::runInference();
+    if (m_profile != nullptr)
+    {
+        m_profile->addLayerTime("conv", 2.0f);
+        m_profile->addLayerTime("upsample", 0.5f);
+        m_numProfiled++;
+    }
+}
+
+FImage testImage(int w, int h, int numChannels, uint32 seed)
+{
+    FImage image;
+    image.AllocateData(w, h, numChannels, (numChannels == 3) ? ColorSpace::RGB : ColorSpace::Gray);
+    uint32 state = seed * 2654435761u + 1;
+    for (int c = 0; c < numChannels; c++)
+        for (int y = 0; y < h; y++)
+        {
+            float* row = image.ScanLine(y, c);
+            for (int x = 0; x < w; x++)
+            {
+                state = state * 1664525u + 1013904223u;
+                float noise = float(state >> 8) / float(1 << 24);
+                row[x] = 0.1f + 0.5f * float(x + 2 * y + 7 * c) / (w + 2 * h + 14) + 0.2f * noise;
+            }
+        }
+    return image;
+}
+
+// Tile positions of the plan processImage uses for an overlap
+static void tileSteps(const TRTEngine& engine, double tileOverlap, int& stepX, int& stepY)
+{
+    stepX = engine.getInputTileW() * (1.0f - tileOverlap);
+    stepY = engine.getInputTileH() * (1.0f - tileOverlap);
+}
+
+FImage inferWeighted(TRTEngine& engine, const FImage& input, double tileOverlap, pcl_enum order, int bandRows)
+{
+    int factorW = engine.getOutputTileW() / engine.getInputTileW();
+    int factorH = engine.getOutputTileH() / engine.getInputTileH();
+    int numPlanes = input.NumberOfChannels();
+    engine.setNumberOfPlanes(numPlanes);
+
+    FImage accumulator, weight;
+    accumulator.AllocateData(input.Width() * factorW, input.Height() * factorH, numPlanes, input.ColorSpace());
+    accumulator.Zero();
+    weight.AllocateData(accumulator.Width(), accumulator.Height());
+    weight.Zero();
+
+    int stepX, stepY;
+    tileSteps(engine, tileOverlap, stepX, stepY);
+    int numColumns = (input.Width() + stepX - 1) / stepX;
+    int numRows = (input.Height() + stepY - 1) / stepY;
+    for (const Point& tile : tileOrder(order, numColumns, numRows, bandRows))
+    {
+        int x = tile.x * stepX;
+        int y = tile.y * stepY;
+        extractTile(input, Point(x, y), engine.getInputTileW(), engine.getInputTileH(), numPlanes, engine.getInputBuffer());
+        engine.runInference();
+        accumulateTile(engine.getOutputBuffer(), engine.getOutputTileW(), engine.getOutputTileH(), numPlanes,
+                       Point(x * factorW, y * factorH), accumulator, weight);
+    }
+
+    normalizeWeighted(accumulator, weight);
+    return accumulator;
+}
+
+void normalizeWeighted(FImage& accumulator, const FImage& weight)
+{
+    for (int c = 0; c < accumulator.NumberOfChannels(); c++)
+        for (int y = 0; y < accumulator.Height(); y++)
+        {
+            float* a = accumulator.ScanLine(y, c);
+            const float* w = weight.ScanLine(y);
+            for (int x = 0; x < accumulator.Width(); x++)
+            {
+                float f = a[x] * ((w[x] > 0.0f) ? 1.0f / w[x] : 0.0f);
+                a[x] = (f < 0.0f) ? 0.0f : ((f > 1.0f) ? 1.0f : f);
+            }
+        }
+}
+
+FImage inferCenterCrop(TRTEngine& engine, const FImage& input, double tileOverlap, int numThreads)
+{
+    int factorW = engine.getOutputTileW() / engine.getInputTileW();
+    int factorH = engine.getOutputTileH() / engine.getInputTileH();
+    int numPlanes = input.NumberOfChannels();
+    engine.setNumberOfPlanes(numPlanes);
+
+    FImage output;
+    output.AllocateData(input.Width() * factorW, input.Height() * factorH, numPlanes, input.ColorSpace());
+
+    int stepX, stepY;
+    tileSteps(engine, tileOverlap, stepX, stepY);
+    TRTTilePlacer placer(output, engine.getOutputTileW(), engine.getOutputTileH(), numPlanes, numThreads);
+    for (int y = 0; y < input.Height(); y += stepY)
+        for (int x = 0; x < input.Width(); x += stepX)
+        {
+            extractTile(input, Point(x, y), engine.getInputTileW(), engine.getInputTileH(), numPlanes, engine.getInputBuffer());
+            engine.runInference();
+            Rect rect = cropRegion(Point(x, y), engine.getInputTileW(), engine.getInputTileH(), stepX, stepY, input.Width(), input.Height());
+            placer.place(engine.getOutputBuffer(), Point(x * factorW, y * factorH),
+                         Rect(rect.x0 * factorW, rect.y0 * factorH, rect.x1 * factorW, rect.y1 * factorH));
+        }
+    placer.wait();
+    return output;
+}
+
+double maxDifference(const FImage& a, const FImage& b)
+{
+    double d = 0;
+    for (int c = 0; c < a.NumberOfChannels(); c++)
+        for (int y = 0; y < a.Height(); y++)
+        {
+            const float* p = a.ScanLine(y, c);
+            const float* q = b.ScanLine(y, c);
+            for (int x = 0; x < a.Width(); x++)
+                d = Max(d, double(Abs(p[x] - q[x])));
+        }
+    return d;
+}
+
+bool identical(const FImage& a, const FImage& b)
+{
+    if ((a.Width() != b.Width()) || (a.Height() != b.Height()) || (a.NumberOfChannels() != b.NumberOfChannels()))
+        return false;
+    for (int c = 0; c < a.NumberOfChannels(); c++)
+        if (::memcmp(a.PixelData(c), b.PixelData(c), a.NumberOfPixels() * sizeof(float)) != 0)
+            return false;
+    return true;
+}
+
+}	// namespace pcl
@@ -0,0 +1,128 @@
+#ifndef __TRTInferenceTestEngines_h
+#define __TRTInferenceTestEngines_h
+
+#include <pcl/Image.h>
+
+#include <functional>
+#include <vector>
+
+#include "../TRTInferenceEngine.h"
+
+namespace pcl
+{
+
+// Engines standing in for TensorRT engines in tests and benchmarks: they run on the CPU and compute a
+// known function of each tile, for any number of planes.
+class TRTTestEngine : public TRTEngine
+{
+public:
+    // Inferences run so far
+    int m_numInferences = 0;
+    // Called before each inference with the number of inferences run so far
+    std::function<void(int)> m_onInference;
+
+    void setNumberOfPlanes(int32_t numPlanes) override;
+
+    float* getInputBuffer() override
+    {
+        return m_input.data();
+    }
+
+    const float* getOutputBuffer() const override
+    {
+        return m_output.data();
+    }
+
+    void runInference() override;
+
+protected:
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+
+    TRTTestEngine(int tileW, int tileH, int factor, int numChannels);
+
+    // Computes one plane of the output tile from one plane of the input tile
+    virtual void inferPlane(const float* input, float* output) const = 0;
+};
+
+// Nearest-neighbor upscale by an integer factor; a factor of 1 is the identity
+class TRTTestUpscaleEngine : public TRTTestEngine
+{
+public:
+    TRTTestUpscaleEngine(int tileSize, int factor, int numChannels = 3);
+
+protected:
+    void inferPlane(const float* input, float* output) const override;
+
+private:
+    int m_factor;
+};
+
+// Box blur of the given radius with the tile edges replicated, so the output at a pixel depends on the
+// input within the radius only, and tile edges show as seams unless the overlap hides them
+class TRTTestBlurEngine : public TRTTestEngine
+{
+public:
+    TRTTestBlurEngine(int tileSize, int radius, int numChannels = 3);
+
+    int32_t getContextMarginX() const override
+    {
+        return m_radius;
+    }
+
+    int32_t getContextMarginY() const override
+    {
+        return m_radius;
+    }
+
+protected:
+    void inferPlane(const float* input, float* output) const override;
+
+private:
+    int m_radius;
+};
+
+// Nearest-neighbor upscale reporting two layers, "conv" of 2 ms and "upsample" of 0.5 ms, to an
+// attached layer profile on each inference, as the layer profiler of a local engine does
+class TRTTestProfiledEngine : public TRTTestUpscaleEngine
+{
+public:
+    TRTLayerProfile* m_profile = nullptr;
+    // Inferences run with a profile attached
+    int m_numProfiled = 0;
+
+    TRTTestProfiledEngine(int tileSize, int factor, int numChannels = 3);
+
+    void runInference() override;
+
+    bool setLayerProfile(TRTLayerProfile* profile) override
+    {
+        m_profile = profile;
+        return true;
+    }
+};
+
+// Image of w x h pixels of smooth gradients with some pseudo-random texture, reproducible from seed
+FImage testImage(int w, int h, int numChannels, uint32 seed = 1);
+
+// Runs an engine over a whole image as processImage does, with weighted blending of overlapping tiles
+// in the given TRTInferenceTileOrder, raster by default, and returns the normalized output at the engine
+// scale
+FImage inferWeighted(TRTEngine& engine, const FImage& input, double tileOverlap, pcl_enum order = 0, int bandRows = 4);
+
+// The normalization of finalizeOutput, which needs the PixInsight thread API: divides the accumulated
+// samples by their weights and clamps them to [0,1]
+void normalizeWeighted(FImage& accumulator, const FImage& weight);
+
+// Same, placing the center-cropped tiles with a TRTTilePlacer
+FImage inferCenterCrop(TRTEngine& engine, const FImage& input, double tileOverlap, int numThreads = 0);
+
+// Largest absolute difference between two images of the same geometry
+double maxDifference(const FImage& a, const FImage& b);
+
+// True if both images have the same geometry and bit-identical samples
+bool identical(const FImage& a, const FImage& b);
+
+}	// namespace pcl
+
+#endif	// __TRTInferenceTestEngines_h
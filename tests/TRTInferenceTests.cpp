@@ -0,0 +1,107 @@
+#include <pcl/File.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+
+#include "TRTInferenceTest.h"
+
+namespace pcl
+{
+
+static std::vector<TRTTestCase>& testCases()
+{
+    static std::vector<TRTTestCase> cases;
+    return cases;
+}
+
+static String s_dataDirectory = "data";
+static String s_serverPath = "./TRTInferenceServer";
+
+TRTTestRegistration::TRTTestRegistration(const char* name, void (*function)())
+{
+    testCases().push_back({ name, function });
+}
+
+void trtCheckFailed(const char* file, int line, const String& what)
+{
+    throw TRTTestFailure{ String().Format("%s:%d: ", file, line) + what };
+}
+
+String trtTestDataPath(const String& name)
+{
+    return s_dataDirectory + '/' + name;
+}
+
+String trtTestServerPath()
+{
+    return s_serverPath;
+}
+
+String trtTestTempPath(const String& name)
+{
+    return File::SystemTempDirectory() + String().Format("/TRTInferenceTests-%d-", int(::getpid())) + name;
+}
+
+}	// namespace pcl
+
+using namespace pcl;
+
+// Runs the test cases whose names contain any of the arguments, or all of them. --data sets the
+// directory of the test data, "data" by default, and --server the inference server executable run by
+// the tile farm tests, "./TRTInferenceServer" by default.
+int main(int argc, char** argv)
+{
+    std::vector<const char*> filters;
+    for (int i = 1; i < argc; i++)
+        if (!std::strcmp(argv[i], "--data") && (i + 1 < argc))
+            s_dataDirectory = String::UTF8ToUTF16(argv[++i]);
+        else if (!std::strcmp(argv[i], "--server") && (i + 1 < argc))
+            s_serverPath = String::UTF8ToUTF16(argv[++i]);
+        else
+            filters.push_back(argv[i]);
+
+    int numRun = 0, numFailed = 0, numSkipped = 0;
+    for (const TRTTestCase& test : testCases())
+    {
+        bool selected = filters.empty();
+        for (const char* filter : filters)
+            selected = selected || (std::strstr(test.name, filter) != nullptr);
+        if (!selected)
+            continue;
+
+        numRun++;
+        String failure;
+        try
+        {
+            test.function();
+            std::printf("[  OK  ] %s\n", test.name);
+            continue;
+        }
+        catch (const TRTTestSkipped& x)
+        {
+            std::printf("[ SKIP ] %s: %s\n", test.name, x.reason.ToUTF8().c_str());
+            numSkipped++;
+            continue;
+        }
+        catch (const TRTTestFailure& x)
+        {
+            failure = x.message;
+        }
+        catch (const Exception& x)
+        {
+            failure = "Unexpected exception: " + x.Message();
+        }
+        catch (const std::exception& x)
+        {
+            failure = "Unexpected exception: " + String(x.what());
+        }
+        std::printf("[ FAIL ] %s: %s\n", test.name, failure.ToUTF8().c_str());
+        numFailed++;
+    }
+
+    std::printf("%d tests, %d failed, %d skipped\n", numRun, numFailed, numSkipped);
+    return (numFailed > 0) ? 1 : 0;
+}
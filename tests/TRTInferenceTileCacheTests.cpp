@@ -0,0 +1,222 @@
+#include <pcl/File.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../TRTInferenceTileCache.h"
+#include "TRTInferenceTest.h"
+
+using namespace pcl;
+
+namespace
+{
+
+const size_type s_tileSize = 16;
+const size_type s_tileBytes = s_tileSize * sizeof(float);
+
+// Input tile of 2x2 pixels of 4 channels, and the key of an engine output tile of 16 samples for it
+std::vector<float> inputTile(int seed)
+{
+    std::vector<float> tile(s_tileSize);
+    for (size_type i = 0; i < tile.size(); i++)
+        tile[i] = 0.001f * seed + 0.01f * i;
+    return tile;
+}
+
+TRTTileCache::Key key(int seed)
+{
+    return TRTTileCache::makeKey(0x1234, 2, 2, 2, 2, 4, inputTile(seed).data());
+}
+
+void store(int seed)
+{
+    std::vector<float> output = inputTile(seed);
+    for (float& v : output)
+        v *= 2;
+    TRTTileCache::instance().store(key(seed), output.data(), s_tileSize);
+}
+
+// True if the tile of the seed is found, and then with the output it was stored with
+bool found(int seed)
+{
+    std::vector<float> output(s_tileSize);
+    if (!TRTTileCache::instance().lookup(key(seed), output.data(), s_tileSize))
+        return false;
+    std::vector<float> expected = inputTile(seed);
+    for (size_type i = 0; i < s_tileSize; i++)
+        TRT_CHECK_EQUAL(output[i], 2 * expected[i]);
+    return true;
+}
+
+int numSpillFiles(const String& directory)
+{
+    int count = 0;
+    FindFileInfo info;
+    for (File::Find f(directory + "/*.tile"); f.NextItem(info);)
+        count++;
+    return count;
+}
+
+// Tiles spilled in a row may share a modification time; eviction order between sessions follows it
+void waitForNextModificationTime()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+// Empties the cache and detaches it from the spill directory, which is removed
+void resetCache(const String& directory = String())
+{
+    TRTTileCache::instance().clear();
+    TRTTileCache::instance().configure(0, 0, String());
+    if (directory.IsEmpty())
+        return;
+    FindFileInfo info;
+    std::vector<String> files;
+    for (File::Find f(directory + "/*.tile"); f.NextItem(info);)
+        files.push_back(directory + '/' + info.name);
+    for (const String& file : files)
+        File::Remove(file);
+    File::RemoveDirectory(directory);
+}
+
+}	// namespace
+
+// Keys tell apart engines, tile geometries and numbers of channels, as well as the input data
+TRT_TEST(tileCacheKeys)
+{
+    std::vector<float> tile = inputTile(1);
+    TRTTileCache::Key k = TRTTileCache::makeKey(0x1234, 2, 2, 2, 2, 4, tile.data());
+    TRT_CHECK(TRTTileCache::makeKey(0x1234, 2, 2, 2, 2, 4, tile.data()) == k);
+    TRT_CHECK(!(TRTTileCache::makeKey(0x1235, 2, 2, 2, 2, 4, tile.data()) == k));
+    TRT_CHECK(!(TRTTileCache::makeKey(0x1234, 2, 2, 4, 4, 4, tile.data()) == k));
+    TRT_CHECK(!(TRTTileCache::makeKey(0x1234, 4, 1, 4, 1, 4, tile.data()) == k));
+    TRT_CHECK(!(TRTTileCache::makeKey(0x1234, 2, 2, 2, 2, 3, tile.data()) == k));
+    TRT_CHECK(!(key(2) == k));
+
+    resetCache();
+    TRTTileCache::instance().configure(10 * s_tileBytes, 0, String());
+    store(1);
+    std::vector<float> output(s_tileSize);
+    TRT_CHECK(TRTTileCache::instance().lookup(k, output.data(), s_tileSize));
+    TRT_CHECK(!TRTTileCache::instance().lookup(TRTTileCache::makeKey(0x1235, 2, 2, 2, 2, 4, tile.data()), output.data(), s_tileSize));
+    TRT_CHECK(!TRTTileCache::instance().lookup(TRTTileCache::makeKey(0x1234, 2, 2, 4, 4, 4, tile.data()), output.data(), s_tileSize));
+    resetCache();
+}
+
+// Beyond the memory limit, the least recently used tiles go first; lookups count as uses
+TRT_TEST(tileCacheEvictsLeastRecentlyUsed)
+{
+    resetCache();
+    TRTTileCache::instance().configure(2 * s_tileBytes, 0, String());
+    store(1);
+    store(2);
+    TRT_CHECK(found(1));
+    store(3);
+    TRT_CHECK(found(1));
+    TRT_CHECK(!found(2));
+    TRT_CHECK(found(3));
+
+    // Storing a tile again does not duplicate it
+    store(3);
+    store(1);
+    TRT_CHECK(found(3));
+    TRT_CHECK(found(1));
+
+    // Lowering the limit evicts at once
+    TRTTileCache::instance().configure(s_tileBytes, 0, String());
+    TRT_CHECK(!found(3));
+    TRT_CHECK(found(1));
+    resetCache();
+}
+
+// A tile of another size under a key is not returned, and is replaced by the next store
+TRT_TEST(tileCacheReplacesTilesOfAnotherSize)
+{
+    resetCache();
+    TRTTileCache::instance().configure(2 * s_tileBytes, 0, String());
+    std::vector<float> shortTile(s_tileSize / 2, 0.5f);
+    TRTTileCache::instance().store(key(1), shortTile.data(), shortTile.size());
+    TRT_CHECK(!found(1));
+    store(1);
+    TRT_CHECK(found(1));
+
+    // The dropped tile no longer counts toward the limit
+    store(2);
+    TRT_CHECK(found(1));
+    TRT_CHECK(found(2));
+    resetCache();
+}
+
+// Evicted tiles are spilled to disk and read back into memory, keeping their spill files
+TRT_TEST(tileCacheSpillsAndReloads)
+{
+    String directory = trtTestTempPath("tilecache-spill");
+    resetCache();
+    try
+    {
+        TRTTileCache::instance().configure(s_tileBytes, 10 * s_tileBytes, directory);
+        TRT_CHECK(File::DirectoryExists(directory));
+        store(1);
+        store(2);
+        TRT_CHECK_EQUAL(numSpillFiles(directory), 1);
+        TRT_CHECK(found(1));
+        TRT_CHECK_EQUAL(numSpillFiles(directory), 2);
+        TRT_CHECK(found(2));
+        TRT_CHECK(found(1));
+        TRT_CHECK_EQUAL(numSpillFiles(directory), 2);
+
+        // Spill files of the wrong size are not read
+        std::vector<float> output(2 * s_tileSize);
+        TRT_CHECK(!TRTTileCache::instance().lookup(key(2), output.data(), output.size()));
+        TRT_CHECK(!found(3));
+    }
+    catch (...)
+    {
+        resetCache(directory);
+        throw;
+    }
+    resetCache(directory);
+}
+
+// Beyond the disk limit the oldest spill files are removed, including those of earlier sessions, which
+// are found when the spill directory is configured
+TRT_TEST(tileCacheLimitsSpillFiles)
+{
+    String directory = trtTestTempPath("tilecache-limit");
+    resetCache();
+    try
+    {
+        TRTTileCache::instance().configure(s_tileBytes, 2 * s_tileBytes, directory);
+        for (int seed = 1; seed <= 4; seed++)
+        {
+            store(seed);
+            waitForNextModificationTime();
+        }
+        // Tiles 2 and 3 are spilled; tile 1 went first
+        TRT_CHECK_EQUAL(numSpillFiles(directory), 2);
+        TRTTileCache::instance().clear();
+        TRT_CHECK(!found(1));
+        TRT_CHECK(found(2));
+        TRT_CHECK(found(3));
+
+        // A later session finds the spill files of tiles 2 and 3 at the limit: spilling tile 5 removes
+        // the oldest one
+        TRTTileCache::instance().clear();
+        TRTTileCache::instance().configure(s_tileBytes, 2 * s_tileBytes, String());
+        TRTTileCache::instance().configure(s_tileBytes, 2 * s_tileBytes, directory);
+        store(5);
+        store(6);
+        TRT_CHECK_EQUAL(numSpillFiles(directory), 2);
+        TRTTileCache::instance().clear();
+        TRT_CHECK(!found(2));
+        TRT_CHECK(found(3));
+        TRT_CHECK(found(5));
+    }
+    catch (...)
+    {
+        resetCache(directory);
+        throw;
+    }
+    resetCache(directory);
+}
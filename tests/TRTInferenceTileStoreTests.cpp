@@ -0,0 +1,143 @@
+#include <pcl/File.h>
+
+#include <vector>
+
+#include "../TRTInferenceParameters.h"
+#include "../TRTInferenceTileStore.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+namespace
+{
+
+TRTTileStoreLayout storeLayout(const TRTEngine& engine, const FImage& input, int stepX, int stepY, int numTiles)
+{
+    return { engine.getEngineHash(), TRTTileStore::imageHash(input), input.Width(), input.Height(), input.NumberOfChannels(),
+             engine.getInputTileW(), engine.getInputTileH(), engine.getOutputTileW(), engine.getOutputTileH(), stepX, stepY, numTiles,
+             -1, 0.0f };
+}
+
+// Blends the tiles of a 2x engine run over an image with 25% overlap as processImage does, recording
+// them to the store at path, or, if replay is true, reading them from it instead of inferring. Stops
+// after numTiles tiles, and returns the normalized output.
+FImage blend(TRTEngine& engine, const FImage& input, const String& path, bool replay, int numTiles = -1)
+{
+    int stepX = engine.getInputTileW() * 3 / 4;
+    int stepY = engine.getInputTileH() * 3 / 4;
+    int tilesPerRow = (input.Width() + stepX - 1) / stepX;
+    int n = tilesPerRow * ((input.Height() + stepY - 1) / stepY);
+    int numPlanes = input.NumberOfChannels();
+    engine.setNumberOfPlanes(numPlanes);
+    TRTTileStore store(path, storeLayout(engine, input, stepX, stepY, n));
+
+    FImage accumulator, weight;
+    accumulator.AllocateData(input.Width() * 2, input.Height() * 2, numPlanes, input.ColorSpace());
+    accumulator.Zero();
+    weight.AllocateData(accumulator.Width(), accumulator.Height());
+    weight.Zero();
+    std::vector<float> storedTile(size_type(numPlanes) * engine.getOutputTileW() * engine.getOutputTileH());
+    for (int i = 0; i < ((numTiles < 0) ? n : numTiles); i++)
+    {
+        Point pos((i % tilesPerRow) * stepX, (i / tilesPerRow) * stepY);
+        const float* outputTile;
+        if (replay)
+        {
+            TRT_CHECK(store.hasTile(i));
+            store.readTile(i, storedTile.data());
+            outputTile = storedTile.data();
+        }
+        else
+        {
+            extractTile(input, pos, engine.getInputTileW(), engine.getInputTileH(), numPlanes, engine.getInputBuffer());
+            engine.runInference();
+            outputTile = engine.getOutputBuffer();
+            store.writeTile(i, outputTile);
+        }
+        accumulateTile(outputTile, engine.getOutputTileW(), engine.getOutputTileH(), numPlanes, Point(pos.x * 2, pos.y * 2), accumulator, weight);
+    }
+    store.flush();
+
+    normalizeWeighted(accumulator, weight);
+    return accumulator;
+}
+
+}	// namespace
+
+// Output blended from stored tiles is within the 16-bit rounding of the stored samples of the output of
+// the recording run, without inference
+TRT_TEST(tileStoreReblendsWithinTolerance)
+{
+    String path = trtTestTempPath("reblend.trttiles");
+    FImage input = testImage(61, 45, 3);
+    // Out of range samples are stored clamped, as they are blended
+    input.Pixel(3, 4, 1) = 1.5f;
+    input.Pixel(40, 30, 2) = -0.25f;
+    try
+    {
+        TRTTestUpscaleEngine recorder(16, 2);
+        FImage recorded = blend(recorder, input, path, false);
+
+        TRTTestUpscaleEngine replayer(16, 2);
+        FImage replayed = blend(replayer, input, path, true);
+        TRT_CHECK_EQUAL(replayer.m_numInferences, 0);
+        double difference = maxDifference(replayed, recorded);
+        TRT_CHECK(difference > 0);
+        TRT_CHECK(difference <= 0.5 / 65535 + 1.0e-7);
+    }
+    catch (...)
+    {
+        File::Remove(path);
+        throw;
+    }
+    File::Remove(path);
+}
+
+// An interrupted recording keeps the tiles written so far; a store recorded for another image, engine,
+// tile plan or uniform tile skipping starts empty
+TRT_TEST(tileStoreMatchesLayout)
+{
+    String path = trtTestTempPath("layout.trttiles");
+    FImage input = testImage(40, 30, 3);
+    try
+    {
+        TRTTestUpscaleEngine engine(16, 2);
+        TRTTileStoreLayout layout = storeLayout(engine, input, 12, 12, 12);
+        blend(engine, input, path, false, 5);
+        {
+            TRTTileStore store(path, layout);
+            TRT_CHECK_EQUAL(store.numStoredTiles(), 5);
+            TRT_CHECK(store.hasTile(4));
+            TRT_CHECK(!store.hasTile(5));
+        }
+
+        TRTTestUpscaleEngine other(16, 3);
+        TRTTileStoreLayout skipping = layout;
+        skipping.uniformTilePolicy = TRTInferenceUniformTilePolicy::Passthrough;
+        skipping.uniformTileTolerance = 1.0f / 256;
+        for (const TRTTileStoreLayout& l : { storeLayout(other, input, 12, 12, 12), storeLayout(engine, testImage(40, 30, 3, 2), 12, 12, 12),
+                                             storeLayout(engine, input, 8, 8, 20), skipping })
+        {
+            blend(engine, input, path, false, 5);
+            TRT_CHECK_EQUAL(TRTTileStore(path, l).numStoredTiles(), 0);
+        }
+
+        // Tiles produced with uniform tile skipping are only reused with the same policy and tolerance
+        {
+            TRTTileStore store(path, skipping);
+            std::vector<float> tile(3 * 32 * 32, 0.5f);
+            store.writeTile(2, tile.data());
+        }
+        TRT_CHECK_EQUAL(TRTTileStore(path, skipping).numStoredTiles(), 1);
+        skipping.uniformTileTolerance = 1.0f / 128;
+        TRT_CHECK_EQUAL(TRTTileStore(path, skipping).numStoredTiles(), 0);
+    }
+    catch (...)
+    {
+        File::Remove(path);
+        throw;
+    }
+    File::Remove(path);
+}
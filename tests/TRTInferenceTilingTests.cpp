@@ -0,0 +1,487 @@
+#include <pcl/IntegerResample.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "../TRTInferenceParameters.h"
+#include "../TRTInferenceTileProducer.h"
+#include "../TRTInferenceTiling.h"
+#include "TRTInferenceTest.h"
+#include "TRTInferenceTestEngines.h"
+
+using namespace pcl;
+
+// Average of the input pixels in [x0,x1) x [y0,y1), in double precision
+static double blockAverage(const FImage& image, int x0, int y0, int x1, int y1, int c)
+{
+    double sum = 0;
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++)
+            sum += image.Pixel(x, y, c);
+    return sum / ((x1 - x0) * (y1 - y0));
+}
+
+// Binning averages whole blocks, and the partial blocks at the right and bottom edges over the pixels
+// they have
+TRT_TEST(binImageAveragesBlocks)
+{
+    FImage input = testImage(23, 17, 3);
+    for (int factor : { 1, 2, 3, 4 })
+    {
+        FImage output;
+        output.AllocateData((input.Width() + factor - 1) / factor, (input.Height() + factor - 1) / factor, 3);
+        binImage(input, factor, output);
+        for (int c = 0; c < 3; c++)
+            for (int y = 0; y < output.Height(); y++)
+                for (int x = 0; x < output.Width(); x++)
+                {
+                    int x0 = x * factor, y0 = y * factor;
+                    double expected = blockAverage(input, x0, y0, Min(x0 + factor, input.Width()), Min(y0 + factor, input.Height()), c);
+                    TRT_CHECK_CLOSE(output.Pixel(x, y, c), expected, 1e-6);
+                }
+        if (factor == 1)
+            TRT_CHECK(identical(output, input));
+    }
+}
+
+// A constant image bins to the same constant, including single-pixel edge blocks
+TRT_TEST(binImageKeepsConstants)
+{
+    FImage input;
+    input.AllocateData(9, 5, 1);
+    input.Fill(0.375f);
+    FImage output;
+    output.AllocateData(3, 2, 1);
+    binImage(input, 4, output);
+    for (int y = 0; y < 2; y++)
+        for (int x = 0; x < 3; x++)
+            TRT_CHECK_EQUAL(output.Pixel(x, y), 0.375f);
+}
+
+// Same-size fast mode: a 2x engine run on the binned input yields an image of the original size, with
+// the tiles of a plan over the binned image, about a quarter of those of the full-resolution run
+TRT_TEST(binnedInputNeedsFewerTiles)
+{
+    FImage input = testImage(160, 120, 3);
+    FImage binned;
+    binned.AllocateData(80, 60, 3, ColorSpace::RGB);
+    binImage(input, 2, binned);
+
+    TRTTestUpscaleEngine full(32, 2), fast(32, 2);
+    FImage fullOutput = inferCenterCrop(full, input, 0.25);
+    FImage fastOutput = inferCenterCrop(fast, binned, 0.25);
+    TRT_CHECK_EQUAL(fullOutput.Width(), 2 * input.Width());
+    TRT_CHECK_EQUAL(fastOutput.Width(), input.Width());
+    TRT_CHECK_EQUAL(fastOutput.Height(), input.Height());
+    TRT_CHECK_EQUAL(full.m_numInferences, 7 * 5);
+    TRT_CHECK_EQUAL(fast.m_numInferences, 4 * 3);
+
+    // Nearest-neighbor upscaling of the binned image
+    for (int y = 0; y < input.Height(); y++)
+        for (int x = 0; x < input.Width(); x++)
+            TRT_CHECK_EQUAL(fastOutput.Pixel(x, y, 1), binned.Pixel(x / 2, y / 2, 1));
+}
+
+// Every order visits each tile of the plan exactly once
+TRT_TEST(tileOrdersArePermutations)
+{
+    const int plans[][2] = { { 1, 1 }, { 7, 5 }, { 8, 8 }, { 3, 11 }, { 16, 1 } };
+    for (const auto& plan : plans)
+        for (pcl_enum order = 0; order < TRTInferenceTileOrder::NumberOfItems; order++)
+            for (int bandRows : { 1, 3, 4 })
+            {
+                Array<Point> tiles = tileOrder(order, plan[0], plan[1], bandRows);
+                TRT_CHECK_EQUAL(int(tiles.Length()), plan[0] * plan[1]);
+                std::vector<int> visits(plan[0] * plan[1], 0);
+                for (const Point& tile : tiles)
+                {
+                    TRT_CHECK((tile.x >= 0) && (tile.x < plan[0]) && (tile.y >= 0) && (tile.y < plan[1]));
+                    visits[tile.y * plan[0] + tile.x]++;
+                }
+                for (int v : visits)
+                    TRT_CHECK_EQUAL(v, 1);
+            }
+}
+
+// Consecutive tiles of a serpentine order are always adjacent
+TRT_TEST(serpentineOrderStaysAdjacent)
+{
+    Array<Point> tiles = tileOrder(TRTInferenceTileOrder::Serpentine, 6, 5, 0);
+    for (size_type i = 1; i < tiles.Length(); i++)
+        TRT_CHECK_EQUAL(Abs(tiles[i].x - tiles[i - 1].x) + Abs(tiles[i].y - tiles[i - 1].y), 1);
+    TRT_CHECK(tiles[6] == Point(5, 1));
+}
+
+// Z-order visits the 2x2 blocks, then the 4x4 blocks, of the plan one after another
+TRT_TEST(zOrderVisitsQuadrants)
+{
+    Array<Point> tiles = tileOrder(TRTInferenceTileOrder::ZOrder, 8, 8, 0);
+    TRT_CHECK(tiles[0] == Point(0, 0));
+    TRT_CHECK(tiles[1] == Point(1, 0));
+    TRT_CHECK(tiles[2] == Point(0, 1));
+    TRT_CHECK(tiles[3] == Point(1, 1));
+    for (size_type i = 0; i < tiles.Length(); i++)
+    {
+        TRT_CHECK_EQUAL(int(i / 4), (tiles[i].y / 2) / 2 * 8 + (tiles[i].x / 2) / 2 * 4 + (tiles[i].y / 2) % 2 * 2 + (tiles[i].x / 2) % 2);
+        TRT_CHECK_EQUAL(int(i / 16), (tiles[i].y / 4) * 2 + tiles[i].x / 4);
+    }
+}
+
+// Band-major order finishes a band of rows before the next, going down each column of the band
+TRT_TEST(bandMajorOrderStaysInBands)
+{
+    Array<Point> tiles = tileOrder(TRTInferenceTileOrder::BandMajor, 4, 7, 3);
+    size_type i = 0;
+    for (int y0 = 0; y0 < 7; y0 += 3)
+        for (int x = 0; x < 4; x++)
+            for (int y = y0; y < Min(y0 + 3, 7); y++, i++)
+                TRT_CHECK(tiles[i] == Point(x, y));
+}
+
+// Center-crop regions of a tile plan are disjoint and cover the image, whatever the overlap and
+// however the last tile overhangs the image edge
+TRT_TEST(cropRegionsPartitionTheImage)
+{
+    const int sizes[][2] = { { 100, 70 }, { 64, 64 }, { 65, 1 }, { 31, 200 } };
+    for (const auto& size : sizes)
+        for (double overlap : { 0.0, 0.1, 0.25, 0.5, 0.75 })
+        {
+            int imageW = size[0], imageH = size[1];
+            int tileW = 32, tileH = 24;
+            int stepX = tileW * (1.0f - overlap);
+            int stepY = tileH * (1.0f - overlap);
+            std::vector<int> count(size_type(imageW) * imageH, 0);
+            for (int y = 0; y < imageH; y += stepY)
+                for (int x = 0; x < imageW; x += stepX)
+                {
+                    Rect r = cropRegion(Point(x, y), tileW, tileH, stepX, stepY, imageW, imageH);
+                    // Inside the tile, so the engine output covers it
+                    TRT_CHECK((r.x0 >= x) && (r.y0 >= y) && (r.x1 <= x + tileW) && (r.y1 <= y + tileH));
+                    for (int v = r.y0; v < r.y1; v++)
+                        for (int u = r.x0; u < r.x1; u++)
+                            count[size_type(v) * imageW + u]++;
+                }
+            for (int c : count)
+                TRT_CHECK_EQUAL(c, 1);
+        }
+}
+
+// placeTile writes the intersection of the rectangle, the tile and the image only, clamped to [0,1]
+TRT_TEST(placeTileClipsAndClamps)
+{
+    const int w = 4, h = 3;
+    std::vector<float> tile(2 * w * h);
+    for (size_type i = 0; i < tile.size(); i++)
+        tile[i] = -1.0f + 0.25f * i;
+
+    FImage output;
+    output.AllocateData(6, 5, 2);
+    output.Fill(0.5f);
+    placeTile(tile.data(), w, h, 2, Point(3, 1), Rect(0, 2, 10, 10), output);
+
+    for (int c = 0; c < 2; c++)
+        for (int y = 0; y < 5; y++)
+            for (int x = 0; x < 6; x++)
+            {
+                bool written = (x >= 3) && (y >= 2) && (y < 4);
+                float expected = 0.5f;
+                if (written)
+                    expected = Range(tile[(c * h + y - 1) * w + x - 3], 0.0f, 1.0f);
+                TRT_CHECK_EQUAL(output.Pixel(x, y, c), expected);
+            }
+}
+
+// Output as processImage finalized it before finalizeOutput: the accumulator divided by the blending
+// weights, converted to the color space of the target, downsampled, and copied to its sample type
+template <class P>
+static void finalizeInSteps(const FImage& accumulator, const FImage& weight, int factor, int colorSpace, GenericImage<P>& target)
+{
+    FImage mask;
+    mask.AllocateData(weight.Width(), weight.Height(), accumulator.NumberOfChannels(), accumulator.ColorSpace());
+    for (int c = 0; c < mask.NumberOfChannels(); c++)
+        for (int y = 0; y < mask.Height(); y++)
+            for (int x = 0; x < mask.Width(); x++)
+                mask.Pixel(x, y, c) = weight.Pixel(x, y);
+
+    FImage image(accumulator);
+    image.Divide(mask);
+    if (image.ColorSpace() != colorSpace)
+        image.SetColorSpace(colorSpace);
+    if (factor > 1)
+    {
+        IntegerResample ir(-factor);
+        ir >> image;
+    }
+    target.CopyImage(image);
+}
+
+// Finalizes an accumulator into a target of sample type P and of numChannels channels, checking it
+// against the separate steps to within rounding to the sample type, and to single precision
+template <class P>
+static void checkFinalizeOutput(const FImage& accumulator, const FImage& weight, int factor, int numChannels)
+{
+    int colorSpace = (numChannels == 3) ? ColorSpace::RGB : ColorSpace::Gray;
+    ImageVariant target;
+    target.CreateImage(P::IsFloatSample(), false, P::BitsPerSample());
+    target.AllocateImage(1, 1, numChannels, colorSpace);
+    finalizeOutput(accumulator, &weight, factor, target);
+
+    GenericImage<P> expected;
+    finalizeInSteps(accumulator, weight, factor, colorSpace, expected);
+    const GenericImage<P>& output = static_cast<const GenericImage<P>&>(*target);
+    TRT_CHECK_EQUAL(output.Width(), expected.Width());
+    TRT_CHECK_EQUAL(output.Height(), expected.Height());
+    TRT_CHECK_EQUAL(output.NumberOfChannels(), numChannels);
+
+    double tolerance = P::IsFloatSample() ? 1.0e-5 : Max(1.0e-5, 1.0 / ((uint64(1) << P::BitsPerSample()) - 1)) + 1.0e-9;
+    double maxDiff = 0;
+    for (int c = 0; c < numChannels; c++)
+        for (int y = 0; y < output.Height(); y++)
+            for (int x = 0; x < output.Width(); x++)
+            {
+                double a, b;
+                P::ToSample(a, output.Pixel(x, y, c));
+                P::ToSample(b, expected.Pixel(x, y, c));
+                maxDiff = Max(maxDiff, Abs(a - b));
+            }
+    if (maxDiff > tolerance)
+        trtCheckFailed(__FILE__, __LINE__,
+                       String().Format("%d-bit %s target, factor %d, %d channels: difference %.3e", P::BitsPerSample(),
+                                       P::IsFloatSample() ? "float" : "integer", factor, numChannels, maxDiff));
+}
+
+// The live display samples every reduction-th pixel of the normalized, clamped accumulator
+TRT_TEST(reduceForDisplaySamplesNormalizedOutput)
+{
+    FImage accumulator = testImage(50, 31, 3);
+    FImage weight = testImage(50, 31, 1, 5);
+    weight.Pixel(6, 3) = 0;
+    for (int reduction : { 1, 3 })
+        for (const FImage* w : { (const FImage*)nullptr, (const FImage*)&weight })
+        {
+            FImage display;
+            display.AllocateData((50 + reduction - 1) / reduction, (31 + reduction - 1) / reduction, 3);
+            display.Fill(-1.0f);
+            // In two batches of rows, as composited while tiles finish
+            reduceForDisplay(accumulator, w, reduction, 0, 4, display);
+            reduceForDisplay(accumulator, w, reduction, 4, display.Height(), display);
+            for (int c = 0; c < 3; c++)
+                for (int y = 0; y < display.Height(); y++)
+                    for (int x = 0; x < display.Width(); x++)
+                    {
+                        int sx = x * reduction, sy = y * reduction;
+                        float f = accumulator.Pixel(sx, sy, c);
+                        if (w != nullptr)
+                            f = (w->Pixel(sx, sy) > 0) ? f / w->Pixel(sx, sy) : 0.0f;
+                        TRT_CHECK_EQUAL(display.Pixel(x, y, c), Range(f, 0.0f, 1.0f));
+                    }
+        }
+}
+
+// Finalizing the output in one pass matches normalizing, converting the color space, downsampling and
+// copying to the view in separate steps, for all sample types, gray and RGB targets, and any factor.
+// Dark pixels take the linear segments of the sRGB curve and of CIE L*.
+TRT_TEST(finalizeOutputMatchesSeparateSteps)
+{
+    FImage values = testImage(30, 20, 3);
+    for (int c = 0; c < 3; c++)
+        for (int x = 0; x < 8; x++)
+            values.Pixel(x, 5, c) = 0.005f * x;
+    FImage weight = testImage(30, 20, 1, 3);
+    FImage accumulator(values);
+    for (int c = 0; c < 3; c++)
+        for (int y = 0; y < 20; y++)
+            for (int x = 0; x < 30; x++)
+                accumulator.Pixel(x, y, c) = values.Pixel(x, y, c) * weight.Pixel(x, y);
+
+    for (int factor : { 1, 2, 5 })
+        for (int numChannels : { 1, 3 })
+        {
+            checkFinalizeOutput<FloatPixelTraits>(accumulator, weight, factor, numChannels);
+            checkFinalizeOutput<UInt8PixelTraits>(accumulator, weight, factor, numChannels);
+            checkFinalizeOutput<UInt16PixelTraits>(accumulator, weight, factor, numChannels);
+            checkFinalizeOutput<UInt32PixelTraits>(accumulator, weight, factor, numChannels);
+        }
+}
+
+// Center-crop stitching of an identity engine reproduces the input exactly: every output pixel comes
+// from exactly one tile, placed on any number of threads
+TRT_TEST(centerCropStitchingIsExact)
+{
+    FImage input = testImage(203, 151, 3);
+    for (int numThreads : { 1, 4 })
+        for (double overlap : { 0.0, 0.2, 0.5 })
+        {
+            TRTTestUpscaleEngine identity(48, 1);
+            TRT_CHECK(identical(inferCenterCrop(identity, input, overlap, numThreads), input));
+        }
+
+    // A 2x engine writes each input pixel as a 2x2 block
+    TRTTestUpscaleEngine upscale(32, 2);
+    FImage output = inferCenterCrop(upscale, input, 0.25, 3);
+    TRT_CHECK_EQUAL(output.Width(), 2 * input.Width());
+    for (int c = 0; c < 3; c++)
+        for (int y = 0; y < output.Height(); y++)
+            for (int x = 0; x < output.Width(); x++)
+                TRT_CHECK_EQUAL(output.Pixel(x, y, c), input.Pixel(x / 2, y / 2, c));
+}
+
+// Queued tiles land as placed sequentially, even when fewer buffers than tiles are in flight
+TRT_TEST(tilePlacerMatchesSequentialPlacement)
+{
+    const int tileSize = 16;
+    FImage input = testImage(120, 90, 1, 7);
+    FImage sequential, parallel;
+    sequential.AllocateData(input.Width(), input.Height(), 1);
+    sequential.Zero();
+    parallel.AllocateData(input.Width(), input.Height(), 1);
+    parallel.Zero();
+
+    std::vector<float> tile(tileSize * tileSize);
+    {
+        TRTTilePlacer placer(parallel, tileSize, tileSize, 1, 3, 2);
+        for (int y = 0; y < input.Height(); y += 12)
+            for (int x = 0; x < input.Width(); x += 12)
+            {
+                extractTile(input, Point(x, y), tileSize, tileSize, 1, tile.data());
+                Rect rect = cropRegion(Point(x, y), tileSize, tileSize, 12, 12, input.Width(), input.Height());
+                placeTile(tile.data(), tileSize, tileSize, 1, Point(x, y), rect, sequential);
+                placer.place(tile.data(), Point(x, y), rect);
+            }
+        placer.wait();
+    }
+    TRT_CHECK(identical(parallel, sequential));
+    TRT_CHECK(identical(parallel, input));
+}
+
+// A tile is uniform if no channel spans more than the tolerance, the bound included; any channel with
+// more structure makes it non-uniform
+TRT_TEST(uniformTileTolerance)
+{
+    const int w = 4, h = 3, n = w * h;
+    const float tolerance = 0.25f;
+    std::vector<float> tile(3 * n);
+    for (int c = 0; c < 3; c++)
+        for (int i = 0; i < n; i++)
+            tile[c * n + i] = 0.25f * c + ((i == 5) ? tolerance : 0.0f);
+
+    float values[3] = { -1, -1, -1 };
+    TRT_CHECK(isUniformTile(tile.data(), w, h, 3, tolerance, values));
+    for (int c = 0; c < 3; c++)
+        TRT_CHECK_CLOSE(values[c], 0.25f * c + tolerance / n, 1e-7);
+    TRT_CHECK(!isUniformTile(tile.data(), w, h, 3, 0.0f, values));
+
+    // One ulp beyond the tolerance, above or below, in the last channel only
+    tile[2 * n + 7] = std::nextafter(0.5f + tolerance, 1.0f);
+    TRT_CHECK(!isUniformTile(tile.data(), w, h, 3, tolerance, values));
+    TRT_CHECK(isUniformTile(tile.data(), w, h, 2, tolerance, values));
+    tile[2 * n + 7] = 0.5f;
+    tile[2 * n + 11] = std::nextafter(0.5f, 0.0f);
+    TRT_CHECK(!isUniformTile(tile.data(), w, h, 3, tolerance, values));
+
+    // Constant tiles are uniform at zero tolerance
+    std::fill(tile.begin(), tile.end(), 0.375f);
+    TRT_CHECK(isUniformTile(tile.data(), w, h, 3, 0.0f, values));
+    TRT_CHECK_EQUAL(values[2], 0.375f);
+}
+
+// Image of 16 px square tiles in a row, each of given channel levels plus a structure of given
+// amplitude in its first pixel row
+static FImage tileRow(const std::vector<std::array<float, 3>>& levels, const std::vector<float>& structure)
+{
+    FImage image;
+    image.AllocateData(16 * int(levels.size()), 16, 3, ColorSpace::RGB);
+    for (int t = 0; t < int(levels.size()); t++)
+        for (int c = 0; c < 3; c++)
+            for (int y = 0; y < 16; y++)
+                for (int x = 0; x < 16; x++)
+                    image.Pixel(16 * t + x, y, c) = levels[t][c] + ((y == 0) ? structure[t] * (x & 1) : 0.0f);
+    return image;
+}
+
+// Output tile of a producer, copied as it is only valid until the next tile
+static std::vector<float> produceTile(TRTTileProducer& producer, const TRTEngine& engine, const FImage& input, int tile)
+{
+    const float* p = producer.produce(input, Point(16 * tile, 0));
+    return std::vector<float>(p, p + 3 * engine.getOutputTileW() * engine.getOutputTileH());
+}
+
+// Expected output tile of the 2x upscale engine for a tile of tileRow
+static std::vector<float> upscaledTile(const FImage& input, int tile)
+{
+    std::vector<float> in(3 * 16 * 16), out(3 * 32 * 32);
+    extractTile(input, Point(16 * tile, 0), 16, 16, 3, in.data());
+    upscaleTile(in.data(), 16, 16, 3, 2, 2, out.data());
+    return out;
+}
+
+// Uniform tiles skip the engine: passed through upscaled, or written as zeros. Tiles with structure in
+// one channel only are inferred.
+TRT_TEST(uniformTilePoliciesSkipEngine)
+{
+    const float tolerance = 1.0f / 256;
+    FImage input = tileRow({ { 0.2f, 0.4f, 0.6f }, { 0.2f, 0.4f, 0.6f }, { 0.7f, 0.1f, 0.9f } }, { 0.002f, 0.01f, 0.0f });
+    for (pcl_enum policy : { TRTInferenceUniformTilePolicy::Passthrough, TRTInferenceUniformTilePolicy::Zero })
+    {
+        TRTTestUpscaleEngine engine(16, 2);
+        TRTTileProducer producer(engine, 3, true, tolerance, policy, false);
+        std::vector<float> first = produceTile(producer, engine, input, 0);
+        std::vector<float> second = produceTile(producer, engine, input, 1);
+        std::vector<float> third = produceTile(producer, engine, input, 2);
+        TRT_CHECK_EQUAL(engine.m_numInferences, 1);
+        TRT_CHECK_EQUAL(producer.numSkipped(), 2);
+        TRT_CHECK(second == upscaledTile(input, 1));
+        if (policy == TRTInferenceUniformTilePolicy::Passthrough)
+        {
+            TRT_CHECK(first == upscaledTile(input, 0));
+            TRT_CHECK(third == upscaledTile(input, 2));
+        }
+        else
+        {
+            TRT_CHECK(std::all_of(first.begin(), first.end(), [](float v) { return v == 0.0f; }));
+            TRT_CHECK(std::all_of(third.begin(), third.end(), [](float v) { return v == 0.0f; }));
+        }
+    }
+
+    // Without skipping, every tile is inferred
+    TRTTestUpscaleEngine engine(16, 2);
+    TRTTileProducer producer(engine, 3, false, tolerance, TRTInferenceUniformTilePolicy::Zero, false);
+    for (int t = 0; t < 3; t++)
+        TRT_CHECK(produceTile(producer, engine, input, t) == upscaledTile(input, t));
+    TRT_CHECK_EQUAL(engine.m_numInferences, 3);
+    TRT_CHECK_EQUAL(producer.numSkipped(), 0);
+}
+
+// Cached responses are keyed by the channel means quantized to the tolerance: the first uniform tile
+// of each level is inferred, and later tiles of the same level reuse its response
+TRT_TEST(uniformTileCachedResponses)
+{
+    const float tolerance = 1.0f / 256;
+    // Means quantize to 128, 128 and 154 steps in the first channel, and alike in the others; the last
+    // tile differs from the first in the last channel only
+    FImage input = tileRow({ { 0.5f, 0.25f, 0.125f }, { 0.5015f, 0.2515f, 0.1265f }, { 0.6f, 0.25f, 0.125f }, { 0.5f, 0.25f, 0.25f } },
+                           { 0.002f, 0.0f, 0.0f, 0.0f });
+    TRTTestUpscaleEngine engine(16, 2);
+    TRTTileProducer producer(engine, 3, true, tolerance, TRTInferenceUniformTilePolicy::CachedResponse, false);
+    std::vector<float> first = produceTile(producer, engine, input, 0);
+    TRT_CHECK(first == upscaledTile(input, 0));
+    TRT_CHECK_EQUAL(engine.m_numInferences, 1);
+    TRT_CHECK_EQUAL(producer.numSkipped(), 0);
+
+    TRT_CHECK(produceTile(producer, engine, input, 1) == first);
+    TRT_CHECK_EQUAL(engine.m_numInferences, 1);
+    TRT_CHECK_EQUAL(producer.numSkipped(), 1);
+
+    TRT_CHECK(produceTile(producer, engine, input, 2) == upscaledTile(input, 2));
+    TRT_CHECK(produceTile(producer, engine, input, 3) == upscaledTile(input, 3));
+    TRT_CHECK_EQUAL(engine.m_numInferences, 3);
+    TRT_CHECK_EQUAL(producer.numSkipped(), 1);
+
+    // The response is kept, not the engine buffer, which later inferences overwrite
+    TRT_CHECK(produceTile(producer, engine, input, 1) == first);
+    TRT_CHECK(produceTile(producer, engine, input, 2) == upscaledTile(input, 2));
+    TRT_CHECK_EQUAL(engine.m_numInferences, 3);
+    TRT_CHECK_EQUAL(producer.numSkipped(), 3);
+}
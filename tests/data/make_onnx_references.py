@@ -0,0 +1,138 @@
+# Writes the ONNX models of the CPU backend tests, with an input and the output computed for it by
+# ONNX Runtime, the reference implementation. Run it from this directory after changing the models:
+#
+#   pip install onnx onnxruntime numpy
+#   python make_onnx_references.py
+#
+# For each model <name>.onnx, <name>.input and <name>.output hold the input and output tensors as
+# little-endian 32-bit floats, in NCHW order.
+
+import numpy as np
+import onnx
+import onnxruntime
+from onnx import TensorProto, helper, numpy_helper
+
+HEIGHT = 12
+WIDTH = 16
+rng = np.random.default_rng(20260119)
+
+
+def constant(name, array):
+    return numpy_helper.from_array(np.asarray(array, dtype=np.float32), name)
+
+
+def weights(name, *shape):
+    return constant(name, rng.uniform(-0.5, 0.5, shape))
+
+
+# Models with dynamic dimensions are run on square tiles of TILE_SIZE pixels
+TILE_SIZE = 16
+
+
+def save(name, nodes, initializers, channels=3, factor=1, dynamic=False, opset=13):
+    h, w = ("H", "W") if dynamic else (HEIGHT, WIDTH)
+    oh, ow = ("OH", "OW") if dynamic else (HEIGHT * factor, WIDTH * factor)
+    graph = helper.make_graph(nodes, name,
+                              [helper.make_tensor_value_info("input", TensorProto.FLOAT, [1, channels, h, w])],
+                              [helper.make_tensor_value_info("output", TensorProto.FLOAT, [1, channels, oh, ow])],
+                              initializers)
+    model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", opset)])
+    model.ir_version = 7
+    onnx.checker.check_model(model)
+    onnx.save(model, name + ".onnx")
+
+    height, width = (TILE_SIZE, TILE_SIZE) if dynamic else (HEIGHT, WIDTH)
+    x = rng.uniform(0, 1, (1, channels, height, width)).astype(np.float32)
+    session = onnxruntime.InferenceSession(name + ".onnx", providers=["CPUExecutionProvider"])
+    y = session.run(None, {"input": x})[0]
+    assert y.shape == (1, channels, height * factor, width * factor), (name, y.shape)
+    x.astype("<f4").tofile(name + ".input")
+    y.astype("<f4").tofile(name + ".output")
+
+
+# Grouped, dilated and depthwise convolutions, with and without bias and padding
+save("conv_grouped", [
+    helper.make_node("Conv", ["input", "w1", "b1"], ["c1"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+    helper.make_node("Conv", ["c1", "w2", "b2"], ["c2"], kernel_shape=[3, 3], pads=[2, 2, 2, 2], dilations=[2, 2], group=2),
+    helper.make_node("Conv", ["c2", "w3"], ["c3"], kernel_shape=[3, 3], pads=[1, 3, 1, 1], dilations=[1, 2], group=6),
+    helper.make_node("Conv", ["c3", "w4", "b4"], ["output"], kernel_shape=[1, 1], group=3),
+], [weights("w1", 6, 3, 3, 3), weights("b1", 6), weights("w2", 6, 3, 3, 3), weights("b2", 6),
+    weights("w3", 6, 1, 3, 3), weights("w4", 3, 2, 1, 1), weights("b4", 3)])
+
+# PRelu with per-channel and scalar slopes, standalone and fused into a convolution
+save("prelu", [
+    helper.make_node("Sub", ["input", "half"], ["centered"]),
+    helper.make_node("PRelu", ["centered", "slopes"], ["p1"]),
+    helper.make_node("Conv", ["p1", "w", "b"], ["c"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+    helper.make_node("PRelu", ["c", "slope"], ["output"]),
+], [constant("half", 0.5), constant("slopes", np.array([0.1, -0.3, 0.7]).reshape(3, 1, 1)),
+    weights("w", 3, 3, 3, 3), weights("b", 3), constant("slope", [0.25])])
+
+# Pixel shuffle in both channel orders
+for mode in ("DCR", "CRD"):
+    save("depth_to_space_" + mode.lower(), [
+        helper.make_node("Conv", ["input", "w", "b"], ["c"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+        helper.make_node("DepthToSpace", ["c"], ["output"], blocksize=2, mode=mode),
+    ], [weights("w", 12, 3, 3, 3), weights("b", 12)], factor=2)
+
+# Resize in each coordinate transformation mode, by scales or by sizes, and the older Upsample
+def resize(name, mode, transform, nearest_mode="round_prefer_floor", sizes=False, opset=13):
+    attributes = {"mode": mode, "coordinate_transformation_mode": transform}
+    if mode == "nearest":
+        attributes["nearest_mode"] = nearest_mode
+    if sizes:
+        inputs = ["input", "", "", "sizes"]
+        initializers = [numpy_helper.from_array(np.array([1, 3, 2 * HEIGHT, 2 * WIDTH], dtype=np.int64), "sizes")]
+    else:
+        inputs, initializers = ["input", "", "scales"], [constant("scales", [1, 1, 2, 2])]
+    if opset < 13:
+        # The region of interest is an input of its own until opset 13
+        inputs[1] = "roi"
+        initializers.append(constant("roi", np.zeros(0)))
+    save(name, [helper.make_node("Resize", inputs, ["output"], **attributes)], initializers, factor=2, opset=opset)
+
+for transform in ("half_pixel", "pytorch_half_pixel", "align_corners", "asymmetric"):
+    resize("resize_linear_" + transform, "linear", transform)
+    resize("resize_nearest_" + transform, "nearest", transform)
+resize("resize_nearest_tf_half_pixel_for_nn", "nearest", "tf_half_pixel_for_nn", opset=11)
+for nearest_mode in ("floor", "ceil", "round_prefer_ceil"):
+    resize("resize_nearest_asymmetric_" + nearest_mode, "nearest", "asymmetric", nearest_mode)
+resize("resize_linear_sizes", "linear", "half_pixel", sizes=True)
+save("upsample_nearest", [helper.make_node("Upsample", ["input", "scales"], ["output"], mode="nearest")],
+     [constant("scales", [1, 1, 2, 2])], factor=2, opset=9)
+
+# Broadcast arithmetic with constants per channel, scalar and of the whole tensor, on either side
+save("broadcast", [
+    helper.make_node("Add", ["input", "perChannel"], ["a"]),
+    helper.make_node("Sub", ["five", "a"], ["b"]),
+    helper.make_node("Div", ["divisors", "b"], ["c"]),
+    helper.make_node("Div", ["c", "scalar"], ["d"]),
+    helper.make_node("Sub", ["d", "whole"], ["e"]),
+    helper.make_node("Mul", ["half", "e"], ["f"]),
+    helper.make_node("Add", ["f", "input"], ["output"]),
+], [constant("perChannel", np.array([1, 2, 3]).reshape(1, 3, 1, 1)), constant("five", 5.0),
+    constant("divisors", np.array([2, 3, 4]).reshape(1, 3, 1, 1)), constant("scalar", [1.5]),
+    constant("whole", rng.uniform(-1, 1, (1, 3, HEIGHT, WIDTH))), constant("half", 0.5)])
+
+# A small upscaling network with dynamic tile dimensions: feature extraction, a grouped residual block,
+# a skip connection, pixel shuffle and a bilinear base image
+save("upscaler", [
+    helper.make_node("Conv", ["input", "w1", "b1"], ["f1"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+    helper.make_node("LeakyRelu", ["f1"], ["a1"], alpha=0.2),
+    helper.make_node("Conv", ["a1", "w2", "b2"], ["f2"], kernel_shape=[3, 3], pads=[1, 1, 1, 1], group=4),
+    helper.make_node("Relu", ["f2"], ["a2"]),
+    helper.make_node("Conv", ["a2", "w3", "b3"], ["f3"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+    helper.make_node("Add", ["f3", "a1"], ["r"]),
+    helper.make_node("Concat", ["r", "input"], ["cat"], axis=1),
+    helper.make_node("Conv", ["cat", "w4", "b4"], ["f4"], kernel_shape=[3, 3], pads=[1, 1, 1, 1]),
+    helper.make_node("Tanh", ["f4"], ["t"]),
+    helper.make_node("DepthToSpace", ["t"], ["shuffled"], blocksize=2, mode="CRD"),
+    helper.make_node("Mul", ["shuffled", "gain"], ["detail"]),
+    helper.make_node("Resize", ["input", "", "scales"], ["base"], mode="linear", coordinate_transformation_mode="half_pixel"),
+    helper.make_node("Add", ["base", "detail"], ["sum"]),
+    helper.make_node("Sigmoid", ["sum"], ["s"]),
+    helper.make_node("Clip", ["s", "low", "high"], ["output"]),
+], [weights("w1", 16, 3, 3, 3), weights("b1", 16), weights("w2", 16, 4, 3, 3), weights("b2", 16),
+    weights("w3", 16, 16, 3, 3), weights("b3", 16), weights("w4", 12, 19, 3, 3), weights("b4", 12),
+    constant("gain", 0.1), constant("scales", [1, 1, 2, 2]), constant("low", 0.3), constant("high", 0.7)],
+    factor=2, dynamic=True)
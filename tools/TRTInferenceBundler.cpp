@@ -0,0 +1,123 @@
+// Packs serialized TensorRT engines of one model into an engine bundle (.trtb), from which the module
+// loads the variant best suited to the GPU, the image and the memory budget.
+//
+// Usage: TRTInferenceBundler <bundle> {[options] <engine>}...
+//
+// Options describe the engines that follow them, until changed:
+// --name <text>          name shown when the variant is selected; the engine file name by default
+// --precision <p>        fp32, fp16 or int8
+// --sm <major.minor>     compute capability of the GPU architecture the engine was built for
+// --trt <version>        TensorRT version the engine was built with, as major.minor.patch
+// --tile <w>x<h>         input tile dimensions
+// --scale <factor>       output to input tile dimension ratio
+// --memory <MiB>         device memory needed to run the engine
+//
+// Example:
+//   TRTInferenceBundler model.trtb --trt 8.5.3 --scale 2 --memory 900
+//       --sm 8.6 --tile 512x512 --precision fp16 model_sm86_512_fp16.trt --precision fp32 model_sm86_512_fp32.trt
+//       --sm 7.5 --tile 256x256 --memory 400 --precision fp16 model_sm75_256_fp16.trt
+
+#include <pcl/Exception.h>
+#include <pcl/File.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../TRTInferenceBundle.h"
+
+using namespace pcl;
+
+// Version components: "8.5.3" gives 8, 5 and 3, missing ones are zero
+static int versionPart(const IsoString& text, size_type index)
+{
+    IsoStringList parts;
+    text.Break(parts, '.');
+    return (index < parts.Length()) ? parts[index].ToInt() : 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "Usage: TRTInferenceBundler <bundle> {[--name <text>] [--precision fp32|fp16|int8] [--sm <major.minor>]\n"
+                             "                           [--trt <version>] [--tile <w>x<h>] [--scale <factor>] [--memory <MiB>] <engine>}...\n");
+        return 1;
+    }
+
+    try
+    {
+        TRTBundleVariant current = {};
+        current.precision = TRTBundlePrecision::FP32;
+        current.scaleFactor = 1;
+        IsoString name;
+        std::vector<TRTBundleVariant> variants;
+        std::vector<ByteArray> engines;
+        for (int i = 2; i < argc; i++)
+        {
+            IsoString arg(argv[i]);
+            bool hasValue = i + 1 < argc;
+            if ((arg == "--name") && hasValue)
+                name = argv[++i];
+            else if ((arg == "--precision") && hasValue)
+            {
+                IsoString p = IsoString(argv[++i]).CaseFolded();
+                if (p == "fp32")
+                    current.precision = TRTBundlePrecision::FP32;
+                else if (p == "fp16")
+                    current.precision = TRTBundlePrecision::FP16;
+                else if (p == "int8")
+                    current.precision = TRTBundlePrecision::INT8;
+                else
+                    throw Error("Unknown precision " + String(p));
+            }
+            else if ((arg == "--sm") && hasValue)
+                {
+                IsoString version(argv[++i]);
+                current.computeCapability = versionPart(version, 0) * 10 + versionPart(version, 1);
+            }
+            else if ((arg == "--trt") && hasValue)
+                {
+                IsoString version(argv[++i]);
+                current.tensorrtVersion = versionPart(version, 0) * 1000 + versionPart(version, 1) * 100 + versionPart(version, 2);
+            }
+            else if ((arg == "--tile") && hasValue)
+            {
+                IsoStringList dims;
+                IsoString(argv[++i]).Break(dims, 'x');
+                current.tileW = dims[0].ToInt();
+                current.tileH = (dims.Length() > 1) ? dims[1].ToInt() : current.tileW;
+            }
+            else if ((arg == "--scale") && hasValue)
+                current.scaleFactor = IsoString(argv[++i]).ToInt();
+            else if ((arg == "--memory") && hasValue)
+                current.deviceMemory = uint64(IsoString(argv[++i]).ToInt()) << 20;
+            else if (arg.StartsWith("--"))
+                throw Error("Unknown or incomplete option " + String(arg));
+            else
+            {
+                if ((current.computeCapability == 0) || (current.tensorrtVersion == 0) || (current.tileW == 0))
+                    throw Error("--sm, --trt and --tile must be given before " + String(arg));
+                String path = String::UTF8ToUTF16(arg.c_str());
+                TRTBundleVariant variant = current;
+                IsoString variantName = name.IsEmpty() ? File::ExtractNameAndExtension(path).ToUTF8() : name;
+                ::strncpy(variant.name, variantName.c_str(), sizeof(variant.name) - 1);
+                variants.push_back(variant);
+                engines.push_back(File::ReadFile(path));
+                name.Clear();
+                std::printf("%s\n", bundleVariantDescription(variant).ToUTF8().c_str());
+            }
+        }
+        if (variants.empty())
+            throw Error("No engine given.");
+
+        TRTEngineBundle::write(String::UTF8ToUTF16(argv[1]), variants, engines);
+        std::printf("%d engines written to %s\n", int(variants.size()), argv[1]);
+        return 0;
+    }
+    catch (const Exception& x)
+    {
+        std::fprintf(stderr, "%s\n", x.Message().ToUTF8().c_str());
+        return 1;
+    }
+}